@@ -0,0 +1,140 @@
+/**
+ * @file BoundedQueue.h
+ * @brief Header file for the BoundedQueue class template
+ *
+ * This file defines a fixed-capacity blocking FIFO queue for producer/consumer
+ * pipelines such as streaming trace ingestion:
+ *
+ * - push() blocks while the queue is full, so a fast producer is throttled to
+ *   the consumers' pace and memory stays bounded by the capacity
+ * - pop() blocks while the queue is empty and returns false once the queue
+ *   has been closed and drained
+ * - Storage is a ring buffer allocated once in the constructor
+ *
+ * Any number of producers and consumers may use the queue concurrently.
+ *
+ * Thread Safety:
+ * - The ring and its indices are protected by queueMutex (CRITICAL SECTION)
+ * - notFull / notEmpty condition variables park blocked producers / consumers
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/**
+ * @class BoundedQueue
+ * @brief Blocking multi-producer/multi-consumer FIFO with a fixed capacity
+ *
+ * @tparam T Element type (must be default-constructible and movable)
+ */
+template <typename T>
+class BoundedQueue {
+private:
+    std::vector<T> ring;                  ///< Element slots (CRITICAL RESOURCE)
+    std::size_t head;                     ///< Index of the oldest element
+    std::size_t count;                    ///< Number of queued elements
+    std::size_t maxDepth;                 ///< Deepest the queue has been
+    bool closed;                          ///< No more pushes will be accepted
+    mutable std::mutex queueMutex;        ///< Protects every member above
+    std::condition_variable notFull;      ///< Signalled when a slot frees up (or on close)
+    std::condition_variable notEmpty;     ///< Signalled when an element arrives (or on close)
+
+    BoundedQueue(const BoundedQueue&) = delete;             ///< Non-copyable
+    BoundedQueue& operator=(const BoundedQueue&) = delete;  ///< Non-assignable
+
+public:
+    /**
+     * @brief Constructor - allocates the ring
+     * @param capacity Maximum number of queued elements (0 is raised to 1)
+     */
+    explicit BoundedQueue(std::size_t capacity)
+        : ring(capacity == 0 ? 1 : capacity), head(0), count(0), maxDepth(0), closed(false) {}
+
+    /**
+     * @brief Append an element, blocking while the queue is full
+     * @param value Element to queue
+     * @return false if the queue was closed (the element is dropped)
+     */
+    bool push(T value) {
+        {
+            // CRITICAL SECTION BEGIN - wait for a free slot
+            std::unique_lock<std::mutex> lock(queueMutex);
+            notFull.wait(lock, [this] { return closed || count < ring.size(); });
+            if (closed) {
+                return false;
+            }
+            ring[(head + count) % ring.size()] = std::move(value);
+            count++;
+            if (count > maxDepth) {
+                maxDepth = count;
+            }
+            // CRITICAL SECTION END
+        }
+        notEmpty.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element, blocking while the queue is empty
+     * @param value Receives the element
+     * @return false once the queue is closed and empty
+     */
+    bool pop(T& value) {
+        {
+            // CRITICAL SECTION BEGIN - wait for an element
+            std::unique_lock<std::mutex> lock(queueMutex);
+            notEmpty.wait(lock, [this] { return closed || count > 0; });
+            if (count == 0) {
+                return false;
+            }
+            value = std::move(ring[head]);
+            head = (head + 1) % ring.size();
+            count--;
+            // CRITICAL SECTION END
+        }
+        notFull.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Stop accepting elements and wake every blocked thread
+     *
+     * Elements already queued can still be popped.
+     */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            closed = true;
+        }
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+
+    /**
+     * @brief Get the capacity
+     * @return Maximum number of queued elements
+     */
+    std::size_t capacity() const {
+        return ring.size();
+    }
+
+    /**
+     * @brief Get the deepest the queue has been
+     * @return High-water mark of the element count
+     */
+    std::size_t getMaxDepth() const {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        return maxDepth;
+    }
+};
+
+#endif // BOUNDED_QUEUE_H
@@ -0,0 +1,529 @@
+/**
+ * @file Checkpoint.cpp
+ * @brief Implementation of checkpoint files and the interruption flag
+ *
+ * All multi-byte fields are stored little-endian and are encoded/decoded byte
+ * by byte, so checkpoints are portable between hosts of either endianness.
+ * Decoding checks every count against the bytes left before allocating, so a
+ * truncated or foreign file is rejected rather than read past its end.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "Checkpoint.h"
+#include "ProcessSimulator.h"
+#include "DiningPhilosophers.h"
+#include "ResourceGraph.h"
+#include "MappedFile.h"
+#include <bit>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+std::atomic<bool> requested(false);  ///< Set by the signal handler
+
+/**
+ * @brief SIGINT / SIGTERM handler: ask for a checkpoint, then restore the default action
+ */
+extern "C" void onCheckpointSignal(int number) {
+    requested.store(true, std::memory_order_relaxed);
+    std::signal(number, SIG_DFL);
+}
+
+/**
+ * @brief Mix one value into a 64-bit FNV-1a style hash
+ */
+inline std::uint64_t mix(std::uint64_t hash, std::uint64_t value) {
+    return (hash ^ value) * 0x100000001B3ull;
+}
+
+/**
+ * @brief Decode a little-endian 32-bit value
+ */
+inline std::uint32_t readU32(const char* p) {
+    const unsigned char* b = reinterpret_cast<const unsigned char*>(p);
+    return static_cast<std::uint32_t>(b[0]) | (static_cast<std::uint32_t>(b[1]) << 8) |
+           (static_cast<std::uint32_t>(b[2]) << 16) | (static_cast<std::uint32_t>(b[3]) << 24);
+}
+
+/**
+ * @brief Decode a little-endian 64-bit value
+ */
+inline std::uint64_t readU64(const char* p) {
+    return static_cast<std::uint64_t>(readU32(p)) | (static_cast<std::uint64_t>(readU32(p + 4)) << 32);
+}
+
+/**
+ * @brief Encode a little-endian 32-bit value
+ */
+inline void writeU32(char* p, std::uint32_t value) {
+    p[0] = static_cast<char>(value & 0xFF);
+    p[1] = static_cast<char>((value >> 8) & 0xFF);
+    p[2] = static_cast<char>((value >> 16) & 0xFF);
+    p[3] = static_cast<char>((value >> 24) & 0xFF);
+}
+
+/**
+ * @brief Encode a little-endian 64-bit value
+ */
+inline void writeU64(char* p, std::uint64_t value) {
+    writeU32(p, static_cast<std::uint32_t>(value & 0xFFFFFFFFu));
+    writeU32(p + 4, static_cast<std::uint32_t>(value >> 32));
+}
+
+/**
+ * @brief Write header and payload to path + ".tmp" and rename it over path
+ * @param path Destination
+ * @param kind Checkpoint kind
+ * @param payload Encoded fields
+ * @return true on success
+ */
+bool writeImage(const std::string& path, CheckpointKind kind, const std::string& payload) {
+    char header[CHECKPOINT_HEADER_SIZE];
+    for (std::size_t i = 0; i < sizeof(CHECKPOINT_MAGIC); i++) {
+        header[i] = CHECKPOINT_MAGIC[i];
+    }
+    writeU32(header + 4, CHECKPOINT_VERSION);
+    writeU32(header + 8, static_cast<std::uint32_t>(kind));
+    writeU32(header + 12, 0);
+    writeU64(header + 16, static_cast<std::uint64_t>(payload.size()));
+    writeU64(header + 24, 0);
+
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Error: Cannot create file " << temporary << std::endl;
+            return false;
+        }
+        file.write(header, static_cast<std::streamsize>(CHECKPOINT_HEADER_SIZE));
+        file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+        if (!file) {
+            std::cerr << "Error: Failed to write " << temporary << std::endl;
+            return false;
+        }
+    }
+    // rename() does not replace an existing file on every platform
+    if (std::rename(temporary.c_str(), path.c_str()) != 0 &&
+        (std::remove(path.c_str()) != 0 || std::rename(temporary.c_str(), path.c_str()) != 0)) {
+        std::cerr << "Error: Cannot replace " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Decode the payload of a process checkpoint
+ */
+bool decodeProcesses(CheckpointReader& in, ProcessCheckpoint& checkpoint) {
+    std::uint32_t policy = in.getU32();
+    std::uint32_t readyQueue = in.getU32();
+    if (policy > static_cast<std::uint32_t>(SchedulingPolicy::Priority) ||
+        readyQueue > static_cast<std::uint32_t>(ReadyQueueType::Bucket)) {
+        return false;
+    }
+    checkpoint.policy = static_cast<SchedulingPolicy>(policy);
+    checkpoint.readyQueue = static_cast<ReadyQueueType>(readyQueue);
+    checkpoint.quantum = static_cast<int>(in.getU32());
+    checkpoint.processCount = in.getU64();
+    checkpoint.traceFingerprint = in.getU64();
+    checkpoint.clock = in.getI64();
+    checkpoint.nextArrival = in.getU64();
+    checkpoint.nextSeq = in.getU64();
+
+    checkpoint.cpus.resize(in.getCount(40));
+    for (CheckpointCpu& cpu : checkpoint.cpus) {
+        cpu.busy = (in.getU32() != 0);
+        cpu.index = in.getU32();
+        cpu.sliceStart = in.getI64();
+        cpu.token = in.getU64();
+        cpu.sliceEnd = in.getI64();
+        cpu.sliceSeq = in.getU64();
+    }
+    checkpoint.ready.resize(in.getCount(4));
+    for (std::uint32_t& index : checkpoint.ready) {
+        index = in.getU32();
+    }
+    in.getInts(checkpoint.remaining);
+    in.getLongs(checkpoint.startTime);
+    in.getLongs(checkpoint.finishTime);
+    if (!in.good()) {
+        return false;
+    }
+
+    // Every index must refer to a row of the table
+    std::uint64_t n = checkpoint.processCount;
+    if (checkpoint.cpus.empty() || checkpoint.nextArrival > n || checkpoint.remaining.size() != n ||
+        checkpoint.startTime.size() != n || checkpoint.finishTime.size() != n) {
+        return false;
+    }
+    for (const CheckpointCpu& cpu : checkpoint.cpus) {
+        if (cpu.busy && cpu.index >= n) {
+            return false;
+        }
+    }
+    for (std::uint32_t index : checkpoint.ready) {
+        if (index >= n) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Decode the payload of a philosopher checkpoint
+ */
+bool decodePhilosophers(CheckpointReader& in, PhilosopherCheckpoint& checkpoint) {
+    std::uint32_t strategy = in.getU32();
+    if (strategy > static_cast<std::uint32_t>(DiningStrategy::Naive)) {
+        return false;
+    }
+    checkpoint.strategy = static_cast<DiningStrategy>(strategy);
+    checkpoint.iterations = static_cast<int>(in.getU32());
+    checkpoint.runDuration = in.getF64();
+    checkpoint.readRatio = in.getF64();
+    checkpoint.elapsed = in.getF64();
+    checkpoint.seed = in.getU64();
+    checkpoint.graphFingerprint = in.getU64();
+
+    checkpoint.philosophers.resize(in.getCount(88));
+    for (PhilosopherProgress& state : checkpoint.philosophers) {
+        state.cycles = static_cast<int>(in.getU32());
+        state.readMeals = static_cast<int>(in.getU32());
+        state.totalWait = in.getF64();
+        state.maxWait = in.getF64();
+        for (std::uint64_t& word : state.rng) {
+            word = in.getU64();
+        }
+        state.waitMin = in.getU64();
+        state.waitMax = in.getU64();
+        state.waitSum = in.getF64();
+        state.waitBuckets.resize(in.getCount(12));
+        for (auto& bucket : state.waitBuckets) {
+            bucket.first = in.getU32();
+            bucket.second = in.getU64();
+        }
+    }
+    checkpoint.forks.resize(in.getCount(48));
+    for (ForkProgress& fork : checkpoint.forks) {
+        fork.owner = static_cast<int>(in.getU32());
+        fork.dirty = (in.getU32() != 0);
+        fork.acquisitions = in.getU64();
+        fork.contended = in.getU64();
+        fork.totalWaitNs = in.getU64();
+        fork.maxWaitNs = in.getU64();
+        fork.shared = in.getU64();
+    }
+    return in.good();
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// CheckpointWriter / CheckpointReader
+// ---------------------------------------------------------------------------
+
+void CheckpointWriter::putU32(std::uint32_t value) {
+    char bytes[4];
+    writeU32(bytes, value);
+    image.append(bytes, sizeof(bytes));
+}
+
+void CheckpointWriter::putU64(std::uint64_t value) {
+    char bytes[8];
+    writeU64(bytes, value);
+    image.append(bytes, sizeof(bytes));
+}
+
+void CheckpointWriter::putI64(std::int64_t value) {
+    putU64(static_cast<std::uint64_t>(value));
+}
+
+void CheckpointWriter::putF64(double value) {
+    putU64(std::bit_cast<std::uint64_t>(value));
+}
+
+/**
+ * @brief Append a count and the values, encoded in one pass into reserved space
+ * @param values Values
+ */
+void CheckpointWriter::putInts(const std::vector<int>& values) {
+    putU64(static_cast<std::uint64_t>(values.size()));
+    std::size_t at = image.size();
+    image.resize(at + 4 * values.size());
+    char* out = &image[0] + at;
+    for (std::size_t i = 0; i < values.size(); i++) {
+        writeU32(out + 4 * i, static_cast<std::uint32_t>(values[i]));
+    }
+}
+
+/**
+ * @brief Append a count and the values, encoded in one pass into reserved space
+ * @param values Values
+ */
+void CheckpointWriter::putLongs(const std::vector<long long>& values) {
+    putU64(static_cast<std::uint64_t>(values.size()));
+    std::size_t at = image.size();
+    image.resize(at + 8 * values.size());
+    char* out = &image[0] + at;
+    for (std::size_t i = 0; i < values.size(); i++) {
+        writeU64(out + 8 * i, static_cast<std::uint64_t>(values[i]));
+    }
+}
+
+const std::string& CheckpointWriter::data() const {
+    return image;
+}
+
+CheckpointReader::CheckpointReader(const char* data, std::size_t size)
+    : next(data), end(data + size), ok(true) {
+}
+
+const char* CheckpointReader::take(std::size_t bytes) {
+    if (!ok || static_cast<std::size_t>(end - next) < bytes) {
+        ok = false;
+        return nullptr;
+    }
+    const char* p = next;
+    next += bytes;
+    return p;
+}
+
+std::uint32_t CheckpointReader::getU32() {
+    const char* p = take(4);
+    return p ? readU32(p) : 0;
+}
+
+std::uint64_t CheckpointReader::getU64() {
+    const char* p = take(8);
+    return p ? readU64(p) : 0;
+}
+
+std::int64_t CheckpointReader::getI64() {
+    return static_cast<std::int64_t>(getU64());
+}
+
+double CheckpointReader::getF64() {
+    return std::bit_cast<double>(getU64());
+}
+
+std::size_t CheckpointReader::getCount(std::size_t elementSize) {
+    std::uint64_t count = getU64();
+    if (!ok || count > static_cast<std::uint64_t>(end - next) / elementSize) {
+        ok = false;
+        return 0;
+    }
+    return static_cast<std::size_t>(count);
+}
+
+void CheckpointReader::getInts(std::vector<int>& values) {
+    values.resize(getCount(4));
+    const char* p = take(4 * values.size());
+    for (std::size_t i = 0; p && i < values.size(); i++) {
+        values[i] = static_cast<int>(readU32(p + 4 * i));
+    }
+}
+
+void CheckpointReader::getLongs(std::vector<long long>& values) {
+    values.resize(getCount(8));
+    const char* p = take(8 * values.size());
+    for (std::size_t i = 0; p && i < values.size(); i++) {
+        values[i] = static_cast<long long>(readU64(p + 8 * i));
+    }
+}
+
+bool CheckpointReader::good() const {
+    return ok;
+}
+
+bool CheckpointReader::atEnd() const {
+    return next == end;
+}
+
+// ---------------------------------------------------------------------------
+// Checkpoint files
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Encode a process checkpoint and write it
+ * @param path Destination
+ * @param checkpoint State to save
+ * @return true on success
+ */
+bool writeCheckpoint(const std::string& path, const ProcessCheckpoint& checkpoint) {
+    CheckpointWriter out;
+    out.putU32(static_cast<std::uint32_t>(checkpoint.policy));
+    out.putU32(static_cast<std::uint32_t>(checkpoint.readyQueue));
+    out.putU32(static_cast<std::uint32_t>(checkpoint.quantum));
+    out.putU64(checkpoint.processCount);
+    out.putU64(checkpoint.traceFingerprint);
+    out.putI64(checkpoint.clock);
+    out.putU64(checkpoint.nextArrival);
+    out.putU64(checkpoint.nextSeq);
+
+    out.putU64(static_cast<std::uint64_t>(checkpoint.cpus.size()));
+    for (const CheckpointCpu& cpu : checkpoint.cpus) {
+        out.putU32(cpu.busy ? 1 : 0);
+        out.putU32(cpu.index);
+        out.putI64(cpu.sliceStart);
+        out.putU64(cpu.token);
+        out.putI64(cpu.sliceEnd);
+        out.putU64(cpu.sliceSeq);
+    }
+    out.putU64(static_cast<std::uint64_t>(checkpoint.ready.size()));
+    for (std::uint32_t index : checkpoint.ready) {
+        out.putU32(index);
+    }
+    out.putInts(checkpoint.remaining);
+    out.putLongs(checkpoint.startTime);
+    out.putLongs(checkpoint.finishTime);
+    return writeImage(path, CheckpointKind::Processes, out.data());
+}
+
+/**
+ * @brief Encode a philosopher checkpoint and write it
+ * @param path Destination
+ * @param checkpoint State to save
+ * @return true on success
+ */
+bool writeCheckpoint(const std::string& path, const PhilosopherCheckpoint& checkpoint) {
+    CheckpointWriter out;
+    out.putU32(static_cast<std::uint32_t>(checkpoint.strategy));
+    out.putU32(static_cast<std::uint32_t>(checkpoint.iterations));
+    out.putF64(checkpoint.runDuration);
+    out.putF64(checkpoint.readRatio);
+    out.putF64(checkpoint.elapsed);
+    out.putU64(checkpoint.seed);
+    out.putU64(checkpoint.graphFingerprint);
+
+    out.putU64(static_cast<std::uint64_t>(checkpoint.philosophers.size()));
+    for (const PhilosopherProgress& state : checkpoint.philosophers) {
+        out.putU32(static_cast<std::uint32_t>(state.cycles));
+        out.putU32(static_cast<std::uint32_t>(state.readMeals));
+        out.putF64(state.totalWait);
+        out.putF64(state.maxWait);
+        for (std::uint64_t word : state.rng) {
+            out.putU64(word);
+        }
+        out.putU64(state.waitMin);
+        out.putU64(state.waitMax);
+        out.putF64(state.waitSum);
+        out.putU64(static_cast<std::uint64_t>(state.waitBuckets.size()));
+        for (const auto& bucket : state.waitBuckets) {
+            out.putU32(bucket.first);
+            out.putU64(bucket.second);
+        }
+    }
+    out.putU64(static_cast<std::uint64_t>(checkpoint.forks.size()));
+    for (const ForkProgress& fork : checkpoint.forks) {
+        out.putU32(static_cast<std::uint32_t>(fork.owner));
+        out.putU32(fork.dirty ? 1 : 0);
+        out.putU64(fork.acquisitions);
+        out.putU64(fork.contended);
+        out.putU64(fork.totalWaitNs);
+        out.putU64(fork.maxWaitNs);
+        out.putU64(fork.shared);
+    }
+    return writeImage(path, CheckpointKind::Philosophers, out.data());
+}
+
+/**
+ * @brief Map a checkpoint file, check its header and decode its payload
+ * @param path Checkpoint file
+ * @param checkpoint Receives the state
+ * @return true on success
+ */
+bool readCheckpoint(const std::string& path, Checkpoint& checkpoint) {
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "Error: Cannot open checkpoint " << path << std::endl;
+        return false;
+    }
+    const char* data = file.data();
+    std::size_t size = file.size();
+    bool magic = size >= CHECKPOINT_HEADER_SIZE;
+    for (std::size_t i = 0; magic && i < sizeof(CHECKPOINT_MAGIC); i++) {
+        magic = (data[i] == CHECKPOINT_MAGIC[i]);
+    }
+    if (!magic) {
+        std::cerr << "Error: " << path << " is not a checkpoint file" << std::endl;
+        return false;
+    }
+    std::uint32_t version = readU32(data + 4);
+    if (version != CHECKPOINT_VERSION) {
+        std::cerr << "Error: " << path << " has checkpoint format version " << version
+                  << " (expected " << CHECKPOINT_VERSION << ")" << std::endl;
+        return false;
+    }
+    std::uint64_t payload = readU64(data + 16);
+    if (payload != size - CHECKPOINT_HEADER_SIZE) {
+        std::cerr << "Error: Checkpoint " << path << " is truncated" << std::endl;
+        return false;
+    }
+
+    CheckpointReader in(data + CHECKPOINT_HEADER_SIZE, static_cast<std::size_t>(payload));
+    std::uint32_t kind = readU32(data + 8);
+    bool decoded = false;
+    if (kind == static_cast<std::uint32_t>(CheckpointKind::Processes)) {
+        checkpoint.kind = CheckpointKind::Processes;
+        decoded = decodeProcesses(in, checkpoint.processes);
+    } else if (kind == static_cast<std::uint32_t>(CheckpointKind::Philosophers)) {
+        checkpoint.kind = CheckpointKind::Philosophers;
+        decoded = decodePhilosophers(in, checkpoint.philosophers);
+    }
+    if (!decoded || !in.atEnd()) {
+        checkpoint.kind = CheckpointKind::None;
+        std::cerr << "Error: Checkpoint " << path << " is corrupt" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Hash every field of every process, in file order
+ * @param processes Processes
+ * @return Fingerprint
+ */
+std::uint64_t traceFingerprint(const std::vector<Process>& processes) {
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (const Process& proc : processes) {
+        hash = mix(hash, static_cast<std::uint32_t>(proc.pid));
+        hash = mix(hash, static_cast<std::uint32_t>(proc.burstTime));
+        hash = mix(hash, static_cast<std::uint32_t>(proc.arrivalTime));
+        hash = mix(hash, static_cast<std::uint32_t>(proc.priority));
+    }
+    return mix(hash, static_cast<std::uint64_t>(processes.size()));
+}
+
+/**
+ * @brief Hash every agent's listed forks and the fork count
+ * @param graph Table
+ * @return Fingerprint
+ */
+std::uint64_t graphFingerprint(const ResourceGraph& graph) {
+    std::uint64_t hash = mix(0xCBF29CE484222325ull, static_cast<std::uint64_t>(graph.resourceCount()));
+    for (int agent = 0; agent < graph.agentCount(); agent++) {
+        const int* needs = graph.listedNeedsOf(agent);
+        hash = mix(hash, static_cast<std::uint64_t>(graph.needCount(agent)));
+        for (std::size_t i = 0; i < graph.needCount(agent); i++) {
+            hash = mix(hash, static_cast<std::uint32_t>(needs[i]));
+        }
+    }
+    return hash;
+}
+
+std::atomic<bool>& checkpointRequest() {
+    return requested;
+}
+
+/**
+ * @brief Route SIGINT and SIGTERM to the checkpoint flag
+ */
+void installCheckpointSignals() {
+    std::signal(SIGINT, onCheckpointSignal);
+    std::signal(SIGTERM, onCheckpointSignal);
+}
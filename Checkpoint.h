@@ -0,0 +1,312 @@
+/**
+ * @file Checkpoint.h
+ * @brief Header file for checkpoint and resume of interrupted simulations
+ *
+ * A checkpoint is the state of a simulation between two steps, written so
+ * that a later process can continue the run exactly where it stopped:
+ *
+ * - ProcessCheckpoint: the virtual-time engine at an event boundary. It holds
+ *   the simulated clock, the arrival cursor, every simulated CPU and its
+ *   pending slice end, the ready queue in pick order, and the remaining,
+ *   start and finish columns of the process table. Re-adding the ready
+ *   processes in pick order reproduces every later scheduling decision, so a
+ *   resumed run ends with the same statistics as an uninterrupted one.
+ * - PhilosopherCheckpoint: the dining philosophers between two think-eat
+ *   cycles (no fork is held then). It holds the cycles, waits, wait
+ *   histogram and generator state of each philosopher, the Chandy-Misra fork
+ *   ownership and the per-fork contention counters.
+ *
+ * File format (versioned, little-endian, encoded byte by byte like the
+ * binary trace format):
+ *
+ *    Offset  Size  Field
+ *    0       4     magic "PSCK"
+ *    4       4     format version (currently 2)
+ *    8       4     kind (CheckpointKind)
+ *    12      4     reserved (0)
+ *    16      8     payload size in bytes
+ *    24      8     reserved (0)
+ *    32      ...   payload: the fields of the checkpoint struct in
+ *                  declaration order, arrays as a 64-bit count followed by
+ *                  the elements (columns stored contiguously)
+ *
+ * A checkpoint is written to PATH.tmp and renamed over PATH, so an
+ * interruption while writing leaves the previous checkpoint intact.
+ *
+ * Interruption: installCheckpointSignals() makes SIGINT and SIGTERM set
+ * checkpointRequest() instead of ending the program. A simulation with a
+ * checkpoint path polls the flag (one relaxed load per event or cycle),
+ * saves its state and stops; the handler then restores the default action,
+ * so a second signal ends the program at once.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct Process;
+class ResourceGraph;
+enum class SchedulingPolicy;
+enum class ReadyQueueType;
+enum class DiningStrategy;
+
+static const char CHECKPOINT_MAGIC[4] = { 'P', 'S', 'C', 'K' };  ///< Checkpoint magic bytes
+static const std::uint32_t CHECKPOINT_VERSION = 2;                ///< Current checkpoint format version
+static const std::size_t CHECKPOINT_HEADER_SIZE = 32;             ///< Header size in bytes
+
+/**
+ * @enum CheckpointKind
+ * @brief Simulation whose state a checkpoint holds
+ */
+enum class CheckpointKind {
+    None = 0,          ///< No checkpoint read yet
+    Processes = 1,     ///< ProcessCheckpoint (virtual-time engine)
+    Philosophers = 2   ///< PhilosopherCheckpoint (the process simulation had finished)
+};
+
+/**
+ * @class CheckpointWriter
+ * @brief Appends little-endian fields to an in-memory checkpoint payload
+ */
+class CheckpointWriter {
+private:
+    std::string image;  ///< Payload written so far
+
+public:
+    void putU32(std::uint32_t value);
+    void putU64(std::uint64_t value);
+    void putI64(std::int64_t value);
+    void putF64(double value);
+
+    /**
+     * @brief Append an array of 32-bit values (count, then the values)
+     * @param values Values
+     */
+    void putInts(const std::vector<int>& values);
+
+    /**
+     * @brief Append an array of 64-bit values (count, then the values)
+     * @param values Values
+     */
+    void putLongs(const std::vector<long long>& values);
+
+    /**
+     * @brief Get the payload
+     * @return Bytes written so far
+     */
+    const std::string& data() const;
+};
+
+/**
+ * @class CheckpointReader
+ * @brief Reads little-endian fields from a checkpoint payload with bounds checks
+ *
+ * A read past the end returns 0 and marks the reader as failed; callers
+ * check good() once after decoding.
+ */
+class CheckpointReader {
+private:
+    const char* next;  ///< First unread byte
+    const char* end;   ///< One past the last byte
+    bool ok;           ///< false after a read past the end
+
+    /**
+     * @brief Claim bytes for a read
+     * @param bytes Number of bytes
+     * @return Start of the bytes, or null (and the reader fails) if too few are left
+     */
+    const char* take(std::size_t bytes);
+
+public:
+    /**
+     * @brief Constructor
+     * @param data Payload
+     * @param size Payload size in bytes
+     */
+    CheckpointReader(const char* data, std::size_t size);
+
+    std::uint32_t getU32();
+    std::uint64_t getU64();
+    std::int64_t getI64();
+    double getF64();
+
+    /**
+     * @brief Read an array written by CheckpointWriter::putInts()
+     * @param values Receives the values
+     */
+    void getInts(std::vector<int>& values);
+
+    /**
+     * @brief Read an array written by CheckpointWriter::putLongs()
+     * @param values Receives the values
+     */
+    void getLongs(std::vector<long long>& values);
+
+    /**
+     * @brief Read an array count, failing if fewer than count * elementSize bytes follow
+     * @param elementSize Encoded size of one element
+     * @return Element count (0 on failure)
+     */
+    std::size_t getCount(std::size_t elementSize);
+
+    /**
+     * @brief Check that every read so far was in bounds
+     * @return true if no read failed
+     */
+    bool good() const;
+
+    /**
+     * @brief Check that the whole payload was read
+     * @return true if no bytes are left
+     */
+    bool atEnd() const;
+};
+
+/**
+ * @struct CheckpointCpu
+ * @brief One simulated CPU and, if busy, the end of its current slice
+ */
+struct CheckpointCpu {
+    bool busy;                 ///< A process is running
+    std::uint32_t index;       ///< Index of the running process
+    long long sliceStart;      ///< Start of the current slice
+    std::uint64_t token;       ///< Dispatch token
+    long long sliceEnd;        ///< Busy: time the pending slice end fires
+    std::uint64_t sliceSeq;    ///< Busy: event sequence number of the slice end (breaks ties)
+};
+
+/**
+ * @struct ProcessCheckpoint
+ * @brief State of the virtual-time engine between two events
+ */
+struct ProcessCheckpoint {
+    SchedulingPolicy policy;          ///< Scheduling policy of the run
+    ReadyQueueType readyQueue;        ///< Ready queue of the keyed policies
+    int quantum;                      ///< Round-Robin time quantum
+    std::uint64_t processCount;       ///< Processes in the trace
+    std::uint64_t traceFingerprint;   ///< traceFingerprint() of the trace
+    long long clock;                  ///< Simulated clock
+    std::uint64_t nextArrival;        ///< Position in the arrival order of the next arrival
+    std::uint64_t nextSeq;            ///< Next event sequence number
+    std::vector<CheckpointCpu> cpus;  ///< Simulated CPUs
+    std::vector<std::uint32_t> ready; ///< Ready processes in pick order
+    std::vector<int> remaining;       ///< Burst time not yet run, per process
+    std::vector<long long> startTime; ///< First dispatch per process (-1 = not started)
+    std::vector<long long> finishTime; ///< Completion per process (-1 = not finished)
+};
+
+/**
+ * @struct PhilosopherProgress
+ * @brief Progress of one philosopher between two cycles
+ */
+struct PhilosopherProgress {
+    int cycles;                     ///< Think-eat cycles completed
+    int readMeals;                  ///< Meals eaten as a read
+    double totalWait;               ///< Seconds spent waiting for forks
+    double maxWait;                 ///< Longest single wait
+    std::uint64_t rng[4];           ///< Think-time generator state
+    std::vector<std::pair<std::uint32_t, std::uint64_t> > waitBuckets;  ///< Non-empty wait histogram buckets
+    std::uint64_t waitMin;          ///< Smallest recorded wait (ns)
+    std::uint64_t waitMax;          ///< Largest recorded wait (ns)
+    double waitSum;                 ///< Sum of the recorded waits (ns)
+};
+
+/**
+ * @struct ForkProgress
+ * @brief Ownership and contention counters of one fork between two cycles
+ */
+struct ForkProgress {
+    int owner;                   ///< Chandy-Misra: philosopher holding the fork
+    bool dirty;                  ///< Chandy-Misra: eaten with since it was handed over
+    std::uint64_t acquisitions;  ///< Pick-ups
+    std::uint64_t contended;     ///< Pick-ups that had to wait
+    std::uint64_t totalWaitNs;   ///< Summed wait in nanoseconds
+    std::uint64_t maxWaitNs;     ///< Longest wait in nanoseconds
+    std::uint64_t shared;        ///< Pick-ups for a read
+};
+
+/**
+ * @struct PhilosopherCheckpoint
+ * @brief State of the dining philosophers between two think-eat cycles
+ */
+struct PhilosopherCheckpoint {
+    DiningStrategy strategy;                     ///< Fork protocol of the run
+    int iterations;                              ///< Cycles per philosopher (cycle-count runs)
+    double runDuration;                          ///< Run length in seconds (0 = cycle-count run)
+    double readRatio;                            ///< Probability that a meal is a read
+    double elapsed;                              ///< Wall-clock seconds run before the checkpoint
+    std::uint64_t seed;                          ///< Run seed
+    std::uint64_t graphFingerprint;              ///< graphFingerprint() of the table
+    std::vector<PhilosopherProgress> philosophers;  ///< Per-philosopher progress
+    std::vector<ForkProgress> forks;             ///< Per-fork state
+};
+
+/**
+ * @struct Checkpoint
+ * @brief A checkpoint file read back (kind selects the member that is filled)
+ */
+struct Checkpoint {
+    CheckpointKind kind;                  ///< Simulation the file belongs to
+    ProcessCheckpoint processes;          ///< Kind Processes
+    PhilosopherCheckpoint philosophers;   ///< Kind Philosophers
+};
+
+/**
+ * @brief Write a process checkpoint (to path + ".tmp", then renamed over path)
+ * @param path Destination
+ * @param checkpoint State to save
+ * @return true on success (false with a message on std::cerr)
+ */
+bool writeCheckpoint(const std::string& path, const ProcessCheckpoint& checkpoint);
+
+/**
+ * @brief Write a philosopher checkpoint (to path + ".tmp", then renamed over path)
+ * @param path Destination
+ * @param checkpoint State to save
+ * @return true on success (false with a message on std::cerr)
+ */
+bool writeCheckpoint(const std::string& path, const PhilosopherCheckpoint& checkpoint);
+
+/**
+ * @brief Read and decode a checkpoint file of either kind
+ * @param path Checkpoint file
+ * @param checkpoint Receives the state
+ * @return true on success (false with a message on std::cerr)
+ */
+bool readCheckpoint(const std::string& path, Checkpoint& checkpoint);
+
+/**
+ * @brief Fingerprint of a trace, checked when a process checkpoint is resumed
+ * @param processes Processes in file order
+ * @return 64-bit hash of every pid, burst, arrival and priority
+ */
+std::uint64_t traceFingerprint(const std::vector<Process>& processes);
+
+/**
+ * @brief Fingerprint of a philosopher table, checked when a philosopher checkpoint is resumed
+ * @param graph Table
+ * @return 64-bit hash of every agent's listed forks
+ */
+std::uint64_t graphFingerprint(const ResourceGraph& graph);
+
+/**
+ * @brief Flag asking the running simulation to save a checkpoint and stop
+ * @return The process-wide flag (set by SIGINT / SIGTERM after installCheckpointSignals())
+ */
+std::atomic<bool>& checkpointRequest();
+
+/**
+ * @brief Make the first SIGINT or SIGTERM set checkpointRequest() instead of ending the program
+ */
+void installCheckpointSignals();
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,402 @@
+/**
+ * @file Coroutine.cpp
+ * @brief Implementation of the C++20 coroutine runtime
+ *
+ * Worker loop (all bookkeeping under scheduleMutex, resumption outside it):
+ * 1. Move every timer whose deadline has passed to the ready ring
+ * 2. Resume the oldest ready coroutine, if any
+ * 3. Otherwise wait on wake until the earliest deadline (or indefinitely
+ *    when no coroutine is sleeping)
+ * Workers exit once every spawned coroutine has returned.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "Coroutine.h"
+#include "CpuTopology.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <new>
+#include <utility>
+
+namespace {
+
+std::atomic<std::uint64_t> allocatedFrameBytes(0);  ///< Bytes of every coroutine frame allocated
+std::atomic<std::uint64_t> allocatedFrames(0);      ///< Number of coroutine frames allocated
+
+thread_local unsigned int workerIndex = 0;  ///< Worker index of the calling thread
+
+const std::size_t INITIAL_READY_CAPACITY = 64;  ///< Ready ring slots allocated up front (power of two)
+
+/**
+ * @brief Timer heap order: earliest deadline on top, FIFO among equal deadlines
+ */
+struct LaterTimer {
+    template <typename Timer>
+    bool operator()(const Timer& a, const Timer& b) const {
+        return (a.when != b.when) ? a.when > b.when : a.sequence > b.sequence;
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Allocate a coroutine frame and count its size
+ */
+void* CoTask::promise_type::operator new(std::size_t size) {
+    allocatedFrameBytes.fetch_add(size, std::memory_order_relaxed);
+    allocatedFrames.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(size);
+}
+
+/**
+ * @brief Free a coroutine frame
+ */
+void CoTask::promise_type::operator delete(void* frame, std::size_t size) {
+    ::operator delete(frame, size);
+}
+
+/**
+ * @brief Final suspend: free the frame, then report the return
+ *
+ * The scheduler pointer is read before the frame is destroyed; nothing
+ * touches the frame afterwards.
+ */
+void CoTask::promise_type::FinalAwaiter::await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+    CoScheduler* scheduler = handle.promise().scheduler;
+    handle.destroy();
+    scheduler->taskFinished();
+}
+
+std::uint64_t CoTask::frameBytes() {
+    return allocatedFrameBytes.load(std::memory_order_relaxed);
+}
+
+std::uint64_t CoTask::frameCount() {
+    return allocatedFrames.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Put the awaiting coroutine on the timer heap (or the ready ring)
+ *
+ * CRITICAL SECTION: Pushes under scheduleMutex. A timer earlier than every
+ * other one wakes a sleeping worker so it can shorten its wait.
+ *
+ * Once the timer is pushed, another worker may pop it, resume the coroutine
+ * and destroy the frame holding this awaiter, so after the unlock only the
+ * copied scheduler pointer is used.
+ */
+void CoScheduler::TimerAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    CoScheduler* target = scheduler;
+    if (yieldOnly) {
+        target->schedule(handle);
+        return;
+    }
+    bool earliest;
+    unsigned int waiting;
+    {
+        std::lock_guard<std::mutex> lock(target->scheduleMutex);
+        Timer timer = { when, target->timerSequence++, handle };
+        earliest = target->timers.empty() || when < target->timers.front().when;
+        target->timers.push_back(timer);
+        std::push_heap(target->timers.begin(), target->timers.end(), LaterTimer());
+        if (target->timers.size() > target->maxTimers) {
+            target->maxTimers = target->timers.size();
+        }
+        waiting = target->sleepers;
+    }
+    if (earliest && waiting > 0) {
+        target->wake.notify_one();
+    }
+}
+
+/**
+ * @brief Constructor - prepares the scheduler (threads start in run())
+ * @param numThreads Worker threads (0 selects ThreadPool::defaultThreadCount())
+ * @param cpus CPU of worker i at index i % size (empty leaves workers unpinned)
+ */
+CoScheduler::CoScheduler(unsigned int numThreads, const std::vector<int>& cpus)
+    : ready(INITIAL_READY_CAPACITY), head(0), queued(0), timerSequence(0), maxTimers(0), busyNs(0), live(0),
+      sleepers(0),
+      threadCount((numThreads == 0) ? ThreadPool::defaultThreadCount() : numThreads), workerCpus(cpus) {}
+
+/**
+ * @brief Destructor - destroys coroutines left in the ready ring or timer heap
+ *
+ * After a completed run() both are empty; this only matters if run() was
+ * never called.
+ */
+CoScheduler::~CoScheduler() {
+    for (std::size_t i = 0; i < queued; i++) {
+        ready[(head + i) & (ready.size() - 1)].destroy();
+    }
+    for (Timer& timer : timers) {
+        timer.handle.destroy();
+    }
+}
+
+/**
+ * @brief Hand a coroutine to the scheduler and make it ready
+ * @param task Coroutine created by calling a CoTask function
+ */
+void CoScheduler::spawn(CoTask task) {
+    std::coroutine_handle<CoTask::promise_type> handle = task.handle;
+    task.handle = nullptr;
+    handle.promise().scheduler = this;
+    {
+        std::lock_guard<std::mutex> lock(scheduleMutex);
+        live++;
+        pushReady(handle);
+    }
+    wake.notify_one();
+}
+
+/**
+ * @brief Run all spawned coroutines to completion on the worker threads
+ */
+void CoScheduler::run() {
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; i++) {
+        int cpu = workerCpus.empty() ? -1 : workerCpus[i % workerCpus.size()];
+        workers.push_back(std::thread([this, i, cpu] {
+            if (cpu >= 0) {
+                pinCurrentThread(cpu);
+            }
+            workerLoop(i);
+        }));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Make a suspended coroutine ready to resume
+ *
+ * CRITICAL SECTION: Appends to the ready ring under scheduleMutex.
+ *
+ * @param handle Coroutine to resume on some worker
+ */
+void CoScheduler::schedule(std::coroutine_handle<> handle) {
+    unsigned int waiting;
+    {
+        std::lock_guard<std::mutex> lock(scheduleMutex);
+        pushReady(handle);
+        waiting = sleepers;
+    }
+    if (waiting > 0) {
+        wake.notify_one();
+    }
+}
+
+/**
+ * @brief Suspend the calling coroutine until a deadline
+ * @param when Deadline
+ * @return Awaiter to co_await
+ */
+CoScheduler::TimerAwaiter CoScheduler::sleepUntil(Clock::time_point when) {
+    return TimerAwaiter{ this, when, when <= Clock::now() };
+}
+
+/**
+ * @brief Suspend the calling coroutine for a duration (<= 0 just yields)
+ * @param duration Time to sleep
+ * @return Awaiter to co_await
+ */
+CoScheduler::TimerAwaiter CoScheduler::sleepFor(std::chrono::nanoseconds duration) {
+    if (duration.count() <= 0) {
+        return TimerAwaiter{ this, Clock::time_point(), true };
+    }
+    return TimerAwaiter{ this, Clock::now() + std::chrono::duration_cast<Clock::duration>(duration), false };
+}
+
+/**
+ * @brief Get the number of worker threads
+ * @return Worker count
+ */
+unsigned int CoScheduler::size() const {
+    return threadCount;
+}
+
+/**
+ * @brief Get the index of the worker running the calling coroutine
+ * @return 0 to size() - 1 (0 outside a worker)
+ */
+unsigned int CoScheduler::currentWorker() {
+    return workerIndex;
+}
+
+/**
+ * @brief Get the deepest the timer heap has been
+ * @return Most coroutines sleeping at once
+ */
+std::size_t CoScheduler::getMaxTimers() const {
+    std::lock_guard<std::mutex> lock(scheduleMutex);
+    return maxTimers;
+}
+
+/**
+ * @brief Get the time workers spent running coroutines
+ * @return Busy time in seconds, summed over all workers
+ */
+double CoScheduler::getBusySeconds() const {
+    std::lock_guard<std::mutex> lock(scheduleMutex);
+    return busyNs / 1e9;
+}
+
+/**
+ * @brief Append a coroutine to the ready ring, doubling it when full
+ *
+ * Caller must hold scheduleMutex.
+ */
+void CoScheduler::pushReady(std::coroutine_handle<> handle) {
+    if (queued == ready.size()) {
+        std::vector<std::coroutine_handle<>> grown(ready.size() * 2);
+        for (std::size_t i = 0; i < queued; i++) {
+            grown[i] = ready[(head + i) & (ready.size() - 1)];
+        }
+        ready.swap(grown);
+        head = 0;
+    }
+    ready[(head + queued) & (ready.size() - 1)] = handle;
+    queued++;
+}
+
+/**
+ * @brief Record that a coroutine has returned (wakes everyone after the last)
+ */
+void CoScheduler::taskFinished() {
+    bool last;
+    {
+        std::lock_guard<std::mutex> lock(scheduleMutex);
+        live--;
+        last = (live == 0);
+    }
+    if (last) {
+        wake.notify_all();
+    }
+}
+
+/**
+ * @brief Worker loop: resume ready coroutines, fire due timers, sleep until the next one
+ *
+ * CRITICAL SECTION: The ring and heap are only touched under scheduleMutex;
+ * the lock is released while a coroutine runs.
+ *
+ * @param worker Index of this worker
+ */
+void CoScheduler::workerLoop(unsigned int worker) {
+    workerIndex = worker;
+    std::unique_lock<std::mutex> lock(scheduleMutex);
+    while (live > 0) {
+        // Due timers become ready in deadline order
+        if (!timers.empty()) {
+            Clock::time_point now = Clock::now();
+            while (!timers.empty() && timers.front().when <= now) {
+                std::pop_heap(timers.begin(), timers.end(), LaterTimer());
+                pushReady(timers.back().handle);
+                timers.pop_back();
+            }
+        }
+
+        if (queued > 0) {
+            std::coroutine_handle<> handle = ready[head];
+            head = (head + 1) & (ready.size() - 1);
+            queued--;
+            if (queued > 0 && sleepers > 0) {
+                // More work than this worker can take: pass it on
+                wake.notify_one();
+            }
+            lock.unlock();
+            Clock::time_point resumed = Clock::now();
+            handle.resume();
+            Clock::time_point suspended = Clock::now();
+            lock.lock();
+            busyNs += static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(suspended - resumed).count());
+            continue;
+        }
+
+        sleepers++;
+        if (timers.empty()) {
+            wake.wait(lock);
+        } else {
+            wake.wait_until(lock, timers.front().when);
+        }
+        sleepers--;
+    }
+}
+
+/**
+ * @brief Take the mutex without suspending if it is free
+ * @return true if acquired (the coroutine does not suspend)
+ */
+bool AsyncMutex::LockAwaiter::await_ready() noexcept {
+    contended = false;
+    return mutex->try_lock();
+}
+
+/**
+ * @brief Queue the coroutine on a held mutex (or take a mutex freed meanwhile)
+ *
+ * Once the awaiter is queued, unlock() on another worker may resume the
+ * coroutine at any moment, so nothing here touches the awaiter afterwards.
+ *
+ * @param coroutine Coroutine acquiring the mutex
+ * @return false if the mutex was acquired after all (resume immediately)
+ */
+bool AsyncMutex::LockAwaiter::await_suspend(std::coroutine_handle<> coroutine) {
+    AsyncMutex* target = mutex;
+    std::lock_guard<SpinParkLock> lock(target->guard);
+    if (!target->locked) {
+        target->locked = true;
+        return false;
+    }
+    contended = true;
+    handle = coroutine;
+    next = nullptr;
+    if (target->tail != nullptr) {
+        target->tail->next = this;
+    } else {
+        target->head = this;
+    }
+    target->tail = this;
+    return true;
+}
+
+/**
+ * @brief Acquire the mutex only if it is free
+ * @return true if the mutex was acquired
+ */
+bool AsyncMutex::try_lock() {
+    std::lock_guard<SpinParkLock> lock(guard);
+    if (locked) {
+        return false;
+    }
+    locked = true;
+    return true;
+}
+
+/**
+ * @brief Release the mutex, handing it to the oldest waiter if there is one
+ *
+ * The mutex stays locked on hand-over; the waiter owns it when it resumes.
+ */
+void AsyncMutex::unlock() {
+    LockAwaiter* waiter;
+    {
+        std::lock_guard<SpinParkLock> lock(guard);
+        waiter = head;
+        if (waiter == nullptr) {
+            locked = false;
+            return;
+        }
+        head = waiter->next;
+        if (head == nullptr) {
+            tail = nullptr;
+        }
+    }
+    waiter->scheduler->schedule(waiter->handle);
+}
@@ -0,0 +1,333 @@
+/**
+ * @file Coroutine.h
+ * @brief Header file for the C++20 coroutine runtime (CoTask, CoScheduler, AsyncMutex)
+ *
+ * This file defines a small runtime on which simulated agents run as
+ * coroutines instead of blocking pool tasks:
+ *
+ * - CoTask: a fire-and-forget coroutine. Its frame is the agent's only
+ *   per-agent memory (no thread stack); frame allocations are counted, so a
+ *   run can report bytes per agent.
+ * - CoScheduler: a few OS threads resuming ready coroutines. sleepFor() and
+ *   sleepUntil() suspend on a timer heap rather than blocking a thread, so
+ *   millions of sleeping agents cost one heap entry each.
+ * - AsyncMutex: a lock whose lock() is co_awaited. A contended coroutine is
+ *   queued on the mutex, and unlock() hands ownership straight to the oldest
+ *   waiter (FIFO) and makes it ready.
+ *
+ * Timers are served by worker threads waiting on a condition variable, so
+ * wake-ups are late by the OS's timed-wait overshoot (typically tens of
+ * microseconds). A duration of zero or less just yields.
+ *
+ * Thread Safety:
+ * - The ready ring, timer heap and live-task count are protected by
+ *   scheduleMutex (CRITICAL SECTION); coroutines run outside the lock
+ * - Each AsyncMutex guards its owner flag and waiter queue with a
+ *   SpinParkLock held only for a few instructions
+ * - A coroutine runs on one worker at a time but may move between workers
+ *   at every co_await
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "SpinParkLock.h"
+
+class CoScheduler;
+
+/**
+ * @class CoTask
+ * @brief Fire-and-forget coroutine started and owned by a CoScheduler
+ *
+ * The coroutine is created suspended; CoScheduler::spawn() makes it ready.
+ * When it returns, its frame is freed and the scheduler's live count drops.
+ */
+class CoTask {
+public:
+    /**
+     * @struct promise_type
+     * @brief Coroutine promise: lazy start, self-destroying final suspend
+     */
+    struct promise_type {
+        CoScheduler* scheduler = nullptr;  ///< Scheduler that runs this task (set by spawn())
+
+        /**
+         * @brief Allocate the coroutine frame (counted in frameBytes())
+         */
+        static void* operator new(std::size_t size);
+
+        /**
+         * @brief Free the coroutine frame
+         */
+        static void operator delete(void* frame, std::size_t size);
+
+        CoTask get_return_object() { return CoTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return std::suspend_always(); }
+
+        /**
+         * @brief Awaiter of the final suspend: destroys the frame, then tells the scheduler
+         */
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+            void await_resume() noexcept {}
+        };
+
+        FinalAwaiter final_suspend() noexcept { return FinalAwaiter(); }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    /**
+     * @brief Move constructor - takes over the coroutine
+     */
+    CoTask(CoTask&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+
+    /**
+     * @brief Destructor - destroys a coroutine that was never spawned
+     */
+    ~CoTask() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    /**
+     * @brief Get the bytes of all coroutine frames allocated so far
+     * @return Total frame bytes since program start
+     */
+    static std::uint64_t frameBytes();
+
+    /**
+     * @brief Get the number of coroutine frames allocated so far
+     * @return Frame count since program start
+     */
+    static std::uint64_t frameCount();
+
+private:
+    friend class CoScheduler;
+
+    std::coroutine_handle<promise_type> handle;  ///< The suspended coroutine (null once spawned)
+
+    explicit CoTask(std::coroutine_handle<promise_type> coroutine) : handle(coroutine) {}
+
+    CoTask(const CoTask&) = delete;             ///< Non-copyable
+    CoTask& operator=(const CoTask&) = delete;  ///< Non-assignable
+};
+
+/**
+ * @class CoScheduler
+ * @brief Runs coroutines on a fixed set of worker threads, with timers
+ */
+class CoScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @struct TimerAwaiter
+     * @brief co_await sleepUntil(...): suspends the coroutine until a deadline
+     */
+    struct TimerAwaiter {
+        CoScheduler* scheduler;   ///< Scheduler holding the timer
+        Clock::time_point when;   ///< Deadline
+        bool yieldOnly;           ///< true if the deadline has passed (just go to the back of the ready ring)
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle);
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief Constructor - prepares the scheduler (threads start in run())
+     * @param numThreads Worker threads (0 selects ThreadPool::defaultThreadCount())
+     * @param cpus CPU of worker i at index i % size (empty leaves workers unpinned)
+     */
+    explicit CoScheduler(unsigned int numThreads = 0, const std::vector<int>& cpus = std::vector<int>());
+
+    /**
+     * @brief Destructor - destroys coroutines left in the ready ring or timer heap
+     */
+    ~CoScheduler();
+
+    /**
+     * @brief Hand a coroutine to the scheduler and make it ready
+     * @param task Coroutine created by calling a CoTask function
+     */
+    void spawn(CoTask task);
+
+    /**
+     * @brief Run all spawned coroutines to completion on the worker threads
+     *
+     * Blocks the caller until the last coroutine has returned.
+     */
+    void run();
+
+    /**
+     * @brief Make a suspended coroutine ready to resume
+     * @param handle Coroutine to resume on some worker
+     */
+    void schedule(std::coroutine_handle<> handle);
+
+    /**
+     * @brief Suspend the calling coroutine until a deadline
+     * @param when Deadline
+     * @return Awaiter to co_await
+     */
+    TimerAwaiter sleepUntil(Clock::time_point when);
+
+    /**
+     * @brief Suspend the calling coroutine for a duration (<= 0 just yields)
+     * @param duration Time to sleep
+     * @return Awaiter to co_await
+     */
+    TimerAwaiter sleepFor(std::chrono::nanoseconds duration);
+
+    /**
+     * @brief Get the number of worker threads
+     * @return Worker count
+     */
+    unsigned int size() const;
+
+    /**
+     * @brief Get the index of the worker running the calling coroutine
+     * @return 0 to size() - 1 (0 outside a worker)
+     */
+    static unsigned int currentWorker();
+
+    /**
+     * @brief Get the deepest the timer heap has been
+     * @return Most coroutines sleeping at once
+     */
+    std::size_t getMaxTimers() const;
+
+    /**
+     * @brief Get the time workers spent running coroutines
+     *
+     * Summed over all workers; a coroutine suspended on a timer or lock
+     * costs nothing, so this is the time the workers were actually busy.
+     *
+     * @return Busy time in seconds
+     */
+    double getBusySeconds() const;
+
+private:
+    /**
+     * @struct Timer
+     * @brief A sleeping coroutine in the timer heap
+     */
+    struct Timer {
+        Clock::time_point when;          ///< Deadline
+        std::uint64_t sequence;          ///< Insertion order (equal deadlines wake FIFO)
+        std::coroutine_handle<> handle;  ///< Coroutine to resume
+    };
+
+    std::vector<std::coroutine_handle<>> ready;  ///< Ring of coroutines ready to run (CRITICAL RESOURCE)
+    std::size_t head;                            ///< Ring index of the oldest ready coroutine
+    std::size_t queued;                          ///< Ready coroutines in the ring
+    std::vector<Timer> timers;                   ///< Min-heap of sleeping coroutines (CRITICAL RESOURCE)
+    std::uint64_t timerSequence;                 ///< Next Timer::sequence
+    std::size_t maxTimers;                       ///< Deepest the timer heap has been
+    std::uint64_t busyNs;                        ///< Nanoseconds workers spent inside resume()
+    std::size_t live;                            ///< Spawned coroutines that have not returned
+    unsigned int sleepers;                       ///< Workers waiting on wake
+    mutable std::mutex scheduleMutex;            ///< Protects every member above
+    std::condition_variable wake;                ///< Signalled on new work, an earlier timer or the last return
+    unsigned int threadCount;                    ///< Worker threads started by run()
+    std::vector<int> workerCpus;                 ///< CPU plan of the workers
+
+    friend struct CoTask::promise_type::FinalAwaiter;
+
+    CoScheduler(const CoScheduler&) = delete;             ///< Non-copyable
+    CoScheduler& operator=(const CoScheduler&) = delete;  ///< Non-assignable
+
+    /**
+     * @brief Append a coroutine to the ready ring, doubling it when full
+     *
+     * Caller must hold scheduleMutex.
+     */
+    void pushReady(std::coroutine_handle<> handle);
+
+    /**
+     * @brief Record that a coroutine has returned (wakes everyone after the last)
+     */
+    void taskFinished();
+
+    /**
+     * @brief Worker loop: resume ready coroutines, fire due timers, sleep until the next one
+     * @param worker Index of this worker
+     */
+    void workerLoop(unsigned int worker);
+};
+
+/**
+ * @class AsyncMutex
+ * @brief Mutex for coroutines: co_await lock() suspends instead of blocking
+ *
+ * Ownership is handed directly to the oldest waiter on unlock(), so waiters
+ * are served in FIFO order and cannot be overtaken by a new arrival.
+ */
+class AsyncMutex {
+public:
+    /**
+     * @struct LockAwaiter
+     * @brief co_await lock(): acquires the mutex, queueing if it is held
+     */
+    struct LockAwaiter {
+        AsyncMutex* mutex;                ///< Mutex being acquired
+        CoScheduler* scheduler;           ///< Scheduler that resumes the waiter
+        std::coroutine_handle<> handle;   ///< Waiting coroutine
+        LockAwaiter* next;                ///< Next waiter in the FIFO
+        bool contended;                   ///< true if the mutex was held when requested
+
+        bool await_ready() noexcept;
+        bool await_suspend(std::coroutine_handle<> coroutine);
+        bool await_resume() const noexcept { return contended; }
+    };
+
+    AsyncMutex() : locked(false), head(nullptr), tail(nullptr) {}
+
+    /**
+     * @brief Acquire the mutex
+     *
+     * co_await yields true if the coroutine had to wait.
+     *
+     * @param scheduler Scheduler that resumes the coroutine once it owns the mutex
+     * @return Awaiter to co_await
+     */
+    LockAwaiter lock(CoScheduler& scheduler) { return LockAwaiter{ this, &scheduler, nullptr, nullptr, false }; }
+
+    /**
+     * @brief Acquire the mutex only if it is free
+     * @return true if the mutex was acquired
+     */
+    bool try_lock();
+
+    /**
+     * @brief Release the mutex, handing it to the oldest waiter if there is one
+     */
+    void unlock();
+
+private:
+    SpinParkLock guard;  ///< Protects locked and the waiter queue
+    bool locked;         ///< Mutex is owned
+    LockAwaiter* head;   ///< Oldest waiter (null if none)
+    LockAwaiter* tail;   ///< Newest waiter
+
+    AsyncMutex(const AsyncMutex&) = delete;             ///< Non-copyable
+    AsyncMutex& operator=(const AsyncMutex&) = delete;  ///< Non-assignable
+};
+
+#endif // COROUTINE_H
@@ -0,0 +1,371 @@
+/**
+ * @file CoroutinePhilosophers.cpp
+ * @brief Implementation of the CoroutinePhilosophers class
+ *
+ * Each philosopher is one CoTask for the whole run:
+ *
+ *   think:  co_await sleepFor(think time)    (no thread held)
+ *   hungry: co_await lower fork, co_await higher fork
+ *   eat:    co_await sleepFor(eat time)      (holding both AsyncMutexes)
+ *   release both forks (the oldest waiter of each becomes ready)
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "CoroutinePhilosophers.h"
+#include "Logger.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <random>
+#include <utility>
+
+const int CoroutinePhilosophers::DEFAULT_PHILOSOPHERS;
+
+/**
+ * @brief Constructor with configurable iterations and table size
+ *
+ * Tables smaller than two philosophers are raised to 2.
+ *
+ * @param iterations Number of think-eat cycles per philosopher
+ * @param numPhilosophers Number of philosophers and forks
+ */
+CoroutinePhilosophers::CoroutinePhilosophers(int iterations, int numPhilosophers)
+    : numPhilosophers(numPhilosophers < 2 ? 2 : numPhilosophers),
+      iterations(iterations),
+      workerCount(0),
+      runDuration(0.0),
+      philosophers(static_cast<std::size_t>(this->numPhilosophers)),
+      forks(static_cast<std::size_t>(this->numPhilosophers)),
+      thinkTime(DurationDistribution::uniform(std::chrono::seconds(1), std::chrono::seconds(3))),
+      eatTime(DurationDistribution::constant(std::chrono::seconds(2))),
+      loggingEnabled(true),
+      seed(0),
+      seedFixed(false),
+      threadsUsed(0),
+      elapsed(0.0),
+      frameBytes(0),
+      maxSleeping(0),
+      scheduler(nullptr) {
+    pinning.policy = PinningPolicy::None;
+    startTime = std::chrono::steady_clock::now();
+    for (auto& record : philosophers) {
+        record.meals = 0;
+        record.contended = 0;
+        record.totalWaitNs = 0;
+        record.maxWaitNs = 0;
+    }
+}
+
+/**
+ * @brief Get the number of philosophers at the table
+ * @return Number of philosophers (and forks)
+ */
+int CoroutinePhilosophers::getNumPhilosophers() const {
+    return numPhilosophers;
+}
+
+/**
+ * @brief Set the number of OS threads that drive the coroutines
+ * @param count Worker count (0 = hardware concurrency)
+ */
+void CoroutinePhilosophers::setWorkerCount(unsigned int count) {
+    workerCount = count;
+}
+
+/**
+ * @brief Run for a fixed wall-clock time instead of a fixed number of cycles
+ * @param seconds Run length (0 = use the iteration count)
+ */
+void CoroutinePhilosophers::setRunDuration(double seconds) {
+    runDuration = (seconds > 0.0) ? seconds : 0.0;
+}
+
+/**
+ * @brief Set the think time distribution
+ * @param distribution Think time
+ */
+void CoroutinePhilosophers::setThinkDistribution(const DurationDistribution& distribution) {
+    thinkTime = distribution;
+}
+
+/**
+ * @brief Set the eat time distribution
+ * @param distribution Eat time
+ */
+void CoroutinePhilosophers::setEatDistribution(const DurationDistribution& distribution) {
+    eatTime = distribution;
+}
+
+/**
+ * @brief Fix the seed of the philosophers' generators
+ * @param newSeed Seed (philosopher i uses newSeed + i)
+ */
+void CoroutinePhilosophers::setSeed(std::uint64_t newSeed) {
+    seed = newSeed;
+    seedFixed = true;
+}
+
+/**
+ * @brief Get the seed of the last run (or the fixed seed before the first run)
+ * @return Seed
+ */
+std::uint64_t CoroutinePhilosophers::getSeed() const {
+    return seed;
+}
+
+/**
+ * @brief Turn the philosopher log messages on or off
+ * @param enabled false suppresses every message
+ */
+void CoroutinePhilosophers::setLoggingEnabled(bool enabled) {
+    loggingEnabled = enabled;
+}
+
+/**
+ * @brief Bind the worker threads to CPUs
+ * @param cpuPinning Placement policy
+ */
+void CoroutinePhilosophers::setPinning(const CpuPinning& cpuPinning) {
+    pinning = cpuPinning;
+}
+
+/**
+ * @brief Check whether a philosopher has another cycle to run
+ * @param record Philosopher's record
+ * @return true while cycles remain (or the run duration has not passed)
+ */
+bool CoroutinePhilosophers::hasNextCycle(const Philosopher& record) const {
+    if (runDuration > 0.0) {
+        return std::chrono::steady_clock::now() < deadline;
+    }
+    return record.meals < static_cast<std::uint64_t>(iterations);
+}
+
+/**
+ * @brief Check whether messages of a level are logged by this simulator
+ * @param level Level of the message
+ * @return true if the level is compiled in and enabled and logging is on
+ */
+bool CoroutinePhilosophers::logging(LogLevel level) const {
+    return SIM_LOG_ON(level) && loggingEnabled;
+}
+
+/**
+ * @brief Log a message built in a fixed buffer
+ * @param line The message to log
+ */
+void CoroutinePhilosophers::log(const LogLine& line) {
+    if (!loggingEnabled) {
+        return;
+    }
+    Logger::instance().log(startTime, line.data(), line.size());
+}
+
+/**
+ * @brief Coroutine of one philosopher: think, acquire forks, eat, release, repeat
+ *
+ * DEADLOCK PREVENTION: the lower-numbered fork is always awaited first, so
+ * no cycle of waiting philosophers can form.
+ *
+ * Thread Safety: record is only touched by this coroutine. The wait
+ * histogram belongs to the worker currently running the coroutine, and a
+ * worker runs one coroutine at a time.
+ *
+ * @param id Philosopher ID (0 to N-1)
+ * @return The philosopher's task
+ */
+CoTask CoroutinePhilosophers::philosopher(int id) {
+    Philosopher& record = philosophers[id];
+    int first = id;
+    int second = (id + 1) % numPhilosophers;
+    if (second < first) {
+        std::swap(first, second);
+    }
+
+    while (hasNextCycle(record)) {
+        if (logging(LogLevel::Events)) {
+            LogLine line;
+            line << "PHIL " << id << " | Thinking...";
+            log(line);
+        }
+        co_await scheduler->sleepFor(thinkTime.isZero() ? std::chrono::nanoseconds(0) : thinkTime.sample(record.rng));
+
+        // CRITICAL SECTION BEGIN - ordered acquisition of both forks
+        auto hungrySince = std::chrono::steady_clock::now();
+        bool waited = co_await forks[first].lock(*scheduler);
+        waited = (co_await forks[second].lock(*scheduler)) || waited;
+        std::uint64_t waitNs = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - hungrySince).count());
+        record.contended += waited ? 1 : 0;
+        record.totalWaitNs += waitNs;
+        record.maxWaitNs = std::max(record.maxWaitNs, waitNs);
+        waitLatency[CoScheduler::currentWorker()].record(waitNs);
+
+        if (logging(LogLevel::Events)) {
+            LogLine line;
+            line << "PHIL " << id << " | Eating...";
+            log(line);
+        }
+        co_await scheduler->sleepFor(eatTime.isZero() ? std::chrono::nanoseconds(0) : eatTime.sample(record.rng));
+
+        forks[second].unlock();
+        forks[first].unlock();
+        // CRITICAL SECTION END
+        record.meals++;
+    }
+
+    if (logging(LogLevel::Summary)) {
+        LogLine line;
+        if (runDuration > 0.0) {
+            line << "PHIL " << id << " | Completed " << static_cast<long long>(record.meals) << " meals";
+        } else {
+            line << "PHIL " << id << " | Completed all " << iterations << " iterations";
+        }
+        log(line);
+    }
+}
+
+/**
+ * @brief Run every philosopher as a coroutine and wait for all to finish
+ *
+ * 1. Reset the records and seed every philosopher's generator
+ * 2. Spawn one CoTask per philosopher (frames are allocated here and counted)
+ * 3. Run the CoScheduler on workerCount threads until every philosopher returns
+ */
+void CoroutinePhilosophers::simulate() {
+    for (auto& record : philosophers) {
+        record.meals = 0;
+        record.contended = 0;
+        record.totalWaitNs = 0;
+        record.maxWaitNs = 0;
+    }
+    if (!seedFixed) {
+        std::random_device entropy;
+        seed = (static_cast<std::uint64_t>(entropy()) << 32) ^ entropy();
+    }
+    for (int i = 0; i < numPhilosophers; i++) {
+        philosophers[i].rng.reseed(seed + static_cast<std::uint64_t>(i));
+    }
+
+    threadsUsed = (workerCount == 0) ? ThreadPool::defaultThreadCount() : workerCount;
+    workerCpus = planCpus(pinning, threadsUsed);
+    waitLatency.assign(threadsUsed, LatencyHistogram());
+
+    CoScheduler runner(threadsUsed, workerCpus);
+    scheduler = &runner;
+    std::uint64_t framesBefore = CoTask::frameBytes();
+    for (int i = 0; i < numPhilosophers; i++) {
+        runner.spawn(philosopher(i));
+    }
+    frameBytes = CoTask::frameBytes() - framesBefore;
+
+    auto runStart = std::chrono::steady_clock::now();
+    deadline = runStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(runDuration));
+    runner.run();
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+    maxSleeping = runner.getMaxTimers();
+    scheduler = nullptr;
+
+    // Make sure all philosopher output is on the console before returning
+    Logger::instance().flush();
+}
+
+/**
+ * @brief Get total meals per wall-clock second of the last run
+ * @return Meals per second (0 before the first run)
+ */
+double CoroutinePhilosophers::getMealsPerSecond() const {
+    if (elapsed <= 0.0) {
+        return 0.0;
+    }
+    std::uint64_t meals = 0;
+    for (const auto& record : philosophers) {
+        meals += record.meals;
+    }
+    return static_cast<double>(meals) / elapsed;
+}
+
+/**
+ * @brief Get the Jain fairness index of the per-philosopher meal counts
+ *
+ * (sum x)^2 / (n * sum x^2).
+ *
+ * @return Index in (0, 1], 1 for perfectly even meal counts
+ */
+double CoroutinePhilosophers::getFairnessIndex() const {
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    for (const auto& record : philosophers) {
+        double meals = static_cast<double>(record.meals);
+        sum += meals;
+        sumSquares += meals * meals;
+    }
+    if (sumSquares == 0.0) {
+        return 1.0;
+    }
+    return (sum * sum) / (static_cast<double>(numPhilosophers) * sumSquares);
+}
+
+/**
+ * @brief Get the wait-for-forks latency of the last run
+ * @return Histogram over all philosophers (nanoseconds)
+ */
+LatencyHistogram CoroutinePhilosophers::getWaitLatency() const {
+    LatencyHistogram merged;
+    for (const auto& histogram : waitLatency) {
+        merged.merge(histogram);
+    }
+    return merged;
+}
+
+/**
+ * @brief Get the coroutine frame size of one philosopher
+ * @return Frame bytes per philosopher in the last run
+ */
+double CoroutinePhilosophers::getFrameBytesPerPhilosopher() const {
+    return static_cast<double>(frameBytes) / numPhilosophers;
+}
+
+/**
+ * @brief Print meals, throughput, fairness, wait percentiles and memory per philosopher
+ * @param out Destination stream
+ */
+void CoroutinePhilosophers::printStatistics(std::ostream& out) const {
+    std::uint64_t meals = 0;
+    std::uint64_t contended = 0;
+    std::uint64_t fewest = philosophers.empty() ? 0 : philosophers[0].meals;
+    std::uint64_t most = 0;
+    for (const auto& record : philosophers) {
+        meals += record.meals;
+        contended += record.contended;
+        fewest = std::min(fewest, record.meals);
+        most = std::max(most, record.meals);
+    }
+    LatencyHistogram latency = getWaitLatency();
+
+    out << std::fixed << std::setprecision(3);
+    out << "  Coroutines: " << numPhilosophers << " philosophers on " << threadsUsed << " threads, pinning "
+        << describeCpuPinning(pinning);
+    if (!workerCpus.empty()) {
+        out << " (CPUs " << formatCpuList(workerCpus) << ")";
+    }
+    out << std::endl;
+    out << "  Strategy: Ordered (async fork locks)" << std::endl;
+    out << "  Meals: " << meals << " (" << fewest << " to " << most << " per philosopher), "
+        << contended << " contended fork waits" << std::endl;
+    out << "  Wait for forks: p50 " << latency.percentile(50.0) / 1e9 << "s, p99 "
+        << latency.percentile(99.0) / 1e9 << "s, max " << latency.max() / 1e9 << "s" << std::endl;
+    out << "  Think: " << thinkTime.describe() << ", eat: " << eatTime.describe() << std::endl;
+    out << "  Seed: " << seed << std::endl;
+    out << "  Memory per philosopher: " << std::setprecision(0) << getFrameBytesPerPhilosopher()
+        << " B coroutine frame + " << sizeof(Philosopher) << " B record + " << sizeof(AsyncMutex)
+        << " B fork; at most " << maxSleeping << " timers pending" << std::setprecision(3) << std::endl;
+    out << "  Throughput: " << getMealsPerSecond() << " meals/s over " << elapsed << "s" << std::endl;
+    out << "  Fairness (Jain index of meal counts): " << getFairnessIndex() << std::endl;
+    out.unsetf(std::ios::floatfield);
+    out << std::setprecision(6);
+}
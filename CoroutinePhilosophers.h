@@ -0,0 +1,218 @@
+/**
+ * @file CoroutinePhilosophers.h
+ * @brief Header file for the CoroutinePhilosophers class
+ *
+ * This file defines a coroutine execution mode of the dining philosophers
+ * for very large tables (millions of philosophers on a few OS threads):
+ *
+ * - Each philosopher is a CoTask; thinking and eating are co_awaited
+ *   CoScheduler timers, so a waiting philosopher holds no thread
+ * - Each fork is an AsyncMutex; a philosopher co_awaits the lower-numbered
+ *   fork, then the higher-numbered one (ordered resource acquisition, so the
+ *   table cannot deadlock)
+ * - Per-philosopher state is a few dozen bytes plus the coroutine frame;
+ *   wait latencies go to one LatencyHistogram per worker thread instead of
+ *   one per philosopher
+ *
+ * Only the ordered strategy is available: the other strategies of
+ * DiningPhilosophers block on condition variables or semaphores.
+ *
+ * Thread Safety:
+ * - A philosopher's record is only touched by its own coroutine, which runs
+ *   on one worker at a time
+ * - Fork hand-over is FIFO through AsyncMutex
+ * - Console output goes through the shared asynchronous Logger
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef COROUTINE_PHILOSOPHERS_H
+#define COROUTINE_PHILOSOPHERS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+#include "Coroutine.h"
+#include "CpuTopology.h"
+#include "DurationDistribution.h"
+#include "LatencyHistogram.h"
+#include "Random.h"
+
+class LogLine;
+enum class LogLevel;
+
+/**
+ * @class CoroutinePhilosophers
+ * @brief Dining philosophers as coroutines with async fork locks
+ */
+class CoroutinePhilosophers {
+public:
+    static const int DEFAULT_PHILOSOPHERS = 5;  ///< Table size used when none is given
+
+private:
+    /**
+     * @struct Philosopher
+     * @brief Per-philosopher results and generator (kept small for huge tables)
+     */
+    struct Philosopher {
+        FastRandom rng;             ///< Think/eat generator (seeded from the run seed + ID)
+        std::uint64_t meals;        ///< Think-eat cycles finished
+        std::uint64_t contended;    ///< Fork requests that had to wait
+        std::uint64_t totalWaitNs;  ///< Summed wait for forks
+        std::uint64_t maxWaitNs;    ///< Longest wait for forks
+    };
+
+    int numPhilosophers;                        ///< Number of philosophers (and forks)
+    int iterations;                             ///< Think-eat cycles per philosopher
+    unsigned int workerCount;                   ///< OS threads (0 = hardware concurrency)
+    double runDuration;                         ///< Duration-based run length in seconds (0 = use iterations)
+    std::vector<Philosopher> philosophers;      ///< Per-philosopher records
+    std::vector<AsyncMutex> forks;              ///< The forks (CRITICAL RESOURCES)
+    std::vector<LatencyHistogram> waitLatency;  ///< "Hungry" to "eating" latency, one histogram per worker
+    DurationDistribution thinkTime;             ///< Think time (default uniform 1-3 s)
+    DurationDistribution eatTime;               ///< Eat time (default constant 2 s)
+    bool loggingEnabled;                        ///< false suppresses all philosopher log messages
+    std::uint64_t seed;                         ///< Seed of the last (or next, if fixed) run
+    bool seedFixed;                             ///< true once setSeed() was called
+    CpuPinning pinning;                         ///< CPU placement of the worker threads
+    std::vector<int> workerCpus;                ///< CPU of each worker in the last run (empty = unpinned)
+    unsigned int threadsUsed;                   ///< Worker threads of the last run
+    double elapsed;                             ///< Wall-clock length of the last simulate() call
+    std::uint64_t frameBytes;                   ///< Coroutine frame bytes allocated by the last run
+    std::size_t maxSleeping;                    ///< Most philosophers thinking or eating at once
+    CoScheduler* scheduler;                     ///< Scheduler of the current simulate() call
+    std::chrono::steady_clock::time_point startTime;  ///< Start time for timestamp calculation
+    std::chrono::steady_clock::time_point deadline;   ///< End of a duration-based run
+
+    /**
+     * @brief Coroutine of one philosopher: think, acquire forks, eat, release, repeat
+     * @param id Philosopher ID (0 to N-1)
+     * @return The philosopher's task
+     */
+    CoTask philosopher(int id);
+
+    /**
+     * @brief Check whether a philosopher has another cycle to run
+     * @param record Philosopher's record
+     * @return true while cycles remain (or the run duration has not passed)
+     */
+    bool hasNextCycle(const Philosopher& record) const;
+
+    /**
+     * @brief Check whether messages of a level are logged by this simulator
+     * @param level Level of the message
+     * @return true if the level is compiled in and enabled and logging is on
+     */
+    bool logging(LogLevel level) const;
+
+    /**
+     * @brief Log a message built in a fixed buffer
+     * @param line The message to log
+     */
+    void log(const LogLine& line);
+
+public:
+    /**
+     * @brief Constructor with configurable iterations and table size
+     * @param iterations Number of think-eat cycles per philosopher (default: 3)
+     * @param numPhilosophers Number of philosophers and forks (default: 5, minimum: 2)
+     */
+    CoroutinePhilosophers(int iterations = 3, int numPhilosophers = DEFAULT_PHILOSOPHERS);
+
+    /**
+     * @brief Get the number of philosophers at the table
+     * @return Number of philosophers (and forks)
+     */
+    int getNumPhilosophers() const;
+
+    /**
+     * @brief Set the number of OS threads that drive the coroutines
+     * @param count Worker count (0 = hardware concurrency)
+     */
+    void setWorkerCount(unsigned int count);
+
+    /**
+     * @brief Run for a fixed wall-clock time instead of a fixed number of cycles
+     * @param seconds Run length (0 = use the iteration count)
+     */
+    void setRunDuration(double seconds);
+
+    /**
+     * @brief Set the think time distribution
+     * @param distribution Think time
+     */
+    void setThinkDistribution(const DurationDistribution& distribution);
+
+    /**
+     * @brief Set the eat time distribution
+     * @param distribution Eat time
+     */
+    void setEatDistribution(const DurationDistribution& distribution);
+
+    /**
+     * @brief Fix the seed of the philosophers' generators
+     * @param newSeed Seed (philosopher i uses newSeed + i)
+     */
+    void setSeed(std::uint64_t newSeed);
+
+    /**
+     * @brief Get the seed of the last run (or the fixed seed before the first run)
+     * @return Seed
+     */
+    std::uint64_t getSeed() const;
+
+    /**
+     * @brief Turn the philosopher log messages on or off
+     * @param enabled false suppresses every message
+     */
+    void setLoggingEnabled(bool enabled);
+
+    /**
+     * @brief Bind the worker threads to CPUs
+     * @param cpuPinning Placement policy (PinningPolicy::None by default)
+     */
+    void setPinning(const CpuPinning& cpuPinning);
+
+    /**
+     * @brief Run every philosopher as a coroutine and wait for all to finish
+     */
+    void simulate();
+
+    /**
+     * @brief Get total meals per wall-clock second of the last run
+     * @return Meals per second (0 before the first run)
+     */
+    double getMealsPerSecond() const;
+
+    /**
+     * @brief Get the Jain fairness index of the per-philosopher meal counts
+     * @return Index in (0, 1], 1 for perfectly even meal counts
+     */
+    double getFairnessIndex() const;
+
+    /**
+     * @brief Get the wait-for-forks latency of the last run
+     * @return Histogram over all philosophers (nanoseconds)
+     */
+    LatencyHistogram getWaitLatency() const;
+
+    /**
+     * @brief Get the coroutine frame size of one philosopher
+     * @return Frame bytes per philosopher in the last run
+     */
+    double getFrameBytesPerPhilosopher() const;
+
+    /**
+     * @brief Print meals, throughput, fairness, wait percentiles and memory per philosopher
+     *
+     * Totals only: a per-philosopher table is not useful for millions of rows.
+     *
+     * @param out Destination stream
+     */
+    void printStatistics(std::ostream& out) const;
+};
+
+#endif // COROUTINE_PHILOSOPHERS_H
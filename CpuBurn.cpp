@@ -0,0 +1,133 @@
+/**
+ * @file CpuBurn.cpp
+ * @brief Implementation of the calibrated CPU-burn kernel and thread CPU clock
+ *
+ * The kernel is a xorshift-multiply chain: every iteration depends on the
+ * previous one, so the compiler can neither vectorize nor drop it, and it
+ * touches no memory, so its speed does not depend on cache state. Its result
+ * is published through an atomic so the loop is never dead code.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "CpuBurn.h"
+#include <atomic>
+#include <chrono>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CPU_BURN_USE_THREAD_CLOCK 1
+#include <time.h>
+#endif
+
+namespace {
+
+const std::uint64_t CHUNK_ITERATIONS = 1 << 16;  ///< Iterations between clock reads while calibrating
+
+std::atomic<std::uint64_t> burnSink(0);  ///< Receives every run's final state
+
+/**
+ * @brief Run the mixing chain
+ * @param state Starting state (non-zero)
+ * @param iterations Number of rounds
+ * @return Final state
+ */
+std::uint64_t burnChunk(std::uint64_t state, std::uint64_t iterations) {
+    for (std::uint64_t i = 0; i < iterations; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        state *= 0x9E3779B97F4A7C15ULL;
+    }
+    return state;
+}
+
+/**
+ * @brief Seconds on the clock used for calibration
+ */
+double calibrationClock() {
+    if (threadCpuClockAvailable()) {
+        return threadCpuSeconds();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+const int BurnKernel::CALIBRATION_MILLISECONDS;
+
+double threadCpuSeconds() {
+#ifdef CPU_BURN_USE_THREAD_CLOCK
+    timespec now;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) == 0) {
+        return static_cast<double>(now.tv_sec) + now.tv_nsec / 1e9;
+    }
+#endif
+    return 0.0;
+}
+
+bool threadCpuClockAvailable() {
+#ifdef CPU_BURN_USE_THREAD_CLOCK
+    timespec now;
+    return clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) == 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Constructor - measures the kernel for CALIBRATION_MILLISECONDS
+ *
+ * Measured on the calling thread's CPU clock, so time the thread spends
+ * preempted during calibration does not slow the kernel's nominal speed.
+ */
+BurnKernel::BurnKernel() : iterationsPerSecond(0.0) {
+    // Warm-up chunk (frequency ramp, page faults of the first call)
+    std::uint64_t state = burnChunk(0x2545F4914F6CDD1DULL, CHUNK_ITERATIONS);
+
+    std::uint64_t iterations = 0;
+    double begin = calibrationClock();
+    double spent = 0.0;
+    while (spent < CALIBRATION_MILLISECONDS / 1e3) {
+        state = burnChunk(state, CHUNK_ITERATIONS);
+        iterations += CHUNK_ITERATIONS;
+        spent = calibrationClock() - begin;
+    }
+    burnSink.store(state, std::memory_order_relaxed);
+    iterationsPerSecond = iterations / spent;
+}
+
+/**
+ * @brief Get the calibrated kernel (calibrated on first use, thread-safe)
+ * @return Process-wide kernel
+ */
+const BurnKernel& BurnKernel::instance() {
+    static const BurnKernel kernel;
+    return kernel;
+}
+
+/**
+ * @brief Keep the calling thread's core busy with seconds' worth of work
+ *
+ * The iteration count is fixed up front: a thread that is descheduled
+ * finishes later but does the same work, which is what makes
+ * oversubscription visible in the run spans.
+ *
+ * @param seconds Uncontended CPU seconds of work
+ */
+void BurnKernel::run(double seconds) const {
+    if (seconds <= 0.0) {
+        return;
+    }
+    std::uint64_t iterations = static_cast<std::uint64_t>(seconds * iterationsPerSecond);
+    std::uint64_t state = burnChunk(0x2545F4914F6CDD1DULL ^ iterations, iterations);
+    burnSink.store(state, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the calibrated speed
+ * @return Kernel iterations per CPU second
+ */
+double BurnKernel::getIterationsPerSecond() const {
+    return iterationsPerSecond;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file CpuBurn.h
+ * @brief Header file for the calibrated CPU-burn kernel and thread CPU clock
+ *
+ * This file defines what ProcessSimulator needs to run a burst on a real
+ * core instead of sleeping through it:
+ *
+ * - BurnKernel: a dependent integer mixing loop whose speed is calibrated
+ *   once per process, so run(seconds) performs the amount of work that takes
+ *   that long on an uncontended core. Under oversubscription the work stays
+ *   the same and the wall time stretches.
+ * - threadCpuSeconds(): CPU time consumed by the calling thread
+ *   (CLOCK_THREAD_CPUTIME_ID), for comparing actual CPU time with wall time
+ *
+ * On platforms without a per-thread CPU clock, threadCpuSeconds() returns 0
+ * and the kernel is calibrated against the wall clock.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef CPU_BURN_H
+#define CPU_BURN_H
+
+#include <cstdint>
+
+/**
+ * @brief Get the CPU time consumed by the calling thread
+ * @return Seconds of CPU time (0 where no per-thread CPU clock exists)
+ */
+double threadCpuSeconds();
+
+/**
+ * @brief Check whether threadCpuSeconds() measures anything on this platform
+ * @return true if a per-thread CPU clock is available
+ */
+bool threadCpuClockAvailable();
+
+/**
+ * @class BurnKernel
+ * @brief Busy-work loop calibrated to iterations per CPU second
+ *
+ * Thread Safety: instance() calibrates exactly once (first call); run() may
+ * be called from any number of threads concurrently.
+ */
+class BurnKernel {
+private:
+    double iterationsPerSecond;  ///< Calibrated kernel speed on one uncontended core
+
+    BurnKernel();
+
+public:
+    static const int CALIBRATION_MILLISECONDS = 20;  ///< CPU time spent measuring the kernel
+
+    /**
+     * @brief Get the calibrated kernel (calibrated on first use)
+     *
+     * Call it before starting competing threads so the calibration sees an
+     * idle core.
+     *
+     * @return Process-wide kernel
+     */
+    static const BurnKernel& instance();
+
+    /**
+     * @brief Keep the calling thread's core busy with seconds' worth of work
+     * @param seconds Uncontended CPU seconds of work (values <= 0 return at once)
+     */
+    void run(double seconds) const;
+
+    /**
+     * @brief Get the calibrated speed
+     * @return Kernel iterations per CPU second
+     */
+    double getIterationsPerSecond() const;
+};
+
+#endif // CPU_BURN_H
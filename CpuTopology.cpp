@@ -0,0 +1,428 @@
+/**
+ * @file CpuTopology.cpp
+ * @brief Implementation of CPU topology detection, thread pinning and NUMA placement
+ *
+ * Linux: the allowed CPUs come from sched_getaffinity(). Core and package ids
+ * come from /sys/devices/system/cpu/cpuN/topology. The node is the nodeK
+ * entry in /sys/devices/system/cpu/cpuN. Threads are pinned with
+ * pthread_setaffinity_np(). Pages are placed with the mbind system call
+ * (MPOL_PREFERRED, MPOL_MF_MOVE), so libnuma is not needed.
+ *
+ * Other platforms: std::thread::hardware_concurrency() CPUs on one node, one
+ * core each; pinning and placement report failure.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "CpuTopology.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+#if defined(__linux__)
+#define CPU_TOPOLOGY_USE_LINUX 1
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef CPU_TOPOLOGY_USE_LINUX
+const int MPOL_PREFERRED_MODE = 1;  ///< mbind mode: prefer the given node (numaif.h MPOL_PREFERRED)
+const unsigned MPOL_MOVE_FLAG = 2;  ///< mbind flag: migrate pages already placed (numaif.h MPOL_MF_MOVE)
+
+/**
+ * @brief Read one integer from a sysfs file
+ * @return The value, or fallback if the file is missing or malformed
+ */
+int readSysInt(const std::string& path, int fallback) {
+    std::ifstream file(path);
+    int value;
+    if (file >> value) {
+        return value;
+    }
+    return fallback;
+}
+
+/**
+ * @brief Find the NUMA node of a CPU from its /sys directory's nodeK entry
+ * @return Node number, or 0 if none is listed
+ */
+int readCpuNode(int cpu) {
+    std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    DIR* dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        return 0;
+    }
+    int node = 0;
+    while (dirent* entry = readdir(dir)) {
+        const char* name = entry->d_name;
+        if (name[0] == 'n' && name[1] == 'o' && name[2] == 'd' && name[3] == 'e' &&
+            name[4] >= '0' && name[4] <= '9') {
+            node = std::atoi(name + 4);
+            break;
+        }
+    }
+    closedir(dir);
+    return node;
+}
+#endif
+
+/**
+ * @brief Count the distinct values of a key over all CPUs
+ */
+template <typename Key>
+int countDistinct(const std::vector<CpuInfo>& cpus, Key key) {
+    std::set<decltype(key(cpus[0]))> seen;
+    for (const CpuInfo& info : cpus) {
+        seen.insert(key(info));
+    }
+    return static_cast<int>(seen.size());
+}
+
+/**
+ * @brief Scatter order within one node: first hyperthread of every core, then the second ...
+ */
+std::vector<CpuInfo> spreadOverCores(std::vector<CpuInfo> cpus) {
+    std::sort(cpus.begin(), cpus.end(), [](const CpuInfo& a, const CpuInfo& b) {
+        return std::make_tuple(a.package, a.core, a.cpu) < std::make_tuple(b.package, b.core, b.cpu);
+    });
+    // Rank of each CPU among its core's hyperthreads
+    std::vector<std::pair<int, std::size_t> > ranked;
+    for (std::size_t i = 0; i < cpus.size(); i++) {
+        int rank = 0;
+        for (std::size_t j = i; j > 0 && cpus[j - 1].package == cpus[i].package && cpus[j - 1].core == cpus[i].core; j--) {
+            rank++;
+        }
+        ranked.push_back(std::make_pair(rank, i));
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [](const std::pair<int, std::size_t>& a,
+                                                      const std::pair<int, std::size_t>& b) {
+        return a.first < b.first;
+    });
+    std::vector<CpuInfo> spread;
+    for (const auto& entry : ranked) {
+        spread.push_back(cpus[entry.second]);
+    }
+    return spread;
+}
+
+} // namespace
+
+/**
+ * @brief Constructor - detects the allowed CPUs and their locations
+ */
+CpuTopology::CpuTopology() : nodes(1), packages(1), cores(1) {
+#ifdef CPU_TOPOLOGY_USE_LINUX
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (!CPU_ISSET(cpu, &allowed)) {
+                continue;
+            }
+            std::string topology = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+            CpuInfo info = { cpu, readSysInt(topology + "core_id", cpu),
+                             readSysInt(topology + "physical_package_id", 0), readCpuNode(cpu) };
+            cpus.push_back(info);
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        unsigned int count = std::thread::hardware_concurrency();
+        for (unsigned int cpu = 0; cpu < (count == 0 ? 1 : count); cpu++) {
+            CpuInfo info = { static_cast<int>(cpu), static_cast<int>(cpu), 0, 0 };
+            cpus.push_back(info);
+        }
+    }
+    nodes = countDistinct(cpus, [](const CpuInfo& info) { return info.node; });
+    packages = countDistinct(cpus, [](const CpuInfo& info) { return info.package; });
+    cores = countDistinct(cpus, [](const CpuInfo& info) { return std::make_pair(info.package, info.core); });
+}
+
+/**
+ * @brief Get the topology (detected on first use, thread-safe)
+ * @return Process-wide topology
+ */
+const CpuTopology& CpuTopology::instance() {
+    static const CpuTopology topology;
+    return topology;
+}
+
+/**
+ * @brief Get the CPUs this process may run on
+ * @return One record per allowed logical CPU
+ */
+const std::vector<CpuInfo>& CpuTopology::getCpus() const {
+    return cpus;
+}
+
+/**
+ * @brief Get the NUMA node of a CPU
+ * @param cpu OS CPU number
+ * @return Node, or 0 if the CPU is unknown
+ */
+int CpuTopology::nodeOf(int cpu) const {
+    for (const CpuInfo& info : cpus) {
+        if (info.cpu == cpu) {
+            return info.node;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Get the number of NUMA nodes in use
+ * @return Node count
+ */
+int CpuTopology::nodeCount() const {
+    return nodes;
+}
+
+/**
+ * @brief Describe the topology
+ * @return e.g. "2 nodes, 2 packages, 16 cores, 32 CPUs"
+ */
+std::string CpuTopology::describe() const {
+    std::ostringstream text;
+    text << nodes << (nodes == 1 ? " node, " : " nodes, ")
+         << packages << (packages == 1 ? " package, " : " packages, ")
+         << cores << (cores == 1 ? " core, " : " cores, ")
+         << cpus.size() << (cpus.size() == 1 ? " CPU" : " CPUs");
+    return text.str();
+}
+
+bool parseCpuPinning(const std::string& spec, CpuPinning& pinning) {
+    CpuPinning parsed = { PinningPolicy::List, std::vector<int>() };
+    if (spec == "none") {
+        parsed.policy = PinningPolicy::None;
+    } else if (spec == "compact") {
+        parsed.policy = PinningPolicy::Compact;
+    } else if (spec == "scatter") {
+        parsed.policy = PinningPolicy::Scatter;
+    } else {
+        // Comma-separated CPUs and inclusive ranges, e.g. "0,2,4-7". Each
+        // bound is checked against the highest allowed CPU before a range is
+        // expanded, so the list never grows beyond a few entries per CPU.
+        int highest = 0;
+        for (const CpuInfo& info : CpuTopology::instance().getCpus()) {
+            highest = std::max(highest, info.cpu);
+        }
+        std::size_t pos = 0;
+        while (pos <= spec.size()) {
+            std::size_t comma = spec.find(',', pos);
+            std::string item = spec.substr(pos, (comma == std::string::npos) ? std::string::npos : comma - pos);
+            std::size_t dash = item.find('-');
+            char* end = nullptr;
+            long first = std::strtol(item.c_str(), &end, 10);
+            if (item.empty() || end == item.c_str() || first < 0) {
+                return false;
+            }
+            long last = first;
+            if (dash != std::string::npos) {
+                const char* rest = item.c_str() + dash + 1;
+                last = std::strtol(rest, &end, 10);
+                if (end == rest || last < first) {
+                    return false;
+                }
+            }
+            if (*end != '\0') {
+                return false;
+            }
+            if (last > highest) {
+                std::cerr << "Error: CPU list item '" << item << "' goes beyond CPU " << highest
+                          << ", the highest available to this process" << std::endl;
+                return false;
+            }
+            for (long cpu = first; cpu <= last; cpu++) {
+                parsed.list.push_back(static_cast<int>(cpu));
+            }
+            if (comma == std::string::npos) {
+                break;
+            }
+            pos = comma + 1;
+        }
+    }
+    pinning = parsed;
+    return true;
+}
+
+std::string describeCpuPinning(const CpuPinning& pinning) {
+    switch (pinning.policy) {
+        case PinningPolicy::Compact: return "compact";
+        case PinningPolicy::Scatter: return "scatter";
+        case PinningPolicy::List:    return "list " + formatCpuList(pinning.list);
+        case PinningPolicy::None:
+        default:                     return "none";
+    }
+}
+
+/**
+ * @brief Choose one CPU per worker
+ *
+ * Compact: CPUs ordered by (node, package, core, CPU), so hyperthread
+ * siblings are used next to each other. Scatter: each node's CPUs spread
+ * over its cores (see spreadOverCores()), then the nodes interleaved.
+ *
+ * @param pinning Placement policy
+ * @param workers Number of workers
+ * @return CPU of each worker (empty for PinningPolicy::None)
+ */
+std::vector<int> planCpus(const CpuPinning& pinning, unsigned int workers) {
+    std::vector<int> order;
+    const std::vector<CpuInfo>& cpus = CpuTopology::instance().getCpus();
+
+    switch (pinning.policy) {
+        case PinningPolicy::None:
+            return order;
+
+        case PinningPolicy::List:
+            order = pinning.list;
+            break;
+
+        case PinningPolicy::Compact: {
+            std::vector<CpuInfo> sorted = cpus;
+            std::sort(sorted.begin(), sorted.end(), [](const CpuInfo& a, const CpuInfo& b) {
+                return std::make_tuple(a.node, a.package, a.core, a.cpu) <
+                       std::make_tuple(b.node, b.package, b.core, b.cpu);
+            });
+            for (const CpuInfo& info : sorted) {
+                order.push_back(info.cpu);
+            }
+            break;
+        }
+
+        case PinningPolicy::Scatter: {
+            std::set<int> nodeIds;
+            for (const CpuInfo& info : cpus) {
+                nodeIds.insert(info.node);
+            }
+            std::vector<std::vector<CpuInfo> > perNode;
+            for (int node : nodeIds) {
+                std::vector<CpuInfo> members;
+                for (const CpuInfo& info : cpus) {
+                    if (info.node == node) {
+                        members.push_back(info);
+                    }
+                }
+                perNode.push_back(spreadOverCores(members));
+            }
+            for (std::size_t round = 0; order.size() < cpus.size(); round++) {
+                for (const auto& members : perNode) {
+                    if (round < members.size()) {
+                        order.push_back(members[round].cpu);
+                    }
+                }
+            }
+            break;
+        }
+    }
+
+    std::vector<int> plan;
+    if (order.empty()) {
+        return plan;
+    }
+    for (unsigned int i = 0; i < workers; i++) {
+        plan.push_back(order[i % order.size()]);
+    }
+    return plan;
+}
+
+std::string formatCpuList(const std::vector<int>& plan) {
+    std::set<int> distinct(plan.begin(), plan.end());
+    std::ostringstream text;
+    bool first = true;
+    for (auto it = distinct.begin(); it != distinct.end();) {
+        int start = *it;
+        int end = start;
+        for (++it; it != distinct.end() && *it == end + 1; ++it) {
+            end = *it;
+        }
+        text << (first ? "" : ",") << start;
+        if (end != start) {
+            text << "-" << end;
+        }
+        first = false;
+    }
+    return text.str();
+}
+
+bool pinCurrentThread(int cpu) {
+#ifdef CPU_TOPOLOGY_USE_LINUX
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+/**
+ * @brief Prefer NUMA nodes for the pages of an array of records
+ *
+ * Runs of consecutive pages with the same node are bound with a single
+ * mbind call.
+ *
+ * @param base Address of record 0
+ * @param stride Size of one record in bytes
+ * @param nodes Node of record i at index i
+ * @return Number of pages bound
+ */
+std::size_t bindToNodes(const void* base, std::size_t stride, const std::vector<int>& nodes) {
+#ifdef CPU_TOPOLOGY_USE_LINUX
+    if (CpuTopology::instance().nodeCount() <= 1 || nodes.empty() || stride == 0) {
+        return 0;
+    }
+    const std::uintptr_t pageSize = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(base);
+    const std::uintptr_t end = begin + stride * nodes.size();
+
+    std::size_t bound = 0;
+    std::uintptr_t runStart = begin & ~(pageSize - 1);
+    int runNode = nodes[0];
+    for (std::uintptr_t page = runStart; ; page += pageSize) {
+        int node = runNode;
+        if (page < end) {
+            std::uintptr_t first = std::max(page, begin);
+            node = nodes[std::min<std::size_t>((first - begin) / stride, nodes.size() - 1)];
+        }
+        if (page >= end || node != runNode) {
+            // Flush the run [runStart, page)
+            if (runNode >= 0 && runNode < 64) {
+                unsigned long mask = 1UL << runNode;
+                if (syscall(SYS_mbind, reinterpret_cast<void*>(runStart), page - runStart, MPOL_PREFERRED_MODE,
+                            &mask, sizeof(mask) * 8, MPOL_MOVE_FLAG) == 0) {
+                    bound += (page - runStart) / pageSize;
+                }
+            }
+            if (page >= end) {
+                break;
+            }
+            runStart = page;
+            runNode = node;
+        }
+    }
+    return bound;
+#else
+    (void)base;
+    (void)stride;
+    (void)nodes;
+    return 0;
+#endif
+}
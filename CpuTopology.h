@@ -0,0 +1,164 @@
+/**
+ * @file CpuTopology.h
+ * @brief Header file for CPU topology detection, thread pinning and NUMA placement
+ *
+ * This file defines the placement controls shared by both simulations:
+ *
+ * - CpuTopology: the CPUs this process may run on, each with its core,
+ *   package (socket) and NUMA node, read once from /sys on Linux
+ * - CpuPinning / planCpus(): turn a pinning policy into one CPU per worker
+ *   - compact: fill one node (and one core's hyperthreads) before the next,
+ *     so communicating workers share caches
+ *   - scatter: round-robin over nodes, then packages, then cores, so every
+ *     worker gets as much cache and memory bandwidth as possible
+ *   - an explicit list such as "0,2,4-7"
+ * - pinCurrentThread(): bind the calling thread to one CPU
+ * - bindToNodes(): move the pages of an array of per-thread records to the
+ *   NUMA nodes of their owners (mbind with MPOL_PREFERRED, no libnuma)
+ *
+ * On platforms without these interfaces, or with a single NUMA node, every
+ * CPU reports node 0, pinning is a no-op and placement is skipped.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef CPU_TOPOLOGY_H
+#define CPU_TOPOLOGY_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @struct CpuInfo
+ * @brief Location of one logical CPU
+ */
+struct CpuInfo {
+    int cpu;      ///< OS CPU number
+    int core;     ///< Core id within the package (hyperthreads share it)
+    int package;  ///< Physical package (socket) id
+    int node;     ///< NUMA node
+};
+
+/**
+ * @class CpuTopology
+ * @brief Logical CPUs available to this process and how they are grouped
+ */
+class CpuTopology {
+private:
+    std::vector<CpuInfo> cpus;  ///< Allowed CPUs, ordered by CPU number
+    int nodes;                  ///< Distinct NUMA nodes among cpus
+    int packages;               ///< Distinct packages among cpus
+    int cores;                  ///< Distinct (package, core) pairs among cpus
+
+    CpuTopology();
+
+public:
+    /**
+     * @brief Get the topology (detected on first use)
+     * @return Process-wide topology
+     */
+    static const CpuTopology& instance();
+
+    /**
+     * @brief Get the CPUs this process may run on
+     * @return One record per allowed logical CPU, by CPU number
+     */
+    const std::vector<CpuInfo>& getCpus() const;
+
+    /**
+     * @brief Get the NUMA node of a CPU
+     * @param cpu OS CPU number
+     * @return Node, or 0 if the CPU is unknown
+     */
+    int nodeOf(int cpu) const;
+
+    /**
+     * @brief Get the number of NUMA nodes in use
+     * @return Node count (at least 1)
+     */
+    int nodeCount() const;
+
+    /**
+     * @brief Describe the topology, e.g. "2 nodes, 2 packages, 16 cores, 32 CPUs"
+     * @return Human-readable summary
+     */
+    std::string describe() const;
+};
+
+/**
+ * @enum PinningPolicy
+ * @brief How worker threads are placed on CPUs
+ */
+enum class PinningPolicy {
+    None,     ///< Leave placement to the OS scheduler
+    Compact,  ///< Fill a node, package and core before moving to the next
+    Scatter,  ///< Spread over nodes, packages and cores round-robin
+    List      ///< Explicit CPU list
+};
+
+/**
+ * @struct CpuPinning
+ * @brief A pinning policy and, for PinningPolicy::List, its CPUs
+ */
+struct CpuPinning {
+    PinningPolicy policy;  ///< Placement policy
+    std::vector<int> list; ///< CPUs of an explicit list, in order
+};
+
+/**
+ * @brief Parse "none", "compact", "scatter" or a CPU list such as "0,2,4-7"
+ * @param spec Pinning specification
+ * @param pinning Receives the parsed pinning
+ * @return true if the specification is valid (a CPU above the highest available
+ *         one is reported on std::cerr)
+ */
+bool parseCpuPinning(const std::string& spec, CpuPinning& pinning);
+
+/**
+ * @brief Describe a pinning, e.g. "compact" or "list 0,2,4"
+ * @param pinning Pinning to describe
+ * @return Human-readable name
+ */
+std::string describeCpuPinning(const CpuPinning& pinning);
+
+/**
+ * @brief Choose one CPU per worker
+ *
+ * More workers than CPUs wrap around the order.
+ *
+ * @param pinning Placement policy
+ * @param workers Number of workers
+ * @return CPU of worker i at index i, or an empty vector for PinningPolicy::None
+ */
+std::vector<int> planCpus(const CpuPinning& pinning, unsigned int workers);
+
+/**
+ * @brief Format a CPU plan, e.g. "0-3,8"
+ * @param plan CPUs, one per worker
+ * @return Compact list of the distinct CPUs in ascending order
+ */
+std::string formatCpuList(const std::vector<int>& plan);
+
+/**
+ * @brief Bind the calling thread to one CPU
+ * @param cpu OS CPU number
+ * @return true on success (false where pinning is unsupported)
+ */
+bool pinCurrentThread(int cpu);
+
+/**
+ * @brief Prefer NUMA nodes for the pages of an array of records
+ *
+ * Each page goes to the node of the record that starts on it (or spans it).
+ * Pages already touched are moved. Does nothing on single-node systems.
+ *
+ * @param base Address of record 0
+ * @param stride Size of one record in bytes
+ * @param nodes Node of record i at index i
+ * @return Number of pages bound (0 if placement is unsupported or unneeded)
+ */
+std::size_t bindToNodes(const void* base, std::size_t stride, const std::vector<int>& nodes);
+
+#endif // CPU_TOPOLOGY_H
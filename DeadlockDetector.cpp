@@ -0,0 +1,358 @@
+/**
+ * @file DeadlockDetector.cpp
+ * @brief Implementation of the wait-for graph deadlock watchdog
+ *
+ * Memory ordering: a philosopher publishes its sequence number before the
+ * fork it waits for, and both with release stores; the watchdog reads them
+ * with acquire loads. A snapshot may still mix moments of different
+ * philosophers, which is why a cycle must survive a second scan unchanged.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "DeadlockDetector.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include "DurationDistribution.h"
+
+const int DeadlockDetector::DEFAULT_INTERVAL_MS;
+
+/**
+ * @brief Constructor - detection off, DEFAULT_INTERVAL_MS between scans
+ */
+DeadlockDetector::DeadlockDetector()
+    : action(DeadlockAction::Off), interval(std::chrono::milliseconds(DEFAULT_INTERVAL_MS)),
+      agents(0), resources(0), deadlocks(0), preemptions(0), stopping(false) {}
+
+/**
+ * @brief Destructor - stops the watchdog if it is still running
+ */
+DeadlockDetector::~DeadlockDetector() {
+    stop();
+}
+
+void DeadlockDetector::setAction(DeadlockAction newAction) {
+    action = newAction;
+}
+
+DeadlockAction DeadlockDetector::getAction() const {
+    return action;
+}
+
+/**
+ * @brief Set the time between two scans (a deadlock is found within two)
+ * @param scanInterval Interval (raised to 1 microsecond if smaller)
+ */
+void DeadlockDetector::setInterval(std::chrono::nanoseconds scanInterval) {
+    interval = std::max<std::chrono::nanoseconds>(scanInterval, std::chrono::microseconds(1));
+}
+
+std::chrono::nanoseconds DeadlockDetector::getInterval() const {
+    return interval;
+}
+
+bool DeadlockDetector::enabled() const {
+    return action != DeadlockAction::Off;
+}
+
+/**
+ * @brief Clear the graph and start the watchdog (no-op when disabled)
+ *
+ * The counters and cycles of the previous run are dropped here, so they
+ * stay readable after stop().
+ *
+ * @param agentCount Number of philosophers
+ * @param resourceCount Number of forks
+ */
+void DeadlockDetector::start(int agentCount, int resourceCount) {
+    stop();
+    deadlocks.store(0, std::memory_order_relaxed);
+    preemptions.store(0, std::memory_order_relaxed);
+    found.clear();
+    if (!enabled()) {
+        return;
+    }
+
+    agents = agentCount;
+    resources = resourceCount;
+    waitingFor.reset(new std::atomic<int>[agents]);
+    waitSequence.reset(new std::atomic<std::uint64_t>[agents]);
+    preemptRequest.reset(new std::atomic<bool>[agents]);
+    holder.reset(new std::atomic<int>[resources]);
+    for (int a = 0; a < agents; a++) {
+        waitingFor[a].store(-1, std::memory_order_relaxed);
+        waitSequence[a].store(0, std::memory_order_relaxed);
+        preemptRequest[a].store(false, std::memory_order_relaxed);
+    }
+    for (int r = 0; r < resources; r++) {
+        holder[r].store(-1, std::memory_order_relaxed);
+    }
+
+    stopping = false;
+    startTime = std::chrono::steady_clock::now();
+    watchdog = std::thread(&DeadlockDetector::watch, this);
+}
+
+/**
+ * @brief Stop the watchdog and wait for it to exit
+ */
+void DeadlockDetector::stop() {
+    if (!watchdog.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stopping = true;
+    }
+    stopSignal.notify_all();
+    watchdog.join();
+}
+
+/**
+ * @brief Hook: a philosopher is about to block on a fork
+ * @param agent Philosopher ID
+ * @param resource Fork index
+ */
+void DeadlockDetector::waiting(int agent, int resource) {
+    // Only the philosopher itself writes its sequence number
+    waitSequence[agent].store(waitSequence[agent].load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    waitingFor[agent].store(resource, std::memory_order_release);
+}
+
+/**
+ * @brief Hook: a philosopher now holds a fork (and waits for nothing)
+ * @param agent Philosopher ID
+ * @param resource Fork index
+ */
+void DeadlockDetector::acquired(int agent, int resource) {
+    holder[resource].store(agent, std::memory_order_release);
+    waitingFor[agent].store(-1, std::memory_order_release);
+}
+
+void DeadlockDetector::gaveUp(int agent) {
+    waitingFor[agent].store(-1, std::memory_order_release);
+}
+
+void DeadlockDetector::released(int resource) {
+    holder[resource].store(-1, std::memory_order_release);
+}
+
+/**
+ * @brief Check (and clear) a preemption request for a waiting philosopher
+ * @param agent Philosopher ID
+ * @return true if the philosopher must release its forks and retry
+ */
+bool DeadlockDetector::preempted(int agent) {
+    return preemptRequest[agent].load(std::memory_order_relaxed)
+        && preemptRequest[agent].exchange(false, std::memory_order_acquire);
+}
+
+std::uint64_t DeadlockDetector::getDeadlocks() const {
+    return deadlocks.load(std::memory_order_relaxed);
+}
+
+std::uint64_t DeadlockDetector::getPreemptions() const {
+    return preemptions.load(std::memory_order_relaxed);
+}
+
+std::vector<DeadlockCycle> DeadlockDetector::getCycles() const {
+    std::lock_guard<std::mutex> lock(stopMutex);
+    return found;
+}
+
+/**
+ * @brief Describe the configuration for statistics output
+ * @return e.g. "preempt, scan every 10ms" or "off"
+ */
+std::string DeadlockDetector::describe() const {
+    if (!enabled()) {
+        return deadlockActionName(action);
+    }
+    return std::string(deadlockActionName(action)) + ", scan every " + formatDuration(interval);
+}
+
+/**
+ * @brief Format a cycle as "PHIL 0 -> fork 1 -> PHIL 1 -> fork 2 -> PHIL 0"
+ * @param cycle Cycle to format
+ * @return One-line description
+ */
+std::string DeadlockDetector::formatCycle(const DeadlockCycle& cycle) {
+    std::ostringstream text;
+    for (std::size_t i = 0; i < cycle.agents.size(); i++) {
+        text << "PHIL " << cycle.agents[i] << " -> fork " << cycle.resources[i] << " -> ";
+    }
+    if (!cycle.agents.empty()) {
+        text << "PHIL " << cycle.agents[0];
+    }
+    return text.str();
+}
+
+/**
+ * @brief Watchdog thread body: scan, confirm, act, sleep until the next interval
+ *
+ * A cycle is confirmed when every member had the same wait (fork and
+ * sequence number) and the same next member in the previous snapshot. Each
+ * confirmed wait is handled once, so a Report run prints a stuck cycle once
+ * and a Preempt victim is not asked twice for the same wait.
+ */
+void DeadlockDetector::watch() {
+    std::vector<int> waits, previousWaits(static_cast<std::size_t>(agents), -1);
+    std::vector<std::uint64_t> sequences, previousSequences(static_cast<std::size_t>(agents), 0);
+    std::vector<int> next, previousNext(static_cast<std::size_t>(agents), -1);
+    std::vector<std::uint64_t> handledSequence(static_cast<std::size_t>(agents), 0);
+
+    std::unique_lock<std::mutex> lock(stopMutex);
+    while (!stopping) {
+        stopSignal.wait_for(lock, interval, [this] { return stopping; });
+        if (stopping) {
+            break;
+        }
+        lock.unlock();
+
+        snapshot(waits, sequences, next);
+        for (const DeadlockCycle& cycle : findCycles(waits, next)) {
+            bool confirmed = true;
+            bool handled = true;
+            for (int member : cycle.agents) {
+                confirmed = confirmed && previousWaits[member] == waits[member]
+                    && previousSequences[member] == sequences[member] && previousNext[member] == next[member];
+                handled = handled && handledSequence[member] == sequences[member];
+            }
+            if (confirmed && !handled) {
+                for (int member : cycle.agents) {
+                    handledSequence[member] = sequences[member];
+                }
+                handle(cycle);
+            }
+        }
+        waits.swap(previousWaits);
+        sequences.swap(previousSequences);
+        next.swap(previousNext);
+
+        lock.lock();
+    }
+}
+
+/**
+ * @brief Take a snapshot of the graph
+ * @param waits Receives the fork each philosopher waits for
+ * @param sequences Receives each philosopher's wait sequence number
+ * @param next Receives the philosopher each one waits on (-1 = none)
+ */
+void DeadlockDetector::snapshot(std::vector<int>& waits, std::vector<std::uint64_t>& sequences,
+                                std::vector<int>& next) const {
+    waits.resize(static_cast<std::size_t>(agents));
+    sequences.resize(static_cast<std::size_t>(agents));
+    next.resize(static_cast<std::size_t>(agents));
+    for (int a = 0; a < agents; a++) {
+        int resource = waitingFor[a].load(std::memory_order_acquire);
+        sequences[a] = waitSequence[a].load(std::memory_order_acquire);
+        int owner = (resource >= 0) ? holder[resource].load(std::memory_order_acquire) : -1;
+        waits[a] = resource;
+        next[a] = (owner == a) ? -1 : owner;  // a stale self-edge is a release in progress
+    }
+}
+
+/**
+ * @brief Find every cycle of a snapshot
+ *
+ * Every philosopher has at most one outgoing edge, so one walk from each
+ * unvisited philosopher, colouring as it goes, visits each node once; a walk
+ * that runs into its own colour has closed a cycle.
+ *
+ * @param waits Fork each philosopher waits for
+ * @param next Philosopher each one waits on (-1 = none)
+ * @return The cycles, each starting at its lowest-numbered member
+ */
+std::vector<DeadlockCycle> DeadlockDetector::findCycles(const std::vector<int>& waits,
+                                                        const std::vector<int>& next) const {
+    std::vector<DeadlockCycle> cycles;
+    std::vector<int> colour(static_cast<std::size_t>(agents), 0);
+    for (int start = 0; start < agents; start++) {
+        int walk = start + 1;
+        int v = start;
+        while (v >= 0 && colour[v] == 0) {
+            colour[v] = walk;
+            v = next[v];
+        }
+        if (v < 0 || colour[v] != walk) {
+            continue;
+        }
+
+        // v is on the cycle: rotate it to start at its lowest member
+        int lowest = v;
+        for (int u = next[v]; u != v; u = next[u]) {
+            lowest = std::min(lowest, u);
+        }
+        DeadlockCycle cycle;
+        int u = lowest;
+        do {
+            cycle.agents.push_back(u);
+            cycle.resources.push_back(waits[u]);
+            u = next[u];
+        } while (u != lowest);
+        cycles.push_back(cycle);
+    }
+    return cycles;
+}
+
+/**
+ * @brief Print a confirmed deadlock and apply the action
+ * @param cycle The deadlocked philosophers
+ */
+void DeadlockDetector::handle(const DeadlockCycle& cycle) {
+    deadlocks.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        found.push_back(cycle);
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    std::cerr << "DEADLOCK after " << seconds << "s: " << formatCycle(cycle)
+              << " (each philosopher waits for the fork held by the next)" << std::endl;
+
+    switch (action) {
+        case DeadlockAction::Abort:
+            std::cerr << "Deadlock detection: aborting" << std::endl;
+            std::abort();
+        case DeadlockAction::Preempt: {
+            int victim = *std::max_element(cycle.agents.begin(), cycle.agents.end());
+            std::cerr << "Deadlock detection: preempting PHIL " << victim << std::endl;
+            preemptions.fetch_add(1, std::memory_order_relaxed);
+            preemptRequest[victim].store(true, std::memory_order_release);
+            break;
+        }
+        case DeadlockAction::Report:
+        case DeadlockAction::Off:
+        default:
+            break;
+    }
+}
+
+bool parseDeadlockAction(const std::string& name, DeadlockAction& action) {
+    if (name == "off") {
+        action = DeadlockAction::Off;
+    } else if (name == "report") {
+        action = DeadlockAction::Report;
+    } else if (name == "abort") {
+        action = DeadlockAction::Abort;
+    } else if (name == "preempt") {
+        action = DeadlockAction::Preempt;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* deadlockActionName(DeadlockAction action) {
+    switch (action) {
+        case DeadlockAction::Report:  return "report";
+        case DeadlockAction::Abort:   return "abort";
+        case DeadlockAction::Preempt: return "preempt";
+        case DeadlockAction::Off:
+        default:                      return "off";
+    }
+}
@@ -0,0 +1,254 @@
+/**
+ * @file DeadlockDetector.h
+ * @brief Header file for the wait-for graph deadlock watchdog
+ *
+ * This file defines a run-time deadlock detector for the lock-based fork
+ * strategies of DiningPhilosophers, so that unsafe strategies (such as the
+ * naive "left fork, then right fork") can be benchmarked without hanging:
+ *
+ * - The wait-for graph is two arrays of atomics: the fork each philosopher
+ *   is blocked on (waiting()) and the philosopher holding each fork
+ *   (acquired() / released()). Every hook is one or two stores by the
+ *   philosopher itself, with no lock and no allocation.
+ * - A watchdog thread snapshots the graph every interval. Each philosopher
+ *   waits for at most one fork, so the graph has out-degree one and a scan
+ *   finds every cycle in O(philosophers).
+ * - A cycle counts as a deadlock once two consecutive scans see it with every
+ *   member still in the same wait (same per-philosopher wait sequence
+ *   number), so a torn snapshot of a moving table is never reported. A
+ *   deadlock is therefore reported within two intervals.
+ * - On a deadlock the cycle is printed to std::cerr, then the detector either
+ *   keeps watching (Report), calls std::abort() (Abort, so a CI job fails
+ *   fast), or asks one member to give up its forks and retry (Preempt).
+ *
+ * The victim of a preemption is the highest-numbered philosopher in the
+ * cycle; it polls preempted() while waiting, because a thread blocked in
+ * lock() cannot be interrupted.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef DEADLOCK_DETECTOR_H
+#define DEADLOCK_DETECTOR_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @enum DeadlockAction
+ * @brief What the watchdog does once it has found a deadlock
+ */
+enum class DeadlockAction {
+    Off,      ///< No watchdog and no graph updates
+    Report,   ///< Print the cycle and keep running (the deadlocked philosophers stay stuck)
+    Abort,    ///< Print the cycle and call std::abort()
+    Preempt   ///< Print the cycle and make one member release its forks and retry
+};
+
+/**
+ * @struct DeadlockCycle
+ * @brief One cycle of the wait-for graph
+ *
+ * Philosopher agents[i] waits for fork resources[i], which is held by
+ * agents[(i + 1) % size].
+ */
+struct DeadlockCycle {
+    std::vector<int> agents;     ///< Philosophers of the cycle, starting at the lowest ID
+    std::vector<int> resources;  ///< Fork each of them waits for
+};
+
+/**
+ * @class DeadlockDetector
+ * @brief Lock-free wait-for graph with a cycle-detecting watchdog thread
+ */
+class DeadlockDetector {
+public:
+    static const int DEFAULT_INTERVAL_MS = 10;  ///< Scan interval used when none is given
+
+private:
+    DeadlockAction action;                          ///< Action of the next start()
+    std::chrono::nanoseconds interval;              ///< Time between two scans
+    int agents;                                     ///< Philosophers of the current run
+    int resources;                                  ///< Forks of the current run
+    std::unique_ptr<std::atomic<int>[]> waitingFor;            ///< Fork each philosopher is blocked on (-1 = none)
+    std::unique_ptr<std::atomic<std::uint64_t>[]> waitSequence; ///< Waits started by each philosopher
+    std::unique_ptr<std::atomic<int>[]> holder;                ///< Philosopher holding each fork (-1 = free)
+    std::unique_ptr<std::atomic<bool>[]> preemptRequest;       ///< Set by the watchdog for a Preempt victim
+    std::atomic<std::uint64_t> deadlocks;           ///< Deadlocks found in the current run
+    std::atomic<std::uint64_t> preemptions;         ///< Victims asked to back off in the current run
+    std::vector<DeadlockCycle> found;               ///< Every deadlock found (guarded by stopMutex)
+    std::thread watchdog;                           ///< Scanning thread (joinable while running)
+    mutable std::mutex stopMutex;                   ///< Guards stopping and found
+    std::condition_variable stopSignal;             ///< Wakes the watchdog for stop()
+    bool stopping;                                  ///< Set by stop() to end the watchdog
+    std::chrono::steady_clock::time_point startTime; ///< When start() was called
+
+    /**
+     * @brief Watchdog thread body: scan, confirm, act, sleep until the next interval
+     */
+    void watch();
+
+    /**
+     * @brief Take a snapshot of the graph
+     * @param waits Receives the fork each philosopher waits for
+     * @param sequences Receives each philosopher's wait sequence number
+     * @param next Receives the philosopher each one waits on (-1 = none)
+     */
+    void snapshot(std::vector<int>& waits, std::vector<std::uint64_t>& sequences, std::vector<int>& next) const;
+
+    /**
+     * @brief Find every cycle of a snapshot
+     * @param waits Fork each philosopher waits for
+     * @param next Philosopher each one waits on (-1 = none)
+     * @return The cycles, each starting at its lowest-numbered member
+     */
+    std::vector<DeadlockCycle> findCycles(const std::vector<int>& waits, const std::vector<int>& next) const;
+
+    /**
+     * @brief Print a confirmed deadlock and apply the action
+     * @param cycle The deadlocked philosophers
+     */
+    void handle(const DeadlockCycle& cycle);
+
+public:
+    /**
+     * @brief Constructor - detection off, DEFAULT_INTERVAL_MS between scans
+     */
+    DeadlockDetector();
+
+    /**
+     * @brief Destructor - stops the watchdog if it is still running
+     */
+    ~DeadlockDetector();
+
+    /**
+     * @brief Select what happens on a deadlock (takes effect at the next start())
+     * @param newAction Action (DeadlockAction::Off disables the detector)
+     */
+    void setAction(DeadlockAction newAction);
+
+    /**
+     * @brief Get the selected action
+     * @return Action
+     */
+    DeadlockAction getAction() const;
+
+    /**
+     * @brief Set the time between two scans (a deadlock is found within two)
+     * @param scanInterval Interval (raised to 1 microsecond if smaller)
+     */
+    void setInterval(std::chrono::nanoseconds scanInterval);
+
+    /**
+     * @brief Get the time between two scans
+     * @return Interval
+     */
+    std::chrono::nanoseconds getInterval() const;
+
+    /**
+     * @brief Check whether the hooks must be called
+     * @return true unless the action is DeadlockAction::Off
+     */
+    bool enabled() const;
+
+    /**
+     * @brief Clear the graph and start the watchdog (no-op when disabled)
+     * @param agentCount Number of philosophers
+     * @param resourceCount Number of forks
+     */
+    void start(int agentCount, int resourceCount);
+
+    /**
+     * @brief Stop the watchdog and wait for it to exit
+     */
+    void stop();
+
+    /**
+     * @brief Hook: a philosopher is about to block on a fork
+     * @param agent Philosopher ID
+     * @param resource Fork index
+     */
+    void waiting(int agent, int resource);
+
+    /**
+     * @brief Hook: a philosopher now holds a fork (and waits for nothing)
+     * @param agent Philosopher ID
+     * @param resource Fork index
+     */
+    void acquired(int agent, int resource);
+
+    /**
+     * @brief Hook: a philosopher stopped waiting without getting the fork
+     * @param agent Philosopher ID
+     */
+    void gaveUp(int agent);
+
+    /**
+     * @brief Hook: a fork is about to be put down
+     * @param resource Fork index
+     */
+    void released(int resource);
+
+    /**
+     * @brief Check (and clear) a preemption request for a waiting philosopher
+     * @param agent Philosopher ID
+     * @return true if the philosopher must release its forks and retry
+     */
+    bool preempted(int agent);
+
+    /**
+     * @brief Get the number of deadlocks found in the last run
+     * @return Deadlock count
+     */
+    std::uint64_t getDeadlocks() const;
+
+    /**
+     * @brief Get the number of preemptions requested in the last run
+     * @return Preemption count
+     */
+    std::uint64_t getPreemptions() const;
+
+    /**
+     * @brief Get every deadlock found in the last run
+     * @return Cycles in the order found
+     */
+    std::vector<DeadlockCycle> getCycles() const;
+
+    /**
+     * @brief Describe the configuration for statistics output
+     * @return e.g. "preempt, scan every 10ms" or "off"
+     */
+    std::string describe() const;
+
+    /**
+     * @brief Format a cycle as "PHIL 0 -> fork 1 -> PHIL 1 -> fork 2 -> PHIL 0"
+     * @param cycle Cycle to format
+     * @return One-line description
+     */
+    static std::string formatCycle(const DeadlockCycle& cycle);
+};
+
+/**
+ * @brief Parse a deadlock action name ("off", "report", "abort", "preempt")
+ * @param name Action name
+ * @param action Receives the parsed action
+ * @return true if the name is recognised
+ */
+bool parseDeadlockAction(const std::string& name, DeadlockAction& action);
+
+/**
+ * @brief Get the command-line name of a deadlock action
+ * @param action Action
+ * @return "off", "report", "abort" or "preempt"
+ */
+const char* deadlockActionName(DeadlockAction action);
+
+#endif // DEADLOCK_DETECTOR_H
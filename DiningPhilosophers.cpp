@@ -3,7 +3,7 @@
  * @brief Implementation of the DiningPhilosophers class
  * 
  * This file implements the classic Dining Philosophers synchronization problem
- * with deadlock prevention. Five philosophers sit at a round table with five forks.
+ * with deadlock prevention. N philosophers sit at a round table with N forks.
  * Each philosopher alternates between thinking and eating, requiring two forks to eat.
  * 
  * DEADLOCK PREVENTION STRATEGY: ORDERED RESOURCE ACQUISITION
@@ -25,59 +25,631 @@
  * - Philosopher 1: needs forks 1 and 0 → picks up 0 first, then 1
  * - Philosopher 4: needs forks 4 and 3 → picks up 3 first, then 4
  * 
+ * Strategies:
+ * - Ordered: lower-numbered fork first (the original protocol)
+ * - Waiter: a semaphore (mutex + condition variable) seats at most N-1 diners,
+ *   who then pick up left then right on the round table and in ascending
+ *   order on a loaded resource graph
+ * - Chandy-Misra: forks start dirty at the lower-numbered neighbour; a hungry
+ *   philosopher takes any dirty fork whose holder is not eating, which cleans
+ *   it, and forks become dirty again after a meal
+ * - TryLock: std::lock() on both fork mutexes (try-and-back-off)
+ * - Monitor: Tanenbaum's THINKING/HUNGRY/EATING array under one mutex
+ * - Naive: forks in listed order (left then right) with no prevention at
+ *   all; it can deadlock and exists to be caught by the DeadlockDetector
+ * 
+ * Deadlock detection:
+ * - With a DeadlockAction other than Off, the lock-based strategies report
+ *   every blocking fork wait, pick-up and put-down to the detector's wait-for
+ *   graph (a few atomic stores; nothing at all when detection is off)
+ * - Monitor and Chandy-Misra hold no fork locks and are not tracked
+ * - With Preempt, a contended fork is polled instead of blocked on, so the
+ *   philosopher can notice that it was chosen as the victim, put its forks
+ *   down and start over
+ * 
+ * Readers and writers:
+ * - A read meal (drawn with probability readRatio) takes its forks with the
+ *   shared calls of the ForkTable, including the all-or-nothing lockAll() of
+ *   TryLock; a ForkTable whose lock is not SharedLockable takes them
+ *   exclusively, so the same run measures the gain of a shared lock
+ * - Readers of one fork update its counters with atomic adds
+ * - The deadlock detector's wait-for graph has one holder per fork, so with
+ *   detection on every meal is exclusive
+ * 
+ * Instrumentation:
+ * - Fork counters are updated right after the fork is acquired, by its holder
+ *   (or under tableMutex for Monitor and Chandy-Misra, where forks are logical),
+ *   so plain integers suffice
+ * - For Monitor and Chandy-Misra the philosopher's whole wait is charged to
+ *   both forks, since there is no per-fork lock to time
+ * 
+ * Scalability:
+ * - The table size is chosen at runtime; forks live in a vector of cache-line
+ *   aligned slots so that adjacent fork mutexes never share a cache line
+ * - Philosophers are multiplexed over a ThreadPool: every think-eat cycle is one
+ *   pool task that re-queues the philosopher's next cycle when it finishes
+ * 
+ * Hot loop:
+ * - think() draws from the philosopher's own FastRandom (seeded once per run)
+ *   instead of building a std::random_device and std::mt19937 per call
+ * - Messages are formatted into on-stack LogLine buffers instead of
+ *   std::stringstream, and skipped entirely when logging is off
+ * 
  * Thread Safety:
- * - Each fork is represented by a std::mutex (CRITICAL RESOURCE)
- * - Console output is protected by coutMutex (CRITICAL SECTION)
- * - Uses RAII pattern (std::lock_guard) for automatic mutex unlocking
+ * - Each fork is a lock in forkLocks (CRITICAL RESOURCE); the table is
+ *   rebuilt by simulate() with the selected ForkLockType
+ * - Console output goes through the shared asynchronous Logger (lock-free)
  * 
  * @author Thread Simulation System
  * @date 2024
  */
 
 #include "DiningPhilosophers.h"
+#include "Logger.h"
+#include "ThreadPool.h"
 #include <iostream>
 #include <thread>
 #include <chrono>
 #include <random>
 #include <sstream>
 #include <iomanip>
+#include <ostream>
+#include <fstream>
+#include <algorithm>
+
+const int DiningPhilosophers::DEFAULT_PHILOSOPHERS;
+const std::size_t DiningPhilosophers::CACHE_LINE_SIZE;
+
+namespace {
+
+/**
+ * @brief Nanoseconds elapsed since a time point
+ */
+inline std::uint64_t nanosecondsSince(std::chrono::steady_clock::time_point since) {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - since).count());
+}
+
+/**
+ * @brief Shortest wait handed to the OS scheduler; shorter tails are spun out
+ */
+const std::chrono::nanoseconds SPIN_THRESHOLD = std::chrono::microseconds(100);
+
+/**
+ * @brief Number of most contended forks named in the statistics and the JSON metrics
+ */
+const std::size_t HOT_FORKS_REPORTED = 5;
+
+/**
+ * @brief Most forks named in one log line; longer sets end in "and N more"
+ *
+ * Keeps the line within Logger::MAX_MESSAGE, which would otherwise cut a
+ * long set mid-number without a trace.
+ */
+const std::size_t LOGGED_FORKS = 4;
+
+/**
+ * @brief Deadlock preemption: time between two tries of a contended fork
+ */
+const std::chrono::nanoseconds PREEMPT_POLL = std::chrono::microseconds(50);
+
+/**
+ * @brief Deadlock preemption: longest random back-off of a victim before it starts over
+ */
+const std::chrono::nanoseconds PREEMPT_BACKOFF = std::chrono::milliseconds(1);
+
+/**
+ * @brief Wait for a duration with sub-microsecond accuracy
+ * 
+ * A plain sleep_for() overshoots by the timer slack and wake-up latency (tens
+ * of microseconds), which would swamp microsecond-scale think and eat times.
+ * The bulk of a long wait is slept; the last SPIN_THRESHOLD is waited out
+ * with yield() so the worker still lets other runnable threads in.
+ */
+inline void pauseFor(std::chrono::nanoseconds duration) {
+    if (duration.count() <= 0) {
+        return;
+    }
+    auto until = std::chrono::steady_clock::now() + duration;
+    if (duration > SPIN_THRESHOLD) {
+        std::this_thread::sleep_until(until - SPIN_THRESHOLD);
+    }
+    while (std::chrono::steady_clock::now() < until) {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Parse a strategy name ("ordered", "waiter", "chandy-misra", "trylock", "monitor", "naive")
+ * @param name Strategy name
+ * @param strategy Receives the parsed strategy
+ * @return true if the name is recognised
+ */
+bool parseDiningStrategy(const std::string& name, DiningStrategy& strategy) {
+    if (name == "ordered") {
+        strategy = DiningStrategy::Ordered;
+    } else if (name == "waiter") {
+        strategy = DiningStrategy::Waiter;
+    } else if (name == "chandy-misra") {
+        strategy = DiningStrategy::ChandyMisra;
+    } else if (name == "trylock") {
+        strategy = DiningStrategy::TryLock;
+    } else if (name == "monitor") {
+        strategy = DiningStrategy::Monitor;
+    } else if (name == "naive") {
+        strategy = DiningStrategy::Naive;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Get the display name of a strategy
+ * @param strategy Strategy
+ * @return Human-readable name
+ */
+const char* diningStrategyName(DiningStrategy strategy) {
+    switch (strategy) {
+        case DiningStrategy::Waiter:      return "Waiter (N-1 semaphore)";
+        case DiningStrategy::ChandyMisra: return "Chandy-Misra";
+        case DiningStrategy::TryLock:     return "Try-lock with back-off";
+        case DiningStrategy::Monitor:     return "Monitor (Tanenbaum)";
+        case DiningStrategy::Naive:       return "Naive (listed order, can deadlock)";
+        case DiningStrategy::Ordered:
+        default:                          return "Ordered resource acquisition";
+    }
+}
 
 /**
  * @brief Constructor - initializes the dining philosophers simulation
+ * 
+ * A table needs at least two philosophers (with one, the left and right fork
+ * would be the same mutex), so smaller values are raised to 2.
+ * 
  * @param iterations Number of think-eat cycles per philosopher
+ * @param numPhilosophers Number of philosophers and forks
  */
-DiningPhilosophers::DiningPhilosophers(int iterations) : iterations(iterations) {
+DiningPhilosophers::DiningPhilosophers(int iterations, int numPhilosophers)
+    : numPhilosophers(numPhilosophers < 2 ? 2 : numPhilosophers),
+      numForks(0),
+      forkLockType(ForkLockType::Mutex),
+      iterations(iterations),
+      workerCount(0),
+      placedPages(0),
+      strategy(DiningStrategy::Ordered),
+      runStrategy(DiningStrategy::Ordered),
+      readRatio(0.0),
+      runDuration(0.0),
+      elapsed(0.0),
+      liveMetrics(nullptr),
+      liveRunning(false),
+      stopRequest(nullptr),
+      resumedElapsed(0.0),
+      interrupted(false),
+      thinkTime(DurationDistribution::uniform(std::chrono::seconds(1), std::chrono::seconds(3))),
+      eatTime(DurationDistribution::constant(std::chrono::seconds(2))),
+      loggingEnabled(true),
+      seed(0),
+      seedFixed(false),
+      seatsAvailable(0),
+      detecting(false) {
     // Initialize start time for timestamp tracking
     startTime = std::chrono::steady_clock::now();
-    // Member variables are initialized:
-    // - forks array (default constructed mutexes)
-    // - coutMutex (default constructed)
-    // - iterations (via initializer list)
+    pinning.policy = PinningPolicy::None;
+    // The classic round table: philosopher i needs forks i and (i + 1) % N
+    setResourceGraph(ResourceGraph::ring(this->numPhilosophers));
+}
+
+/**
+ * @brief Get the number of philosophers at the table
+ * @return Number of philosophers (and forks)
+ */
+int DiningPhilosophers::getNumPhilosophers() const {
+    return numPhilosophers;
 }
 
 /**
- * @brief Get the index of the left fork for a philosopher
+ * @brief Get the number of forks
+ * @return Number of forks (resources)
+ */
+int DiningPhilosophers::getNumForks() const {
+    return numForks;
+}
+
+/**
+ * @brief Replace the ring with an arbitrary agent -> resource set graph
+ * 
+ * The philosopher and fork vectors are rebuilt rather than resized, since a
+ * PhilosopherState (condition variable) cannot be moved.
+ * 
+ * @param newGraph Graph with at least one agent (see ResourceGraph::load())
+ */
+void DiningPhilosophers::setResourceGraph(const ResourceGraph& newGraph) {
+    if (newGraph.agentCount() == 0) {
+        std::cerr << "Error: A resource graph needs at least one agent" << std::endl;
+        return;
+    }
+    graph = newGraph;
+    numPhilosophers = graph.agentCount();
+    numForks = graph.resourceCount();
+    std::vector<Fork>(static_cast<std::size_t>(numForks)).swap(forks);
+    std::vector<PhilosopherState> seats(static_cast<std::size_t>(numPhilosophers));
+    philosophers.swap(seats);
+    for (auto& state : philosophers) {
+        state.cyclesCompleted = 0;
+        state.readMeals = 0;
+        state.access = ForkAccess::Exclusive;
+        state.phase = THINKING;
+        state.totalWait = 0.0;
+        state.maxWait = 0.0;
+        state.homePool = 0;
+    }
+    elapsed = 0.0;
+}
+
+/**
+ * @brief Get the table layout
+ * @return Current graph (ResourceGraph::ring() unless replaced)
+ */
+const ResourceGraph& DiningPhilosophers::getResourceGraph() const {
+    return graph;
+}
+
+/**
+ * @brief Check whether a strategy can run on the current graph
  * 
- * Fork arrangement: Philosopher i has fork i on their left
+ * Chandy-Misra keeps one owner per fork and hands a dirty fork to the
+ * hungry neighbour, which is only sound when a fork is an edge between two
+ * philosophers.
  * 
- * @param id Philosopher ID (0-4)
- * @return Index of the left fork
+ * @param candidate Strategy to check
+ * @return true if simulate() would use the strategy as is
+ */
+bool DiningPhilosophers::supportsStrategy(DiningStrategy candidate) const {
+    return candidate != DiningStrategy::ChandyMisra || graph.maxUsers() <= 2;
+}
+
+/**
+ * @brief Turn the wait-for graph deadlock watchdog on or off
+ * @param action What to do on a deadlock (DeadlockAction::Off disables detection)
+ * @param interval Time between two watchdog scans
  */
-int DiningPhilosophers::leftFork(int id) {
-    return id;
+void DiningPhilosophers::setDeadlockDetection(DeadlockAction action, std::chrono::nanoseconds interval) {
+    deadlock.setAction(action);
+    deadlock.setInterval(interval);
 }
 
 /**
- * @brief Get the index of the right fork for a philosopher
+ * @brief Get the deadlock detector (its counters describe the last run)
+ * @return The detector
+ */
+const DeadlockDetector& DiningPhilosophers::getDeadlockDetector() const {
+    return deadlock;
+}
+
+/**
+ * @brief Set the number of pool workers that run the philosophers
  * 
- * Fork arrangement: Philosopher i has fork (i+1) % 5 on their right
- * The modulo ensures philosopher 4's right fork is fork 0 (circular table)
+ * With fewer workers than philosophers, philosophers take turns on the
+ * workers one think-eat cycle at a time.
  * 
- * @param id Philosopher ID (0-4)
- * @return Index of the right fork
+ * @param count Worker count (0 = ThreadPool::defaultThreadCount())
  */
-int DiningPhilosophers::rightFork(int id) {
-    return (id + 1) % NUM_PHILOSOPHERS;
+void DiningPhilosophers::setWorkerCount(unsigned int count) {
+    workerCount = count;
+}
+
+/**
+ * @brief Select the fork acquisition protocol
+ * @param newStrategy Strategy used by the next simulate() call
+ */
+void DiningPhilosophers::setStrategy(DiningStrategy newStrategy) {
+    strategy = newStrategy;
+}
+
+/**
+ * @brief Get the fork acquisition protocol
+ * @return Current strategy
+ */
+DiningStrategy DiningPhilosophers::getStrategy() const {
+    return strategy;
+}
+
+/**
+ * @brief Make a share of the meals reads, which hold their forks shared
+ * @param ratio Probability in [0, 1] (clamped)
+ */
+void DiningPhilosophers::setReadRatio(double ratio) {
+    readRatio = (ratio > 0.0) ? ((ratio < 1.0) ? ratio : 1.0) : 0.0;
+}
+
+/**
+ * @brief Get the probability that a meal is a read
+ * @return Read ratio in [0, 1]
+ */
+double DiningPhilosophers::getReadRatio() const {
+    return readRatio;
+}
+
+/**
+ * @brief Check whether the read ratio applies to the current strategy
+ * 
+ * Monitor and Chandy-Misra hand out logical forks under tableMutex and have
+ * no shared mode, so every meal of theirs writes. The deadlock detector
+ * records a single holder per fork and would miss cycles through a fork
+ * held by several readers, so detection keeps every meal exclusive too.
+ * 
+ * @return true if meals may be reads
+ */
+bool DiningPhilosophers::readsShared() const {
+    return readRatio > 0.0 && !deadlock.enabled()
+        && runStrategy != DiningStrategy::Monitor && runStrategy != DiningStrategy::ChandyMisra;
+}
+
+/**
+ * @brief Run for a fixed wall-clock time instead of a fixed number of cycles
+ * @param seconds Run length in seconds (0 = use the iterations count)
+ */
+void DiningPhilosophers::setRunDuration(double seconds) {
+    runDuration = (seconds > 0.0) ? seconds : 0.0;
+}
+
+/**
+ * @brief Set the think and eat durations
+ * @param minThink Shortest think time (default 1 s)
+ * @param maxThink Longest think time (default 3 s, raised to minThink if smaller)
+ * @param eat Eat time (default 2 s)
+ */
+void DiningPhilosophers::setTiming(std::chrono::microseconds minThink, std::chrono::microseconds maxThink,
+                                   std::chrono::microseconds eat) {
+    thinkTime = DurationDistribution::uniform(minThink, maxThink);
+    eatTime = DurationDistribution::constant(eat);
+}
+
+/**
+ * @brief Set the think time distribution
+ * @param distribution Think time of every cycle (default uniform:1s:3s)
+ */
+void DiningPhilosophers::setThinkDistribution(const DurationDistribution& distribution) {
+    thinkTime = distribution;
+}
+
+/**
+ * @brief Set the eat time distribution
+ * @param distribution Eat time of every meal (default constant:2s)
+ */
+void DiningPhilosophers::setEatDistribution(const DurationDistribution& distribution) {
+    eatTime = distribution;
+}
+
+/**
+ * @brief Get the think time distribution
+ * @return Current distribution
+ */
+const DurationDistribution& DiningPhilosophers::getThinkDistribution() const {
+    return thinkTime;
+}
+
+/**
+ * @brief Get the eat time distribution
+ * @return Current distribution
+ */
+const DurationDistribution& DiningPhilosophers::getEatDistribution() const {
+    return eatTime;
+}
+
+/**
+ * @brief Select the fork lock implementation
+ * @param type Lock type used by the next simulate() call (default std::mutex)
+ */
+void DiningPhilosophers::setForkLockType(ForkLockType type) {
+    forkLockType = type;
+}
+
+/**
+ * @brief Get the fork lock implementation
+ * @return Current lock type
+ */
+ForkLockType DiningPhilosophers::getForkLockType() const {
+    return forkLockType;
+}
+
+/**
+ * @brief Turn the philosopher log messages on or off
+ * @param enabled false suppresses every message (e.g., for benchmarking)
+ */
+void DiningPhilosophers::setLoggingEnabled(bool enabled) {
+    loggingEnabled = enabled;
+}
+
+/**
+ * @brief Use a fixed seed for the think-time generators
+ * @param newSeed Seed for all following simulate() calls
+ */
+void DiningPhilosophers::setSeed(std::uint64_t newSeed) {
+    seed = newSeed;
+    seedFixed = true;
+}
+
+/**
+ * @brief Get the seed of the last simulate() call
+ * @return Seed (pass it to setSeed() to repeat the run's think times)
+ */
+std::uint64_t DiningPhilosophers::getSeed() const {
+    return seed;
+}
+
+/**
+ * @brief Write contention metrics as JSON at the end of every simulate() call
+ * @param path Output file ("" disables the dump)
+ */
+void DiningPhilosophers::setMetricsPath(const std::string& path) {
+    metricsPath = path;
+}
+
+/**
+ * @brief Write a Chrome trace-event timeline at the end of every simulate() call
+ * @param path Output file ("" disables tracing)
+ */
+void DiningPhilosophers::setTracePath(const std::string& path) {
+    tracePath = path;
+}
+
+/**
+ * @brief Publish meals and fork contention to a live metrics exporter
+ * @param metrics Exporter (null = none)
+ */
+void DiningPhilosophers::setLiveMetrics(LiveMetrics* metrics) {
+    liveMetrics = metrics;
+}
+
+/**
+ * @brief Set the file a run interrupted by checkpointRequest() is saved to
+ * @param path Checkpoint file ("" = none)
+ */
+void DiningPhilosophers::setCheckpoint(const std::string& path) {
+    checkpointPath = path;
+    stopRequest = path.empty() ? nullptr : &checkpointRequest();
+}
+
+/**
+ * @brief Check a philosopher checkpoint against the table and keep it for the next run
+ * @param checkpoint State read by readCheckpoint()
+ * @return false if the checkpoint was taken on another table or holds a fork
+ *         owner or wait histogram bucket this table cannot have
+ */
+bool DiningPhilosophers::setResumePoint(const PhilosopherCheckpoint& checkpoint) {
+    if (checkpoint.philosophers.size() != static_cast<std::size_t>(numPhilosophers) ||
+        checkpoint.forks.size() != static_cast<std::size_t>(numForks) ||
+        checkpoint.graphFingerprint != graphFingerprint(graph)) {
+        std::cerr << "Error: The checkpoint was taken on a different table (" << checkpoint.philosophers.size()
+                  << " philosophers and " << checkpoint.forks.size() << " forks; this table: "
+                  << graph.describe() << ")" << std::endl;
+        return false;
+    }
+    // Reject corrupt state that would index out of range or stall Chandy-Misra
+    for (int f = 0; f < numForks; f++) {
+        int owner = checkpoint.forks[f].owner;
+        const int* users = graph.usersOf(f);
+        std::size_t count = graph.userCount(f);
+        bool known = (count == 0) ? (owner == -1) : (std::find(users, users + count, owner) != users + count);
+        if (!known) {
+            std::cerr << "Error: The checkpoint is corrupt (fork " << f << " is held by " << owner
+                      << ", which does not use it)" << std::endl;
+            return false;
+        }
+    }
+    for (int i = 0; i < numPhilosophers; i++) {
+        if (!LatencyHistogram::validBuckets(checkpoint.philosophers[i].waitBuckets)) {
+            std::cerr << "Error: The checkpoint is corrupt (wait histogram of philosopher " << i
+                      << " is out of range)" << std::endl;
+            return false;
+        }
+    }
+    strategy = checkpoint.strategy;
+    iterations = checkpoint.iterations;
+    runDuration = checkpoint.runDuration;
+    readRatio = checkpoint.readRatio;
+    setSeed(checkpoint.seed);
+    resumeState.reset(new PhilosopherCheckpoint(checkpoint));
+    return true;
+}
+
+bool DiningPhilosophers::wasInterrupted() const {
+    return interrupted;
+}
+
+/**
+ * @brief Save the stopped run (every philosopher is between two cycles)
+ * @return true if the file was written
+ */
+bool DiningPhilosophers::saveCheckpoint() const {
+    PhilosopherCheckpoint checkpoint;
+    checkpoint.strategy = strategy;
+    checkpoint.iterations = iterations;
+    checkpoint.runDuration = runDuration;
+    checkpoint.readRatio = readRatio;
+    checkpoint.elapsed = elapsed;
+    checkpoint.seed = seed;
+    checkpoint.graphFingerprint = graphFingerprint(graph);
+    checkpoint.philosophers.resize(philosophers.size());
+    for (std::size_t i = 0; i < philosophers.size(); i++) {
+        const PhilosopherState& state = philosophers[i];
+        PhilosopherProgress& saved = checkpoint.philosophers[i];
+        saved.cycles = state.cyclesCompleted;
+        saved.readMeals = state.readMeals;
+        saved.totalWait = state.totalWait;
+        saved.maxWait = state.maxWait;
+        state.rng.saveState(saved.rng);
+        state.waitLatency.nonEmptyBuckets(saved.waitBuckets);
+        saved.waitMin = state.waitLatency.min();
+        saved.waitMax = state.waitLatency.max();
+        saved.waitSum = state.waitLatency.mean() * static_cast<double>(state.waitLatency.count());
+    }
+    checkpoint.forks.resize(forks.size());
+    for (std::size_t f = 0; f < forks.size(); f++) {
+        const Fork& fork = forks[f];
+        ForkProgress& saved = checkpoint.forks[f];
+        saved.owner = fork.owner;
+        saved.dirty = fork.dirty;
+        saved.acquisitions = fork.acquisitions;
+        saved.contended = fork.contended;
+        saved.totalWaitNs = fork.totalWaitNs;
+        saved.maxWaitNs = fork.maxWaitNs;
+        saved.shared = fork.shared;
+    }
+    return writeCheckpoint(checkpointPath, checkpoint);
+}
+
+/**
+ * @brief Bind the pool workers to CPUs and place state on their NUMA nodes
+ * @param cpuPinning Placement policy
+ */
+void DiningPhilosophers::setPinning(const CpuPinning& cpuPinning) {
+    pinning = cpuPinning;
+}
+
+/**
+ * @brief Check whether a philosopher has another cycle to run
+ * @param id Philosopher ID
+ * @return true while cycles remain (or the run duration has not passed)
+ */
+bool DiningPhilosophers::hasNextCycle(int id) const {
+    if (checkpointStop()) {
+        return false;
+    }
+    if (runDuration > 0.0) {
+        return std::chrono::steady_clock::now() < deadline;
+    }
+    return philosophers[id].cyclesCompleted < iterations;
+}
+
+/**
+ * @brief Append "fork F" or "forks A, B and C" to a log line
+ * 
+ * On the ring this reads "forks L and R" (left fork first). Sets of more
+ * than LOGGED_FORKS forks name the first few and count the rest, as in
+ * "forks 0, 1, 2 and 37 more".
+ * 
+ * @param line Line being built
+ * @param ids Fork indexes
+ * @param count Number of forks
+ */
+void DiningPhilosophers::appendForkList(LogLine& line, const int* ids, std::size_t count) {
+    line << ((count == 1) ? "fork " : "forks ");
+    std::size_t named = (count > LOGGED_FORKS) ? LOGGED_FORKS - 1 : count;
+    for (std::size_t k = 0; k < named; k++) {
+        if (k > 0) {
+            line << ((k + 1 == count) ? " and " : ", ");
+        }
+        line << ids[k];
+    }
+    if (named < count) {
+        line << " and " << static_cast<long long>(count - named) << " more";
+    }
 }
 
 /**
@@ -86,65 +658,93 @@ int DiningPhilosophers::rightFork(int id) {
  * Calculates the time elapsed since the DiningPhilosophers was created.
  * Used for timestamp logging to show the sequence of events.
  * 
+ * Full steady_clock resolution; the number of decimals follows the
+ * Logger's timestamp precision (3 by default).
+ * 
  * @return Formatted timestamp string in seconds (e.g., "1.234")
  */
 std::string DiningPhilosophers::getTimestamp() {
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime);
-    
-    double seconds = elapsed.count() / 1000.0;
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - startTime);
     
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(3) << seconds;
-    return oss.str();
+    char text[32];
+    int length = Logger::formatSeconds(text, sizeof(text), elapsed, Logger::instance().getTimestampPrecision());
+    return std::string(text, static_cast<std::size_t>(length));
 }
 
 /**
  * @brief Thread-safe logging with timestamp
  * 
- * CRITICAL SECTION: This method acquires coutMutex before writing to console.
- * This prevents interleaved output when multiple philosopher threads log simultaneously.
- * 
- * Uses std::lock_guard for RAII-style automatic mutex unlocking when the
- * function exits (even if an exception is thrown).
+ * Lock-free: the message is copied into the calling thread's Logger ring
+ * together with the raw capture time. Timestamp formatting and console I/O
+ * happen on the Logger's drain thread, so a philosopher holding forks never
+ * waits for the console.
  * 
  * @param message The message to log to console
  */
 void DiningPhilosophers::log(const std::string& message) {
-    // CRITICAL SECTION BEGIN - acquire lock for thread-safe console output
-    std::lock_guard<std::mutex> lock(coutMutex);
-    std::cout << "[" << getTimestamp() << "s] " << message << std::endl;
-    // CRITICAL SECTION END - lock automatically released when lock_guard goes out of scope
+    if (!loggingEnabled) {
+        return;
+    }
+    Logger::instance().log(startTime, message);
+}
+
+/**
+ * @brief Check whether messages of a level are logged by this simulator
+ * 
+ * Levels above SIM_LOG_LEVEL are constant-false here, so the guarded
+ * message formatting is compiled out of every call site.
+ * 
+ * @param level Level of the message
+ * @return true if the level is compiled in and enabled and logging is on
+ */
+bool DiningPhilosophers::logging(LogLevel level) const {
+    return SIM_LOG_ON(level) && loggingEnabled;
+}
+
+/**
+ * @brief Log a message built in a fixed buffer
+ * 
+ * Same as log(const std::string&), without the std::string.
+ * 
+ * @param line The message to log
+ */
+void DiningPhilosophers::log(const LogLine& line) {
+    if (!loggingEnabled) {
+        return;
+    }
+    Logger::instance().log(startTime, line.data(), line.size());
 }
 
 /**
  * @brief Philosopher thinks for a random duration
  * 
- * Simulates the philosopher thinking by sleeping for a random duration
- * between 1 and 3 seconds. This represents the philosopher not needing
- * any resources (forks) during this time.
+ * Simulates the philosopher thinking by waiting for a duration drawn from
+ * thinkTime (uniform 1-3 seconds by default) with the philosopher's own
+ * generator. This represents the philosopher not needing any resources
+ * (forks) during this time.
  * 
- * @param id Philosopher ID (0-4)
+ * @param id Philosopher ID (0 to N-1)
  */
 void DiningPhilosophers::think(int id) {
-    std::stringstream ss;
-    ss << "PHIL " << id << " | Thinking...";
-    log(ss.str());
-    
-    // Random sleep duration between 1 and 3 seconds
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(1, 3);
-    int thinkTime = dis(gen);
+    if (logging(LogLevel::Events)) {
+        LogLine line;
+        line << "PHIL " << id << " | Thinking...";
+        log(line);
+    }
     
-    std::this_thread::sleep_for(std::chrono::seconds(thinkTime));
+    // Random duration from the think distribution (uniform 1-3 seconds by default)
+    if (thinkTime.isZero()) {
+        return;
+    }
+    pauseFor(thinkTime.sample(philosophers[id].rng));
 }
 
 /**
- * @brief Philosopher picks up both forks using ordered resource acquisition
+ * @brief Philosopher picks up both forks using the selected strategy
  * 
- * DEADLOCK PREVENTION STRATEGY: ORDERED RESOURCE ACQUISITION
- * ===========================================================
+ * DEADLOCK PREVENTION STRATEGY (default): ORDERED RESOURCE ACQUISITION
+ * =====================================================================
  * This is the CRITICAL method that prevents deadlock. The key insight is:
  * 
  * 1. Identify which fork has the lower number and which has the higher number
@@ -163,83 +763,465 @@ void DiningPhilosophers::think(int id) {
  * - Both want fork 4, but Philosopher 0 must get fork 0 first, and Philosopher 4
  *   must get fork 3 first. This ordering prevents circular wait.
  * 
+ * The other strategies avoid deadlock differently:
+ * - Waiter: with at most N-1 philosophers reaching for forks, one of them can
+ *   always get both, so on the round table forks may be taken left-then-right.
+ *   On a loaded resource graph seats alone do not break every cycle, so the
+ *   seated philosophers lock their forks in ascending order
+ * - Chandy-Misra: clean forks are never given away, dirty ones always are, which
+ *   keeps the precedence graph acyclic and lets the longest-waiting neighbour eat
+ * - TryLock: std::lock() never holds one fork while blocking on the other
+ * - Monitor: both forks are taken atomically under tableMutex, only when neither
+ *   neighbour is eating
+ * - Naive does not avoid deadlock: every philosopher may hold its left fork
+ *   while waiting for its right one. Run it with deadlock detection.
+ * 
  * CRITICAL SECTION: Acquires two fork mutexes (shared resources)
  * 
- * @param id Philosopher ID (0-4)
+ * @param id Philosopher ID (0 to N-1)
  */
 void DiningPhilosophers::pickupForks(int id) {
-    int left = leftFork(id);
-    int right = rightFork(id);
+    const int* listed = graph.listedNeedsOf(id);
+    const int* sorted = graph.sortedNeedsOf(id);
+    std::size_t count = graph.needCount(id);
+    ForkAccess access = philosophers[id].access;
+    
+    if (logging(LogLevel::Trace)) {
+        LogLine line;
+        line << "PHIL " << id << " | Waiting for ";
+        appendForkList(line, listed, count);
+        if (access == ForkAccess::Shared) {
+            line << " (shared)";
+        }
+        log(line);
+    }
     
-    // DEADLOCK PREVENTION: Ordered resource acquisition
-    // Always pick up lower-numbered fork first, then higher-numbered fork
-    int firstFork = (left < right) ? left : right;
-    int secondFork = (left < right) ? right : left;
+    switch (runStrategy) {
+        case DiningStrategy::Waiter: {
+            // Ask the waiter for a seat (counting semaphore, N-1 seats)
+            {
+                std::unique_lock<std::mutex> lock(waiterMutex);
+                seatFreed.wait(lock, [this] { return seatsAvailable > 0; });
+                seatsAvailable--;
+            }
+            
+            // CRITICAL SECTION BEGIN - left then right; safe with at most N-1 seated
+            // (on a general graph seats alone do not break every cycle, so ascending)
+            lockForksInOrder(id, graph.isRing() ? listed : sorted, count);
+            break;
+        }
+        
+        case DiningStrategy::Naive:
+            // CRITICAL SECTION BEGIN - listed order, no prevention (deadlock-prone)
+            lockForksInOrder(id, listed, count);
+            break;
+        
+        case DiningStrategy::TryLock: {
+            // CRITICAL SECTION BEGIN - lock all or none, backing off on contention
+            bool contended = !forkLocks->tryLockAll(sorted, count, access);
+            std::uint64_t waitNs = 0;
+            if (contended) {
+                auto waitStart = std::chrono::steady_clock::now();
+                forkLocks->lockAll(sorted, count, access);
+                waitNs = nanosecondsSince(waitStart);
+            }
+            for (std::size_t k = 0; k < count; k++) {
+                recordForkAcquisition(listed[k], id, contended, waitNs);
+                if (detecting) {
+                    // Never holds a fork while blocking, so it only ever appears as a holder
+                    deadlock.acquired(id, listed[k]);
+                }
+            }
+            break;
+        }
+        
+        case DiningStrategy::Monitor: {
+            // CRITICAL SECTION BEGIN - become hungry and wait until allowed to eat
+            std::unique_lock<std::mutex> lock(tableMutex);
+            PhilosopherState& state = philosophers[id];
+            state.phase = HUNGRY;
+            testMonitor(id);
+            bool contended = (state.phase != EATING);
+            std::uint64_t waitNs = 0;
+            if (contended) {
+                auto waitStart = std::chrono::steady_clock::now();
+                state.turn.wait(lock, [&state] { return state.phase == EATING; });
+                waitNs = nanosecondsSince(waitStart);
+            }
+            for (std::size_t k = 0; k < count; k++) {
+                recordForkAcquisition(listed[k], id, contended, waitNs);
+            }
+            break;
+        }
+        
+        case DiningStrategy::ChandyMisra: {
+            // CRITICAL SECTION BEGIN - collect dirty forks until holding all of them
+            std::unique_lock<std::mutex> lock(tableMutex);
+            PhilosopherState& state = philosophers[id];
+            state.phase = HUNGRY;
+            bool contended = !claimForks(id);
+            std::uint64_t waitNs = 0;
+            if (contended) {
+                auto waitStart = std::chrono::steady_clock::now();
+                state.turn.wait(lock, [this, id] { return claimForks(id); });
+                waitNs = nanosecondsSince(waitStart);
+            }
+            state.phase = EATING;
+            for (std::size_t k = 0; k < count; k++) {
+                recordForkAcquisition(listed[k], id, contended, waitNs);
+            }
+            break;
+        }
+        
+        case DiningStrategy::Ordered:
+        default: {
+            // DEADLOCK PREVENTION: Ordered resource acquisition
+            // Always pick up lower-numbered forks first, in ascending order
+            // CRITICAL SECTION BEGIN / CONTINUE - acquire the next fork in order
+            lockForksInOrder(id, sorted, count);
+            // All forks now held - philosopher can eat
+            break;
+        }
+    }
     
-    std::stringstream ss;
-    ss << "PHIL " << id << " | Waiting for forks " << left << " and " << right;
-    log(ss.str());
+    if (logging(LogLevel::Events)) {
+        LogLine line;
+        line << "PHIL " << id << " | Acquired ";
+        appendForkList(line, listed, count);
+        log(line);
+    }
+}
+
+/**
+ * @brief Lock a philosopher's forks one at a time in the given order
+ * 
+ * If the deadlock detector preempts the philosopher while it waits, the
+ * forks it already holds are put down, it backs off for a random time of up
+ * to PREEMPT_BACKOFF (so the philosopher it blocked can take them) and it
+ * starts over from the first fork.
+ * 
+ * CRITICAL SECTION BEGIN: Acquires every fork mutex of the philosopher
+ * 
+ * @param id Philosopher ID
+ * @param order Fork indexes in acquisition order
+ * @param count Number of forks
+ */
+void DiningPhilosophers::lockForksInOrder(int id, const int* order, std::size_t count) {
+    std::size_t k = 0;
+    while (k < count) {
+        if (lockFork(order[k], id)) {
+            if (logging(LogLevel::Trace)) {
+                LogLine line;
+                line << "PHIL " << id << " | Acquired fork " << order[k];
+                log(line);
+            }
+            k++;
+            continue;
+        }
+        
+        // Preempted: the watchdog picked this philosopher to break a cycle
+        for (std::size_t held = 0; held < k; held++) {
+            recordForkRelease(order[held], id);
+            deadlock.released(order[held]);
+            forkLocks->release(order[held], philosophers[id].access);
+        }
+        if (logging(LogLevel::Events)) {
+            LogLine line;
+            line << "PHIL " << id << " | Preempted to break a deadlock: put down ";
+            appendForkList(line, order, k);
+            line << ", retrying";
+            log(line);
+        }
+        PhilosopherState& state = philosophers[id];
+        pauseFor(std::chrono::nanoseconds(state.rng.uniform(0, PREEMPT_BACKOFF.count())));
+        k = 0;
+    }
+}
+
+/**
+ * @brief Lock one fork mutex, updating its contention counters
+ * 
+ * The uncontended path is a single try-acquire in the mode of the
+ * philosopher's current meal; the clock is read only when the fork is
+ * already taken. With deadlock detection the wait is entered in
+ * the wait-for graph, and with DeadlockAction::Preempt the fork is polled
+ * every PREEMPT_POLL so that a preemption request can end the wait.
+ * 
+ * CRITICAL SECTION BEGIN: Acquires the fork mutex
+ * 
+ * @param f Fork index
+ * @param id Philosopher picking it up
+ * @return true once the fork is held, false if the philosopher was preempted instead
+ */
+bool DiningPhilosophers::lockFork(int f, int id) {
+    ForkAccess access = philosophers[id].access;
+    if (forkLocks->tryAcquire(f, access)) {
+        recordForkAcquisition(f, id, false, 0);
+        if (detecting) {
+            deadlock.acquired(id, f);
+        }
+        return true;
+    }
     
-    // CRITICAL SECTION BEGIN - acquire first fork (lower-numbered)
-    forks[firstFork].lock();
-    ss.str("");
-    ss << "PHIL " << id << " | Acquired fork " << firstFork;
-    log(ss.str());
+    auto waitStart = std::chrono::steady_clock::now();
+    if (!detecting) {
+        forkLocks->acquire(f, access);
+        recordForkAcquisition(f, id, true, nanosecondsSince(waitStart));
+        return true;
+    }
     
-    // CRITICAL SECTION CONTINUE - acquire second fork (higher-numbered)
-    forks[secondFork].lock();
-    ss.str("");
-    ss << "PHIL " << id << " | Acquired fork " << secondFork;
-    log(ss.str());
-    // Both forks now held - philosopher can eat
+    deadlock.waiting(id, f);
+    if (deadlock.getAction() != DeadlockAction::Preempt) {
+        forkLocks->acquire(f, access);
+    } else {
+        while (!forkLocks->tryAcquire(f, access)) {
+            if (deadlock.preempted(id)) {
+                deadlock.gaveUp(id);
+                return false;
+            }
+            std::this_thread::sleep_for(PREEMPT_POLL);
+        }
+    }
+    deadlock.acquired(id, f);
+    recordForkAcquisition(f, id, true, nanosecondsSince(waitStart));
+    return true;
+}
+
+/**
+ * @brief Count a pick-up of a fork the caller now holds
+ * 
+ * Only the fork's holder calls this, so the counters need no synchronization
+ * of their own. Readers may hold a fork together, so a read meal updates
+ * the counters with atomic adds instead.
+ * 
+ * When tracing, a contended pick-up of a fork last put down by another
+ * philosopher becomes a flow arrow from that release to this acquisition.
+ * 
+ * @param f Fork index
+ * @param id Philosopher that picked it up
+ * @param contended true if the caller had to wait for the fork
+ * @param waitNs Time the caller waited for it in nanoseconds
+ */
+void DiningPhilosophers::recordForkAcquisition(int f, int id, bool contended, std::uint64_t waitNs) {
+    Fork& fork = forks[f];
+    if (philosophers[id].access == ForkAccess::Shared) {
+        fork.acquisitions.add(1);
+        fork.shared.add(1);
+        if (contended) {
+            fork.contended.add(1);
+            fork.totalWaitNs.add(waitNs);
+            fork.maxWaitNs.raiseTo(waitNs);
+        }
+    } else {
+        fork.acquisitions++;
+        if (contended) {
+            fork.contended++;
+            fork.totalWaitNs += waitNs;
+            if (waitNs > fork.maxWaitNs) {
+                fork.maxWaitNs = waitNs;
+            }
+        }
+    }
+    if (contended) {
+        if (timeline && fork.releasedBy >= 0 && fork.releasedBy != id) {
+            timeline->addFlow(static_cast<std::size_t>(fork.releasedBy), fork.releasedNs,
+                              static_cast<std::size_t>(id), timelineNow(), f);
+        }
+    }
 }
 
 /**
- * @brief Philosopher eats for a fixed duration
+ * @brief Timeline: note who puts a fork down and when
+ * 
+ * Called before the fork is released (or under tableMutex), so the next
+ * holder sees these fields through the same lock hand-over. Readers that
+ * put a shared fork down together race to be the last one named, which is
+ * why the fields are relaxed atomics.
  * 
- * Simulates the philosopher eating by sleeping for 2 seconds.
+ * @param f Fork index
+ * @param id Philosopher putting it down
+ */
+void DiningPhilosophers::recordForkRelease(int f, int id) {
+    if (timeline) {
+        forks[f].releasedBy = id;
+        forks[f].releasedNs = timelineNow();
+    }
+}
+
+/**
+ * @brief Timeline clock: nanoseconds since startTime
+ * @return Current time on the timeline
+ */
+std::int64_t DiningPhilosophers::timelineNow() const {
+    return static_cast<std::int64_t>(nanosecondsSince(startTime));
+}
+
+/**
+ * @brief Monitor strategy: let a hungry philosopher eat if no philosopher sharing a fork eats
+ * 
+ * This is Tanenbaum's test(i), with "neighbour" generalized to every other
+ * user of the philosopher's forks (on the ring: the left and right
+ * neighbours). Caller must hold tableMutex.
+ * 
+ * @param id Philosopher ID
+ */
+void DiningPhilosophers::testMonitor(int id) {
+    PhilosopherState& state = philosophers[id];
+    if (state.phase != HUNGRY) {
+        return;
+    }
+    
+    const int* needs = graph.listedNeedsOf(id);
+    for (std::size_t k = 0; k < graph.needCount(id); k++) {
+        const int* users = graph.usersOf(needs[k]);
+        for (std::size_t u = 0; u < graph.userCount(needs[k]); u++) {
+            if (users[u] != id && philosophers[users[u]].phase == EATING) {
+                return;
+            }
+        }
+    }
+    state.phase = EATING;
+    state.turn.notify_one();
+}
+
+/**
+ * @brief Chandy-Misra: take every dirty fork a neighbour is not eating with
+ * 
+ * A dirty fork held by a philosopher who is not eating must be surrendered on
+ * request; taking it over cleans it. A clean fork stays with its (hungry)
+ * holder until that holder has eaten. Caller must hold tableMutex.
+ * 
+ * @param id Hungry philosopher ID
+ * @return true once the philosopher owns all its forks
+ */
+bool DiningPhilosophers::claimForks(int id) {
+    const int* wanted = graph.listedNeedsOf(id);
+    bool ownsAll = true;
+    
+    for (std::size_t k = 0; k < graph.needCount(id); k++) {
+        Fork& fork = forks[wanted[k]];
+        if (fork.owner != id && fork.dirty && philosophers[fork.owner].phase != EATING) {
+            fork.owner = id;
+            fork.dirty = false;
+        }
+        ownsAll = ownsAll && (fork.owner == id);
+    }
+    return ownsAll;
+}
+
+/**
+ * @brief Philosopher eats for a duration drawn from eatTime
+ * 
+ * Simulates the philosopher eating by waiting for a draw from eatTime
+ * (constant 2 seconds by default).
  * During this time, the philosopher holds both forks (mutexes are locked).
  * 
- * @param id Philosopher ID (0-4)
+ * @param id Philosopher ID (0 to N-1)
  */
 void DiningPhilosophers::eat(int id) {
-    std::stringstream ss;
-    ss << "PHIL " << id << " | Eating...";
-    log(ss.str());
+    if (logging(LogLevel::Events)) {
+        LogLine line;
+        line << "PHIL " << id << " | Eating...";
+        log(line);
+    }
     
-    // Eat for 2 seconds (holding both forks)
-    std::this_thread::sleep_for(std::chrono::seconds(2));
+    // Eat for a duration from the eat distribution (2 seconds by default) while holding both forks
+    if (!eatTime.isZero()) {
+        pauseFor(eatTime.sample(philosophers[id].rng));
+    }
 }
 
 /**
- * @brief Philosopher puts down both forks
+ * @brief Philosopher puts down all its forks
  * 
- * Releases both fork mutexes, making them available for other philosophers.
+ * Releases every fork mutex, making them available for other philosophers.
  * The order of release doesn't matter for correctness (unlike acquisition).
+ * Monitor and Chandy-Misra instead update the shared state and wake the
+ * other users of the forks (the neighbours, on the ring); Waiter also
+ * returns the philosopher's seat.
  * 
- * CRITICAL SECTION END: Releases two fork mutexes (shared resources)
+ * CRITICAL SECTION END: Releases the fork mutexes (shared resources)
  * 
- * @param id Philosopher ID (0-4)
+ * @param id Philosopher ID (0 to N-1)
  */
 void DiningPhilosophers::putdownForks(int id) {
-    int left = leftFork(id);
-    int right = rightFork(id);
+    const int* listed = graph.listedNeedsOf(id);
+    std::size_t count = graph.needCount(id);
     
-    // CRITICAL SECTION END - release both forks
-    // Order of release doesn't matter (unlike acquisition order)
-    forks[left].unlock();
-    forks[right].unlock();
+    switch (runStrategy) {
+        case DiningStrategy::Monitor: {
+            // CRITICAL SECTION END - stop eating and let waiting neighbours in
+            std::lock_guard<std::mutex> lock(tableMutex);
+            for (std::size_t k = 0; k < count; k++) {
+                recordForkRelease(listed[k], id);
+            }
+            philosophers[id].phase = THINKING;
+            for (std::size_t k = 0; k < count; k++) {
+                const int* users = graph.usersOf(listed[k]);
+                for (std::size_t u = 0; u < graph.userCount(listed[k]); u++) {
+                    if (users[u] != id) {
+                        testMonitor(users[u]);
+                    }
+                }
+            }
+            break;
+        }
+        
+        case DiningStrategy::ChandyMisra: {
+            // CRITICAL SECTION END - forks become dirty and stay here until requested
+            std::lock_guard<std::mutex> lock(tableMutex);
+            for (std::size_t k = 0; k < count; k++) {
+                recordForkRelease(listed[k], id);
+                forks[listed[k]].dirty = true;
+            }
+            philosophers[id].phase = THINKING;
+            for (std::size_t k = 0; k < count; k++) {
+                const int* users = graph.usersOf(listed[k]);
+                for (std::size_t u = 0; u < graph.userCount(listed[k]); u++) {
+                    if (users[u] != id) {
+                        philosophers[users[u]].turn.notify_one();
+                    }
+                }
+            }
+            break;
+        }
+        
+        default:
+            // CRITICAL SECTION END - release every fork
+            // Order of release doesn't matter (unlike acquisition order)
+            for (std::size_t k = 0; k < count; k++) {
+                recordForkRelease(listed[k], id);
+                if (detecting) {
+                    // Before the unlock, so the next holder's entry is never overwritten
+                    deadlock.released(listed[k]);
+                }
+                forkLocks->release(listed[k], philosophers[id].access);
+            }
+            
+            if (runStrategy == DiningStrategy::Waiter) {
+                // Give the seat back to the waiter
+                std::lock_guard<std::mutex> lock(waiterMutex);
+                seatsAvailable++;
+                seatFreed.notify_one();
+            }
+            break;
+    }
     
-    std::stringstream ss;
-    ss << "PHIL " << id << " | Released forks " << left << " and " << right;
-    log(ss.str());
+    if (logging(LogLevel::Events)) {
+        LogLine line;
+        line << "PHIL " << id << " | Released ";
+        appendForkList(line, listed, count);
+        log(line);
+    }
 }
 
 /**
- * @brief Worker function executed by each philosopher thread
+ * @brief Pool task that runs one think-eat cycle of a philosopher
  * 
- * This static function is the entry point for each philosopher thread.
- * It performs multiple think-eat cycles based on the iterations parameter.
+ * Each philosopher is a chain of pool tasks, one per think-eat cycle. When a
+ * cycle finishes, the task queues the philosopher's next cycle at the back of
+ * the pool's FIFO queue, so philosophers take turns on the workers. Forks are
+ * never held across tasks, which keeps multiplexing deadlock-free.
  * 
  * Each cycle consists of:
  * 1. Think (random duration, no resources needed)
@@ -247,54 +1229,676 @@ void DiningPhilosophers::putdownForks(int id) {
  * 3. Eat (fixed duration, holding both forks)
  * 4. Put down forks (release both mutexes)
  * 
- * Thread Safety: All methods called use thread-safe logging
+ * Thread Safety: All methods called use thread-safe logging. A philosopher's
+ * state is only touched by the single task that is currently running it.
  * 
- * @param id Philosopher ID (0-4)
+ * @param id Philosopher ID (0 to N-1)
  * @param sim Pointer to DiningPhilosophers instance
  */
 void DiningPhilosophers::philosopherWorker(int id, DiningPhilosophers* sim) {
-    // Loop for multiple think-eat cycles based on iterations
-    for (int i = 0; i < sim->iterations; i++) {
-        std::stringstream ss;
-        ss << "PHIL " << id << " | Starting cycle " << (i + 1) << " of " << sim->iterations;
-        sim->log(ss.str());
+    PhilosopherState& state = sim->philosophers[id];
+    
+    if (sim->hasNextCycle(id)) {
+        if (sim->logging(LogLevel::Events)) {
+            LogLine line;
+            line << "PHIL " << id << " | Starting cycle " << (state.cyclesCompleted + 1);
+            if (sim->runDuration <= 0.0) {
+                line << " of " << sim->iterations;
+            }
+            sim->log(line);
+        }
         
         // Execute one think-eat cycle
+        std::int64_t thinkStart = sim->timeline ? sim->timelineNow() : 0;
         sim->think(id);           // Think (no resources needed)
-        sim->pickupForks(id);     // Acquire forks (CRITICAL: ordered acquisition prevents deadlock)
+        
+        // A read with probability readRatio (no draw at all when every meal writes)
+        state.access = (sim->readsShared() && state.rng.uniformReal() < sim->readRatio)
+            ? ForkAccess::Shared : ForkAccess::Exclusive;
+        
+        auto hungrySince = std::chrono::steady_clock::now();
+        sim->pickupForks(id);     // Acquire forks (CRITICAL: the strategy prevents deadlock)
+        std::uint64_t waitNs = nanosecondsSince(hungrySince);
+        state.waitLatency.record(waitNs);
+        double waited = waitNs / 1e9;
+        state.totalWait += waited;
+        if (waited > state.maxWait) {
+            state.maxWait = waited;
+        }
+        
         sim->eat(id);             // Eat (holding both forks)
         sim->putdownForks(id);    // Release forks (make available for others)
+        state.cyclesCompleted++;
+        if (state.access == ForkAccess::Shared) {
+            state.readMeals++;
+        }
+        
+        if (sim->timeline) {
+            // think / wait / eat spans of this cycle (eat ends once the forks are down)
+            std::int64_t hungryNs = static_cast<std::int64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(hungrySince - sim->startTime).count());
+            std::int64_t eatingNs = hungryNs + static_cast<std::int64_t>(waitNs);
+            std::size_t track = static_cast<std::size_t>(id);
+            sim->timeline->addSpan(track, "think", thinkStart, hungryNs);
+            sim->timeline->addSpan(track, "wait", hungryNs, eatingNs);
+            sim->timeline->addSpan(track, (state.access == ForkAccess::Shared) ? "read" : "eat",
+                                   eatingNs, sim->timelineNow());
+        }
     }
     
-    std::stringstream ss;
-    ss << "PHIL " << id << " | Completed all " << sim->iterations << " iterations";
-    sim->log(ss.str());
+    if (sim->hasNextCycle(id)) {
+        // Queue the next cycle behind the other philosophers of the home pool
+        sim->pools[state.homePool]->submit([id, sim] { philosopherWorker(id, sim); });
+        return;
+    }
+    
+    if (sim->logging(LogLevel::Summary)) {
+        LogLine line;
+        if (sim->checkpointStop()) {
+            line << "PHIL " << id << " | Stopped for a checkpoint after " << state.cyclesCompleted << " cycles";
+        } else if (sim->runDuration > 0.0) {
+            line << "PHIL " << id << " | Completed " << state.cyclesCompleted << " meals";
+        } else {
+            line << "PHIL " << id << " | Completed all " << sim->iterations << " iterations";
+        }
+        sim->log(line);
+    }
 }
 
 /**
  * @brief Start the dining philosophers simulation
  * 
- * Creates 5 philosopher threads and waits for all to complete.
+ * Runs all philosophers on a worker pool and waits for all to complete.
  * Each philosopher will perform the specified number of think-eat cycles.
  * 
  * Thread Management:
- * 1. Create all philosopher threads and store them in an array
- * 2. Join all threads to wait for completion before returning
+ * 1. Build the fork lock table with the selected ForkLockType
+ * 2. Start workerCount threads (hardware concurrency by default): one pool, or
+ *    with pinning one pool per NUMA node of the planned CPUs
+ * 3. Give each pool a contiguous block of philosophers and move their state
+ *    (and each fork, to its lowest-numbered user's node) to the pool's node
+ * 4. Queue the first cycle of every philosopher; later cycles queue themselves
+ *    on the same pool
+ * 5. Wait for the pools to drain before returning
+ * 6. Write the JSON metrics if a metrics path is set
  * 
  * This ensures all philosophers complete their iterations before the function returns.
  */
 void DiningPhilosophers::simulate() {
-    // Create 5 philosopher threads
-    std::thread philosophers[NUM_PHILOSOPHERS];
+    // An unsupported choice falls back for this run only; strategy keeps the setting
+    runStrategy = strategy;
+    if (!supportsStrategy(strategy)) {
+        std::cerr << "Warning: Chandy-Misra needs every fork shared by at most two philosophers ("
+                  << graph.describe() << "); using ordered resource acquisition" << std::endl;
+        runStrategy = DiningStrategy::Ordered;
+    }
     
-    // Create each philosopher thread
-    for (int i = 0; i < NUM_PHILOSOPHERS; i++) {
-        philosophers[i] = std::thread(philosopherWorker, i, this);
+    for (auto& state : philosophers) {
+        state.cyclesCompleted = 0;
+        state.readMeals = 0;
+        state.access = ForkAccess::Exclusive;
+        state.phase = THINKING;
+        state.totalWait = 0.0;
+        state.maxWait = 0.0;
+        state.waitLatency.reset();
+    }
+    
+    // One generator per philosopher, seeded once per run (no per-draw setup)
+    if (!seedFixed) {
+        std::random_device entropy;
+        seed = (static_cast<std::uint64_t>(entropy()) << 32) ^ entropy();
+    }
+    for (int i = 0; i < numPhilosophers; i++) {
+        philosophers[i].rng.reseed(seed + static_cast<std::uint64_t>(i));
+    }
+    
+    // Chandy-Misra: every fork starts dirty at its lowest-numbered user
+    // (on the ring: the lower-numbered neighbour; -1 for a fork nobody needs)
+    for (int f = 0; f < numForks; f++) {
+        Fork& fork = forks[f];
+        fork.owner = (graph.userCount(f) > 0) ? graph.usersOf(f)[0] : -1;
+        fork.dirty = true;
+        fork.acquisitions = 0;
+        fork.contended = 0;
+        fork.totalWaitNs = 0;
+        fork.maxWaitNs = 0;
+        fork.shared = 0;
+        fork.releasedBy = -1;
+        fork.releasedNs = 0;
+    }
+    seatsAvailable = (numPhilosophers > 1) ? numPhilosophers - 1 : 1;
+    
+    // A resumed run continues each philosopher and fork where the checkpoint left them
+    resumedElapsed = 0.0;
+    interrupted = false;
+    if (resumeState) {
+        for (int i = 0; i < numPhilosophers; i++) {
+            PhilosopherState& state = philosophers[i];
+            const PhilosopherProgress& saved = resumeState->philosophers[i];
+            state.cyclesCompleted = saved.cycles;
+            state.readMeals = saved.readMeals;
+            state.totalWait = saved.totalWait;
+            state.maxWait = saved.maxWait;
+            state.rng.restoreState(saved.rng);
+            // Bucket indexes were checked by setResumePoint()
+            state.waitLatency.restore(saved.waitBuckets, saved.waitMin, saved.waitMax, saved.waitSum);
+        }
+        for (int f = 0; f < numForks; f++) {
+            Fork& fork = forks[f];
+            const ForkProgress& saved = resumeState->forks[f];
+            fork.owner = saved.owner;
+            fork.dirty = saved.dirty;
+            fork.acquisitions = saved.acquisitions;
+            fork.contended = saved.contended;
+            fork.totalWaitNs = saved.totalWaitNs;
+            fork.maxWaitNs = saved.maxWaitNs;
+            fork.shared = saved.shared;
+        }
+        resumedElapsed = resumeState->elapsed;
+        resumeState.reset();
+    }
+    
+    // Timeline tracks are created up front so philosophers never resize them
+    timeline.reset();
+    if (!tracePath.empty()) {
+        timeline.reset(new TimelineTrace("Dining philosophers (" + std::string(diningStrategyName(runStrategy)) + ")", "fork"));
+        timeline->reset(static_cast<std::size_t>(numPhilosophers));
+        for (int i = 0; i < numPhilosophers; i++) {
+            timeline->setTrackName(static_cast<std::size_t>(i), "PHIL " + std::to_string(i));
+        }
+    }
+    forkLocks = createForkTable(forkLockType, numForks);
+    
+    auto runStart = std::chrono::steady_clock::now();
+    deadline = runStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(runDuration - resumedElapsed));
+    
+    unsigned int threads = (workerCount == 0) ? ThreadPool::defaultThreadCount() : workerCount;
+    workerCpus = planCpus(pinning, threads);
+    
+    // Group the planned CPUs by node, one pool per node (a single unpinned pool otherwise)
+    const CpuTopology& topology = CpuTopology::instance();
+    std::vector<std::vector<int> > poolCpus;
+    poolNodes.clear();
+    for (int cpu : workerCpus) {
+        int node = topology.nodeOf(cpu);
+        std::size_t p = 0;
+        while (p < poolNodes.size() && poolNodes[p] != node) {
+            p++;
+        }
+        if (p == poolNodes.size()) {
+            poolNodes.push_back(node);
+            poolCpus.push_back(std::vector<int>());
+        }
+        poolCpus[p].push_back(cpu);
+    }
+    std::vector<std::unique_ptr<ThreadPool> > workers;
+    if (poolCpus.empty()) {
+        poolNodes.push_back(0);
+        workers.push_back(std::unique_ptr<ThreadPool>(new ThreadPool(threads)));
+    } else {
+        for (const auto& cpus : poolCpus) {
+            workers.push_back(std::unique_ptr<ThreadPool>(
+                new ThreadPool(static_cast<unsigned int>(cpus.size()), cpus)));
+        }
+    }
+    pools.clear();
+    for (const auto& worker : workers) {
+        pools.push_back(worker.get());
     }
     
-    // Wait for all philosophers to complete (join all threads)
+    // Contiguous philosopher blocks proportional to each pool's worker count
+    std::vector<int> philosopherNodes(static_cast<std::size_t>(numPhilosophers));
+    std::size_t assignedWorkers = 0;
+    int first = 0;
+    for (std::size_t p = 0; p < pools.size(); p++) {
+        assignedWorkers += pools[p]->size();
+        int last = (p + 1 == pools.size()) ? numPhilosophers
+            : static_cast<int>(static_cast<std::size_t>(numPhilosophers) * assignedWorkers / threads);
+        for (int i = first; i < last; i++) {
+            philosophers[i].homePool = p;
+            philosopherNodes[i] = poolNodes[p];
+        }
+        first = last;
+    }
+    
+    // Each philosopher's state lives on its pool's node, each fork on its lowest-numbered user's
+    placedPages = 0;
+    if (poolNodes.size() > 1) {
+        std::vector<int> forkNodes(static_cast<std::size_t>(numForks), poolNodes[0]);
+        for (int f = 0; f < numForks; f++) {
+            if (graph.userCount(f) > 0) {
+                forkNodes[f] = philosopherNodes[graph.usersOf(f)[0]];
+            }
+        }
+        placedPages += bindToNodes(philosophers.data(), sizeof(PhilosopherState), philosopherNodes);
+        placedPages += bindToNodes(forks.data(), sizeof(Fork), forkNodes);
+        placedPages += forkLocks->placeOnNodes(forkNodes);
+    }
+    
+    // The watchdog runs beside the pools for the whole run
+    detecting = deadlock.enabled() && runStrategy != DiningStrategy::Monitor
+        && runStrategy != DiningStrategy::ChandyMisra;
+    if (detecting) {
+        deadlock.start(numPhilosophers, numForks);
+    }
+    
+    // The counters were reset above; from here on the exporter may read them
+    if (liveMetrics) {
+        liveRunning = true;
+        liveMetrics->addCollector("philosophers", [this](MetricsWriter& out) { collectLiveMetrics(out); });
+    }
+    
+    // Queue the first cycle of each philosopher on its home pool
+    for (int i = 0; i < numPhilosophers; i++) {
+        pools[philosophers[i].homePool]->submit([i, this] { philosopherWorker(i, this); });
+    }
+    
+    // Wait for all philosophers to complete
     // This ensures all philosophers finish before we return
-    for (int i = 0; i < NUM_PHILOSOPHERS; i++) {
-        philosophers[i].join();
+    // (a philosopher only ever re-queues itself on its own pool)
+    for (ThreadPool* worker : pools) {
+        worker->wait();
+    }
+    pools.clear();
+    workers.clear();
+    deadlock.stop();
+    elapsed = resumedElapsed + std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+    if (liveMetrics) {
+        liveRunning = false;
+        liveMetrics->removeCollector("philosophers");
+    }
+    
+    // Make sure all philosopher output is on the console before returning
+    Logger::instance().flush();
+    
+    // Stopped for a checkpoint: the files are written when the resumed run ends
+    if (checkpointStop()) {
+        stopRequest->store(false, std::memory_order_relaxed);
+        if (saveCheckpoint()) {
+            interrupted = true;
+            return;
+        }
+        std::cerr << "Warning: Checkpoint not saved; the statistics cover the cycles run so far" << std::endl;
+    }
+    
+    if (!metricsPath.empty()) {
+        writeMetricsJson(metricsPath);
+    }
+    if (timeline) {
+        timeline->write(tracePath);
+    }
+}
+
+/**
+ * @brief Write meals and fork contention of the current run (exporter thread)
+ * 
+ * Totals cover every philosopher and fork; the labelled per-philosopher and
+ * per-fork series stop after LiveMetrics::MAX_LABELLED_SERIES of each, so a
+ * huge table does not flood the scraper.
+ * 
+ * @param out Metrics writer
+ */
+void DiningPhilosophers::collectLiveMetrics(MetricsWriter& out) const {
+    const int labelled = static_cast<int>(LiveMetrics::MAX_LABELLED_SERIES);
+    std::uint64_t meals = 0;
+    std::uint64_t readMeals = 0;
+    for (const PhilosopherState& state : philosophers) {
+        meals += static_cast<std::uint64_t>(state.cyclesCompleted.load());
+        readMeals += static_cast<std::uint64_t>(state.readMeals.load());
+    }
+    std::uint64_t acquisitions = 0;
+    std::uint64_t contended = 0;
+    std::uint64_t waitNs = 0;
+    for (const Fork& fork : forks) {
+        acquisitions += fork.acquisitions.load();
+        contended += fork.contended.load();
+        waitNs += fork.totalWaitNs.load();
+    }
+    
+    out.family("sim_dining_running", "gauge", "1 while a dining philosophers run is in progress");
+    out.sample("sim_dining_running", liveRunning.load() ? 1.0 : 0.0);
+    out.family("sim_dining_philosophers", "gauge", "Philosophers at the table");
+    out.sample("sim_dining_philosophers", numPhilosophers);
+    out.family("sim_dining_meals_total", "counter", "Meals eaten by all philosophers");
+    out.sample("sim_dining_meals_total", static_cast<double>(meals));
+    out.family("sim_dining_read_meals_total", "counter", "Meals eaten as a read (forks held shared)");
+    out.sample("sim_dining_read_meals_total", static_cast<double>(readMeals));
+    out.family("sim_dining_philosopher_meals_total", "counter", "Meals eaten per philosopher");
+    for (int i = 0; i < numPhilosophers && i < labelled; i++) {
+        out.sample("sim_dining_philosopher_meals_total", "philosopher", i, philosophers[i].cyclesCompleted.load());
+    }
+    
+    out.family("sim_dining_fork_acquisitions_total", "counter", "Fork pick-ups on all forks");
+    out.sample("sim_dining_fork_acquisitions_total", static_cast<double>(acquisitions));
+    out.family("sim_dining_fork_contended_total", "counter", "Fork pick-ups that had to wait, on all forks");
+    out.sample("sim_dining_fork_contended_total", static_cast<double>(contended));
+    out.family("sim_dining_fork_wait_seconds_total", "counter", "Time spent waiting for busy forks");
+    out.sample("sim_dining_fork_wait_seconds_total", waitNs / 1e9);
+    out.family("sim_dining_fork_contention_ratio", "gauge", "Share of fork pick-ups that had to wait");
+    out.sample("sim_dining_fork_contention_ratio",
+               (acquisitions > 0) ? static_cast<double>(contended) / static_cast<double>(acquisitions) : 0.0);
+    out.family("sim_dining_fork_pickups_total", "counter", "Pick-ups per fork");
+    for (int f = 0; f < numForks && f < labelled; f++) {
+        out.sample("sim_dining_fork_pickups_total", "fork", f, static_cast<double>(forks[f].acquisitions.load()));
+    }
+    out.family("sim_dining_fork_waits_total", "counter", "Pick-ups per fork that had to wait");
+    for (int f = 0; f < numForks && f < labelled; f++) {
+        out.sample("sim_dining_fork_waits_total", "fork", f, static_cast<double>(forks[f].contended.load()));
+    }
+}
+
+/**
+ * @brief Get per-philosopher results of the last simulate() call
+ * @return One record per philosopher, ordered by ID
+ */
+std::vector<PhilosopherStats> DiningPhilosophers::getPhilosopherStats() const {
+    std::vector<PhilosopherStats> result;
+    result.reserve(philosophers.size());
+    for (int i = 0; i < numPhilosophers; i++) {
+        const PhilosopherState& state = philosophers[i];
+        PhilosopherStats record = { i, state.cyclesCompleted, state.readMeals, state.totalWait, state.maxWait,
+                                    state.waitLatency.percentile(50.0) / 1e9,
+                                    state.waitLatency.percentile(99.0) / 1e9,
+                                    (elapsed > 0.0) ? state.cyclesCompleted / elapsed : 0.0 };
+        result.push_back(record);
+    }
+    return result;
+}
+
+/**
+ * @brief Get per-fork contention counters of the last simulate() call
+ * @return One record per fork, ordered by index
+ */
+std::vector<ForkStats> DiningPhilosophers::getForkStats() const {
+    std::vector<ForkStats> result;
+    result.reserve(forks.size());
+    for (int f = 0; f < numForks; f++) {
+        const Fork& fork = forks[f];
+        ForkStats record = { f, fork.acquisitions, fork.shared, fork.contended, fork.totalWaitNs, fork.maxWaitNs,
+                             graph.userCount(f), (elapsed > 0.0) ? fork.acquisitions / elapsed : 0.0 };
+        result.push_back(record);
+    }
+    return result;
+}
+
+/**
+ * @brief Get the forks that cost their philosophers the most waiting
+ * 
+ * Ordered by total wait, then contended pick-ups, then index; forks that
+ * were never contended are left out.
+ * 
+ * @param count Maximum number of forks returned
+ * @return Up to count records, most contended first
+ */
+std::vector<ForkStats> DiningPhilosophers::getMostContendedForks(std::size_t count) const {
+    std::vector<ForkStats> result;
+    for (const auto& record : getForkStats()) {
+        if (record.contended > 0) {
+            result.push_back(record);
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const ForkStats& a, const ForkStats& b) {
+        if (a.totalWaitNs != b.totalWaitNs) {
+            return a.totalWaitNs > b.totalWaitNs;
+        }
+        return (a.contended != b.contended) ? a.contended > b.contended : a.id < b.id;
+    });
+    if (result.size() > count) {
+        result.resize(count);
+    }
+    return result;
+}
+
+/**
+ * @brief Get the wait-for-forks latency of all philosophers combined
+ * @return Merged histogram of the last simulate() call (nanoseconds)
+ */
+LatencyHistogram DiningPhilosophers::getWaitLatency() const {
+    LatencyHistogram merged;
+    for (const auto& state : philosophers) {
+        merged.merge(state.waitLatency);
+    }
+    return merged;
+}
+
+/**
+ * @brief Get total meals per wall-clock second of the last run
+ * @return Meals per second (0 before the first run)
+ */
+double DiningPhilosophers::getMealsPerSecond() const {
+    if (elapsed <= 0.0) {
+        return 0.0;
+    }
+    
+    long long meals = 0;
+    for (const auto& state : philosophers) {
+        meals += state.cyclesCompleted;
+    }
+    return static_cast<double>(meals) / elapsed;
+}
+
+/**
+ * @brief Get the Jain fairness index of the per-philosopher meal counts
+ * 
+ * (sum x)^2 / (n * sum x^2). Every philosopher runs for the same wall-clock
+ * time, so meal counts are proportional to meal rates.
+ * 
+ * @return Fairness index in [1/n, 1] (1.0 before the first run)
+ */
+double DiningPhilosophers::getFairnessIndex() const {
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    for (const auto& state : philosophers) {
+        double meals = static_cast<double>(state.cyclesCompleted);
+        sum += meals;
+        sumSquares += meals * meals;
+    }
+    
+    if (sumSquares == 0.0) {
+        return 1.0;
+    }
+    return (sum * sum) / (static_cast<double>(numPhilosophers) * sumSquares);
+}
+
+/**
+ * @brief Print per-philosopher meals and waits, per-fork contention and the throughput summary
+ * 
+ * Wait columns are in seconds; percentiles come from each philosopher's
+ * LatencyHistogram.
+ * 
+ * @param out Destination stream
+ */
+void DiningPhilosophers::printStatistics(std::ostream& out) const {
+    out << "  " << std::setw(5) << "PHIL" << std::setw(8) << "Meals" << std::setw(10) << "Meals/s"
+        << std::setw(11) << "Avg wait" << std::setw(11) << "P50 wait"
+        << std::setw(11) << "P99 wait" << std::setw(11) << "Max wait" << std::endl;
+    
+    out << std::fixed << std::setprecision(3);
+    for (const auto& record : getPhilosopherStats()) {
+        double averageWait = (record.meals > 0) ? record.totalWait / record.meals : 0.0;
+        out << "  " << std::setw(5) << record.id << std::setw(8) << record.meals
+            << std::setw(10) << record.mealsPerSecond << std::setw(11) << averageWait
+            << std::setw(11) << record.p50Wait
+            << std::setw(11) << record.p99Wait << std::setw(11) << record.maxWait << std::endl;
+    }
+    
+    // The Shared column only appears when meals may be reads
+    bool reads = readsShared();
+    out << std::endl;
+    out << "  " << std::setw(5) << "FORK" << std::setw(7) << "Users" << std::setw(10) << "Acquired";
+    if (reads) {
+        out << std::setw(9) << "Shared";
+    }
+    out << std::setw(12) << "Acquired/s" << std::setw(11) << "Contended" << std::setw(11) << "Avg wait"
+        << std::setw(11) << "Max wait" << std::endl;
+    for (const auto& record : getForkStats()) {
+        double averageWait = (record.contended > 0)
+            ? static_cast<double>(record.totalWaitNs) / record.contended / 1e9 : 0.0;
+        out << "  " << std::setw(5) << record.id << std::setw(7) << record.users
+            << std::setw(10) << record.acquisitions;
+        if (reads) {
+            out << std::setw(9) << record.shared;
+        }
+        out << std::setw(12) << record.acquisitionsPerSecond
+            << std::setw(11) << record.contended << std::setw(11) << averageWait
+            << std::setw(11) << record.maxWaitNs / 1e9 << std::endl;
+    }
+    
+    out << std::endl;
+    out << "  Table: " << graph.describe() << std::endl;
+    out << "  Strategy: " << diningStrategyName(runStrategy);
+    if (runStrategy != strategy) {
+        out << " (" << diningStrategyName(strategy) << " is not supported on this table)";
+    }
+    out << std::endl;
+    out << "  Fork lock: " << forkLockTypeName(forkLockType) << std::endl;
+    if (readRatio > 0.0) {
+        long long meals = 0;
+        long long readMeals = 0;
+        for (const auto& state : philosophers) {
+            meals += state.cyclesCompleted;
+            readMeals += state.readMeals;
+        }
+        out << "  Reads: ratio " << readRatio;
+        if (!reads) {
+            out << (deadlock.enabled() ? " (not used: deadlock detection tracks one holder per fork)"
+                                       : " (not used: this strategy has no shared forks)");
+        } else {
+            out << ", " << readMeals << " of " << meals << " meals held their forks shared";
+            if (forkLocks && !forkLocks->sharesReads()) {
+                out << " (this fork lock takes them exclusively)";
+            }
+        }
+        out << std::endl;
+    }
+    if (deadlock.enabled()) {
+        out << "  Deadlock detection: " << deadlock.describe();
+        if (detecting) {
+            out << ", " << deadlock.getDeadlocks() << " deadlocks, " << deadlock.getPreemptions() << " preemptions";
+        } else {
+            out << " (not tracked: this strategy holds no fork locks)";
+        }
+        out << std::endl;
+        for (const DeadlockCycle& cycle : deadlock.getCycles()) {
+            out << "    " << DeadlockDetector::formatCycle(cycle) << std::endl;
+        }
+    }
+    out << "  Think: " << thinkTime.describe() << ", eat: " << eatTime.describe() << std::endl;
+    out << "  Seed: " << seed << std::endl;
+    out << "  Topology: " << CpuTopology::instance().describe() << ", pinning " << describeCpuPinning(pinning);
+    if (!workerCpus.empty()) {
+        out << " (CPUs " << formatCpuList(workerCpus) << ", " << poolNodes.size()
+            << (poolNodes.size() == 1 ? " pool, " : " pools, ") << placedPages << " pages placed)";
+    }
+    out << std::endl;
+    out << "  Throughput: " << getMealsPerSecond() << " meals/s over " << elapsed << "s" << std::endl;
+    out << "  Fairness (Jain index of meal counts): " << getFairnessIndex() << std::endl;
+    out << "  Most contended forks:";
+    std::vector<ForkStats> hottest = getMostContendedForks(HOT_FORKS_REPORTED);
+    if (hottest.empty()) {
+        out << " none";
+    }
+    for (std::size_t k = 0; k < hottest.size(); k++) {
+        out << (k > 0 ? "," : "") << " " << hottest[k].id << " (" << hottest[k].contended << " waits, "
+            << hottest[k].totalWaitNs / 1e9 << "s waited, " << hottest[k].users << " users)";
+    }
+    out << std::endl;
+    out.unsetf(std::ios::floatfield);
+    out << std::setprecision(6);
+}
+
+/**
+ * @brief Write the statistics of the last run as JSON
+ * 
+ * Layout (all latencies in nanoseconds):
+ * {
+ *   "strategy": "...", "forkLock": "...", "readRatio": W, "table": "...", "philosophers": N, "forks": R,
+ *   "seed": S, "think": "...", "eat": "...", "deadlockDetection": "...", "deadlocks": D, "preemptions": P,
+ *   "topology": "...", "pinning": "...", "workerCpus": "...", "pools": P, "placedPages": G,
+ *   "elapsedSeconds": T,
+ *   "mealsPerSecond": M, "fairness": F, "mostContended": [ fork IDs, longest total wait first ],
+ *   "philosopherStats": [ { "id", "meals", "readMeals", "mealsPerSecond", "waitNs": { "count", "min", "mean",
+ *                           "p50", "p90", "p99", "p999", "max" } }, ... ],
+ *   "forkStats": [ { "id", "users", "acquisitions", "shared", "acquisitionsPerSecond", "contended",
+ *                    "totalWaitNs", "maxWaitNs" }, ... ]
+ * }
+ * 
+ * @param path Output file
+ * @return true on success, false (with a message on std::cerr) on error
+ */
+bool DiningPhilosophers::writeMetricsJson(const std::string& path) const {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot create metrics file " << path << std::endl;
+        return false;
+    }
+    
+    file << "{\n";
+    file << "  \"strategy\": \"" << diningStrategyName(runStrategy) << "\",\n";
+    file << "  \"forkLock\": \"" << forkLockTypeName(forkLockType) << "\",\n";
+    file << "  \"readRatio\": " << (readsShared() ? readRatio : 0.0) << ",\n";
+    file << "  \"table\": \"" << graph.describe() << "\",\n";
+    file << "  \"philosophers\": " << numPhilosophers << ",\n";
+    file << "  \"forks\": " << numForks << ",\n";
+    file << "  \"deadlockDetection\": \"" << deadlock.describe() << "\",\n";
+    file << "  \"deadlocks\": " << deadlock.getDeadlocks() << ",\n";
+    file << "  \"preemptions\": " << deadlock.getPreemptions() << ",\n";
+    file << "  \"seed\": " << seed << ",\n";
+    file << "  \"think\": \"" << thinkTime.describe() << "\",\n";
+    file << "  \"eat\": \"" << eatTime.describe() << "\",\n";
+    file << "  \"topology\": \"" << CpuTopology::instance().describe() << "\",\n";
+    file << "  \"pinning\": \"" << describeCpuPinning(pinning) << "\",\n";
+    file << "  \"workerCpus\": \"" << formatCpuList(workerCpus) << "\",\n";
+    file << "  \"pools\": " << poolNodes.size() << ",\n";
+    file << "  \"placedPages\": " << placedPages << ",\n";
+    file << "  \"elapsedSeconds\": " << elapsed << ",\n";
+    file << "  \"mealsPerSecond\": " << getMealsPerSecond() << ",\n";
+    file << "  \"fairness\": " << getFairnessIndex() << ",\n";
+    file << "  \"mostContended\": [";
+    std::vector<ForkStats> hottest = getMostContendedForks(HOT_FORKS_REPORTED);
+    for (std::size_t k = 0; k < hottest.size(); k++) {
+        file << (k > 0 ? ", " : "") << hottest[k].id;
+    }
+    file << "],\n";
+    
+    file << "  \"philosopherStats\": [\n";
+    for (int i = 0; i < numPhilosophers; i++) {
+        const PhilosopherState& state = philosophers[i];
+        const LatencyHistogram& latency = state.waitLatency;
+        file << "    { \"id\": " << i << ", \"meals\": " << state.cyclesCompleted
+             << ", \"readMeals\": " << state.readMeals
+             << ", \"mealsPerSecond\": " << ((elapsed > 0.0) ? state.cyclesCompleted / elapsed : 0.0)
+             << ", \"waitNs\": { \"count\": " << latency.count()
+             << ", \"min\": " << latency.min()
+             << ", \"mean\": " << static_cast<std::uint64_t>(latency.mean())
+             << ", \"p50\": " << latency.percentile(50.0)
+             << ", \"p90\": " << latency.percentile(90.0)
+             << ", \"p99\": " << latency.percentile(99.0)
+             << ", \"p999\": " << latency.percentile(99.9)
+             << ", \"max\": " << latency.max() << " } }"
+             << ((i + 1 < numPhilosophers) ? ",\n" : "\n");
+    }
+    file << "  ],\n";
+    
+    file << "  \"forkStats\": [\n";
+    for (int f = 0; f < numForks; f++) {
+        const Fork& fork = forks[f];
+        file << "    { \"id\": " << f << ", \"users\": " << graph.userCount(f)
+             << ", \"acquisitions\": " << fork.acquisitions
+             << ", \"shared\": " << fork.shared
+             << ", \"acquisitionsPerSecond\": " << ((elapsed > 0.0) ? fork.acquisitions / elapsed : 0.0)
+             << ", \"contended\": " << fork.contended
+             << ", \"totalWaitNs\": " << fork.totalWaitNs
+             << ", \"maxWaitNs\": " << fork.maxWaitNs << " }"
+             << ((f + 1 < numForks) ? ",\n" : "\n");
+    }
+    file << "  ]\n";
+    file << "}\n";
+    
+    if (!file) {
+        std::cerr << "Error: Failed to write metrics file " << path << std::endl;
+        return false;
     }
+    return true;
 }
@@ -3,18 +3,90 @@
  * @brief Header file for the DiningPhilosophers class
  * 
  * This file defines the DiningPhilosophers class which implements the classic
- * Dining Philosophers synchronization problem. Five philosophers sit at a round
- * table with five forks. Each philosopher needs two forks to eat.
+ * Dining Philosophers synchronization problem. N philosophers (5 by default,
+ * chosen at runtime) sit at a round table with N forks. Each philosopher needs
+ * two forks to eat.
  * 
- * Deadlock Prevention Strategy: ORDERED RESOURCE ACQUISITION
- * - Each philosopher picks up the lower-numbered fork first, then the higher-numbered fork
- * - This breaks the circular wait condition and prevents deadlock
- * - Example: Philosopher 0 needs forks 0 and 4, so picks up fork 0 first, then fork 4
+ * The table is a ResourceGraph: the ring by default, or any agent -> resource
+ * set graph (setResourceGraph()), in which agent i must hold every resource
+ * it lists to eat. The strategies below acquire whole sets:
+ * - Ordered and TryLock work on any graph (ascending IDs / all-or-nothing)
+ * - Waiter takes the forks left then right on the ring, ascending on a graph
+ * - Monitor lets an agent eat when no agent sharing one of its resources eats
+ * - Chandy-Misra needs every resource shared by at most two agents (one fork
+ *   per conflict edge, as in the original algorithm); with larger groups
+ *   simulate() falls back to Ordered
+ * 
+ * Deadlock Prevention Strategies (selectable, see DiningStrategy):
+ * - ORDERED RESOURCE ACQUISITION (default): lower-numbered fork first, then the
+ *   higher-numbered fork; this breaks the circular wait condition
+ * - WAITER: a counting semaphore lets at most N-1 philosophers reach for forks
+ * - CHANDY-MISRA: clean/dirty forks; a dirty fork is handed to a hungry neighbour
+ * - TRY-LOCK: std::lock()-style try-and-back-off acquires both forks at once
+ * - MONITOR: Tanenbaum's state array; a philosopher eats only when neither
+ *   neighbour is eating
+ * - NAIVE: left fork, then right fork, with no prevention; it deadlocks once
+ *   every philosopher holds its left fork, and is meant to be run with the
+ *   DeadlockDetector (setDeadlockDetection()) as a baseline
+ * 
+ * After a run, meals per second and the Jain fairness index of the
+ * per-philosopher meal counts are available for comparing the strategies.
+ * 
+ * Readers and writers: with setReadRatio(), each meal is a read with that
+ * probability and takes every fork shared (ForkAccess::Shared); the other
+ * meals take them exclusively. A shared-capable fork lock (std::shared_mutex
+ * or ReaderBiasedLock) lets readers of one fork eat at the same time, while
+ * std::mutex and SpinParkLock take reads exclusively too, which gives the
+ * baseline for measuring the gain. Reads apply to the strategies that lock
+ * forks (Ordered, Waiter, TryLock, Naive) with deadlock detection off;
+ * Monitor, Chandy-Misra and detected runs keep every meal exclusive.
+ * 
+ * Contention instrumentation:
+ * - Every fork counts acquisitions, contended acquisitions (the fork was not
+ *   free on the first try) and total/maximum wait; the counters are written
+ *   only by the fork's current holder, so they need no atomic read-modify-
+ *   writes or extra locks (readers holding a fork together use atomic adds)
+ * - Every philosopher keeps a LatencyHistogram of the "waiting for forks" to
+ *   "eating" latency
+ * - printStatistics() prints both as tables; writeMetricsJson() (called at the
+ *   end of simulate() when a metrics path is set) writes them as JSON
+ * - With a trace path set, simulate() also records a TimelineTrace: think,
+ *   wait and eat spans per philosopher, and a flow arrow for every contended
+ *   fork hand-over from the releasing philosopher to the next acquirer
+ * - The meal and contention counters are RelaxedCounters, so with
+ *   setLiveMetrics() an exporter reads meals per philosopher and fork
+ *   contention while the run is in progress, at no cost to the writers
+ * 
+ * Checkpoints: with setCheckpoint(), SIGINT / SIGTERM (see Checkpoint.h)
+ * make every philosopher stop after its current cycle, when it holds no
+ * fork; simulate() then saves cycles, waits, generator states, Chandy-Misra
+ * fork ownership and the fork counters. setResumePoint() continues such a
+ * run: the remaining cycles (or the rest of the run duration) follow, and
+ * the statistics cover the whole run.
+ * 
+ * Think and eat times are DurationDistributions with nanosecond resolution
+ * (constant, uniform, exponential or empirical). Durations up to 100 us are
+ * waited out by yielding rather than sleeping, since a sleep alone
+ * overshoots short critical sections by tens of microseconds.
+ * 
+ * Steady state:
+ * - Each philosopher owns a FastRandom generator, seeded once per simulate()
+ *   from the run seed (setSeed() makes runs reproducible)
+ * - Log messages are built in fixed LogLine buffers, so a think-eat cycle
+ *   performs no heap allocation
  * 
  * Thread Safety:
- * - Each fork is represented by a std::mutex
- * - Console output is protected by coutMutex to prevent interleaved messages
- * - Uses RAII pattern (std::lock_guard) for automatic mutex unlocking
+ * - Each fork is a lock in a ForkTable (std::mutex by default, or the
+ *   spin-then-park SpinParkLock), padded and aligned to its own 64-byte cache
+ *   line so that neighbouring forks never false-share
+ * - Philosophers are multiplexed over a worker pool: each think-eat cycle is one
+ *   pool task, so the table size is not limited by the number of OS threads
+ * - With CPU pinning (setPinning()), there is one pool per NUMA node, each
+ *   owning a contiguous block of philosophers, and the philosophers' state and
+ *   their forks (on the node of the lowest-numbered user) are placed on the
+ *   owning node
+ * - Console output goes through the shared asynchronous Logger, so philosophers
+ *   never block on console I/O while holding forks
  * 
  * @author Thread Simulation System
  * @date 2024
@@ -24,64 +96,572 @@
 #define DINING_PHILOSOPHERS_H
 
 #include <mutex>
+#include <condition_variable>
 #include <chrono>
+#include <iosfwd>
+#include <memory>
 #include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "LatencyHistogram.h"
+#include "Random.h"
+#include "DurationDistribution.h"
+#include "ForkTable.h"
+#include "TimelineTrace.h"
+#include "ResourceGraph.h"
+#include "DeadlockDetector.h"
+#include "LiveMetrics.h"
+#include "Checkpoint.h"
+
+class ThreadPool;
+class LogLine;
+enum class LogLevel;
+
+/**
+ * @enum DiningStrategy
+ * @brief Fork acquisition protocols available to DiningPhilosophers
+ */
+enum class DiningStrategy {
+    Ordered,      ///< Lower-numbered fork first (resource ordering)
+    Waiter,       ///< Arbitrator semaphore admitting at most N-1 diners
+    ChandyMisra,  ///< Clean/dirty forks handed over on request
+    TryLock,      ///< std::lock()-style try-and-back-off on all forks at once
+    Monitor,      ///< Tanenbaum state array with one condition variable per philosopher
+    Naive         ///< Listed order (left then right) with no prevention: can deadlock
+};
+
+/**
+ * @brief Parse a strategy name ("ordered", "waiter", "chandy-misra", "trylock", "monitor", "naive")
+ * @param name Strategy name
+ * @param strategy Receives the parsed strategy
+ * @return true if the name is recognised
+ */
+bool parseDiningStrategy(const std::string& name, DiningStrategy& strategy);
+
+/**
+ * @brief Get the display name of a strategy
+ * @param strategy Strategy
+ * @return Human-readable name
+ */
+const char* diningStrategyName(DiningStrategy strategy);
+
+/**
+ * @struct PhilosopherStats
+ * @brief Per-philosopher results of one simulate() call
+ */
+struct PhilosopherStats {
+    int id;              ///< Philosopher ID
+    int meals;           ///< Meals eaten
+    int readMeals;       ///< Meals eaten as a read (forks held shared)
+    double totalWait;    ///< Seconds spent hungry (waiting for forks), summed over meals
+    double maxWait;      ///< Longest single wait for forks in seconds
+    double p50Wait;      ///< Median wait for forks in seconds
+    double p99Wait;      ///< 99th percentile wait for forks in seconds
+    double mealsPerSecond;  ///< Meals per wall-clock second of the run
+};
+
+/**
+ * @struct ForkStats
+ * @brief Per-fork contention counters of one simulate() call
+ */
+struct ForkStats {
+    int id;                        ///< Fork index
+    std::uint64_t acquisitions;    ///< Times the fork was picked up
+    std::uint64_t shared;          ///< Pick-ups for a read (shared)
+    std::uint64_t contended;       ///< Pick-ups that had to wait for the fork
+    std::uint64_t totalWaitNs;     ///< Summed wait of contended pick-ups in nanoseconds
+    std::uint64_t maxWaitNs;       ///< Longest single wait in nanoseconds
+    std::size_t users;             ///< Agents that need the fork
+    double acquisitionsPerSecond;  ///< Pick-ups per wall-clock second of the run
+};
 
 /**
  * @class DiningPhilosophers
  * @brief Implements the Dining Philosophers synchronization problem
  * 
- * This class simulates 5 philosophers who alternate between thinking and eating.
- * Each philosopher needs two adjacent forks to eat. Deadlock is prevented using
- * ordered resource acquisition (always pick up lower-numbered fork first).
+ * This class simulates N philosophers who alternate between thinking and eating.
+ * Each philosopher needs two adjacent forks to eat (or, with a ResourceGraph,
+ * every fork it lists). Deadlock is prevented by the selected DiningStrategy
+ * (ordered resource acquisition by default).
  */
 class DiningPhilosophers {
+public:
+    static const int DEFAULT_PHILOSOPHERS = 5;     ///< Table size used when none is given
+    static const std::size_t CACHE_LINE_SIZE = 64; ///< Alignment of each fork and philosopher slot
+
 private:
-    static const int NUM_PHILOSOPHERS = 5;  ///< Number of philosophers (and forks)
-    std::mutex forks[NUM_PHILOSOPHERS];     ///< Array of mutexes representing forks (CRITICAL RESOURCES)
-    std::mutex coutMutex;                   ///< Mutex for thread-safe console output (CRITICAL SECTION)
-    int iterations;                         ///< Number of think-eat cycles per philosopher
+    /**
+     * @struct Fork
+     * @brief Per-fork bookkeeping on its own cache line (the lock itself lives in forkLocks)
+     */
+    struct alignas(CACHE_LINE_SIZE) Fork {
+        int owner;         ///< Chandy-Misra: philosopher holding the fork
+        bool dirty;        ///< Chandy-Misra: fork has been eaten with since it was handed over
+        RelaxedCounter<std::uint64_t> acquisitions;  ///< Contention counter: pick-ups (written by the holders only)
+        RelaxedCounter<std::uint64_t> contended;     ///< Contention counter: pick-ups that had to wait
+        RelaxedCounter<std::uint64_t> totalWaitNs;   ///< Contention counter: summed wait in nanoseconds
+        RelaxedCounter<std::uint64_t> maxWaitNs;     ///< Contention counter: longest wait in nanoseconds
+        RelaxedCounter<std::uint64_t> shared;        ///< Contention counter: pick-ups for a read
+        RelaxedCounter<int> releasedBy;              ///< Timeline: last philosopher to put the fork down (-1 = none)
+        RelaxedCounter<std::int64_t> releasedNs;     ///< Timeline: when it was put down (ns since startTime)
+    };
+    
+    /**
+     * @enum Phase
+     * @brief Monitor strategy: Tanenbaum's per-philosopher state
+     */
+    enum Phase { THINKING, HUNGRY, EATING };
+    
+    /**
+     * @struct PhilosopherState
+     * @brief Per-philosopher progress, on its own cache line
+     */
+    struct alignas(CACHE_LINE_SIZE) PhilosopherState {
+        RelaxedCounter<int> cyclesCompleted;  ///< Think-eat cycles finished so far (read live by the exporter)
+        RelaxedCounter<int> readMeals;        ///< Meals eaten as a read (forks held shared)
+        ForkAccess access;            ///< Mode of the current meal's forks
+        Phase phase;                  ///< Monitor / Chandy-Misra: current phase (guarded by tableMutex)
+        std::condition_variable turn; ///< Monitor / Chandy-Misra: signalled when forks may be free
+        double totalWait;             ///< Seconds spent waiting for forks
+        double maxWait;               ///< Longest single wait for forks
+        LatencyHistogram waitLatency; ///< "Waiting for forks" to "eating" latency in nanoseconds
+        FastRandom rng;               ///< Think-time generator (seeded from the run seed + ID)
+        std::size_t homePool;         ///< Index in pools of the pool that runs this philosopher
+    };
+    
+    int numPhilosophers;                          ///< Number of philosophers (agents)
+    ResourceGraph graph;                          ///< Forks each philosopher needs (ring by default)
+    int numForks;                                 ///< Number of forks (resources)
+    std::vector<Fork> forks;                      ///< Fork bookkeeping, one cache line each
+    ForkLockType forkLockType;                    ///< Lock implementation used by the next simulate()
+    std::unique_ptr<ForkTableBase> forkLocks;     ///< The fork locks (CRITICAL RESOURCES)
+    std::vector<PhilosopherState> philosophers;   ///< Per-philosopher progress
+    int iterations;                               ///< Number of think-eat cycles per philosopher
+    unsigned int workerCount;                     ///< Pool size (0 = hardware concurrency)
+    std::vector<ThreadPool*> pools;               ///< Pools running the current simulate() call (one per node)
+    CpuPinning pinning;                           ///< CPU placement of the pool workers
+    std::vector<int> workerCpus;                  ///< CPU of each worker in the last run (empty = unpinned)
+    std::vector<int> poolNodes;                   ///< NUMA node of each pool in the last run
+    std::size_t placedPages;                      ///< Pages moved to their owners' nodes in the last run
+    DiningStrategy strategy;                      ///< Fork acquisition protocol (as configured)
+    DiningStrategy runStrategy;                   ///< Protocol of the current or last run (Ordered if strategy is unsupported)
+    double readRatio;                             ///< Probability that a meal is a read (0 = every meal writes)
+    double runDuration;                           ///< Duration-based run length in seconds (0 = use iterations)
+    std::chrono::steady_clock::time_point deadline;   ///< End of a duration-based run
+    double elapsed;                               ///< Wall-clock length of the last simulate() call
+    std::string metricsPath;                      ///< JSON metrics destination ("" = none)
+    std::string tracePath;                        ///< Chrome trace destination ("" = none)
+    std::unique_ptr<TimelineTrace> timeline;      ///< Timeline of the current run (null when not tracing)
+    LiveMetrics* liveMetrics;                     ///< Exporter of the live counters (null = none)
+    std::atomic<bool> liveRunning;                ///< Live: simulate() is in progress
+    std::string checkpointPath;                   ///< Checkpoint written when interrupted ("" = none)
+    std::atomic<bool>* stopRequest;               ///< checkpointRequest() while checkpointing (null = never stop)
+    std::unique_ptr<PhilosopherCheckpoint> resumeState;  ///< State the next simulate() continues from (null = none)
+    double resumedElapsed;                        ///< Seconds run before the checkpoint the current run resumed
+    bool interrupted;                             ///< true if the last simulate() stopped at a checkpoint
+    DurationDistribution thinkTime;               ///< Think time (default uniform 1-3 s)
+    DurationDistribution eatTime;                 ///< Eat time (default constant 2 s)
+    bool loggingEnabled;                          ///< false suppresses all philosopher log messages
+    std::uint64_t seed;                           ///< Seed of the last (or next, if fixed) run
+    bool seedFixed;                               ///< true once setSeed() was called
+    
+    std::mutex tableMutex;                        ///< Guards phases and fork ownership (Monitor, Chandy-Misra)
+    std::mutex waiterMutex;                       ///< Guards seatsAvailable (Waiter)
+    std::condition_variable seatFreed;            ///< Signalled when a seat becomes available (Waiter)
+    int seatsAvailable;                           ///< Waiter semaphore count (N-1 when idle, at least 1)
+    
+    DeadlockDetector deadlock;                    ///< Wait-for graph watchdog (off by default)
+    bool detecting;                               ///< The current run reports fork waits to deadlock
+    
     std::chrono::steady_clock::time_point startTime;  ///< Start time for timestamp calculation
     
     /**
-     * @brief Get the index of the left fork for a philosopher
-     * @param id Philosopher ID (0-4)
-     * @return Index of the left fork
+     * @brief Append "fork F", "forks A, B and C" or "forks A, B, C and N more" to a log line
+     * @param line Line being built
+     * @param ids Fork indexes
+     * @param count Number of forks
      */
-    int leftFork(int id);
+    static void appendForkList(LogLine& line, const int* ids, std::size_t count);
     
     /**
-     * @brief Get the index of the right fork for a philosopher
-     * @param id Philosopher ID (0-4)
-     * @return Index of the right fork
+     * @brief Write meals and fork contention of the current run (exporter thread)
+     * @param out Metrics writer
      */
-    int rightFork(int id);
+    void collectLiveMetrics(MetricsWriter& out) const;
+    
+    /**
+     * @brief Check whether the philosophers were asked to stop for a checkpoint
+     * @return true once checkpointRequest() is set while checkpointing
+     */
+    bool checkpointStop() const {
+        return stopRequest && stopRequest->load(std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Save the state of a stopped run to checkpointPath
+     * @return true if the file was written
+     */
+    bool saveCheckpoint() const;
+    
+    /**
+     * @brief Check whether the read ratio applies to the current strategy
+     * @return true if meals may be reads (ratio above 0 and a strategy that locks forks)
+     */
+    bool readsShared() const;
     
 public:
     /**
-     * @brief Constructor with configurable iterations parameter
+     * @brief Constructor with configurable iterations and table size
      * @param iterations Number of think-eat cycles per philosopher (default: 3)
+     * @param numPhilosophers Number of philosophers and forks (default: 5, minimum: 2)
+     */
+    DiningPhilosophers(int iterations = 3, int numPhilosophers = DEFAULT_PHILOSOPHERS);
+    
+    /**
+     * @brief Get the number of philosophers at the table
+     * @return Number of philosophers (agents)
+     */
+    int getNumPhilosophers() const;
+    
+    /**
+     * @brief Get the number of forks
+     * @return Number of forks (resources)
+     */
+    int getNumForks() const;
+    
+    /**
+     * @brief Replace the ring with an arbitrary agent -> resource set graph
+     * 
+     * Resizes the table to the graph's agents and resources; all results of
+     * earlier runs are dropped.
+     * 
+     * @param newGraph Graph with at least one agent (see ResourceGraph::load())
+     */
+    void setResourceGraph(const ResourceGraph& newGraph);
+    
+    /**
+     * @brief Get the table layout
+     * @return Current graph (ResourceGraph::ring() unless replaced)
+     */
+    const ResourceGraph& getResourceGraph() const;
+    
+    /**
+     * @brief Check whether a strategy can run on the current graph
+     * 
+     * Chandy-Misra needs every fork shared by at most two philosophers; all
+     * other strategies run on any graph.
+     * 
+     * @param candidate Strategy to check
+     * @return true if simulate() would use the strategy as is
+     */
+    bool supportsStrategy(DiningStrategy candidate) const;
+    
+    /**
+     * @brief Turn the wait-for graph deadlock watchdog on or off
+     * 
+     * Applies to the strategies that lock forks (ordered, waiter, trylock,
+     * naive); a deadlock is found within two scan intervals.
+     * 
+     * @param action What to do on a deadlock (DeadlockAction::Off disables detection)
+     * @param interval Time between two watchdog scans
+     */
+    void setDeadlockDetection(DeadlockAction action, std::chrono::nanoseconds interval =
+                              std::chrono::milliseconds(DeadlockDetector::DEFAULT_INTERVAL_MS));
+    
+    /**
+     * @brief Get the deadlock detector (its counters describe the last run)
+     * @return The detector
+     */
+    const DeadlockDetector& getDeadlockDetector() const;
+    
+    /**
+     * @brief Set the number of pool workers that run the philosophers
+     * 
+     * @param count Worker count (0 = ThreadPool::defaultThreadCount())
      */
-    DiningPhilosophers(int iterations = 3);
+    void setWorkerCount(unsigned int count);
+    
+    /**
+     * @brief Select the fork acquisition protocol
+     * @param newStrategy Strategy used by the next simulate() call
+     */
+    void setStrategy(DiningStrategy newStrategy);
+    
+    /**
+     * @brief Get the fork acquisition protocol
+     * @return Current strategy
+     */
+    DiningStrategy getStrategy() const;
+    
+    /**
+     * @brief Make a share of the meals reads, which hold their forks shared
+     * 
+     * Each meal is a read with the given probability, drawn from the
+     * philosopher's generator. Only the strategies that lock forks (Ordered,
+     * Waiter, TryLock, Naive) take reads shared, and only with deadlock
+     * detection off (its wait-for graph has one holder per fork); readers
+     * actually overlap with a shared-capable fork lock
+     * (ForkLockType::SharedMutex or ReaderBiased).
+     * 
+     * @param ratio Probability in [0, 1] (0 = every meal writes, the default)
+     */
+    void setReadRatio(double ratio);
+    
+    /**
+     * @brief Get the probability that a meal is a read
+     * @return Read ratio in [0, 1]
+     */
+    double getReadRatio() const;
+    
+    /**
+     * @brief Run for a fixed wall-clock time instead of a fixed number of cycles
+     * 
+     * Philosophers keep cycling until the duration has passed, so fast and
+     * slow philosophers end with different meal counts (needed for fairness).
+     * 
+     * @param seconds Run length in seconds (0 = use the iterations count)
+     */
+    void setRunDuration(double seconds);
+    
+    /**
+     * @brief Set the think and eat durations
+     * 
+     * Shorthand for setThinkDistribution(uniform) plus setEatDistribution(constant).
+     * Zero durations skip the sleep entirely, which measures the pure
+     * synchronization cost.
+     * 
+     * @param minThink Shortest think time (default 1 s)
+     * @param maxThink Longest think time (default 3 s, raised to minThink if smaller)
+     * @param eat Eat time (default 2 s)
+     */
+    void setTiming(std::chrono::microseconds minThink, std::chrono::microseconds maxThink,
+                   std::chrono::microseconds eat);
+    
+    /**
+     * @brief Set the think time distribution
+     * @param distribution Think time of every cycle (default uniform:1s:3s)
+     */
+    void setThinkDistribution(const DurationDistribution& distribution);
+    
+    /**
+     * @brief Set the eat time distribution
+     * @param distribution Eat time of every meal (default constant:2s)
+     */
+    void setEatDistribution(const DurationDistribution& distribution);
+    
+    /**
+     * @brief Get the think time distribution
+     * @return Current distribution
+     */
+    const DurationDistribution& getThinkDistribution() const;
+    
+    /**
+     * @brief Get the eat time distribution
+     * @return Current distribution
+     */
+    const DurationDistribution& getEatDistribution() const;
+    
+    /**
+     * @brief Select the fork lock implementation
+     * 
+     * Only the strategies that lock forks directly (Ordered, Waiter, TryLock)
+     * are affected; Monitor and Chandy-Misra coordinate under tableMutex.
+     * SharedMutex and ReaderBiased let read meals share forks (setReadRatio()).
+     * 
+     * @param type Lock type used by the next simulate() call (default std::mutex)
+     */
+    void setForkLockType(ForkLockType type);
+    
+    /**
+     * @brief Get the fork lock implementation
+     * @return Current lock type
+     */
+    ForkLockType getForkLockType() const;
+    
+    /**
+     * @brief Turn the philosopher log messages on or off
+     * @param enabled false suppresses every message (e.g., for benchmarking)
+     */
+    void setLoggingEnabled(bool enabled);
+    
+    /**
+     * @brief Use a fixed seed for the think-time generators
+     * 
+     * Philosopher i draws from a generator seeded with seed + i, so equal
+     * seeds give equal think-time sequences. Without a fixed seed every
+     * simulate() call picks a fresh one from std::random_device.
+     * 
+     * @param newSeed Seed for all following simulate() calls
+     */
+    void setSeed(std::uint64_t newSeed);
+    
+    /**
+     * @brief Get the seed of the last simulate() call
+     * @return Seed (pass it to setSeed() to repeat the run's think times)
+     */
+    std::uint64_t getSeed() const;
+    
+    /**
+     * @brief Write contention metrics as JSON at the end of every simulate() call
+     * @param path Output file ("" disables the dump)
+     */
+    void setMetricsPath(const std::string& path);
+    
+    /**
+     * @brief Write a Chrome trace-event timeline at the end of every simulate() call
+     * 
+     * The file opens in chrome://tracing or the Perfetto UI: one track per
+     * philosopher with think / wait / eat spans, and flow arrows for fork
+     * hand-overs to a philosopher that was waiting for the fork.
+     * 
+     * @param path Output file ("" disables tracing)
+     */
+    void setTracePath(const std::string& path);
+    
+    /**
+     * @brief Publish meals and fork contention to a live metrics exporter while simulate() runs
+     * 
+     * Each simulate() call registers the "philosophers" source for its
+     * duration; its final counts are kept by the exporter afterwards.
+     * 
+     * @param metrics Exporter (null = none; must outlive the runs)
+     */
+    void setLiveMetrics(LiveMetrics* metrics);
+    
+    /**
+     * @brief Let simulate() be interrupted and continued later
+     * 
+     * Once checkpointRequest() is set, philosophers stop after their current
+     * cycle and simulate() saves the run to path; it then skips the metrics
+     * and trace files and wasInterrupted() is true. A naive table that is
+     * deadlocked never reaches the end of a cycle and does not stop.
+     * 
+     * @param path Checkpoint file ("" disables checkpoints)
+     */
+    void setCheckpoint(const std::string& path);
+    
+    /**
+     * @brief Continue the next simulate() from a philosopher checkpoint
+     * 
+     * The table must be the one the checkpoint was taken on (same
+     * fingerprint); strategy, cycle count, run duration, read ratio and seed are taken
+     * from the checkpoint. Every fork owner must be one of the fork's users
+     * (-1 for a fork nobody uses) and every wait histogram bucket in range.
+     * 
+     * @param checkpoint State read by readCheckpoint()
+     * @return false (with a message on std::cerr) if it does not match the table
+     */
+    bool setResumePoint(const PhilosopherCheckpoint& checkpoint);
+    
+    /**
+     * @brief Check whether the last simulate() stopped at a checkpoint
+     * @return true if the run was interrupted and its state saved
+     */
+    bool wasInterrupted() const;
+    
+    /**
+     * @brief Bind the pool workers to CPUs and place state on their NUMA nodes
+     * 
+     * With a pinning policy, workers are grouped by the node of their CPU
+     * into one pool per node. Each pool runs a contiguous block of
+     * philosophers (sized by its worker count), whose state is moved to that
+     * node; each fork goes to the node of its lowest-numbered user.
+     * 
+     * @param cpuPinning Placement policy (PinningPolicy::None by default)
+     */
+    void setPinning(const CpuPinning& cpuPinning);
     
     /**
      * @brief Start the dining philosophers simulation
      * 
-     * Creates 5 philosopher threads and waits for all to complete.
-     * Each philosopher will perform the specified number of think-eat cycles.
+     * Runs all philosophers on a worker pool and waits for all to complete.
+     * Each philosopher will perform the specified number of think-eat cycles
+     * (or keep cycling until the run duration has passed).
      */
     void simulate();
     
+    /**
+     * @brief Get per-philosopher results of the last simulate() call
+     * @return One record per philosopher, ordered by ID
+     */
+    std::vector<PhilosopherStats> getPhilosopherStats() const;
+    
+    /**
+     * @brief Get per-fork contention counters of the last simulate() call
+     * @return One record per fork, ordered by index
+     */
+    std::vector<ForkStats> getForkStats() const;
+    
+    /**
+     * @brief Get the forks that cost their philosophers the most waiting
+     * 
+     * Ordered by total wait, then contended pick-ups; forks that were never
+     * contended are left out. Use this to decide which resources to split.
+     * 
+     * @param count Maximum number of forks returned
+     * @return Up to count records, most contended first
+     */
+    std::vector<ForkStats> getMostContendedForks(std::size_t count) const;
+    
+    /**
+     * @brief Get the wait-for-forks latency of all philosophers combined
+     * @return Merged histogram of the last simulate() call (nanoseconds)
+     */
+    LatencyHistogram getWaitLatency() const;
+    
+    /**
+     * @brief Get total meals per wall-clock second of the last run
+     * @return Meals per second (0 before the first run)
+     */
+    double getMealsPerSecond() const;
+    
+    /**
+     * @brief Get the Jain fairness index of the per-philosopher meal counts
+     * 
+     * (sum x)^2 / (n * sum x^2): 1.0 when every philosopher ate equally often,
+     * 1/n when a single philosopher ate every meal.
+     * 
+     * @return Fairness index in [1/n, 1] (1.0 before the first run)
+     */
+    double getFairnessIndex() const;
+    
+    /**
+     * @brief Print per-philosopher meals and waits, per-fork contention and the throughput summary
+     * @param out Destination stream
+     */
+    void printStatistics(std::ostream& out) const;
+    
+    /**
+     * @brief Write the statistics of the last run as JSON
+     * @param path Output file
+     * @return true on success, false (with a message on std::cerr) on error
+     */
+    bool writeMetricsJson(const std::string& path) const;
+    
     /**
      * @brief Thread-safe logging with timestamp
      * 
-     * CRITICAL SECTION: Acquires coutMutex before writing to console
-     * to prevent interleaved output from multiple threads.
+     * Hands the message to the shared Logger, which stamps it with the time
+     * elapsed since startTime and writes it from its background thread.
      * 
      * @param message The message to log
      */
     void log(const std::string& message);
     
+    /**
+     * @brief Check whether messages of a level are logged by this simulator
+     * @param level Level of the message
+     * @return true if the level is compiled in and enabled and logging is on
+     */
+    bool logging(LogLevel level) const;
+    
+    /**
+     * @brief Log a message built in a fixed buffer (no heap allocation)
+     * @param line The message to log
+     */
+    void log(const LogLine& line);
+    
     /**
      * @brief Get elapsed time since simulation start
      * @return Formatted timestamp string in seconds
@@ -90,44 +670,118 @@ public:
     
 private:
     /**
-     * @brief Worker function executed by each philosopher thread
+     * @brief Pool task that runs one think-eat cycle of a philosopher
      * 
-     * This static function is the entry point for each philosopher thread.
-     * It performs multiple think-eat cycles based on the iterations parameter.
+     * Runs the philosopher's next cycle and, if more cycles remain, queues
+     * itself again on the pool; otherwise logs completion.
      * 
-     * @param id Philosopher ID (0-4)
+     * @param id Philosopher ID (0 to N-1)
      * @param sim Pointer to DiningPhilosophers instance
      */
     static void philosopherWorker(int id, DiningPhilosophers* sim);
     
     /**
-     * @brief Philosopher thinks for a random duration (1-3 seconds)
+     * @brief Philosopher thinks for a duration drawn from thinkTime (1-3 seconds by default)
      * @param id Philosopher ID
      */
     void think(int id);
     
     /**
-     * @brief Philosopher picks up both forks using ordered resource acquisition
+     * @brief Check whether a philosopher has another cycle to run
+     * @param id Philosopher ID
+     * @return true while cycles remain (or the run duration has not passed)
+     */
+    bool hasNextCycle(int id) const;
+    
+    /**
+     * @brief Philosopher picks up all its forks using the selected strategy
      * 
-     * DEADLOCK PREVENTION: Always picks up lower-numbered fork first, then higher-numbered fork.
-     * This breaks the circular wait condition and prevents deadlock.
+     * DEADLOCK PREVENTION: With the default Ordered strategy, always picks up the
+     * forks in ascending order (lower-numbered first). This breaks the
+     * circular wait condition and prevents deadlock.
      * 
-     * CRITICAL SECTION: Acquires two fork mutexes in a specific order
+     * CRITICAL SECTION: Acquires every fork of the philosopher (fork locks,
+     * or logical ownership for the Monitor and Chandy-Misra strategies)
      * 
      * @param id Philosopher ID
      */
     void pickupForks(int id);
     
     /**
-     * @brief Philosopher eats for a fixed duration (2 seconds)
+     * @brief Monitor strategy: let a hungry philosopher eat if no philosopher sharing a fork eats
+     * 
+     * Caller must hold tableMutex.
+     * 
+     * @param id Philosopher ID
+     */
+    void testMonitor(int id);
+    
+    /**
+     * @brief Chandy-Misra: take every dirty fork a neighbour is not eating with
+     * 
+     * Caller must hold tableMutex.
+     * 
+     * @param id Hungry philosopher ID
+     * @return true once the philosopher owns all its forks
+     */
+    bool claimForks(int id);
+    
+    /**
+     * @brief Lock a philosopher's forks one at a time, starting over if preempted
+     * 
+     * Forks are taken in the mode of the philosopher's current meal.
+     * 
+     * @param id Philosopher ID
+     * @param order Fork indexes in acquisition order
+     * @param count Number of forks
+     */
+    void lockForksInOrder(int id, const int* order, std::size_t count);
+    
+    /**
+     * @brief Lock one fork, updating its contention counters
+     * 
+     * The uncontended path is a single try-acquire in the mode of the
+     * philosopher's current meal; the clock is read only when the fork is
+     * already taken.
+     * 
+     * @param f Fork index
+     * @param id Philosopher picking it up
+     * @return true once the fork is held, false if the deadlock detector preempted the wait
+     */
+    bool lockFork(int f, int id);
+    
+    /**
+     * @brief Count a pick-up of a fork the caller now holds
+     * @param f Fork index
+     * @param id Philosopher that picked it up
+     * @param contended true if the caller had to wait for the fork
+     * @param waitNs Time the caller waited for it in nanoseconds
+     */
+    void recordForkAcquisition(int f, int id, bool contended, std::uint64_t waitNs);
+    
+    /**
+     * @brief Timeline: note who puts a fork down and when (caller still holds it)
+     * @param f Fork index
+     * @param id Philosopher putting it down
+     */
+    void recordForkRelease(int f, int id);
+    
+    /**
+     * @brief Timeline clock: nanoseconds since startTime
+     * @return Current time on the timeline
+     */
+    std::int64_t timelineNow() const;
+    
+    /**
+     * @brief Philosopher eats for a duration drawn from eatTime (2 seconds by default)
      * @param id Philosopher ID
      */
     void eat(int id);
     
     /**
-     * @brief Philosopher puts down both forks
+     * @brief Philosopher puts down all its forks using the selected strategy
      * 
-     * CRITICAL SECTION: Releases two fork mutexes
+     * CRITICAL SECTION: Releases every fork of the philosopher
      * 
      * @param id Philosopher ID
      */
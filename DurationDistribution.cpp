@@ -0,0 +1,371 @@
+/**
+ * @file DurationDistribution.cpp
+ * @brief Implementation of the DurationDistribution class
+ *
+ * This file implements:
+ * - Sampling from the constant, uniform, exponential and empirical shapes
+ * - Duration parsing and formatting with ns/us/ms/s units
+ * - The "kind:args" distribution syntax and empirical file loading
+ *
+ * Exponential draws use inversion, -mean * ln(1 - u), so the caller's FastRandom
+ * is the only source of randomness and equal seeds give equal durations.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "DurationDistribution.h"
+#include "Random.h"
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+/**
+ * @brief Clamp a duration to be non-negative and return its tick count
+ */
+inline std::int64_t nonNegative(std::chrono::nanoseconds value) {
+    return (value.count() > 0) ? static_cast<std::int64_t>(value.count()) : 0;
+}
+
+/**
+ * @brief Strip leading and trailing blanks (spaces, tabs, CR)
+ */
+std::string trim(const std::string& text) {
+    std::size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return std::string();
+    }
+    std::size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+} // namespace
+
+/**
+ * @brief Get the display name of a distribution kind
+ * @param kind Distribution kind
+ * @return Human-readable name
+ */
+const char* distributionKindName(DistributionKind kind) {
+    switch (kind) {
+        case DistributionKind::Uniform:     return "Uniform";
+        case DistributionKind::Exponential: return "Exponential";
+        case DistributionKind::Empirical:   return "Empirical";
+        case DistributionKind::Constant:
+        default:                            return "Constant";
+    }
+}
+
+/**
+ * @brief Constructor - a constant zero duration
+ */
+DurationDistribution::DurationDistribution()
+    : kind(DistributionKind::Constant), first(0), second(0) {
+}
+
+/**
+ * @brief Always return the same duration
+ * @param value Duration (negative values become 0)
+ * @return The distribution
+ */
+DurationDistribution DurationDistribution::constant(std::chrono::nanoseconds value) {
+    DurationDistribution result;
+    result.first = nonNegative(value);
+    return result;
+}
+
+/**
+ * @brief Uniform on [lo, hi]
+ * @param lo Shortest duration (negative values become 0)
+ * @param hi Longest duration (raised to lo if smaller)
+ * @return The distribution
+ */
+DurationDistribution DurationDistribution::uniform(std::chrono::nanoseconds lo, std::chrono::nanoseconds hi) {
+    DurationDistribution result;
+    result.kind = DistributionKind::Uniform;
+    result.first = nonNegative(lo);
+    result.second = (nonNegative(hi) > result.first) ? nonNegative(hi) : result.first;
+    return result;
+}
+
+/**
+ * @brief Exponential with the given mean
+ * @param mean Mean duration (negative values become 0)
+ * @return The distribution
+ */
+DurationDistribution DurationDistribution::exponential(std::chrono::nanoseconds mean) {
+    DurationDistribution result;
+    result.kind = DistributionKind::Exponential;
+    result.first = nonNegative(mean);
+    return result;
+}
+
+/**
+ * @brief Resample recorded durations (each sample equally likely)
+ *
+ * The mean and maximum are computed once here: first holds the mean and
+ * second the maximum, so mean() and isZero() stay O(1).
+ *
+ * @param values Recorded durations (negative values become 0; empty means constant 0)
+ * @param name Where the values came from (shown by describe())
+ * @return The distribution
+ */
+DurationDistribution DurationDistribution::empirical(const std::vector<std::chrono::nanoseconds>& values,
+                                                     const std::string& name) {
+    DurationDistribution result;
+    if (values.empty()) {
+        return result;
+    }
+
+    result.kind = DistributionKind::Empirical;
+    result.source = name;
+    result.samples.reserve(values.size());
+    double sum = 0.0;
+    for (const auto& value : values) {
+        std::int64_t ns = nonNegative(value);
+        result.samples.push_back(ns);
+        sum += static_cast<double>(ns);
+        if (ns > result.second) {
+            result.second = ns;
+        }
+    }
+    result.first = static_cast<std::int64_t>(std::llround(sum / static_cast<double>(values.size())));
+    return result;
+}
+
+/**
+ * @brief Draw one duration
+ *
+ * Allocation-free; empirical draws pick one recorded sample uniformly.
+ *
+ * @param rng Caller's generator (one per thread)
+ * @return Non-negative duration
+ */
+std::chrono::nanoseconds DurationDistribution::sample(FastRandom& rng) const {
+    switch (kind) {
+        case DistributionKind::Uniform:
+            return std::chrono::nanoseconds(rng.uniform(first, second));
+
+        case DistributionKind::Exponential: {
+            double draw = -static_cast<double>(first) * std::log(1.0 - rng.uniformReal());
+            return std::chrono::nanoseconds(static_cast<std::int64_t>(draw));
+        }
+
+        case DistributionKind::Empirical: {
+            long long last = static_cast<long long>(samples.size()) - 1;
+            return std::chrono::nanoseconds(samples[static_cast<std::size_t>(rng.uniform(0, last))]);
+        }
+
+        case DistributionKind::Constant:
+        default:
+            return std::chrono::nanoseconds(first);
+    }
+}
+
+/**
+ * @brief Get the distribution kind
+ * @return Kind
+ */
+DistributionKind DurationDistribution::getKind() const {
+    return kind;
+}
+
+/**
+ * @brief Get the expected duration
+ * @return Mean in nanoseconds
+ */
+std::chrono::nanoseconds DurationDistribution::mean() const {
+    if (kind == DistributionKind::Uniform) {
+        return std::chrono::nanoseconds(first + (second - first) / 2);
+    }
+    return std::chrono::nanoseconds(first);
+}
+
+/**
+ * @brief Check whether every draw is zero (callers can skip the sleep)
+ * @return true for constant 0 (and equivalent shapes)
+ */
+bool DurationDistribution::isZero() const {
+    switch (kind) {
+        case DistributionKind::Uniform:
+        case DistributionKind::Empirical:
+            return second == 0;
+        case DistributionKind::Constant:
+        case DistributionKind::Exponential:
+        default:
+            return first == 0;
+    }
+}
+
+/**
+ * @brief Get the text form (e.g., "uniform:1ms:3ms")
+ * @return Description in parseDurationDistribution() syntax
+ */
+std::string DurationDistribution::describe() const {
+    switch (kind) {
+        case DistributionKind::Uniform:
+            return "uniform:" + formatDuration(std::chrono::nanoseconds(first)) + ":" +
+                   formatDuration(std::chrono::nanoseconds(second));
+        case DistributionKind::Exponential:
+            return "exp:" + formatDuration(std::chrono::nanoseconds(first));
+        case DistributionKind::Empirical:
+            return "empirical:" + source;
+        case DistributionKind::Constant:
+        default:
+            return "constant:" + formatDuration(std::chrono::nanoseconds(first));
+    }
+}
+
+/**
+ * @brief Parse a duration such as "250ns", "20us", "1.5ms" or "2s"
+ *
+ * Fractional values are rounded to the nearest nanosecond.
+ *
+ * @param text Duration text ("0" needs no unit)
+ * @param value Receives the duration
+ * @return true if the text is a valid non-negative duration
+ */
+bool parseDuration(const std::string& text, std::chrono::nanoseconds& value) {
+    std::string number = trim(text);
+    if (number.empty()) {
+        return false;
+    }
+
+    const char* begin = number.c_str();
+    char* end = nullptr;
+    double amount = std::strtod(begin, &end);
+    if (end == begin || !(amount >= 0.0)) {
+        return false;
+    }
+
+    std::string unit(end);
+    double scale = 0.0;
+    if (unit == "ns") {
+        scale = 1.0;
+    } else if (unit == "us") {
+        scale = 1e3;
+    } else if (unit == "ms") {
+        scale = 1e6;
+    } else if (unit == "s") {
+        scale = 1e9;
+    } else if (unit.empty() && amount == 0.0) {
+        scale = 1.0;
+    } else {
+        return false;
+    }
+
+    double ns = amount * scale;
+    if (ns >= static_cast<double>(std::numeric_limits<std::int64_t>::max())) {
+        return false;
+    }
+    value = std::chrono::nanoseconds(std::llround(ns));
+    return true;
+}
+
+/**
+ * @brief Format a duration with the largest unit that keeps it exact
+ * @param value Duration
+ * @return Text accepted by parseDuration() (e.g., "1500us")
+ */
+std::string formatDuration(std::chrono::nanoseconds value) {
+    long long ns = static_cast<long long>(value.count());
+    if (ns == 0) {
+        return "0";
+    }
+    if (ns % 1000000000LL == 0) {
+        return std::to_string(ns / 1000000000LL) + "s";
+    }
+    if (ns % 1000000LL == 0) {
+        return std::to_string(ns / 1000000LL) + "ms";
+    }
+    if (ns % 1000LL == 0) {
+        return std::to_string(ns / 1000LL) + "us";
+    }
+    return std::to_string(ns) + "ns";
+}
+
+/**
+ * @brief Parse a distribution ("constant:D", "uniform:MIN:MAX", "exp:MEAN",
+ *        "empirical:FILE"); a bare duration D means constant:D
+ * @param spec Distribution text
+ * @param distribution Receives the parsed distribution
+ * @return true on success, false (with a message on std::cerr) on error
+ */
+bool parseDurationDistribution(const std::string& spec, DurationDistribution& distribution) {
+    std::size_t colon = spec.find(':');
+    std::string kind = (colon == std::string::npos) ? std::string() : spec.substr(0, colon);
+    std::string args = (colon == std::string::npos) ? spec : spec.substr(colon + 1);
+
+    std::chrono::nanoseconds lo(0);
+    std::chrono::nanoseconds hi(0);
+    if (kind.empty() || kind == "constant") {
+        if (parseDuration(args, lo)) {
+            distribution = DurationDistribution::constant(lo);
+            return true;
+        }
+    } else if (kind == "uniform") {
+        std::size_t split = args.find(':');
+        if (split != std::string::npos && parseDuration(args.substr(0, split), lo) &&
+            parseDuration(args.substr(split + 1), hi) && hi >= lo) {
+            distribution = DurationDistribution::uniform(lo, hi);
+            return true;
+        }
+    } else if (kind == "exp" || kind == "exponential") {
+        if (parseDuration(args, lo)) {
+            distribution = DurationDistribution::exponential(lo);
+            return true;
+        }
+    } else if (kind == "empirical") {
+        return loadEmpiricalDistribution(args, distribution);
+    }
+
+    std::cerr << "Error: Invalid duration distribution '" << spec
+              << "' (expected constant:D, uniform:MIN:MAX, exp:MEAN or empirical:FILE;"
+              << " durations need an ns, us, ms or s suffix)" << std::endl;
+    return false;
+}
+
+/**
+ * @brief Load an empirical distribution from a file (one duration per line)
+ * @param filename Path to the file
+ * @param distribution Receives the distribution
+ * @return true on success, false (with a message on std::cerr) on error
+ */
+bool loadEmpiricalDistribution(const std::string& filename, DurationDistribution& distribution) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open duration file " << filename << std::endl;
+        return false;
+    }
+
+    std::vector<std::chrono::nanoseconds> values;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        std::string text = trim(line);
+        if (text.empty() || text[0] == '#') {
+            continue;
+        }
+
+        std::chrono::nanoseconds value(0);
+        if (!parseDuration(text, value)) {
+            std::cerr << "Error: Invalid duration '" << text << "' at line " << lineNumber
+                      << " in file " << filename << std::endl;
+            return false;
+        }
+        values.push_back(value);
+    }
+
+    if (values.empty()) {
+        std::cerr << "Error: No durations found in file " << filename << std::endl;
+        return false;
+    }
+
+    distribution = DurationDistribution::empirical(values, filename);
+    return true;
+}
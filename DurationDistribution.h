@@ -0,0 +1,176 @@
+/**
+ * @file DurationDistribution.h
+ * @brief Header file for the DurationDistribution class
+ *
+ * This file defines the random duration model used for the philosophers'
+ * think and eat times. Durations are kept in nanoseconds so that contention
+ * studies can use microsecond-scale critical sections, where the lock handoff
+ * itself is a visible part of the cycle.
+ *
+ * Supported distributions:
+ * - Constant:    always the same duration
+ * - Uniform:     uniform on [min, max]
+ * - Exponential: exponential with a given mean (memoryless arrivals)
+ * - Empirical:   resampled from recorded durations (e.g., a measured trace)
+ *
+ * Text form, accepted by parseDurationDistribution() and produced by
+ * describe() (durations take an ns, us, ms or s suffix):
+ *
+ *   constant:2s   uniform:1ms:3ms   exp:50us   empirical:FILE
+ *
+ * An empirical FILE holds one duration per line in the same notation; blank
+ * lines and lines starting with '#' are ignored.
+ *
+ * Thread Safety:
+ * - sample() only reads the distribution; the caller supplies the generator,
+ *   so one distribution can be shared by every philosopher
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef DURATION_DISTRIBUTION_H
+#define DURATION_DISTRIBUTION_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class FastRandom;
+
+/**
+ * @enum DistributionKind
+ * @brief Shapes available to DurationDistribution
+ */
+enum class DistributionKind {
+    Constant,     ///< Fixed duration
+    Uniform,      ///< Uniform on [min, max]
+    Exponential,  ///< Exponential with the given mean
+    Empirical     ///< Resampled from recorded durations
+};
+
+/**
+ * @brief Get the display name of a distribution kind
+ * @param kind Distribution kind
+ * @return Human-readable name
+ */
+const char* distributionKindName(DistributionKind kind);
+
+/**
+ * @class DurationDistribution
+ * @brief Random duration source with nanosecond resolution
+ */
+class DurationDistribution {
+private:
+    DistributionKind kind;                ///< Shape of the distribution
+    std::int64_t first;                   ///< Constant value, uniform minimum or exponential mean (ns)
+    std::int64_t second;                  ///< Uniform maximum (ns)
+    std::vector<std::int64_t> samples;    ///< Empirical durations (ns)
+    std::string source;                   ///< Empirical: file the samples came from
+
+public:
+    /**
+     * @brief Constructor - a constant zero duration
+     */
+    DurationDistribution();
+
+    /**
+     * @brief Always return the same duration
+     * @param value Duration (negative values become 0)
+     * @return The distribution
+     */
+    static DurationDistribution constant(std::chrono::nanoseconds value);
+
+    /**
+     * @brief Uniform on [lo, hi]
+     * @param lo Shortest duration (negative values become 0)
+     * @param hi Longest duration (raised to lo if smaller)
+     * @return The distribution
+     */
+    static DurationDistribution uniform(std::chrono::nanoseconds lo, std::chrono::nanoseconds hi);
+
+    /**
+     * @brief Exponential with the given mean
+     * @param mean Mean duration (negative values become 0)
+     * @return The distribution
+     */
+    static DurationDistribution exponential(std::chrono::nanoseconds mean);
+
+    /**
+     * @brief Resample recorded durations (each sample equally likely)
+     * @param values Recorded durations (negative values become 0; empty means constant 0)
+     * @param name Where the values came from (shown by describe())
+     * @return The distribution
+     */
+    static DurationDistribution empirical(const std::vector<std::chrono::nanoseconds>& values,
+                                          const std::string& name = "samples");
+
+    /**
+     * @brief Draw one duration
+     * @param rng Caller's generator (one per thread)
+     * @return Non-negative duration
+     */
+    std::chrono::nanoseconds sample(FastRandom& rng) const;
+
+    /**
+     * @brief Get the distribution kind
+     * @return Kind
+     */
+    DistributionKind getKind() const;
+
+    /**
+     * @brief Get the expected duration
+     * @return Mean in nanoseconds
+     */
+    std::chrono::nanoseconds mean() const;
+
+    /**
+     * @brief Check whether every draw is zero (callers can skip the sleep)
+     * @return true for constant 0 (and equivalent shapes)
+     */
+    bool isZero() const;
+
+    /**
+     * @brief Get the text form (e.g., "uniform:1ms:3ms")
+     * @return Description in parseDurationDistribution() syntax
+     */
+    std::string describe() const;
+};
+
+/**
+ * @brief Parse a duration such as "250ns", "20us", "1.5ms" or "2s"
+ * @param text Duration text ("0" needs no unit)
+ * @param value Receives the duration
+ * @return true if the text is a valid non-negative duration
+ */
+bool parseDuration(const std::string& text, std::chrono::nanoseconds& value);
+
+/**
+ * @brief Format a duration with the largest unit that keeps it exact
+ * @param value Duration
+ * @return Text accepted by parseDuration() (e.g., "1500us")
+ */
+std::string formatDuration(std::chrono::nanoseconds value);
+
+/**
+ * @brief Parse a distribution ("constant:D", "uniform:MIN:MAX", "exp:MEAN",
+ *        "empirical:FILE"); a bare duration D means constant:D
+ *
+ * Empirical files are loaded immediately.
+ *
+ * @param spec Distribution text
+ * @param distribution Receives the parsed distribution
+ * @return true on success, false (with a message on std::cerr) on error
+ */
+bool parseDurationDistribution(const std::string& spec, DurationDistribution& distribution);
+
+/**
+ * @brief Load an empirical distribution from a file (one duration per line)
+ * @param filename Path to the file
+ * @param distribution Receives the distribution
+ * @return true on success, false (with a message on std::cerr) on error
+ */
+bool loadEmpiricalDistribution(const std::string& filename, DurationDistribution& distribution);
+
+#endif // DURATION_DISTRIBUTION_H
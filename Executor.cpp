@@ -0,0 +1,40 @@
+/**
+ * @file Executor.cpp
+ * @brief Factory and name helpers for the Executor implementations
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "Executor.h"
+#include "ThreadPool.h"
+#include "WorkStealingPool.h"
+
+std::unique_ptr<Executor> createExecutor(ExecutorType type, unsigned int numThreads, const std::vector<int>& cpus) {
+    switch (type) {
+        case ExecutorType::WorkStealing:
+            return std::unique_ptr<Executor>(new WorkStealingPool(numThreads, cpus));
+        case ExecutorType::GlobalQueue:
+        default:
+            return std::unique_ptr<Executor>(new ThreadPool(numThreads, cpus));
+    }
+}
+
+bool parseExecutorType(const std::string& name, ExecutorType& type) {
+    if (name == "pool") {
+        type = ExecutorType::GlobalQueue;
+    } else if (name == "stealing") {
+        type = ExecutorType::WorkStealing;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* executorTypeName(ExecutorType type) {
+    switch (type) {
+        case ExecutorType::WorkStealing: return "Work-stealing";
+        case ExecutorType::GlobalQueue:
+        default:                         return "Global queue";
+    }
+}
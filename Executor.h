@@ -0,0 +1,117 @@
+/**
+ * @file Executor.h
+ * @brief Header file for the Executor interface
+ *
+ * This file defines the common interface of the worker pools that run
+ * simulation tasks, so that callers such as ProcessSimulator can switch
+ * between them:
+ *
+ * - ThreadPool: one shared FIFO queue (global order, one lock for everybody)
+ * - WorkStealingPool: one run queue per worker; idle workers steal from busy
+ *   ones, so submit and dispatch rarely touch the same lock
+ *
+ * Both report ExecutorStats (tasks executed, steals, queue depth) for
+ * comparing them.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @enum ExecutorType
+ * @brief Worker pool implementations available to the simulations
+ */
+enum class ExecutorType {
+    GlobalQueue,   ///< ThreadPool: single shared FIFO queue
+    WorkStealing   ///< WorkStealingPool: per-worker queues with stealing
+};
+
+/**
+ * @struct ExecutorStats
+ * @brief Counters describing how a pool distributed its tasks
+ */
+struct ExecutorStats {
+    std::uint64_t tasksExecuted;   ///< Tasks run to completion
+    std::uint64_t steals;          ///< Successful steal operations (0 for the global queue)
+    std::uint64_t tasksStolen;     ///< Tasks moved by steals
+    std::uint64_t failedSteals;    ///< Steal attempts that found every victim empty
+    std::size_t maxQueueDepth;     ///< Deepest any single run queue has been
+};
+
+/**
+ * @class Executor
+ * @brief Interface of a fixed-size pool of worker threads
+ */
+class Executor {
+public:
+    virtual ~Executor() {}
+
+    /**
+     * @brief Queue a task for execution on one of the workers
+     *
+     * May be called from any thread, including from inside a running task.
+     *
+     * @param task Callable to run
+     */
+    virtual void submit(std::function<void()> task) = 0;
+
+    /**
+     * @brief Block until all submitted tasks have completed
+     */
+    virtual void wait() = 0;
+
+    /**
+     * @brief Get the number of worker threads
+     * @return Worker count
+     */
+    virtual unsigned int size() const = 0;
+
+    /**
+     * @brief Get the pool's counters (aggregated over all workers)
+     * @return Statistics since the pool was created
+     */
+    virtual ExecutorStats getStats() const = 0;
+
+    /**
+     * @brief Get the display name of the pool implementation
+     * @return Human-readable name
+     */
+    virtual const char* name() const = 0;
+};
+
+/**
+ * @brief Create a worker pool
+ * @param type Pool implementation
+ * @param numThreads Number of workers (0 selects hardware concurrency)
+ * @param cpus CPU of worker i at index i % size (empty leaves workers unpinned)
+ * @return Newly created pool (workers already started)
+ */
+std::unique_ptr<Executor> createExecutor(ExecutorType type, unsigned int numThreads,
+                                         const std::vector<int>& cpus = std::vector<int>());
+
+/**
+ * @brief Parse an executor name ("pool" or "stealing")
+ * @param name Executor name
+ * @param type Receives the parsed type
+ * @return true if the name is recognised
+ */
+bool parseExecutorType(const std::string& name, ExecutorType& type);
+
+/**
+ * @brief Get the display name of an executor type
+ * @param type Executor type
+ * @return Human-readable name
+ */
+const char* executorTypeName(ExecutorType type);
+
+#endif // EXECUTOR_H
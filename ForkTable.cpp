@@ -0,0 +1,55 @@
+/**
+ * @file ForkTable.cpp
+ * @brief Factory and name helpers for the ForkTable lock types
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "ForkTable.h"
+#include "SpinParkLock.h"
+#include "ReaderBiasedLock.h"
+#include <shared_mutex>
+
+std::unique_ptr<ForkTableBase> createForkTable(ForkLockType type, int count) {
+    switch (type) {
+        case ForkLockType::SpinPark:
+            return std::unique_ptr<ForkTableBase>(
+                new ForkTable<SpinParkLock>(count, forkLockTypeName(type)));
+        case ForkLockType::SharedMutex:
+            return std::unique_ptr<ForkTableBase>(
+                new ForkTable<std::shared_mutex>(count, forkLockTypeName(type)));
+        case ForkLockType::ReaderBiased:
+            return std::unique_ptr<ForkTableBase>(
+                new ForkTable<ReaderBiasedLock>(count, forkLockTypeName(type)));
+        case ForkLockType::Mutex:
+        default:
+            return std::unique_ptr<ForkTableBase>(
+                new ForkTable<std::mutex>(count, forkLockTypeName(type)));
+    }
+}
+
+bool parseForkLockType(const std::string& name, ForkLockType& type) {
+    if (name == "mutex") {
+        type = ForkLockType::Mutex;
+    } else if (name == "spin") {
+        type = ForkLockType::SpinPark;
+    } else if (name == "shared") {
+        type = ForkLockType::SharedMutex;
+    } else if (name == "biased") {
+        type = ForkLockType::ReaderBiased;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* forkLockTypeName(ForkLockType type) {
+    switch (type) {
+        case ForkLockType::SpinPark:     return "Spin-then-park";
+        case ForkLockType::SharedMutex:  return "std::shared_mutex";
+        case ForkLockType::ReaderBiased: return "Reader-biased (per-core reader counters)";
+        case ForkLockType::Mutex:
+        default:                         return "std::mutex";
+    }
+}
@@ -0,0 +1,352 @@
+/**
+ * @file ForkTable.h
+ * @brief Header file for the ForkTable interface and its lock-type template
+ *
+ * This file defines the storage for the fork locks of DiningPhilosophers so
+ * that the lock implementation can be swapped and benchmarked:
+ *
+ * - ForkTableBase: the interface the simulation calls (lock, try_lock,
+ *   unlock, their shared counterparts, and the all-or-nothing set lock used
+ *   by the TryLock strategy)
+ * - ForkTable<Lock>: one Lock per fork, each padded to its own cache line,
+ *   for any type meeting the standard Lockable requirements. A Lock that is
+ *   also SharedLockable (lock_shared, try_lock_shared, unlock_shared) lets
+ *   readers hold a fork together; for any other Lock a shared acquisition
+ *   is an exclusive one.
+ * - ForkLockType / createForkTable(): the runtime choice between the
+ *   available instantiations (std::mutex, SpinParkLock, std::shared_mutex
+ *   and ReaderBiasedLock)
+ * - placeOnNodes(): move each lock to the NUMA node of the philosopher that
+ *   owns it (see bindToNodes() in CpuTopology.h)
+ *
+ * Adding a lock type needs one enum value and one case in createForkTable().
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef FORK_TABLE_H
+#define FORK_TABLE_H
+
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "CpuTopology.h"
+
+/**
+ * @enum ForkLockType
+ * @brief Lock implementations available for the forks
+ */
+enum class ForkLockType {
+    Mutex,     ///< std::mutex (futex sleep on every contended acquisition)
+    SpinPark,      ///< SpinParkLock (TTAS spin with backoff, then park)
+    SharedMutex,   ///< std::shared_mutex (readers share a fork)
+    ReaderBiased   ///< ReaderBiasedLock (readers share a fork through per-core counters)
+};
+
+/**
+ * @enum ForkAccess
+ * @brief How a philosopher holds its forks for one meal
+ */
+enum class ForkAccess {
+    Exclusive,  ///< Alone (a write)
+    Shared      ///< Together with other shared holders (a read)
+};
+
+/**
+ * @concept SharedLockable
+ * @brief A lock that can also be held by several readers at once
+ */
+template <typename Lock>
+concept SharedLockable = requires(Lock& lock) {
+    lock.lock_shared();
+    { lock.try_lock_shared() } -> std::convertible_to<bool>;
+    lock.unlock_shared();
+};
+
+/**
+ * @class ForkTableBase
+ * @brief Interface of a table of fork locks
+ */
+class ForkTableBase {
+public:
+    virtual ~ForkTableBase() {}
+
+    /**
+     * @brief Acquire one fork's lock (blocking)
+     * @param f Fork index
+     */
+    virtual void lock(int f) = 0;
+
+    /**
+     * @brief Acquire one fork's lock only if it is free
+     * @param f Fork index
+     * @return true if the lock was acquired
+     */
+    virtual bool try_lock(int f) = 0;
+
+    /**
+     * @brief Release one fork's lock
+     * @param f Fork index
+     */
+    virtual void unlock(int f) = 0;
+
+    /**
+     * @brief Acquire one fork's lock shared (blocking; exclusive if sharesReads() is false)
+     * @param f Fork index
+     */
+    virtual void lock_shared(int f) = 0;
+
+    /**
+     * @brief Acquire one fork's lock shared only if no exclusive holder has it
+     * @param f Fork index
+     * @return true if the lock was acquired
+     */
+    virtual bool try_lock_shared(int f) = 0;
+
+    /**
+     * @brief Release a shared acquisition of one fork's lock
+     * @param f Fork index
+     */
+    virtual void unlock_shared(int f) = 0;
+
+    /**
+     * @brief Acquire a set of forks' locks without deadlock (std::lock back-off)
+     *
+     * Blocks on one fork, then tries the rest; on failure releases everything
+     * and blocks on the fork that was busy, so no fork is held while waiting.
+     *
+     * @param ids Fork indexes (distinct)
+     * @param count Number of forks
+     * @param access Exclusive or shared acquisition of every fork
+     */
+    virtual void lockAll(const int* ids, std::size_t count, ForkAccess access) = 0;
+
+    /**
+     * @brief Acquire a set of forks' locks only if all are available
+     * @param ids Fork indexes (distinct)
+     * @param count Number of forks
+     * @param access Exclusive or shared acquisition of every fork
+     * @return true if every lock was acquired (none is held otherwise)
+     */
+    virtual bool tryLockAll(const int* ids, std::size_t count, ForkAccess access) = 0;
+
+    /**
+     * @brief Check whether shared acquisitions can overlap
+     * @return true if the lock type is SharedLockable
+     */
+    virtual bool sharesReads() const = 0;
+
+    /**
+     * @brief Get the number of forks
+     * @return Fork count
+     */
+    virtual int size() const = 0;
+
+    /**
+     * @brief Prefer NUMA nodes for the lock slots
+     * @param nodes Node of fork i at index i
+     * @return Number of pages bound (0 on single-node systems)
+     */
+    virtual std::size_t placeOnNodes(const std::vector<int>& nodes) = 0;
+
+    /**
+     * @brief Get the display name of the lock implementation
+     * @return Human-readable name
+     */
+    virtual const char* name() const = 0;
+
+    /**
+     * @brief Acquire one fork's lock in the given mode (blocking)
+     * @param f Fork index
+     * @param access Exclusive or shared
+     */
+    void acquire(int f, ForkAccess access) {
+        if (access == ForkAccess::Shared) {
+            lock_shared(f);
+        } else {
+            lock(f);
+        }
+    }
+
+    /**
+     * @brief Acquire one fork's lock in the given mode only if it is available
+     * @param f Fork index
+     * @param access Exclusive or shared
+     * @return true if the lock was acquired
+     */
+    bool tryAcquire(int f, ForkAccess access) {
+        return (access == ForkAccess::Shared) ? try_lock_shared(f) : try_lock(f);
+    }
+
+    /**
+     * @brief Release one fork's lock acquired in the given mode
+     * @param f Fork index
+     * @param access Mode it was acquired in
+     */
+    void release(int f, ForkAccess access) {
+        if (access == ForkAccess::Shared) {
+            unlock_shared(f);
+        } else {
+            unlock(f);
+        }
+    }
+};
+
+/**
+ * @class ForkTable
+ * @brief One Lock per fork, each on its own cache line
+ *
+ * @tparam Lock Lockable type (lock, try_lock, unlock), optionally SharedLockable; need not be copyable
+ */
+template <typename Lock>
+class ForkTable : public ForkTableBase {
+private:
+    static const std::size_t CACHE_LINE_SIZE = 64;  ///< Alignment of each lock slot
+
+    /**
+     * @struct Slot
+     * @brief A fork lock on its own cache line (no false sharing with neighbours)
+     */
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        Lock lock;  ///< The fork itself (CRITICAL RESOURCE)
+    };
+
+    std::vector<Slot> slots;  ///< One slot per fork
+    const char* lockName;     ///< Display name of Lock
+
+    /**
+     * @brief Acquire a fork lock in a mode (shared falls back to exclusive if Lock is not SharedLockable)
+     */
+    static void lockSlot(Lock& lock, ForkAccess access) {
+        if constexpr (SharedLockable<Lock>) {
+            if (access == ForkAccess::Shared) {
+                lock.lock_shared();
+                return;
+            }
+        }
+        lock.lock();
+    }
+
+    /**
+     * @brief Acquire a fork lock in a mode only if it is available
+     */
+    static bool tryLockSlot(Lock& lock, ForkAccess access) {
+        if constexpr (SharedLockable<Lock>) {
+            if (access == ForkAccess::Shared) {
+                return lock.try_lock_shared();
+            }
+        }
+        return lock.try_lock();
+    }
+
+    /**
+     * @brief Release a fork lock acquired in a mode
+     */
+    static void unlockSlot(Lock& lock, ForkAccess access) {
+        if constexpr (SharedLockable<Lock>) {
+            if (access == ForkAccess::Shared) {
+                lock.unlock_shared();
+                return;
+            }
+        }
+        lock.unlock();
+    }
+
+    /**
+     * @brief Try every fork of a set except one already held
+     * @param ids Fork indexes
+     * @param count Number of forks
+     * @param held Index in ids of the fork the caller holds
+     * @param access Mode of every acquisition
+     * @return count if all are now held, else the index in ids of a busy fork (none is held then)
+     */
+    std::size_t lockRest(const int* ids, std::size_t count, std::size_t held, ForkAccess access) {
+        for (std::size_t k = 0; k < count; k++) {
+            if (k == held || tryLockSlot(slots[ids[k]].lock, access)) {
+                continue;
+            }
+            for (std::size_t j = 0; j < k; j++) {
+                if (j != held) {
+                    unlockSlot(slots[ids[j]].lock, access);
+                }
+            }
+            unlockSlot(slots[ids[held]].lock, access);
+            return k;
+        }
+        return count;
+    }
+
+public:
+    /**
+     * @brief Constructor - creates count unlocked forks
+     * @param count Number of forks
+     * @param displayName Display name of Lock
+     */
+    ForkTable(int count, const char* displayName)
+        : slots(static_cast<std::size_t>(count)), lockName(displayName) {}
+
+    void lock(int f) override { slots[f].lock.lock(); }
+    bool try_lock(int f) override { return slots[f].lock.try_lock(); }
+    void unlock(int f) override { slots[f].lock.unlock(); }
+    void lock_shared(int f) override { lockSlot(slots[f].lock, ForkAccess::Shared); }
+    bool try_lock_shared(int f) override { return tryLockSlot(slots[f].lock, ForkAccess::Shared); }
+    void unlock_shared(int f) override { unlockSlot(slots[f].lock, ForkAccess::Shared); }
+    void lockAll(const int* ids, std::size_t count, ForkAccess access) override {
+        std::size_t first = 0;
+        for (;;) {
+            lockSlot(slots[ids[first]].lock, access);
+            std::size_t busy = lockRest(ids, count, first, access);
+            if (busy == count) {
+                return;
+            }
+            first = busy;
+        }
+    }
+    bool tryLockAll(const int* ids, std::size_t count, ForkAccess access) override {
+        if (count == 0) {
+            return true;
+        }
+        if (!tryLockSlot(slots[ids[0]].lock, access)) {
+            return false;
+        }
+        return lockRest(ids, count, 0, access) == count;
+    }
+    bool sharesReads() const override { return SharedLockable<Lock>; }
+    int size() const override { return static_cast<int>(slots.size()); }
+    std::size_t placeOnNodes(const std::vector<int>& nodes) override {
+        return bindToNodes(slots.data(), sizeof(Slot), nodes);
+    }
+    const char* name() const override { return lockName; }
+};
+
+template <typename Lock>
+const std::size_t ForkTable<Lock>::CACHE_LINE_SIZE;
+
+/**
+ * @brief Create a table of fork locks
+ * @param type Lock implementation
+ * @param count Number of forks
+ * @return Newly created table (all forks unlocked)
+ */
+std::unique_ptr<ForkTableBase> createForkTable(ForkLockType type, int count);
+
+/**
+ * @brief Parse a fork lock name ("mutex", "spin", "shared" or "biased")
+ * @param name Lock name
+ * @param type Receives the parsed type
+ * @return true if the name is recognised
+ */
+bool parseForkLockType(const std::string& name, ForkLockType& type);
+
+/**
+ * @brief Get the display name of a fork lock type
+ * @param type Lock type
+ * @return Human-readable name
+ */
+const char* forkLockTypeName(ForkLockType type);
+
+#endif // FORK_TABLE_H
@@ -0,0 +1,227 @@
+/**
+ * @file LatencyHistogram.cpp
+ * @brief Implementation of the LatencyHistogram class
+ *
+ * Bucket layout (S = SUB_BUCKETS, H = S / 2):
+ * - Values 0 .. S-1 each have their own bucket (exact)
+ * - A value v >= S with highest set bit m falls in bucket
+ *   S + (m - SUB_BUCKET_BITS) * H + ((v >> (m - SUB_BUCKET_BITS + 1)) - H),
+ *   i.e. the range [2^m, 2^(m+1)) is split into H buckets of width 2^(m-6)
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "LatencyHistogram.h"
+#include <cmath>
+
+const unsigned int LatencyHistogram::SUB_BUCKET_BITS;
+const std::uint64_t LatencyHistogram::SUB_BUCKETS;
+const unsigned int LatencyHistogram::MAX_VALUE_BITS;
+const std::uint64_t LatencyHistogram::MAX_VALUE;
+
+namespace {
+
+const std::uint64_t HALF_BUCKETS = LatencyHistogram::SUB_BUCKETS / 2;
+
+/**
+ * @brief Total number of buckets for the configured range
+ */
+const std::size_t BUCKET_COUNT = static_cast<std::size_t>(
+    LatencyHistogram::SUB_BUCKETS +
+    (LatencyHistogram::MAX_VALUE_BITS - LatencyHistogram::SUB_BUCKET_BITS) * HALF_BUCKETS);
+
+/**
+ * @brief Index of the highest set bit (value must be non-zero)
+ */
+inline unsigned int highestBit(std::uint64_t value) {
+    return 63u - static_cast<unsigned int>(__builtin_clzll(value));
+}
+
+} // namespace
+
+/**
+ * @brief Constructor - creates an empty histogram
+ */
+LatencyHistogram::LatencyHistogram()
+    : counts(BUCKET_COUNT, 0), total(0), minimum(0), maximum(0), sum(0.0L) {
+}
+
+std::size_t LatencyHistogram::bucketIndex(std::uint64_t value) {
+    if (value < SUB_BUCKETS) {
+        return static_cast<std::size_t>(value);
+    }
+    unsigned int msb = highestBit(value);
+    unsigned int shift = msb - SUB_BUCKET_BITS + 1;
+    return static_cast<std::size_t>(SUB_BUCKETS + (msb - SUB_BUCKET_BITS) * HALF_BUCKETS +
+                                    ((value >> shift) - HALF_BUCKETS));
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(std::size_t index) {
+    if (index < SUB_BUCKETS) {
+        return static_cast<std::uint64_t>(index);
+    }
+    std::uint64_t offset = static_cast<std::uint64_t>(index) - SUB_BUCKETS;
+    unsigned int shift = static_cast<unsigned int>(offset / HALF_BUCKETS) + 1;
+    std::uint64_t mantissa = HALF_BUCKETS + offset % HALF_BUCKETS;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+/**
+ * @brief Record one latency
+ *
+ * Values above MAX_VALUE are counted in the last bucket; min/max/mean still
+ * use the exact value.
+ *
+ * @param nanoseconds Latency in nanoseconds
+ */
+void LatencyHistogram::record(std::uint64_t nanoseconds) {
+    std::uint64_t clamped = (nanoseconds > MAX_VALUE) ? MAX_VALUE : nanoseconds;
+    counts[bucketIndex(clamped)]++;
+
+    if (total == 0 || nanoseconds < minimum) {
+        minimum = nanoseconds;
+    }
+    if (nanoseconds > maximum) {
+        maximum = nanoseconds;
+    }
+    total++;
+    sum += static_cast<long double>(nanoseconds);
+}
+
+/**
+ * @brief Add every value recorded in another histogram
+ * @param other Histogram to merge in
+ */
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.total == 0) {
+        return;
+    }
+    for (std::size_t i = 0; i < counts.size(); i++) {
+        counts[i] += other.counts[i];
+    }
+    if (total == 0 || other.minimum < minimum) {
+        minimum = other.minimum;
+    }
+    if (other.maximum > maximum) {
+        maximum = other.maximum;
+    }
+    total += other.total;
+    sum += other.sum;
+}
+
+/**
+ * @brief Remove all recorded values
+ */
+void LatencyHistogram::reset() {
+    for (auto& bucket : counts) {
+        bucket = 0;
+    }
+    total = 0;
+    minimum = 0;
+    maximum = 0;
+    sum = 0.0L;
+}
+
+/**
+ * @brief Copy out the non-empty buckets
+ * @param buckets Receives (bucket index, count) pairs
+ */
+void LatencyHistogram::nonEmptyBuckets(std::vector<std::pair<std::uint32_t, std::uint64_t> >& buckets) const {
+    buckets.clear();
+    for (std::size_t i = 0; i < counts.size(); i++) {
+        if (counts[i] != 0) {
+            buckets.push_back(std::make_pair(static_cast<std::uint32_t>(i), counts[i]));
+        }
+    }
+}
+
+/**
+ * @brief Rebuild the histogram from non-empty buckets
+ * @param buckets (bucket index, count) pairs
+ * @param minimumValue Smallest recorded value
+ * @param maximumValue Largest recorded value
+ * @param valueSum Sum of the recorded values
+ * @return false if a bucket index is out of range
+ */
+bool LatencyHistogram::restore(const std::vector<std::pair<std::uint32_t, std::uint64_t> >& buckets,
+                               std::uint64_t minimumValue, std::uint64_t maximumValue, double valueSum) {
+    reset();
+    for (const auto& bucket : buckets) {
+        if (bucket.first >= counts.size()) {
+            reset();
+            return false;
+        }
+        counts[bucket.first] += bucket.second;
+        total += bucket.second;
+    }
+    if (total > 0) {
+        minimum = minimumValue;
+        maximum = maximumValue;
+        sum = valueSum;
+    }
+    return true;
+}
+
+/**
+ * @brief Check that every bucket index is in range
+ * @param buckets (bucket index, count) pairs
+ * @return true if restore() would accept the buckets
+ */
+bool LatencyHistogram::validBuckets(const std::vector<std::pair<std::uint32_t, std::uint64_t> >& buckets) {
+    for (const auto& bucket : buckets) {
+        if (bucket.first >= BUCKET_COUNT) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::uint64_t LatencyHistogram::count() const {
+    return total;
+}
+
+std::uint64_t LatencyHistogram::min() const {
+    return minimum;
+}
+
+std::uint64_t LatencyHistogram::max() const {
+    return maximum;
+}
+
+double LatencyHistogram::mean() const {
+    return (total == 0) ? 0.0 : static_cast<double>(sum / static_cast<long double>(total));
+}
+
+/**
+ * @brief Get the value at a percentile
+ *
+ * Walks the buckets until the cumulative count reaches ceil(p/100 * count).
+ *
+ * @param percentile Percentile in [0, 100] (e.g. 99.9)
+ * @return Value in nanoseconds (0 if empty)
+ */
+std::uint64_t LatencyHistogram::percentile(double percentile) const {
+    if (total == 0) {
+        return 0;
+    }
+    if (percentile <= 0.0) {
+        return minimum;
+    }
+
+    double fraction = (percentile >= 100.0) ? 1.0 : percentile / 100.0;
+    std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(fraction * static_cast<double>(total)));
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < counts.size(); i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            std::uint64_t bound = bucketUpperBound(i);
+            return (bound < maximum) ? bound : maximum;
+        }
+    }
+    return maximum;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file LatencyHistogram.h
+ * @brief Header file for the LatencyHistogram class
+ *
+ * This file defines a fixed-size, HDR-style latency histogram. Values (in
+ * nanoseconds) are counted in log-linear buckets: every power-of-two range is
+ * split into SUB_BUCKETS / 2 equal sub-buckets, so recorded values keep a
+ * relative precision better than 2 / SUB_BUCKETS (about 1.6%) from 1 ns up to
+ * MAX_VALUE, while record() stays a handful of integer operations.
+ *
+ * Thread Safety:
+ * - A histogram is not synchronized: each one has a single writer (for example
+ *   the philosopher it belongs to) and is read after the writer has finished
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @class LatencyHistogram
+ * @brief Log-linear histogram of nanosecond latencies with percentile queries
+ */
+class LatencyHistogram {
+public:
+    static const unsigned int SUB_BUCKET_BITS = 7;                      ///< log2 of the linear range
+    static const std::uint64_t SUB_BUCKETS = 1ull << SUB_BUCKET_BITS;   ///< Values below this are exact
+    static const unsigned int MAX_VALUE_BITS = 40;                      ///< Largest tracked exponent
+    static const std::uint64_t MAX_VALUE = (1ull << MAX_VALUE_BITS) - 1; ///< Larger values are clamped (~18 min)
+
+private:
+    std::vector<std::uint64_t> counts;  ///< One counter per bucket
+    std::uint64_t total;                ///< Number of recorded values
+    std::uint64_t minimum;              ///< Smallest recorded value
+    std::uint64_t maximum;              ///< Largest recorded value (unclamped)
+    long double sum;                    ///< Sum of recorded values (for the mean)
+
+    /**
+     * @brief Map a value to its bucket index
+     */
+    static std::size_t bucketIndex(std::uint64_t value);
+
+    /**
+     * @brief Highest value that maps to a bucket
+     */
+    static std::uint64_t bucketUpperBound(std::size_t index);
+
+public:
+    /**
+     * @brief Constructor - creates an empty histogram
+     */
+    LatencyHistogram();
+
+    /**
+     * @brief Record one latency
+     * @param nanoseconds Latency in nanoseconds
+     */
+    void record(std::uint64_t nanoseconds);
+
+    /**
+     * @brief Add every value recorded in another histogram
+     * @param other Histogram to merge in
+     */
+    void merge(const LatencyHistogram& other);
+
+    /**
+     * @brief Remove all recorded values
+     */
+    void reset();
+
+    /**
+     * @brief Copy out the non-empty buckets (for checkpoints)
+     * @param buckets Receives (bucket index, count) pairs in bucket order
+     */
+    void nonEmptyBuckets(std::vector<std::pair<std::uint32_t, std::uint64_t> >& buckets) const;
+
+    /**
+     * @brief Replace the contents with buckets copied out by nonEmptyBuckets()
+     * @param buckets (bucket index, count) pairs
+     * @param minimumValue Smallest recorded value
+     * @param maximumValue Largest recorded value
+     * @param valueSum Sum of the recorded values
+     * @return false (and the histogram is left empty) if a bucket index is out of range
+     */
+    bool restore(const std::vector<std::pair<std::uint32_t, std::uint64_t> >& buckets,
+                 std::uint64_t minimumValue, std::uint64_t maximumValue, double valueSum);
+
+    /**
+     * @brief Check buckets copied out by nonEmptyBuckets() before restoring them
+     * @param buckets (bucket index, count) pairs
+     * @return true if every bucket index is in range (restore() would succeed)
+     */
+    static bool validBuckets(const std::vector<std::pair<std::uint32_t, std::uint64_t> >& buckets);
+
+    /**
+     * @brief Get the number of recorded values
+     * @return Count
+     */
+    std::uint64_t count() const;
+
+    /**
+     * @brief Get the smallest recorded value
+     * @return Minimum in nanoseconds (0 if empty)
+     */
+    std::uint64_t min() const;
+
+    /**
+     * @brief Get the largest recorded value
+     * @return Maximum in nanoseconds (0 if empty)
+     */
+    std::uint64_t max() const;
+
+    /**
+     * @brief Get the arithmetic mean of the recorded values
+     * @return Mean in nanoseconds (0 if empty)
+     */
+    double mean() const;
+
+    /**
+     * @brief Get the value at a percentile
+     *
+     * Returns the upper bound of the bucket holding the requested rank, capped
+     * at the recorded maximum.
+     *
+     * @param percentile Percentile in [0, 100] (e.g. 99.9)
+     * @return Value in nanoseconds (0 if empty)
+     */
+    std::uint64_t percentile(double percentile) const;
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,442 @@
+/**
+ * @file LiveMetrics.cpp
+ * @brief Implementation of the live progress metrics exporter
+ *
+ * HTTP (POSIX): a blocking IPv4 listening socket polled every
+ * POLL_INTERVAL_MS so stop() is noticed quickly. Requests are answered one
+ * at a time on the exporter thread with "Connection: close"; a scrape is
+ * small enough that a second scraper simply waits in the accept backlog.
+ *
+ * Other platforms: start() refuses the Http transport; snapshot files are
+ * written with the standard library only.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "LiveMetrics.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "DurationDistribution.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LIVE_METRICS_USE_SOCKETS 1
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+const int LiveMetrics::DEFAULT_INTERVAL_MS;
+const std::size_t LiveMetrics::MAX_LABELLED_SERIES;
+
+namespace {
+
+const int POLL_INTERVAL_MS = 100;         ///< Longest time the HTTP loop takes to notice stop()
+const std::size_t MAX_REQUEST_BYTES = 8192;  ///< Request header bytes read at most
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// MetricsWriter
+// ---------------------------------------------------------------------------
+
+MetricsWriter::MetricsWriter(std::ostream& out) : out(out) {
+}
+
+void MetricsWriter::family(const char* name, const char* type, const char* help) {
+    out << "# HELP " << name << ' ' << help << '\n'
+        << "# TYPE " << name << ' ' << type << '\n';
+}
+
+void MetricsWriter::sample(const char* name, double value) {
+    out << name << ' ' << std::setprecision(15) << value << '\n';
+}
+
+void MetricsWriter::sample(const char* name, const char* label, long long labelValue, double value) {
+    out << name << '{' << label << "=\"" << labelValue << "\"} " << std::setprecision(15) << value << '\n';
+}
+
+// ---------------------------------------------------------------------------
+// LiveMetrics
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Constructor - no sources and no exporter
+ */
+LiveMetrics::LiveMetrics()
+    : startTime(std::chrono::steady_clock::now()), interval(std::chrono::milliseconds(DEFAULT_INTERVAL_MS)),
+      stopping(false), listenSocket(-1), exports(0) {
+    target.transport = LiveMetricsTransport::Off;
+    target.port = 0;
+}
+
+/**
+ * @brief Destructor - stops the exporter if it is still running
+ */
+LiveMetrics::~LiveMetrics() {
+    stop();
+}
+
+/**
+ * @brief Register the live collector of a source
+ * @param name Source name
+ * @param collector Function writing the source's metrics
+ */
+void LiveMetrics::addCollector(const std::string& name, const Collector& collector) {
+    std::lock_guard<std::mutex> lock(collectorMutex);
+    for (auto& source : sources) {
+        if (source.name == name) {
+            source.collector = collector;
+            source.retained.clear();
+            return;
+        }
+    }
+    Source source;
+    source.name = name;
+    source.collector = collector;
+    sources.push_back(source);
+}
+
+/**
+ * @brief Render a source one last time and drop its collector
+ * @param name Source name
+ */
+void LiveMetrics::removeCollector(const std::string& name) {
+    std::lock_guard<std::mutex> lock(collectorMutex);
+    for (auto& source : sources) {
+        if (source.name == name && source.collector) {
+            std::ostringstream text;
+            MetricsWriter writer(text);
+            source.collector(writer);
+            source.retained = text.str();
+            source.collector = Collector();
+        }
+    }
+}
+
+/**
+ * @brief Render the uptime and every source
+ * @return Exposition text
+ */
+std::string LiveMetrics::render() const {
+    std::ostringstream text;
+    MetricsWriter writer(text);
+    writer.family("sim_uptime_seconds", "gauge", "Seconds since the metrics exporter was created");
+    writer.sample("sim_uptime_seconds",
+                  std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+
+    std::lock_guard<std::mutex> lock(collectorMutex);
+    for (const auto& source : sources) {
+        if (source.collector) {
+            source.collector(writer);
+        } else {
+            text << source.retained;
+        }
+    }
+    return text.str();
+}
+
+/**
+ * @brief Write the rendered metrics to path + ".tmp" and rename it over path
+ * @param path Destination
+ * @return true on success
+ */
+bool LiveMetrics::writeSnapshot(const std::string& path) const {
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Error: Cannot create file " << temporary << std::endl;
+            return false;
+        }
+        file << render();
+        if (!file) {
+            std::cerr << "Error: Failed to write " << temporary << std::endl;
+            return false;
+        }
+    }
+    // rename() does not replace an existing file on every platform
+    if (std::rename(temporary.c_str(), path.c_str()) != 0 &&
+        (std::remove(path.c_str()) != 0 || std::rename(temporary.c_str(), path.c_str()) != 0)) {
+        std::cerr << "Error: Cannot replace " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Open the transport and start the exporter thread
+ * @param newTarget Transport
+ * @param snapshotInterval Time between two snapshot files
+ * @return false if the port cannot be opened or HTTP is unsupported here
+ */
+bool LiveMetrics::start(const LiveMetricsTarget& newTarget, std::chrono::nanoseconds snapshotInterval) {
+    stop();
+    target = newTarget;
+    interval = std::max<std::chrono::nanoseconds>(snapshotInterval, std::chrono::milliseconds(1));
+    stopping = false;
+
+    if (target.transport == LiveMetricsTransport::Off) {
+        return true;
+    }
+    if (target.transport == LiveMetricsTransport::Snapshot) {
+        if (!writeSnapshot(target.path)) {
+            target.transport = LiveMetricsTransport::Off;
+            return false;
+        }
+        exports.fetch_add(1, std::memory_order_relaxed);
+        exporter = std::thread(&LiveMetrics::snapshotLoop, this);
+        return true;
+    }
+
+#ifdef LIVE_METRICS_USE_SOCKETS
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<std::uint16_t>(target.port));
+    if (inet_pton(AF_INET, target.address.c_str(), &address.sin_addr) != 1) {
+        std::cerr << "Error: Invalid listen address " << target.address << std::endl;
+        target.transport = LiveMetricsTransport::Off;
+        return false;
+    }
+
+    listenSocket = ::socket(AF_INET, SOCK_STREAM, 0);
+    int reuse = 1;
+    if (listenSocket < 0 ||
+        setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0 ||
+        ::bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listenSocket, 16) != 0) {
+        std::cerr << "Error: Cannot listen on " << target.address << ":" << target.port
+                  << " (" << std::strerror(errno) << ")" << std::endl;
+        if (listenSocket >= 0) {
+            ::close(listenSocket);
+            listenSocket = -1;
+        }
+        target.transport = LiveMetricsTransport::Off;
+        return false;
+    }
+    exporter = std::thread(&LiveMetrics::serve, this);
+    return true;
+#else
+    std::cerr << "Error: The HTTP metrics endpoint needs POSIX sockets; use file:PATH instead" << std::endl;
+    target.transport = LiveMetricsTransport::Off;
+    return false;
+#endif
+}
+
+/**
+ * @brief Stop the exporter thread and close the transport
+ */
+void LiveMetrics::stop() {
+    if (!exporter.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stopping = true;
+    }
+    stopSignal.notify_all();
+    exporter.join();
+
+#ifdef LIVE_METRICS_USE_SOCKETS
+    if (listenSocket >= 0) {
+        ::close(listenSocket);
+        listenSocket = -1;
+    }
+#endif
+}
+
+/**
+ * @brief Snapshot loop: sleep an interval, write the file; once more on stop()
+ */
+void LiveMetrics::snapshotLoop() {
+    std::unique_lock<std::mutex> lock(stopMutex);
+    for (;;) {
+        bool last = stopSignal.wait_for(lock, interval, [this] { return stopping.load(); });
+        lock.unlock();
+        if (writeSnapshot(target.path)) {
+            exports.fetch_add(1, std::memory_order_relaxed);
+        }
+        lock.lock();
+        if (last) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief HTTP loop: wait for a connection (or stop()), answer it, repeat
+ */
+void LiveMetrics::serve() {
+#ifdef LIVE_METRICS_USE_SOCKETS
+    while (!stopping.load()) {
+        pollfd ready;
+        ready.fd = listenSocket;
+        ready.events = POLLIN;
+        ready.revents = 0;
+        if (::poll(&ready, 1, POLL_INTERVAL_MS) <= 0) {
+            continue;
+        }
+        int client = ::accept(listenSocket, nullptr, nullptr);
+        if (client < 0) {
+            continue;
+        }
+        answer(client);
+        ::close(client);
+    }
+#endif
+}
+
+/**
+ * @brief Read one request and reply with the metrics (GET /metrics or /) or 404
+ * @param client Connected socket
+ */
+void LiveMetrics::answer(int client) {
+#ifdef LIVE_METRICS_USE_SOCKETS
+    // A stalled client must not hold up the exporter for long
+    timeval timeout;
+    timeout.tv_sec = 1;
+    timeout.tv_usec = 0;
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_BYTES) {
+        ssize_t count = ::recv(client, buffer, sizeof(buffer), 0);
+        if (count <= 0) {
+            break;
+        }
+        request.append(buffer, static_cast<std::size_t>(count));
+    }
+
+    // Request line: METHOD SP TARGET SP VERSION
+    std::istringstream line(request.substr(0, request.find("\r\n")));
+    std::string method;
+    std::string path;
+    line >> method >> path;
+    std::string query = path.substr(0, path.find('?'));
+
+    std::string status = "200 OK";
+    std::string body;
+    if (method != "GET" && method != "HEAD") {
+        status = "405 Method Not Allowed";
+        body = "Only GET is supported\n";
+    } else if (query == "/metrics" || query == "/") {
+        body = render();
+        exports.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        status = "404 Not Found";
+        body = "Metrics are at /metrics\n";
+    }
+
+    std::ostringstream response;
+    response << "HTTP/1.1 " << status << "\r\n"
+             << "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+             << "Content-Length: " << body.size() << "\r\n"
+             << "Connection: close\r\n\r\n";
+    if (method != "HEAD") {
+        response << body;
+    }
+
+    std::string bytes = response.str();
+    std::size_t sent = 0;
+#ifdef MSG_NOSIGNAL
+    const int flags = MSG_NOSIGNAL;  // A scraper that hangs up must not raise SIGPIPE
+#else
+    const int flags = 0;
+#endif
+    while (sent < bytes.size()) {
+        ssize_t count = ::send(client, bytes.data() + sent, bytes.size() - sent, flags);
+        if (count <= 0) {
+            break;
+        }
+        sent += static_cast<std::size_t>(count);
+    }
+#else
+    (void)client;
+#endif
+}
+
+/**
+ * @brief Get the TCP port being served
+ * @return Port, or -1 if not serving HTTP
+ */
+int LiveMetrics::boundPort() const {
+#ifdef LIVE_METRICS_USE_SOCKETS
+    if (listenSocket >= 0) {
+        sockaddr_in address;
+        socklen_t length = sizeof(address);
+        if (getsockname(listenSocket, reinterpret_cast<sockaddr*>(&address), &length) == 0) {
+            return ntohs(address.sin_port);
+        }
+    }
+#endif
+    return -1;
+}
+
+std::uint64_t LiveMetrics::exportCount() const {
+    return exports.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Describe the running exporter
+ * @return Endpoint URL, snapshot file and interval, or "off"
+ */
+std::string LiveMetrics::describe() const {
+    switch (target.transport) {
+        case LiveMetricsTransport::Http:
+            return "http://" + target.address + ":" + std::to_string(boundPort()) + "/metrics";
+        case LiveMetricsTransport::Snapshot:
+            return target.path + " every " + formatDuration(interval);
+        case LiveMetricsTransport::Off:
+        default:
+            return "off";
+    }
+}
+
+/**
+ * @brief Parse "http:PORT", "http:ADDRESS:PORT" or "file:PATH"
+ * @param spec Target text
+ * @param target Receives the target
+ * @return true if the text is valid
+ */
+bool parseLiveMetricsTarget(const std::string& spec, LiveMetricsTarget& target) {
+    LiveMetricsTarget parsed;
+    parsed.transport = LiveMetricsTransport::Off;
+    parsed.address = "127.0.0.1";
+    parsed.port = 0;
+
+    if (spec.compare(0, 5, "file:") == 0 && spec.size() > 5) {
+        parsed.transport = LiveMetricsTransport::Snapshot;
+        parsed.path = spec.substr(5);
+    } else if (spec.compare(0, 5, "http:") == 0) {
+        std::string rest = spec.substr(5);
+        std::size_t colon = rest.rfind(':');
+        if (colon != std::string::npos) {
+            parsed.address = rest.substr(0, colon);
+            rest = rest.substr(colon + 1);
+        }
+        char* end = nullptr;
+        long port = std::strtol(rest.c_str(), &end, 10);
+        if (rest.empty() || *end != '\0' || port < 0 || port > 65535 || parsed.address.empty()) {
+            return false;
+        }
+        parsed.transport = LiveMetricsTransport::Http;
+        parsed.port = static_cast<int>(port);
+    } else {
+        return false;
+    }
+    target = parsed;
+    return true;
+}
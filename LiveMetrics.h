@@ -0,0 +1,335 @@
+/**
+ * @file LiveMetrics.h
+ * @brief Header file for the live progress metrics of long-running simulations
+ *
+ * This file defines an optional exporter that makes the progress of a run
+ * visible while it is still running, without tailing the log:
+ *
+ * - RelaxedCounter<T>: a single-writer counter. The owning thread updates it
+ *   with a relaxed load and store (no locked instruction), and any other
+ *   thread can read a recent value at any time. Counters with several
+ *   writers use std::atomic and fetch_add(memory_order_relaxed) instead.
+ * - MetricsWriter: writes samples in the Prometheus text exposition format
+ *   (version 0.0.4).
+ * - LiveMetrics: a registry of collectors plus one exporter thread. Each
+ *   simulation registers a collector for the length of a run; the collector
+ *   only reads its counters, so a scrape never blocks a worker. The exporter
+ *   either serves the text over HTTP (GET /metrics) or rewrites a snapshot
+ *   file every interval (written to PATH.tmp and renamed, so a reader such
+ *   as node_exporter's textfile collector never sees a partial file).
+ *
+ * When a collector is removed at the end of a run, its last output is kept
+ * and served in its place, so the final counts stay visible until the same
+ * source starts its next run.
+ *
+ * HTTP needs POSIX sockets; snapshot files work everywhere.
+ *
+ * Thread Safety:
+ * - addCollector(), removeCollector(), render() and the exporter thread are
+ *   serialized by collectorMutex; collectors must be safe to call from the
+ *   exporter thread while the run is in progress
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef LIVE_METRICS_H
+#define LIVE_METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class RelaxedCounter
+ * @brief Counter written by one thread and read by any, with relaxed atomics
+ *
+ * Behaves like a plain T for the owner (++, +=, assignment, conversion).
+ * While several threads hold a resource together (shared fork holders),
+ * they update its counters with add() and raiseTo() instead.
+ * Copies take the current value.
+ *
+ * @tparam T Integer type
+ */
+template <typename T>
+class RelaxedCounter {
+private:
+    std::atomic<T> value;  ///< Current value
+
+public:
+    RelaxedCounter(T initial = T()) : value(initial) {}
+    RelaxedCounter(const RelaxedCounter& other) : value(other.load()) {}
+
+    RelaxedCounter& operator=(const RelaxedCounter& other) {
+        store(other.load());
+        return *this;
+    }
+
+    RelaxedCounter& operator=(T newValue) {
+        store(newValue);
+        return *this;
+    }
+
+    /**
+     * @brief Read the value (any thread)
+     * @return A recent value
+     */
+    T load() const {
+        return value.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Set the value (owner only)
+     * @param newValue Value
+     */
+    void store(T newValue) {
+        value.store(newValue, std::memory_order_relaxed);
+    }
+
+    operator T() const {
+        return load();
+    }
+
+    RelaxedCounter& operator++() {
+        store(load() + 1);
+        return *this;
+    }
+
+    T operator++(int) {
+        T old = load();
+        store(old + 1);
+        return old;
+    }
+
+    RelaxedCounter& operator+=(T delta) {
+        store(load() + delta);
+        return *this;
+    }
+
+    /**
+     * @brief Add to the value while other threads may add too (an atomic read-modify-write)
+     * @param delta Amount
+     */
+    void add(T delta) {
+        value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Raise the value to at least candidate while other threads may raise it too
+     * @param candidate New maximum if larger than the value
+     */
+    void raiseTo(T candidate) {
+        T current = load();
+        while (candidate > current &&
+               !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+        }
+    }
+};
+
+/**
+ * @class MetricsWriter
+ * @brief Writes metric families and samples in the Prometheus text format
+ */
+class MetricsWriter {
+private:
+    std::ostream& out;  ///< Destination
+
+public:
+    /**
+     * @brief Constructor
+     * @param out Destination stream
+     */
+    explicit MetricsWriter(std::ostream& out);
+
+    /**
+     * @brief Start a metric family ("# HELP" and "# TYPE" lines)
+     * @param name Metric name (e.g., "sim_process_completed_total")
+     * @param type "counter" or "gauge"
+     * @param help One-line description
+     */
+    void family(const char* name, const char* type, const char* help);
+
+    /**
+     * @brief Write an unlabelled sample
+     * @param name Metric name
+     * @param value Sample value
+     */
+    void sample(const char* name, double value);
+
+    /**
+     * @brief Write a sample with one numeric label, e.g. name{fork="3"} value
+     * @param name Metric name
+     * @param label Label name
+     * @param labelValue Label value
+     * @param value Sample value
+     */
+    void sample(const char* name, const char* label, long long labelValue, double value);
+};
+
+/**
+ * @enum LiveMetricsTransport
+ * @brief How the exporter publishes the metrics
+ */
+enum class LiveMetricsTransport {
+    Off,       ///< No exporter
+    Http,      ///< Prometheus scrape endpoint (GET /metrics)
+    Snapshot   ///< Snapshot file rewritten every interval
+};
+
+/**
+ * @struct LiveMetricsTarget
+ * @brief Parsed --live-metrics specification
+ */
+struct LiveMetricsTarget {
+    LiveMetricsTransport transport;  ///< Transport
+    std::string address;             ///< Http: IPv4 address to listen on
+    int port;                        ///< Http: TCP port (0 = any free port)
+    std::string path;                ///< Snapshot: file to write
+};
+
+/**
+ * @class LiveMetrics
+ * @brief Collector registry with an HTTP or snapshot-file exporter thread
+ */
+class LiveMetrics {
+public:
+    static const int DEFAULT_INTERVAL_MS = 1000;          ///< Snapshot interval used when none is given
+    static const std::size_t MAX_LABELLED_SERIES = 1024;  ///< Per-philosopher / per-fork series written at most
+
+    /**
+     * @brief Function that writes one source's metrics
+     */
+    typedef std::function<void(MetricsWriter&)> Collector;
+
+private:
+    /**
+     * @struct Source
+     * @brief One named metrics source: live collector or the output of its last run
+     */
+    struct Source {
+        std::string name;     ///< Source name (e.g., "process")
+        Collector collector;  ///< Live collector (empty once the run has ended)
+        std::string retained; ///< Output of the collector when it was removed
+    };
+
+    mutable std::mutex collectorMutex;    ///< Guards sources
+    std::vector<Source> sources;          ///< Registered sources, in registration order
+    std::chrono::steady_clock::time_point startTime;  ///< Construction time (uptime metric)
+    LiveMetricsTarget target;             ///< Transport of the running exporter
+    std::chrono::nanoseconds interval;    ///< Time between two snapshot files
+    std::thread exporter;                 ///< Exporter thread (joinable while running)
+    std::mutex stopMutex;                 ///< Guards stopping
+    std::condition_variable stopSignal;   ///< Wakes the snapshot loop for stop()
+    std::atomic<bool> stopping;           ///< Set by stop() to end the exporter
+    int listenSocket;                     ///< Http: listening socket (-1 = none)
+    std::atomic<std::uint64_t> exports;   ///< Scrapes answered or snapshots written
+
+    /**
+     * @brief Exporter thread body for Http: accept and answer one request at a time
+     */
+    void serve();
+
+    /**
+     * @brief Answer one HTTP request
+     * @param client Connected socket
+     */
+    void answer(int client);
+
+    /**
+     * @brief Exporter thread body for Snapshot: write, sleep until the next interval
+     */
+    void snapshotLoop();
+
+public:
+    /**
+     * @brief Constructor - no exporter until start()
+     */
+    LiveMetrics();
+
+    /**
+     * @brief Destructor - stops the exporter if it is still running
+     */
+    ~LiveMetrics();
+
+    /**
+     * @brief Register the live collector of a source
+     *
+     * Replaces the retained output of an earlier run of the same source.
+     *
+     * @param name Source name
+     * @param collector Function writing the source's metrics
+     */
+    void addCollector(const std::string& name, const Collector& collector);
+
+    /**
+     * @brief End a source's run: keep its last output and drop the collector
+     * @param name Source name
+     */
+    void removeCollector(const std::string& name);
+
+    /**
+     * @brief Render every source in the Prometheus text format
+     * @return Exposition text
+     */
+    std::string render() const;
+
+    /**
+     * @brief Write the rendered metrics to a file, replacing it atomically
+     * @param path Destination (written to path + ".tmp", then renamed)
+     * @return true on success
+     */
+    bool writeSnapshot(const std::string& path) const;
+
+    /**
+     * @brief Start the exporter thread
+     * @param newTarget Transport (LiveMetricsTransport::Off does nothing)
+     * @param snapshotInterval Time between two snapshot files (raised to 1 millisecond if smaller)
+     * @return false if the port cannot be opened or HTTP is unsupported here
+     */
+    bool start(const LiveMetricsTarget& newTarget, std::chrono::nanoseconds snapshotInterval);
+
+    /**
+     * @brief Stop the exporter; a snapshot exporter writes one last file first
+     */
+    void stop();
+
+    /**
+     * @brief Get the TCP port being served (after start(), useful with port 0)
+     * @return Port, or -1 if not serving HTTP
+     */
+    int boundPort() const;
+
+    /**
+     * @brief Get the number of scrapes answered or snapshots written
+     * @return Export count
+     */
+    std::uint64_t exportCount() const;
+
+    /**
+     * @brief Describe the running exporter
+     * @return e.g. "http://127.0.0.1:9100/metrics" or "metrics.prom every 1s"
+     */
+    std::string describe() const;
+};
+
+/**
+ * @brief Parse a live metrics target: "http:PORT", "http:ADDRESS:PORT" or "file:PATH"
+ *
+ * "http:PORT" listens on 127.0.0.1; use "http:0.0.0.0:PORT" to accept
+ * remote scrapers.
+ *
+ * @param spec Target text
+ * @param target Receives the target
+ * @return true if the text is valid
+ */
+bool parseLiveMetricsTarget(const std::string& spec, LiveMetricsTarget& target);
+
+#endif // LIVE_METRICS_H
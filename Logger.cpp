@@ -0,0 +1,427 @@
+/**
+ * @file Logger.cpp
+ * @brief Implementation of the shared asynchronous Logger
+ *
+ * This file implements the logging subsystem:
+ * - Per-thread single-producer/single-consumer rings filled without locking
+ * - A background drain thread that merges all rings by capture time, formats
+ *   the timestamps and writes each batch to stdout with a single flush
+ * - flush() for callers that need their output on the console before
+ *   printing directly to std::cout (e.g., section banners in main.cpp)
+ *
+ * Thread Safety:
+ * - Producer side: only the owning thread writes head and the entry slots;
+ *   the entry is published with a release store of head
+ * - Consumer side: only the drain thread writes tail; slots are released back
+ *   to the producer with a release store of tail
+ * - registryMutex protects the list of rings and the flush counters
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Raw steady_clock tick count of a time point
+ */
+std::int64_t ticksOf(std::chrono::steady_clock::time_point time) {
+    return static_cast<std::int64_t>(time.time_since_epoch().count());
+}
+
+} // namespace
+
+const std::size_t Logger::RING_CAPACITY;
+const std::size_t Logger::MAX_MESSAGE;
+const int Logger::DEFAULT_TIMESTAMP_DIGITS;
+
+std::atomic<int> Logger::runtimeLevel(static_cast<int>(LogLevel::Trace));
+
+/**
+ * @brief Get the process-wide logger
+ *
+ * The instance is created (and the drain thread started) on first use and
+ * destroyed at program exit after a final drain.
+ *
+ * @return The Logger instance
+ */
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+/**
+ * @brief Constructor - starts the drain thread
+ */
+Logger::Logger()
+    : flushRequested(0), flushCompleted(0), stopping(false), timestampDigits(DEFAULT_TIMESTAMP_DIGITS) {
+    drainThread = std::thread(drainLoop, this);
+}
+
+/**
+ * @brief Destructor - writes any remaining entries and stops the drain thread
+ */
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        stopping = true;
+    }
+    wakeDrain.notify_all();
+    drainThread.join();
+
+    for (Ring* ring : rings) {
+        delete ring;
+    }
+}
+
+/**
+ * @brief Thread exit - hand the ring back to the drain thread for reclamation
+ */
+Logger::RingOwner::~RingOwner() {
+    if (ring != nullptr) {
+        ring->abandoned.store(true, std::memory_order_release);
+    }
+}
+
+/**
+ * @brief Get (registering on first use) the calling thread's ring
+ *
+ * Registration takes registryMutex once per thread; every later call is a
+ * plain thread-local read.
+ *
+ * @return Ring owned by the calling thread
+ */
+Logger::Ring* Logger::localRing() {
+    static thread_local RingOwner owner = { nullptr };
+
+    if (owner.ring == nullptr) {
+        Ring* ring = new Ring;
+        ring->head.store(0, std::memory_order_relaxed);
+        ring->tail.store(0, std::memory_order_relaxed);
+        ring->abandoned.store(false, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+        rings.push_back(ring);
+        owner.ring = ring;
+    }
+    return owner.ring;
+}
+
+/**
+ * @brief Append one entry to the calling thread's ring
+ *
+ * Lock-free hot path. If the ring is full the producer yields until the drain
+ * thread has freed a slot, so messages are never lost.
+ *
+ * @param captured Raw steady_clock ticks at capture time
+ * @param origin Raw ticks that correspond to printed timestamp 0
+ * @param text Message text
+ * @param length Message length in bytes (truncated to MAX_MESSAGE)
+ */
+void Logger::push(std::int64_t captured, std::int64_t origin, const char* text, std::size_t length) {
+    Ring* ring = localRing();
+    std::uint64_t head = ring->head.load(std::memory_order_relaxed);
+
+    // Back-pressure: wait for the drain thread if the ring is full
+    while (head - ring->tail.load(std::memory_order_acquire) >= RING_CAPACITY) {
+        std::this_thread::yield();
+    }
+
+    Entry& entry = ring->entries[head & (RING_CAPACITY - 1)];
+    entry.captured = captured;
+    entry.origin = origin;
+    entry.length = static_cast<std::uint16_t>(std::min(length, MAX_MESSAGE));
+    std::memcpy(entry.text, text, entry.length);
+
+    // Publish the entry to the drain thread
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Log a message stamped with the time elapsed since origin
+ *
+ * @param origin Time point that corresponds to timestamp 0
+ * @param text Message text
+ * @param length Message length in bytes
+ */
+void Logger::log(std::chrono::steady_clock::time_point origin, const char* text, std::size_t length) {
+    push(ticksOf(std::chrono::steady_clock::now()), ticksOf(origin), text, length);
+}
+
+/**
+ * @brief Log a message stamped with the time elapsed since origin
+ *
+ * @param origin Time point that corresponds to timestamp 0
+ * @param message Message text
+ */
+void Logger::log(std::chrono::steady_clock::time_point origin, const std::string& message) {
+    log(origin, message.data(), message.size());
+}
+
+/**
+ * @brief Log a message with an explicit timestamp
+ *
+ * The origin is chosen so that (captured - origin) equals the requested
+ * timestamp, which keeps a single formatting path on the drain thread.
+ *
+ * @param elapsed Timestamp to print
+ * @param message Message text
+ */
+void Logger::logAt(std::chrono::steady_clock::duration elapsed, const std::string& message) {
+    std::int64_t captured = ticksOf(std::chrono::steady_clock::now());
+    push(captured, captured - static_cast<std::int64_t>(elapsed.count()), message.data(), message.size());
+}
+
+/**
+ * @brief Block until everything this thread logged so far has been written
+ *
+ * Any drain pass that starts after the request was registered covers every
+ * entry the calling thread had already published.
+ */
+void Logger::flush() {
+    std::unique_lock<std::mutex> lock(registryMutex);
+    std::uint64_t ticket = ++flushRequested;
+    wakeDrain.notify_all();
+    flushed.wait(lock, [this, ticket] { return flushCompleted >= ticket; });
+}
+
+/**
+ * @brief Set the number of decimals printed for timestamps
+ *
+ * Applies to entries drained from now on, including ones already captured.
+ *
+ * @param digits 0 (whole seconds) to 9 (nanoseconds); other values are clamped
+ */
+void Logger::setTimestampPrecision(int digits) {
+    timestampDigits.store(std::max(0, std::min(digits, 9)), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the number of decimals printed for timestamps
+ * @return Digits in [0, 9]
+ */
+int Logger::getTimestampPrecision() const {
+    return timestampDigits.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Set the run-time verbosity
+ *
+ * Takes effect at the next check of every logging thread; messages already
+ * captured are still written.
+ *
+ * @param level Most detailed level to log
+ */
+void Logger::setLevel(LogLevel level) {
+    runtimeLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the effective verbosity
+ * @return Run-time level, capped at SIM_LOG_LEVEL
+ */
+LogLevel Logger::getLevel() {
+    return static_cast<LogLevel>(std::min(runtimeLevel.load(std::memory_order_relaxed), SIM_LOG_LEVEL));
+}
+
+/**
+ * @brief Format an elapsed time as seconds with a fixed number of decimals
+ *
+ * The fraction is the nanosecond remainder truncated to the requested digits,
+ * matching the old millisecond output for the default of 3.
+ *
+ * @param buffer Destination (32 bytes always suffice)
+ * @param size Size of the destination
+ * @param elapsed Time to format (negative values print as 0)
+ * @param digits Decimals, 0 to 9
+ * @return Number of characters written (excluding the NUL)
+ */
+int Logger::formatSeconds(char* buffer, std::size_t size, std::chrono::nanoseconds elapsed, int digits) {
+    long long ns = static_cast<long long>(elapsed.count());
+    if (ns < 0) {
+        ns = 0;
+    }
+    digits = std::max(0, std::min(digits, 9));
+
+    long long divisor = 1;
+    for (int i = digits; i < 9; i++) {
+        divisor *= 10;
+    }
+    long long whole = ns / 1000000000LL;
+    long long fraction = (ns % 1000000000LL) / divisor;
+
+    int length = (digits == 0)
+        ? std::snprintf(buffer, size, "%lld", whole)
+        : std::snprintf(buffer, size, "%lld.%0*lld", whole, digits, fraction);
+    return (length < 0) ? 0 : std::min(length, static_cast<int>(size) - 1);
+}
+
+/**
+ * @brief Write every entry captured up to now
+ *
+ * 1. Take a cutoff time and a snapshot of the ring list
+ * 2. Merge the published entries of all rings by capture time (min-heap),
+ *    stopping at entries captured after the cutoff so that lines from
+ *    different threads come out in chronological order
+ * 3. Format the batch into one buffer, release the slots and write the buffer
+ *    to stdout with a single flush
+ * 4. Reclaim rings whose owning thread has exited and that are empty
+ *
+ * The snapshot, heap and batch live in drain* members and keep their
+ * capacity, so passes after the first few allocate nothing.
+ *
+ * @return true if at least one entry was written
+ */
+bool Logger::drainOnce() {
+    std::int64_t cutoff = ticksOf(std::chrono::steady_clock::now());
+
+    std::vector<Ring*>& snapshot = drainRings;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        snapshot.assign(rings.begin(), rings.end());
+    }
+
+    std::vector<std::uint64_t>& positions = drainPositions;
+    std::vector<std::uint64_t>& ends = drainEnds;
+    positions.resize(snapshot.size());
+    ends.resize(snapshot.size());
+    typedef std::pair<std::int64_t, std::size_t> HeapItem;  // (captured, ring index)
+    std::vector<HeapItem>& heap = drainHeap;
+    std::greater<HeapItem> later;
+    heap.clear();
+
+    for (std::size_t i = 0; i < snapshot.size(); i++) {
+        positions[i] = snapshot[i]->tail.load(std::memory_order_relaxed);
+        ends[i] = snapshot[i]->head.load(std::memory_order_acquire);
+        if (positions[i] != ends[i]) {
+            heap.push_back(HeapItem(snapshot[i]->entries[positions[i] & (RING_CAPACITY - 1)].captured, i));
+        }
+    }
+    std::make_heap(heap.begin(), heap.end(), later);
+
+    std::string& batch = drainBatch;
+    batch.clear();
+    char stamp[40];
+    int digits = timestampDigits.load(std::memory_order_relaxed);
+    while (!heap.empty() && heap.front().first <= cutoff) {
+        std::size_t i = heap.front().second;
+        std::pop_heap(heap.begin(), heap.end(), later);
+        heap.pop_back();
+
+        const Entry& entry = snapshot[i]->entries[positions[i] & (RING_CAPACITY - 1)];
+        std::chrono::steady_clock::duration elapsed(entry.captured - entry.origin);
+        int stampLength = formatSeconds(stamp, sizeof(stamp), elapsed, digits);
+        batch.push_back('[');
+        batch.append(stamp, static_cast<std::size_t>(stampLength));
+        batch.append("s] ", 3);
+        batch.append(entry.text, entry.length);
+        batch.push_back('\n');
+
+        positions[i]++;
+        if (positions[i] != ends[i]) {
+            heap.push_back(HeapItem(snapshot[i]->entries[positions[i] & (RING_CAPACITY - 1)].captured, i));
+            std::push_heap(heap.begin(), heap.end(), later);
+        }
+    }
+
+    // Hand the consumed slots back to the producers
+    for (std::size_t i = 0; i < snapshot.size(); i++) {
+        snapshot[i]->tail.store(positions[i], std::memory_order_release);
+    }
+
+    if (!batch.empty()) {
+        std::cout.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+        std::cout.flush();
+    }
+
+    // Reclaim rings of exited threads once they are empty
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (std::size_t i = 0; i < rings.size();) {
+            Ring* ring = rings[i];
+            if (ring->abandoned.load(std::memory_order_acquire) &&
+                ring->tail.load(std::memory_order_relaxed) == ring->head.load(std::memory_order_acquire)) {
+                rings[i] = rings.back();
+                rings.pop_back();
+                delete ring;
+            } else {
+                i++;
+            }
+        }
+    }
+
+    return !batch.empty();
+}
+
+/**
+ * @brief Main loop of the drain thread
+ *
+ * Drains continuously while there is output, otherwise polls every
+ * millisecond (producers never signal, to keep the hot path lock-free).
+ * flush() and the destructor wake the thread early.
+ *
+ * @param logger Pointer to the Logger instance
+ */
+void Logger::drainLoop(Logger* logger) {
+    for (;;) {
+        std::uint64_t request;
+        bool stop;
+        {
+            std::lock_guard<std::mutex> lock(logger->registryMutex);
+            request = logger->flushRequested;
+            stop = logger->stopping;
+        }
+
+        bool wrote = logger->drainOnce();
+
+        {
+            std::lock_guard<std::mutex> lock(logger->registryMutex);
+            logger->flushCompleted = request;
+        }
+        logger->flushed.notify_all();
+
+        if (stop) {
+            return;
+        }
+
+        if (!wrote) {
+            std::unique_lock<std::mutex> lock(logger->registryMutex);
+            logger->wakeDrain.wait_for(lock, std::chrono::milliseconds(1), [logger] {
+                return logger->stopping || logger->flushRequested != logger->flushCompleted;
+            });
+        }
+    }
+}
+
+bool parseLogLevel(const std::string& name, LogLevel& level) {
+    if (name == "off") {
+        level = LogLevel::Off;
+    } else if (name == "summary") {
+        level = LogLevel::Summary;
+    } else if (name == "events") {
+        level = LogLevel::Events;
+    } else if (name == "trace") {
+        level = LogLevel::Trace;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* logLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Off:     return "off";
+        case LogLevel::Summary: return "summary";
+        case LogLevel::Events:  return "events";
+        case LogLevel::Trace:
+        default:                return "trace";
+    }
+}
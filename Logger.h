@@ -0,0 +1,364 @@
+/**
+ * @file Logger.h
+ * @brief Header file for the shared asynchronous Logger
+ *
+ * This file defines the logging subsystem shared by ProcessSimulator and
+ * DiningPhilosophers. Logging threads never take a lock or touch the console:
+ *
+ * - Each thread that logs owns a single-producer/single-consumer ring buffer
+ * - The hot path captures the raw steady_clock tick count, copies the message
+ *   into the next ring slot and publishes it with one release store
+ * - A single background drain thread collects entries from all rings, merges
+ *   them by capture time, formats the "[t s] message" lines and writes them to
+ *   stdout in batches with a single flush per batch
+ *
+ * If a ring is full the producer yields until the drain thread catches up, so
+ * no message is ever dropped.
+ *
+ * Timestamps keep full steady_clock resolution until they are printed; the
+ * number of decimals shown is a runtime setting (milliseconds by default,
+ * up to nanoseconds).
+ *
+ * Verbosity is chosen twice (see LogLevel):
+ *
+ * - At compile time, SIM_LOG_LEVEL (0 = off ... 3 = trace, default 3) is the
+ *   most detailed level that is built in. Call sites guarded by SIM_LOG_ON()
+ *   or Logger::levelEnabled() above it are constant-false, so the compiler
+ *   drops their formatting and logging code entirely
+ * - At run time, setLevel() lowers the verbosity further with one relaxed
+ *   atomic load per check (no lock, no Logger instance needed)
+ *
+ * LogLine builds a message in a fixed on-stack buffer of MAX_MESSAGE bytes, so
+ * hot loops can format their messages without std::stringstream or any other
+ * heap allocation.
+ *
+ * Thread Safety:
+ * - Ring buffers are lock-free (atomic head/tail indices)
+ * - The ring registry is protected by registryMutex (taken once per thread and
+ *   by the drain thread, never on the logging hot path)
+ * - The drain thread reuses its merge and batch buffers between passes, so
+ *   steady-state logging allocates nothing on either side of the rings
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @def SIM_LOG_LEVEL
+ * @brief Most detailed LogLevel compiled in (0 = Off, 1 = Summary, 2 = Events, 3 = Trace)
+ */
+#ifndef SIM_LOG_LEVEL
+#define SIM_LOG_LEVEL 3
+#endif
+
+/**
+ * @enum LogLevel
+ * @brief Log verbosity, from nothing to every fork and preemption
+ */
+enum class LogLevel {
+    Off = 0,      ///< No log output
+    Summary = 1,  ///< Run results only (statistics, per-philosopher totals)
+    Events = 2,   ///< Process start/finish, think/eat and fork pair acquire/release
+    Trace = 3     ///< Everything: single forks, waits, preemptions and resumptions
+};
+
+/**
+ * @def SIM_LOG_ON
+ * @brief true if messages of the given LogLevel are compiled in and enabled
+ *
+ * The first operand is a constant expression, so above SIM_LOG_LEVEL the
+ * whole guarded block is dead code.
+ */
+#define SIM_LOG_ON(level) \
+    (static_cast<int>(level) <= SIM_LOG_LEVEL && Logger::levelEnabled(level))
+
+/**
+ * @brief Parse a log level name ("off", "summary", "events" or "trace")
+ * @param name Level name
+ * @param level Receives the parsed level
+ * @return true if the name is recognised
+ */
+bool parseLogLevel(const std::string& name, LogLevel& level);
+
+/**
+ * @brief Get the name of a log level
+ * @param level Log level
+ * @return Lower-case name
+ */
+const char* logLevelName(LogLevel level);
+
+/**
+ * @class Logger
+ * @brief Process-wide asynchronous logger with per-thread lock-free buffers
+ */
+class Logger {
+public:
+    static const std::size_t RING_CAPACITY = 512;  ///< Entries per thread ring (power of two)
+    static const std::size_t MAX_MESSAGE = 110;    ///< Longer messages are truncated
+    static const int DEFAULT_TIMESTAMP_DIGITS = 3; ///< Decimals of the printed seconds (milliseconds)
+
+    /**
+     * @brief Get the process-wide logger (starts the drain thread on first use)
+     * @return The Logger instance
+     */
+    static Logger& instance();
+
+    /**
+     * @brief Log a message stamped with the time elapsed since origin
+     *
+     * Lock-free: captures steady_clock::now() and copies the text into the
+     * calling thread's ring. Formatting happens later on the drain thread.
+     *
+     * @param origin Time point that corresponds to timestamp 0
+     * @param text Message text
+     * @param length Message length in bytes
+     */
+    void log(std::chrono::steady_clock::time_point origin, const char* text, std::size_t length);
+
+    /**
+     * @brief Log a message stamped with the time elapsed since origin
+     * @param origin Time point that corresponds to timestamp 0
+     * @param message Message text
+     */
+    void log(std::chrono::steady_clock::time_point origin, const std::string& message);
+
+    /**
+     * @brief Log a message with an explicit timestamp (e.g., a simulated clock)
+     *
+     * The entry is still ordered by its real capture time.
+     *
+     * @param elapsed Timestamp to print
+     * @param message Message text
+     */
+    void logAt(std::chrono::steady_clock::duration elapsed, const std::string& message);
+
+    /**
+     * @brief Block until everything this thread logged so far has been written
+     */
+    void flush();
+
+    /**
+     * @brief Set the number of decimals printed for timestamps
+     * @param digits 0 (whole seconds) to 9 (nanoseconds); other values are clamped
+     */
+    void setTimestampPrecision(int digits);
+
+    /**
+     * @brief Get the number of decimals printed for timestamps
+     * @return Digits in [0, 9]
+     */
+    int getTimestampPrecision() const;
+
+    /**
+     * @brief Format an elapsed time as seconds with a fixed number of decimals
+     *
+     * Integer arithmetic on the nanosecond count, so no precision is lost to
+     * floating point (e.g., 1234567891 ns with 6 digits gives "1.234567").
+     *
+     * @param buffer Destination (32 bytes always suffice)
+     * @param size Size of the destination
+     * @param elapsed Time to format (negative values print as 0)
+     * @param digits Decimals, 0 to 9
+     * @return Number of characters written (excluding the NUL)
+     */
+    static int formatSeconds(char* buffer, std::size_t size, std::chrono::nanoseconds elapsed, int digits);
+
+    /**
+     * @brief Set the run-time verbosity
+     *
+     * Levels above SIM_LOG_LEVEL stay off whatever is set here.
+     *
+     * @param level Most detailed level to log (default: Trace)
+     */
+    static void setLevel(LogLevel level);
+
+    /**
+     * @brief Get the effective verbosity (run-time level capped at SIM_LOG_LEVEL)
+     * @return Most detailed level that is logged
+     */
+    static LogLevel getLevel();
+
+    /**
+     * @brief Check whether messages of a level are logged
+     * @param level Level of the message
+     * @return true if level is compiled in and enabled at run time
+     */
+    static bool levelEnabled(LogLevel level) {
+        return static_cast<int>(level) <= SIM_LOG_LEVEL &&
+               static_cast<int>(level) <= runtimeLevel.load(std::memory_order_relaxed);
+    }
+
+private:
+    static std::atomic<int> runtimeLevel;  ///< Run-time verbosity (a LogLevel value)
+
+    /**
+     * @struct Entry
+     * @brief One captured log message (fixed size, no heap storage)
+     */
+    struct Entry {
+        std::int64_t captured;   ///< Raw steady_clock ticks when logged (ordering key)
+        std::int64_t origin;     ///< Raw ticks of timestamp 0 (printed time = captured - origin)
+        std::uint16_t length;    ///< Message length in bytes
+        char text[MAX_MESSAGE];  ///< Message text (not NUL-terminated)
+    };
+
+    /**
+     * @struct Ring
+     * @brief Single-producer/single-consumer ring owned by one logging thread
+     */
+    struct Ring {
+        std::atomic<std::uint64_t> head;  ///< Next slot to write (producer only)
+        char headPadding[64 - sizeof(std::atomic<std::uint64_t>)];  ///< Keeps head and tail on separate cache lines
+        std::atomic<std::uint64_t> tail;  ///< Next slot to read (drain thread only)
+        std::atomic<bool> abandoned;      ///< Set when the owning thread exits
+        Entry entries[RING_CAPACITY];     ///< Message slots
+    };
+
+    /**
+     * @struct RingOwner
+     * @brief Thread-local handle that marks the ring abandoned at thread exit
+     */
+    struct RingOwner {
+        Ring* ring;
+        ~RingOwner();
+    };
+
+    std::mutex registryMutex;            ///< Protects rings and the flush counters
+    std::vector<Ring*> rings;            ///< All live rings (owned by the Logger)
+    std::condition_variable wakeDrain;   ///< Wakes the drain thread early (flush or shutdown)
+    std::condition_variable flushed;     ///< Signalled after each completed drain pass
+    std::uint64_t flushRequested;        ///< Number of flush() calls so far
+    std::uint64_t flushCompleted;        ///< Highest flush request covered by a drain pass
+    bool stopping;                       ///< Set by the destructor to stop the drain thread
+    std::atomic<int> timestampDigits;    ///< Decimals of the printed seconds
+    std::thread drainThread;             ///< Background writer
+
+    // Drain-thread scratch space, kept between passes so draining does not allocate
+    std::vector<Ring*> drainRings;                                   ///< Snapshot of rings
+    std::vector<std::uint64_t> drainPositions;                       ///< Next entry to read per ring
+    std::vector<std::uint64_t> drainEnds;                            ///< Published head per ring
+    std::vector<std::pair<std::int64_t, std::size_t> > drainHeap;    ///< Min-heap of (captured, ring index)
+    std::string drainBatch;                                          ///< Formatted output of one pass
+
+    Logger();
+    ~Logger();
+    Logger(const Logger&) = delete;             ///< Non-copyable
+    Logger& operator=(const Logger&) = delete;  ///< Non-assignable
+
+    /**
+     * @brief Get (registering on first use) the calling thread's ring
+     * @return Ring owned by the calling thread
+     */
+    Ring* localRing();
+
+    /**
+     * @brief Append one entry to the calling thread's ring
+     */
+    void push(std::int64_t captured, std::int64_t origin, const char* text, std::size_t length);
+
+    /**
+     * @brief Write every entry captured up to now; returns false if none were found
+     */
+    bool drainOnce();
+
+    /**
+     * @brief Main loop of the drain thread
+     * @param logger Pointer to the Logger instance
+     */
+    static void drainLoop(Logger* logger);
+};
+
+/**
+ * @class LogLine
+ * @brief Fixed-capacity message builder (no heap allocation)
+ *
+ * Usage mirrors a stream: line << "PHIL " << id << " | Eating...". Text past
+ * Logger::MAX_MESSAGE bytes is dropped, matching the Logger's own truncation.
+ */
+class LogLine {
+private:
+    char text[Logger::MAX_MESSAGE];  ///< Message text (not NUL-terminated)
+    std::size_t length;              ///< Bytes used in text
+
+public:
+    /**
+     * @brief Constructor - creates an empty line
+     */
+    LogLine() : length(0) {}
+
+    /**
+     * @brief Append a NUL-terminated string
+     */
+    LogLine& operator<<(const char* s) {
+        while (*s != '\0' && length < Logger::MAX_MESSAGE) {
+            text[length++] = *s++;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Append a single character
+     */
+    LogLine& operator<<(char c) {
+        if (length < Logger::MAX_MESSAGE) {
+            text[length++] = c;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Append the decimal form of an integer
+     */
+    LogLine& operator<<(long long value) {
+        char digits[20];
+        int count = 0;
+        unsigned long long v = (value < 0) ? 0ull - static_cast<unsigned long long>(value)
+                                           : static_cast<unsigned long long>(value);
+        do {
+            digits[count++] = static_cast<char>('0' + (v % 10));
+            v /= 10;
+        } while (v != 0);
+        if (value < 0) {
+            *this << '-';
+        }
+        while (count > 0) {
+            *this << digits[--count];
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Append the decimal form of an int
+     */
+    LogLine& operator<<(int value) {
+        return *this << static_cast<long long>(value);
+    }
+
+    /**
+     * @brief Get the message text
+     * @return Pointer to the first byte (not NUL-terminated)
+     */
+    const char* data() const { return text; }
+
+    /**
+     * @brief Get the message length
+     * @return Number of bytes
+     */
+    std::size_t size() const { return length; }
+};
+
+#endif // LOGGER_H
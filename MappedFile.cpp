@@ -0,0 +1,132 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Implementation of the MappedFile class
+ *
+ * POSIX: open() + fstat() + mmap(PROT_READ, MAP_PRIVATE), with a sequential
+ * access hint so the kernel reads ahead aggressively. The descriptor is closed
+ * right after mapping; the mapping stays valid until munmap().
+ *
+ * Other platforms: the file is read into a std::vector in a single read.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "MappedFile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_FILE_USE_MMAP 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+/**
+ * @brief Constructor - creates an empty view
+ */
+MappedFile::MappedFile() : bytes(nullptr), length(0), mapped(false) {
+}
+
+/**
+ * @brief Destructor - unmaps the file if it is open
+ */
+MappedFile::~MappedFile() {
+    close();
+}
+
+/**
+ * @brief Map (or read) the whole file
+ *
+ * An empty file opens successfully with size() == 0.
+ *
+ * @param filename Path to the file
+ * @return true on success, false if the file cannot be opened or read
+ */
+bool MappedFile::open(const std::string& filename) {
+    close();
+
+#ifdef MAPPED_FILE_USE_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+
+    length = static_cast<std::size_t>(info.st_size);
+    if (length > 0) {
+        void* region = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (region == MAP_FAILED) {
+            ::close(fd);
+            length = 0;
+            return false;
+        }
+#ifdef MADV_SEQUENTIAL
+        madvise(region, length, MADV_SEQUENTIAL);
+#endif
+        bytes = static_cast<const char*>(region);
+        mapped = true;
+    }
+
+    ::close(fd);
+    return true;
+#else
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::streamoff fileSize = file.tellg();
+    if (fileSize < 0) {
+        return false;
+    }
+    buffer.resize(static_cast<std::size_t>(fileSize));
+    file.seekg(0);
+    if (!buffer.empty() && !file.read(&buffer[0], fileSize)) {
+        buffer.clear();
+        return false;
+    }
+
+    bytes = buffer.empty() ? nullptr : &buffer[0];
+    length = buffer.size();
+    return true;
+#endif
+}
+
+/**
+ * @brief Release the mapping or buffer
+ */
+void MappedFile::close() {
+#ifdef MAPPED_FILE_USE_MMAP
+    if (mapped) {
+        munmap(const_cast<char*>(bytes), length);
+    }
+#endif
+    bytes = nullptr;
+    length = 0;
+    mapped = false;
+    buffer.clear();
+}
+
+/**
+ * @brief Get the file contents
+ * @return Pointer to the first byte (may be null for an empty file)
+ */
+const char* MappedFile::data() const {
+    return bytes;
+}
+
+/**
+ * @brief Get the file size
+ * @return Number of bytes
+ */
+std::size_t MappedFile::size() const {
+    return length;
+}
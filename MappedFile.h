@@ -0,0 +1,72 @@
+/**
+ * @file MappedFile.h
+ * @brief Header file for the MappedFile class
+ *
+ * This file defines a small RAII wrapper that exposes the whole contents of a
+ * file as one contiguous read-only byte range. On POSIX systems the file is
+ * memory-mapped (no copy into user-space buffers); elsewhere it falls back to
+ * reading the file into memory in one call.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/**
+ * @class MappedFile
+ * @brief Read-only view of an entire file (mmap where available)
+ */
+class MappedFile {
+private:
+    const char* bytes;          ///< Start of the file contents
+    std::size_t length;         ///< Size of the file in bytes
+    bool mapped;                ///< true if bytes points to an mmap'ed region
+    std::vector<char> buffer;   ///< Storage used when mmap is not available
+
+public:
+    /**
+     * @brief Constructor - creates an empty view
+     */
+    MappedFile();
+
+    /**
+     * @brief Destructor - unmaps the file if it is open
+     */
+    ~MappedFile();
+
+    /**
+     * @brief Map (or read) the whole file
+     * @param filename Path to the file
+     * @return true on success, false if the file cannot be opened or read
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * @brief Release the mapping or buffer
+     */
+    void close();
+
+    /**
+     * @brief Get the file contents
+     * @return Pointer to the first byte (may be null for an empty file)
+     */
+    const char* data() const;
+
+    /**
+     * @brief Get the file size
+     * @return Number of bytes
+     */
+    std::size_t size() const;
+
+private:
+    MappedFile(const MappedFile&) = delete;             ///< Non-copyable
+    MappedFile& operator=(const MappedFile&) = delete;  ///< Non-assignable
+};
+
+#endif // MAPPED_FILE_H
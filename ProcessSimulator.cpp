@@ -3,31 +3,289 @@
  * @brief Implementation of the ProcessSimulator class
  * 
  * This file implements the process simulation functionality, including:
- * - Loading process data from file with validation
- * - Creating and managing process threads
+ * - Loading process data from file with validation (memory-mapped, hand-rolled
+ *   integer scanning)
+ * - Executing processes on a fixed-size worker pool
+ * - Virtual-time (discrete-event) execution on a simulated clock
+ * - Coroutine execution: one C++20 coroutine per process on a CoScheduler
+ * - Pluggable CPU scheduling policies over simulated CPUs
+ * - Per-process waiting, turnaround and response time statistics
  * - Thread-safe logging with timestamps
  * - CPU burst time simulation using sleep
  * 
  * Thread Safety:
- * - All console output is protected by coutMutex (CRITICAL SECTION)
- * - Uses std::lock_guard for RAII-style automatic mutex unlocking
+ * - All console output goes through the shared asynchronous Logger
+ * - Each worker records timing results only in its own process's stats slot
  * 
  * @author Thread Simulation System
  * @date 2024
  */
 
 #include "ProcessSimulator.h"
+#include "ThreadPool.h"
+#include "Executor.h"
+#include "Logger.h"
+#include "MappedFile.h"
+#include "TraceFile.h"
+#include "BoundedQueue.h"
+#include "TimelineTrace.h"
+#include "CpuBurn.h"
+#include "Coroutine.h"
+#include "ProcessTable.h"
+#include "LiveMetrics.h"
+#include "Checkpoint.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <thread>
 #include <chrono>
 #include <iomanip>
+#include <queue>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <memory>
+#include <cstdio>
+#include <cerrno>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PROCESS_STREAM_USE_POSIX_READ 1
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+/**
+ * @struct SimEvent
+ * @brief The end of a slice in the virtual-time simulation
+ *
+ * Arrivals are not events: they are read in order from the process table's
+ * arrivalOrder column.
+ */
+struct SimEvent {
+    long long time;          ///< Simulated time at which the slice ends
+    unsigned long long seq;  ///< Insertion order, breaks ties between simultaneous events
+    std::size_t index;       ///< Index of the running process in the process table
+    unsigned int cpu;        ///< CPU the slice runs on
+    unsigned long long token;  ///< Dispatch token; stale if the CPU was preempted since
+};
+
+/**
+ * @struct SimCpu
+ * @brief State of one simulated CPU in the virtual-time simulation
+ */
+struct SimCpu {
+    bool busy;                 ///< true while a process is running on this CPU
+    std::size_t index;         ///< Index of the running process
+    long long sliceStart;      ///< Simulated time the current slice started
+    unsigned long long token;  ///< Incremented on every dispatch and preemption
+};
+
+/**
+ * @struct LaterEvent
+ * @brief Priority queue ordering: earliest time first, then insertion order
+ */
+struct LaterEvent {
+    bool operator()(const SimEvent& a, const SimEvent& b) const {
+        if (a.time != b.time) {
+            return a.time > b.time;
+        }
+        return a.seq > b.seq;
+    }
+};
+
+/**
+ * @brief Build the log line written when a process starts
+ */
+std::string startedMessage(int pid, int burstTime) {
+    std::ostringstream ss;
+    ss << "PROCESS " << std::setw(3) << pid << " | Started (burst time: " << burstTime << "s)";
+    return ss.str();
+}
+
+/**
+ * @brief Build the log line written when a process is preempted or resumed
+ */
+std::string remainingMessage(int pid, const char* event, long long remaining) {
+    std::ostringstream ss;
+    ss << "PROCESS " << std::setw(3) << pid << " | " << event << " (remaining: " << remaining << "s)";
+    return ss.str();
+}
+
+/**
+ * @brief Build the log line written when a process finishes
+ */
+std::string finishedMessage(int pid) {
+    std::ostringstream ss;
+    ss << "PROCESS " << std::setw(3) << pid << " | Finished";
+    return ss.str();
+}
+
+/**
+ * @brief Whitespace as recognised by stream extraction ("C" locale)
+ */
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f' || c == '\n';
+}
+
+/**
+ * @brief Advance past whitespace
+ * @return First non-whitespace position (or end)
+ */
+inline const char* skipSpace(const char* p, const char* end) {
+    while (p != end && isSpace(*p)) {
+        p++;
+    }
+    return p;
+}
+
+/**
+ * @brief Scan a decimal int the way "stream >> int" does
+ * 
+ * Skips leading whitespace, accepts an optional sign and at least one digit,
+ * and stops at the first non-digit. Values outside the int range fail, like
+ * the failbit set by stream extraction on overflow.
+ * 
+ * @param p Scan position, advanced past the number on success
+ * @param end End of the line
+ * @param value Receives the parsed value
+ * @return true if a number was read
+ */
+inline bool scanInt(const char*& p, const char* end, int& value) {
+    const char* q = skipSpace(p, end);
+    bool negative = false;
+    if (q != end && (*q == '-' || *q == '+')) {
+        negative = (*q == '-');
+        q++;
+    }
+    if (q == end || *q < '0' || *q > '9') {
+        return false;
+    }
+    
+    long long magnitude = 0;
+    const long long limit = negative ? -static_cast<long long>(INT_MIN) : INT_MAX;
+    while (q != end && *q >= '0' && *q <= '9') {
+        magnitude = magnitude * 10 + (*q - '0');
+        if (magnitude > limit) {
+            return false;
+        }
+        q++;
+    }
+    
+    value = static_cast<int>(negative ? -magnitude : magnitude);
+    p = q;
+    return true;
+}
+
+/**
+ * @class StreamSource
+ * @brief Unbuffered chunk reader over a file or stdin for streamProcesses()
+ * 
+ * POSIX read() returns whatever is available (a pipe delivers records as
+ * soon as they are written); the stdio fallback blocks until a chunk is full.
+ */
+class StreamSource {
+private:
+#ifdef PROCESS_STREAM_USE_POSIX_READ
+    int fd;          ///< Descriptor being read (-1 if not open)
+    bool ownsFd;     ///< true if close() must close fd (not stdin)
+#else
+    std::FILE* file; ///< Stream being read (nullptr if not open)
+    bool ownsFile;   ///< true if close() must fclose file (not stdin)
+#endif
+
+public:
+#ifdef PROCESS_STREAM_USE_POSIX_READ
+    StreamSource() : fd(-1), ownsFd(false) {}
+#else
+    StreamSource() : file(nullptr), ownsFile(false) {}
+#endif
+    
+    ~StreamSource() {
+        close();
+    }
+    
+    /**
+     * @brief Open a path, or stdin for "-"
+     * @return true on success
+     */
+    bool open(const std::string& source) {
+#ifdef PROCESS_STREAM_USE_POSIX_READ
+        if (source == "-") {
+            fd = STDIN_FILENO;
+            ownsFd = false;
+        } else {
+            fd = ::open(source.c_str(), O_RDONLY);
+            ownsFd = true;
+        }
+        return fd >= 0;
+#else
+        if (source == "-") {
+            file = stdin;
+            ownsFile = false;
+        } else {
+            file = std::fopen(source.c_str(), "rb");
+            ownsFile = true;
+        }
+        return file != nullptr;
+#endif
+    }
+    
+    /**
+     * @brief Read up to size bytes
+     * @return Bytes read, 0 at end of input, -1 on error
+     */
+    long read(char* buffer, std::size_t size) {
+#ifdef PROCESS_STREAM_USE_POSIX_READ
+        ssize_t count;
+        do {
+            count = ::read(fd, buffer, size);
+        } while (count < 0 && errno == EINTR);
+        return static_cast<long>(count);
+#else
+        std::size_t count = std::fread(buffer, 1, size, file);
+        return (count == 0 && std::ferror(file)) ? -1 : static_cast<long>(count);
+#endif
+    }
+    
+    void close() {
+#ifdef PROCESS_STREAM_USE_POSIX_READ
+        if (fd >= 0 && ownsFd) {
+            ::close(fd);
+        }
+        fd = -1;
+#else
+        if (file != nullptr && ownsFile) {
+            std::fclose(file);
+        }
+        file = nullptr;
+#endif
+    }
+};
+
+const std::size_t STREAM_CHUNK_SIZE = 64 * 1024;  ///< Bytes requested per read of the stream
+
+} // namespace
 
 /**
  * @brief Constructor - initializes start time for timestamp tracking
  */
-ProcessSimulator::ProcessSimulator() {
+ProcessSimulator::ProcessSimulator()
+    : workerCount(0), mode(ExecutionMode::RealTime), virtualNow(0),
+      policy(SchedulingPolicy::FCFS), readyQueue(ReadyQueueType::Scan), timeQuantum(2), timeScale(1.0), loggingEnabled(true),
+      executorType(ExecutorType::GlobalQueue), executorWorkers(0), frameBytes(0), coroutineBusy(0.0), streamed(false),
+      metricsFormat(MetricsFormat::Csv), liveMetrics(nullptr), liveRunning(false), liveTotal(0),
+      liveQueued(0), liveDispatched(0), liveCompleted(0), liveClock(0),
+      checkpointInterval(0), interrupted(false) {
+    pinning.policy = PinningPolicy::None;
+    burstMode = BurstMode::Sleep;
+    ExecutorStats none = { 0, 0, 0, 0, 0 };
+    executorStats = none;
+    StreamStats empty = { 0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0, 0, 0.0 };
+    streamStats = empty;
+    RunSummary nothing = { 0, 0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    summary = nothing;
     // Initialize start time for timestamp tracking
     startTime = std::chrono::steady_clock::now();
 }
@@ -42,72 +300,77 @@ ProcessSimulator::~ProcessSimulator() {
 /**
  * @brief Load processes from a text file with validation
  * 
- * File format: Each line contains "pid burstTime" (space-separated integers)
+ * File format: Each line contains "pid burstTime [arrivalTime [priority]]"
+ * (space-separated integers). The arrival time and priority columns are
+ * optional and default to 0.
  * Example:
  *   1 3
- *   2 5
- *   3 2
+ *   2 5 1
+ *   3 2 4 1
+ * 
+ * Files that start with the binary trace magic (see TraceFile.h) are decoded
+ * as binary traces instead, with the same validation rules.
  * 
  * Validation:
  * - Process ID must be positive
  * - Burst time must be positive
+ * - Arrival time, if present, must not be negative
  * - File must exist and be readable
  * 
  * @param filename Path to the input file
  * @return true if file loaded successfully, false on error
  */
 bool ProcessSimulator::loadProcesses(const std::string& filename) {
-    std::ifstream file(filename);
+    MappedFile file;
     
     // Check if file exists and can be opened
-    if (!file.is_open()) {
+    if (!file.open(filename)) {
         std::cerr << "Error: Cannot open file " << filename << std::endl;
         return false;
     }
     
-    std::string line;
-    int lineNumber = 0;
+    const char* cursor = file.data();
+    const char* end = cursor + file.size();
     
-    // Read file line by line
-    while (std::getline(file, line)) {
-        lineNumber++;
-        
-        // Skip empty lines
-        if (line.empty()) {
-            continue;
-        }
-        
-        std::istringstream iss(line);
-        int pid, burstTime;
-        
-        // Try to read process ID and burst time
-        if (!(iss >> pid >> burstTime)) {
-            std::cerr << "Error: Invalid data format at line " << lineNumber 
-                      << " in file " << filename << std::endl;
+    // Binary traces are decoded column by column straight from the mapping
+    if (isBinaryTrace(cursor, file.size())) {
+        if (!parseBinaryTrace(cursor, file.size(), filename, processes)) {
             return false;
         }
-        
-        // Validate process ID (should be positive)
-        if (pid <= 0) {
-            std::cerr << "Error: Invalid process ID " << pid 
-                      << " at line " << lineNumber 
-                      << ". Process ID must be positive." << std::endl;
-            return false;
+        if (processes.empty()) {
+            std::cerr << "Warning: No valid processes found in " << filename << std::endl;
         }
+        return true;
+    }
+    
+    // Reserve one slot per line up front (an upper bound on the record count)
+    std::size_t lineCount = 0;
+    for (const char* p = cursor; p != end; lineCount++) {
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        p = (newline == nullptr) ? end : newline + 1;
+    }
+    processes.reserve(processes.size() + lineCount);
+    
+    int lineNumber = 0;
+    
+    // Scan the mapped file line by line
+    while (cursor != end) {
+        const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor)));
+        const char* lineEnd = (newline == nullptr) ? end : newline;
+        lineNumber++;
         
-        // Validate burst time (should be positive)
-        if (burstTime <= 0) {
-            std::cerr << "Error: Invalid burst time " << burstTime 
-                      << " at line " << lineNumber 
-                      << ". Burst time must be positive." << std::endl;
-            return false;
+        // Skip empty lines
+        if (lineEnd != cursor) {
+            Process proc;
+            if (!parseProcessLine(cursor, lineEnd, lineNumber, filename, proc)) {
+                return false;
+            }
+            
+            // Add valid process to the vector
+            processes.push_back(proc);
         }
         
-        // Add valid process to the vector
-        Process proc;
-        proc.pid = pid;
-        proc.burstTime = burstTime;
-        processes.push_back(proc);
+        cursor = (newline == nullptr) ? end : newline + 1;
     }
     
     file.close();
@@ -120,99 +383,1539 @@ bool ProcessSimulator::loadProcesses(const std::string& filename) {
     return true;
 }
 
+/**
+ * @brief Parse and validate one line of the text trace format
+ * 
+ * Line format: "pid burstTime [arrivalTime [priority]]". Anything after the
+ * priority column is ignored.
+ * 
+ * Validation:
+ * - pid and burstTime must be integers; optional columns, if present, too
+ * - Process ID must be positive
+ * - Burst time must be positive
+ * - Arrival time must not be negative
+ * 
+ * @param begin First character of the line
+ * @param end One past the last character (excluding the newline)
+ * @param lineNumber 1-based line number for error messages
+ * @param filename File name for error messages
+ * @param process Receives the parsed process
+ * @return true if the line is a valid process record
+ */
+bool ProcessSimulator::parseProcessLine(const char* begin, const char* end, int lineNumber,
+                                        const std::string& filename, Process& process) {
+    const char* p = begin;
+    int pid, burstTime;
+    
+    // Try to read process ID and burst time
+    bool valid = scanInt(p, end, pid) && scanInt(p, end, burstTime);
+    
+    // Optional columns: arrival time, then priority
+    int arrivalTime = 0;
+    int priority = 0;
+    if (valid && skipSpace(p, end) != end) {
+        valid = scanInt(p, end, arrivalTime) &&
+                (skipSpace(p, end) == end || scanInt(p, end, priority));
+    }
+    
+    if (!valid) {
+        std::cerr << "Error: Invalid data format at line " << lineNumber 
+                  << " in file " << filename << std::endl;
+        return false;
+    }
+    
+    // Validate process ID (should be positive)
+    if (pid <= 0) {
+        std::cerr << "Error: Invalid process ID " << pid 
+                  << " at line " << lineNumber 
+                  << ". Process ID must be positive." << std::endl;
+        return false;
+    }
+    
+    // Validate burst time (should be positive)
+    if (burstTime <= 0) {
+        std::cerr << "Error: Invalid burst time " << burstTime 
+                  << " at line " << lineNumber 
+                  << ". Burst time must be positive." << std::endl;
+        return false;
+    }
+    
+    // Validate arrival time (should not be negative)
+    if (arrivalTime < 0) {
+        std::cerr << "Error: Invalid arrival time " << arrivalTime 
+                  << " at line " << lineNumber 
+                  << ". Arrival time must not be negative." << std::endl;
+        return false;
+    }
+    
+    process.pid = pid;
+    process.burstTime = burstTime;
+    process.arrivalTime = arrivalTime;
+    process.priority = priority;
+    return true;
+}
+
 /**
  * @brief Get elapsed time since simulation start
  * 
  * Calculates the time elapsed since the ProcessSimulator was created.
  * Used for timestamp logging to show the sequence of events.
+ * In VirtualTime mode the simulated clock is reported instead.
+ * 
+ * Full steady_clock resolution; the number of decimals follows the
+ * Logger's timestamp precision (3 by default).
  * 
  * @return Formatted timestamp string in seconds (e.g., "1.234")
  */
 std::string ProcessSimulator::getTimestamp() {
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime);
+    if (mode == ExecutionMode::VirtualTime) {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(Logger::instance().getTimestampPrecision())
+            << static_cast<double>(virtualNow);
+        return oss.str();
+    }
     
-    double seconds = elapsed.count() / 1000.0;
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - startTime);
     
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(3) << seconds;
-    return oss.str();
+    char text[32];
+    int length = Logger::formatSeconds(text, sizeof(text), elapsed, Logger::instance().getTimestampPrecision());
+    return std::string(text, static_cast<std::size_t>(length));
+}
+
+/**
+ * @brief Seconds of wall-clock time elapsed since startTime
+ * 
+ * @return Elapsed time in seconds (full steady_clock resolution)
+ */
+double ProcessSimulator::elapsedSeconds() const {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+    return elapsed.count();
 }
 
 /**
  * @brief Thread-safe logging with timestamp
  * 
- * CRITICAL SECTION: This method acquires coutMutex before writing to console.
- * This prevents interleaved output when multiple threads log simultaneously.
+ * Lock-free: the message is copied into the calling thread's Logger ring
+ * together with the raw capture time. Timestamp formatting and console I/O
+ * happen on the Logger's drain thread.
  * 
- * Uses std::lock_guard for RAII-style automatic mutex unlocking when the
- * function exits (even if an exception is thrown).
+ * In VirtualTime mode the message is stamped with the simulated clock.
  * 
  * @param message The message to log to console
  */
 void ProcessSimulator::log(const std::string& message) {
-    // CRITICAL SECTION BEGIN - acquire lock for thread-safe console output
-    std::lock_guard<std::mutex> lock(coutMutex);
-    std::cout << "[" << getTimestamp() << "s] " << message << std::endl;
-    // CRITICAL SECTION END - lock automatically released when lock_guard goes out of scope
+    if (!loggingEnabled) {
+        return;
+    }
+    if (mode == ExecutionMode::VirtualTime) {
+        Logger::instance().logAt(std::chrono::seconds(virtualNow), message);
+    } else {
+        Logger::instance().log(startTime, message);
+    }
+}
+
+/**
+ * @brief Check whether messages of a level are logged by this simulator
+ * 
+ * Levels above SIM_LOG_LEVEL are constant-false here, so the guarded
+ * message formatting is compiled out of every call site.
+ * 
+ * @param level Level of the message
+ * @return true if the level is compiled in and enabled and logging is on
+ */
+bool ProcessSimulator::logging(LogLevel level) const {
+    return SIM_LOG_ON(level) && loggingEnabled;
+}
+
+/**
+ * @brief Set the number of worker threads used by executeProcesses()
+ * 
+ * @param count Worker count (0 selects std::thread::hardware_concurrency())
+ */
+void ProcessSimulator::setWorkerCount(unsigned int count) {
+    workerCount = count;
+}
+
+/**
+ * @brief Get the configured number of worker threads
+ * 
+ * @return Worker count (0 means hardware concurrency)
+ */
+unsigned int ProcessSimulator::getWorkerCount() const {
+    return workerCount;
+}
+
+/**
+ * @brief Select real-time, virtual-time or coroutine execution
+ * 
+ * @param newMode ExecutionMode::RealTime (default), ExecutionMode::VirtualTime
+ *                or ExecutionMode::Coroutine
+ */
+void ProcessSimulator::setExecutionMode(ExecutionMode newMode) {
+    mode = newMode;
+}
+
+/**
+ * @brief Get the current execution mode
+ * 
+ * @return The configured ExecutionMode
+ */
+ExecutionMode ProcessSimulator::getExecutionMode() const {
+    return mode;
+}
+
+/**
+ * @brief Select the CPU scheduling policy used in VirtualTime mode
+ * 
+ * @param newPolicy Scheduling policy (default FCFS)
+ */
+void ProcessSimulator::setSchedulingPolicy(SchedulingPolicy newPolicy) {
+    policy = newPolicy;
+}
+
+/**
+ * @brief Get the configured scheduling policy
+ * 
+ * @return The configured SchedulingPolicy
+ */
+SchedulingPolicy ProcessSimulator::getSchedulingPolicy() const {
+    return policy;
+}
+
+/**
+ * @brief Select the ready queue of the keyed policies in VirtualTime mode
+ * 
+ * @param type Ready queue implementation (default Scan)
+ */
+void ProcessSimulator::setReadyQueue(ReadyQueueType type) {
+    readyQueue = type;
+}
+
+/**
+ * @brief Get the configured ready queue type
+ * 
+ * @return The configured ReadyQueueType
+ */
+ReadyQueueType ProcessSimulator::getReadyQueue() const {
+    return readyQueue;
+}
+
+/**
+ * @brief Set the Round-Robin time quantum
+ * 
+ * Non-positive values are ignored.
+ * 
+ * @param quantum Time slice in seconds
+ */
+void ProcessSimulator::setTimeQuantum(int quantum) {
+    if (quantum > 0) {
+        timeQuantum = quantum;
+    }
+}
+
+/**
+ * @brief Set how long one trace time unit lasts in RealTime mode
+ * 
+ * @param secondsPerUnit Wall-clock seconds per unit (default 1.0, must not be negative)
+ */
+void ProcessSimulator::setTimeScale(double secondsPerUnit) {
+    if (secondsPerUnit >= 0.0) {
+        timeScale = secondsPerUnit;
+    }
+}
+
+/**
+ * @brief Turn the per-process log messages on or off
+ * 
+ * @param enabled false suppresses every message (e.g., for benchmarking)
+ */
+void ProcessSimulator::setLoggingEnabled(bool enabled) {
+    loggingEnabled = enabled;
+}
+
+/**
+ * @brief Select the worker pool used in RealTime mode
+ * 
+ * @param type ExecutorType::GlobalQueue (default) or ExecutorType::WorkStealing
+ */
+void ProcessSimulator::setExecutorType(ExecutorType type) {
+    executorType = type;
+}
+
+/**
+ * @brief Get the configured worker pool type
+ * 
+ * @return The configured ExecutorType
+ */
+ExecutorType ProcessSimulator::getExecutorType() const {
+    return executorType;
+}
+
+/**
+ * @brief Get the worker pool counters of the last RealTime run
+ * 
+ * @return Tasks executed, steals and maximum queue depth (all 0 before a RealTime run)
+ */
+const ExecutorStats& ProcessSimulator::getExecutorStats() const {
+    return executorStats;
 }
 
 /**
- * @brief Worker function executed by each process thread
+ * @brief Worker function executed for each process
  * 
- * This static function is the entry point for each process thread.
+ * This static function is run by a pool worker for each process.
  * It performs the following steps:
  * 1. Log process start with burst time
- * 2. Simulate CPU burst time using std::this_thread::sleep_for
+ * 2. Spend the CPU burst (sleep_for, or the calibrated kernel in BurstMode::Burn)
+ *    and record the thread CPU time it took
  * 3. Log process completion
  * 
+ * The start and finish times are recorded in the process's own stats slot,
+ * which no other thread touches during the run.
+ * 
  * Thread Safety: Uses sim->log() which is thread-safe
  * 
- * @param pid Process ID
- * @param burstTime CPU burst time in seconds
+ * @param index Index of the process in the processes vector
  * @param sim Pointer to ProcessSimulator instance for thread-safe logging
  */
-void ProcessSimulator::processWorker(int pid, int burstTime, ProcessSimulator* sim) {
+void ProcessSimulator::processWorker(std::size_t index, ProcessSimulator* sim) {
+    const Process& process = sim->processes[index];
+    ProcessStats& record = sim->stats[index];
+    
     // Log process start
-    std::ostringstream ss;
-    ss << "PROCESS " << std::setw(3) << pid << " | Started (burst time: " << burstTime << "s)";
-    sim->log(ss.str());
+    record.startTime = sim->elapsedSeconds();
+    sim->liveCount(sim->liveDispatched);
+    if (sim->logging(LogLevel::Events)) {
+        sim->log(startedMessage(process.pid, process.burstTime));
+    }
     
-    // Simulate CPU burst time using sleep
+    // Simulate CPU burst time
     // This represents the process executing on the CPU
-    std::this_thread::sleep_for(std::chrono::seconds(burstTime));
+    record.cpuTime = sim->runBurst(process.burstTime);
     
     // Log process finish
-    ss.str("");
-    ss << "PROCESS " << std::setw(3) << pid << " | Finished";
-    sim->log(ss.str());
+    record.finishTime = sim->elapsedSeconds();
+    sim->liveCount(sim->liveCompleted);
+    if (sim->logging(LogLevel::Events)) {
+        sim->log(finishedMessage(process.pid));
+    }
 }
 
 /**
- * @brief Execute all loaded processes as concurrent threads
+ * @brief Spend one burst on the calling worker
  * 
- * Creates one thread per process and waits for all threads to complete.
- * This demonstrates concurrent process execution where multiple processes
- * can run simultaneously.
+ * Sleep: sleep_for the scaled burst. Burn: run the calibrated BurnKernel for
+ * the scaled burst, so the worker occupies a core (and competes with the
+ * other workers for one) for the whole burst.
  * 
- * Thread Management:
- * 1. Create all threads and store them in a vector
- * 2. Join all threads to wait for completion before returning
+ * @param burstTime Burst in trace time units
+ * @return Thread CPU seconds the burst consumed
+ */
+double ProcessSimulator::runBurst(int burstTime) const {
+    double cpuBefore = threadCpuSeconds();
+    double seconds = burstTime * timeScale;
+    if (seconds > 0.0) {
+        if (burstMode == BurstMode::Burn) {
+            BurnKernel::instance().run(seconds);
+        } else {
+            std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+        }
+    }
+    return threadCpuSeconds() - cpuBefore;
+}
+
+/**
+ * @brief Discrete-event execution of all loaded processes
  * 
- * This ensures all processes complete before the function returns.
+ * Simulates workerCount CPUs under the configured scheduling policy on a
+ * ProcessTable copy of the processes. Instead of sleeping, the simulated
+ * clock jumps straight to the next of two event sources:
+ * 
+ * - Arrivals:   a cursor into the table's arrivalOrder column. The process
+ *               joins the scheduler's ready queue; under a preemptive
+ *               policy it may preempt a running process
+ * - Slice ends: a priority queue ordered by (time, insertion order), holding
+ *               at most one live entry per CPU. The running process has
+ *               either finished its burst (its CPU becomes idle) or used up
+ *               its time quantum (it goes back to the ready queue if
+ *               anything else is waiting)
+ * 
+ * All events at time t are handled before any CPU is given work: first the
+ * arrivals at t (equal arrivals in file order), then the slice ends at t.
+ * Only then are idle CPUs given the processes chosen by the scheduler, so
+ * the policy picks from every process ready at t, and an arrival at t that
+ * found no idle CPU may preempt. A preempted CPU's pending slice end is
+ * invalidated by bumping its dispatch token rather than by removing it from
+ * the queue.
+ * 
+ * Runs on the calling thread only, so no locking is needed beyond log().
  */
-void ProcessSimulator::executeProcesses() {
-    std::vector<std::thread> threads;
+void ProcessSimulator::runVirtualTime() {
+    unsigned int cpuCount = (workerCount == 0) ? ThreadPool::defaultThreadCount() : workerCount;
+    
+    ProcessTable table;
+    table.assign(processes);
+    std::unique_ptr<Scheduler> scheduler = createScheduler(policy, table, timeQuantum, readyQueue);
+    std::priority_queue<SimEvent, std::vector<SimEvent>, LaterEvent> events;
+    std::vector<SimCpu> cpus(cpuCount);
+    std::vector<int>& remaining = table.remaining;
+    std::size_t count = table.size();
+    std::size_t nextArrival = 0;
+    unsigned long long nextSeq = 0;
+    
+    for (auto& cpu : cpus) {
+        cpu.busy = false;
+        cpu.index = 0;
+        cpu.sliceStart = 0;
+        cpu.token = 0;
+    }
+    
+    virtualNow = 0;
     
-    // Create a thread for each process
-    // Each thread will execute the processWorker function
-    for (const auto& process : processes) {
-        threads.push_back(std::thread(processWorker, process.pid, process.burstTime, this));
+    // Continue an interrupted run: the columns, clock, CPUs, pending slice
+    // ends and ready queue are put back exactly as they were saved
+    if (resumeState) {
+        ProcessCheckpoint& resume = *resumeState;
+        table.remaining.swap(resume.remaining);
+        table.startTime.swap(resume.startTime);
+        table.finishTime.swap(resume.finishTime);
+        virtualNow = resume.clock;
+        nextArrival = static_cast<std::size_t>(resume.nextArrival);
+        nextSeq = resume.nextSeq;
+        for (unsigned int c = 0; c < cpuCount; c++) {
+            const CheckpointCpu& saved = resume.cpus[c];
+            cpus[c].busy = saved.busy;
+            cpus[c].index = saved.index;
+            cpus[c].sliceStart = saved.sliceStart;
+            cpus[c].token = saved.token;
+            if (saved.busy) {
+                SimEvent sliceEnd = { saved.sliceEnd, saved.sliceSeq, saved.index, c, saved.token };
+                events.push(sliceEnd);
+            }
+        }
+        // Re-adding in pick order keeps every tie in the same order
+        for (std::uint32_t index : resume.ready) {
+            scheduler->addReady(index, remaining[index]);
+        }
+        if (liveMetrics) {
+            std::uint64_t finished = 0;
+            for (long long finish : table.finishTime) {
+                finished += (finish >= 0) ? 1 : 0;
+            }
+            liveCompleted.store(finished, std::memory_order_relaxed);
+        }
+        resumeState.reset();
     }
     
-    // Wait for all threads to complete (join all threads)
-    // This ensures all processes finish before we return
-    for (auto& thread : threads) {
-        thread.join();
+    // Save the state between two instants (the top of the loop) to checkpointPath
+    bool checkpointing = !checkpointPath.empty();
+    std::uint64_t fingerprint = checkpointing ? traceFingerprint(processes) : 0;
+    auto saveCheckpoint = [&]() {
+        ProcessCheckpoint checkpoint;
+        checkpoint.policy = policy;
+        checkpoint.readyQueue = readyQueue;
+        checkpoint.quantum = timeQuantum;
+        checkpoint.processCount = count;
+        checkpoint.traceFingerprint = fingerprint;
+        checkpoint.clock = virtualNow;
+        checkpoint.nextArrival = nextArrival;
+        checkpoint.nextSeq = nextSeq;
+        checkpoint.cpus.resize(cpuCount);
+        for (unsigned int c = 0; c < cpuCount; c++) {
+            CheckpointCpu& saved = checkpoint.cpus[c];
+            saved.busy = cpus[c].busy;
+            saved.index = static_cast<std::uint32_t>(cpus[c].index);
+            saved.sliceStart = cpus[c].sliceStart;
+            saved.token = cpus[c].token;
+            saved.sliceEnd = 0;
+            saved.sliceSeq = 0;
+        }
+        // Only the slice end carrying its CPU's current token is still pending
+        std::priority_queue<SimEvent, std::vector<SimEvent>, LaterEvent> pending = events;
+        while (!pending.empty()) {
+            const SimEvent& event = pending.top();
+            if (event.token == cpus[event.cpu].token && cpus[event.cpu].busy) {
+                checkpoint.cpus[event.cpu].sliceEnd = event.time;
+                checkpoint.cpus[event.cpu].sliceSeq = event.seq;
+            }
+            pending.pop();
+        }
+        // Drain the ready queue in pick order and put it back unchanged
+        while (!scheduler->empty()) {
+            checkpoint.ready.push_back(static_cast<std::uint32_t>(scheduler->pickNext()));
+        }
+        for (std::uint32_t index : checkpoint.ready) {
+            scheduler->addReady(index, remaining[index]);
+        }
+        checkpoint.remaining = table.remaining;
+        checkpoint.startTime = table.startTime;
+        checkpoint.finishTime = table.finishTime;
+        return writeCheckpoint(checkpointPath, checkpoint);
+    };
+    std::atomic<bool>& stopRequest = checkpointRequest();
+    std::chrono::steady_clock::time_point nextCheckpoint = std::chrono::steady_clock::now() + checkpointInterval;
+    unsigned int untilClockCheck = CHECKPOINT_POLL_EVENTS;
+    
+    // Queue the end of a new slice for whatever runs on CPU 'c', starting now
+    auto startSlice = [&](unsigned int c) {
+        SimCpu& cpu = cpus[c];
+        cpu.sliceStart = virtualNow;
+        cpu.token++;
+        
+        long long slice = scheduler->timeSlice();
+        long long left = remaining[cpu.index];
+        long long run = (slice > 0 && slice < left) ? slice : left;
+        SimEvent sliceEnd = { virtualNow + run, nextSeq++, cpu.index, c, cpu.token };
+        events.push(sliceEnd);
+    };
+    
+    // Run process 'index' on idle CPU 'c'
+    auto dispatch = [&](unsigned int c, std::size_t index) {
+        cpus[c].busy = true;
+        cpus[c].index = index;
+        liveCount(liveDispatched);
+        
+        if (table.startTime[index] < 0) {
+            table.startTime[index] = virtualNow;
+            if (logging(LogLevel::Events)) {
+                log(startedMessage(table.pid[index], table.burstTime[index]));
+            }
+        } else if (logging(LogLevel::Trace)) {
+            log(remainingMessage(table.pid[index], "Resumed", remaining[index]));
+        }
+        
+        startSlice(c);
+    };
+    
+    // Timeline: the slice of CPU 'c' ends now
+    auto traceSlice = [&](unsigned int c) {
+        if (timeline) {
+            timeline->addSpan(cpus[c].index, "run", cpus[c].sliceStart * 1000000000LL, virtualNow * 1000000000LL);
+        }
+    };
+    
+    // Stop the process on CPU 'c' and return it to the ready queue
+    auto preempt = [&](unsigned int c) {
+        SimCpu& cpu = cpus[c];
+        traceSlice(c);
+        remaining[cpu.index] -= static_cast<int>(virtualNow - cpu.sliceStart);
+        cpu.busy = false;
+        cpu.token++;  // Invalidates the pending slice end
+        if (logging(LogLevel::Trace)) {
+            log(remainingMessage(table.pid[cpu.index], "Preempted", remaining[cpu.index]));
+        }
+        scheduler->addReady(cpu.index, remaining[cpu.index]);
+        liveCount(liveQueued);
+    };
+    
+    while (nextArrival < count || !events.empty()) {
+        if (checkpointing) {
+            if (stopRequest.load(std::memory_order_relaxed)) {
+                stopRequest.store(false, std::memory_order_relaxed);
+                if (saveCheckpoint()) {
+                    interrupted = true;
+                    return;
+                }
+                std::cerr << "Warning: Checkpoint not saved; the run continues" << std::endl;
+            } else if (checkpointInterval.count() > 0 && --untilClockCheck == 0) {
+                untilClockCheck = CHECKPOINT_POLL_EVENTS;
+                if (std::chrono::steady_clock::now() >= nextCheckpoint) {
+                    saveCheckpoint();
+                    nextCheckpoint = std::chrono::steady_clock::now() + checkpointInterval;
+                }
+            }
+        }
+        
+        // Skip slice ends of CPUs that were preempted after the event was queued
+        if (!events.empty() && events.top().token != cpus[events.top().cpu].token) {
+            events.pop();
+            continue;
+        }
+        
+        // Next instant: the earlier of the next arrival and the next slice end
+        if (nextArrival < count &&
+            (events.empty() || table.arrivalTime[table.arrivalOrder[nextArrival]] <= events.top().time)) {
+            virtualNow = table.arrivalTime[table.arrivalOrder[nextArrival]];
+        } else {
+            virtualNow = events.top().time;
+        }
+        
+        // Queue every arrival at this instant before anything is dispatched
+        std::size_t firstArrival = nextArrival;
+        while (nextArrival < count && table.arrivalTime[table.arrivalOrder[nextArrival]] == virtualNow) {
+            std::size_t index = table.arrivalOrder[nextArrival++];
+            scheduler->addReady(index, remaining[index]);
+            liveCount(liveQueued);
+        }
+        
+        // Then every slice end at this instant
+        while (!events.empty() && events.top().time == virtualNow) {
+            SimEvent event = events.top();
+            events.pop();
+            if (event.token != cpus[event.cpu].token) {
+                continue;
+            }
+            
+            SimCpu& cpu = cpus[event.cpu];
+            std::size_t index = cpu.index;
+            long long ran = virtualNow - cpu.sliceStart;
+            
+            if (ran == remaining[index]) {
+                traceSlice(event.cpu);
+                // Burst complete - CPU becomes idle
+                remaining[index] = 0;
+                cpu.busy = false;
+                table.finishTime[index] = virtualNow;
+                liveCount(liveCompleted);
+                if (logging(LogLevel::Events)) {
+                    log(finishedMessage(table.pid[index]));
+                }
+            } else if (!scheduler->empty()) {
+                // Quantum expired and others are waiting - back of the queue
+                preempt(event.cpu);
+            } else {
+                // Quantum expired but nothing else is ready - keep running
+                traceSlice(event.cpu);
+                remaining[index] -= static_cast<int>(ran);
+                startSlice(event.cpu);
+            }
+        }
+        
+        if (liveMetrics) {
+            liveClock.store(virtualNow, std::memory_order_relaxed);
+        }
+        
+        // Dispatch ready processes onto idle CPUs (lowest CPU number first)
+        for (unsigned int c = 0; c < cpuCount && !scheduler->empty(); c++) {
+            if (!cpus[c].busy) {
+                dispatch(c, scheduler->pickNext());
+            }
+        }
+        
+        // Preemptive policies: every CPU is busy if anything is still ready.
+        // An arrival of this instant that did not get a CPU may displace the
+        // worst running process, in arrival order
+        for (std::size_t a = firstArrival; a < nextArrival && !scheduler->empty(); a++) {
+            std::size_t index = table.arrivalOrder[a];
+            if (table.startTime[index] >= 0) {
+                continue;  // Already dispatched
+            }
+            bool found = false;
+            unsigned int victim = 0;
+            long long victimRemaining = 0;
+            for (unsigned int c = 0; c < cpuCount; c++) {
+                long long left = remaining[cpus[c].index] - (virtualNow - cpus[c].sliceStart);
+                if (scheduler->shouldPreempt(index, remaining[index], cpus[c].index, left) &&
+                    (!found || left > victimRemaining)) {
+                    found = true;
+                    victim = c;
+                    victimRemaining = left;
+                }
+            }
+            if (found) {
+                preempt(victim);
+                dispatch(victim, scheduler->pickNext());
+            }
+        }
+    }
+    
+    for (std::size_t i = 0; i < count; i++) {
+        stats[i].startTime = static_cast<double>(table.startTime[i]);
+        stats[i].finishTime = static_cast<double>(table.finishTime[i]);
+    }
+}
+
+/**
+ * @brief Coroutine of one process: wait for the arrival, spend the burst, finish
+ * 
+ * 1. co_await a timer until the scaled arrival time (the process is "queued"
+ *    at its arrival; its start is when a worker resumed it)
+ * 2. Spend the burst: co_await a timer in BurstMode::Sleep, so the worker
+ *    is free for other processes meanwhile; run the BurnKernel inline in
+ *    BurstMode::Burn, measured on the worker's CPU clock
+ * 3. Record the finish and log it, as processWorker() does
+ * 
+ * Thread Safety: Only this coroutine touches the process's stats slot.
+ * 
+ * @param index Index of the process in the processes vector
+ * @param runner Scheduler running the coroutine
+ * @return The process's task
+ */
+CoTask ProcessSimulator::processTask(std::size_t index, CoScheduler* runner) {
+    const Process& process = processes[index];
+    ProcessStats& record = stats[index];
+    double arrival = process.arrivalTime * timeScale;
+    
+    co_await runner->sleepUntil(startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(arrival)));
+    record.queuedTime = arrival;
+    liveCount(liveQueued);
+    
+    record.startTime = elapsedSeconds();
+    liveCount(liveDispatched);
+    if (logging(LogLevel::Events)) {
+        log(startedMessage(process.pid, process.burstTime));
+    }
+    
+    double seconds = process.burstTime * timeScale;
+    if (burstMode == BurstMode::Burn) {
+        double cpuBefore = threadCpuSeconds();
+        BurnKernel::instance().run(seconds);
+        record.cpuTime = threadCpuSeconds() - cpuBefore;
+    } else {
+        co_await runner->sleepFor(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::duration<double>(seconds)));
+        record.cpuTime = 0.0;
+    }
+    
+    record.finishTime = elapsedSeconds();
+    liveCount(liveCompleted);
+    if (logging(LogLevel::Events)) {
+        log(finishedMessage(process.pid));
+    }
+}
+
+/**
+ * @brief Run every loaded process as a coroutine on workerCount threads
+ * 
+ * All frames are allocated (and counted) before the clock starts; each
+ * coroutine then parks itself on the timer heap until its arrival, so
+ * equal arrivals leave the heap in file order.
+ */
+void ProcessSimulator::runCoroutines() {
+    if (burstMode == BurstMode::Burn) {
+        BurnKernel::instance();
+    }
+    unsigned int threads = (workerCount == 0) ? ThreadPool::defaultThreadCount() : workerCount;
+    workerCpus = planCpus(pinning, threads);
+    CoScheduler runner(threads, workerCpus);
+    
+    std::uint64_t framesBefore = CoTask::frameBytes();
+    for (std::size_t i = 0; i < processes.size(); i++) {
+        runner.spawn(processTask(i, &runner));
+    }
+    frameBytes = CoTask::frameBytes() - framesBefore;
+    startTime = std::chrono::steady_clock::now();
+    runner.run();
+    coroutineBusy = runner.getBusySeconds();
+    
+    ExecutorStats none = { 0, 0, 0, 0, 0 };
+    executorStats = none;
+    executorWorkers = runner.size();
+}
+
+/**
+ * @brief Execute all loaded processes
+ * 
+ * In VirtualTime mode the work is delegated to runVirtualTime() instead.
+ * 
+ * In RealTime mode every process is queued on an Executor once its arrival
+ * time has passed. At most workerCount processes run at the same time; the
+ * rest wait in the pool's run queue(s) - the shared FIFO queue of a ThreadPool
+ * or the per-worker queues of a WorkStealingPool. This bounds the number of OS
+ * threads regardless of how many processes the workload file contains.
+ * 
+ * Thread Management:
+ * 1. Start a pool of workerCount threads (hardware concurrency by default)
+ *    of the configured executor type (after calibrating the burn kernel, in
+ *    BurstMode::Burn, while the cores are still idle)
+ * 2. Submit one task per process, in arrival order, sleeping until each arrival
+ * 3. Wait for the pool to drain before returning and keep its counters
+ * 
+ * This ensures all processes complete before the function returns.
+ * Per-process statistics are then available from getProcessStats().
+ */
+void ProcessSimulator::executeProcesses() {
+    // Reset the per-process results; arrival times are known up front
+    // (RealTime and Coroutine statistics are in scaled wall-clock seconds)
+    double unit = (mode != ExecutionMode::VirtualTime) ? timeScale : 1.0;
+    streamed = false;
+    interrupted = false;
+    stats.assign(processes.size(), ProcessStats());
+    for (std::size_t i = 0; i < processes.size(); i++) {
+        stats[i].pid = processes[i].pid;
+        stats[i].arrivalTime = processes[i].arrivalTime * unit;
+    }
+    
+    // Timeline tracks are created up front (one per process)
+    timeline.reset();
+    if (!tracePath.empty()) {
+        const char* clock = (mode == ExecutionMode::RealTime) ? "real time"
+                            : (mode == ExecutionMode::Coroutine) ? "coroutines" : schedulingPolicyName(policy);
+        timeline.reset(new TimelineTrace(std::string("Process simulation (") + clock + ")", "cpu"));
+        timeline->reset(processes.size());
+        for (std::size_t i = 0; i < processes.size(); i++) {
+            timeline->setTrackName(i, "PID " + std::to_string(processes[i].pid));
+        }
+    }
+    
+    beginLiveRun(processes.size());
+    if (mode == ExecutionMode::VirtualTime) {
+        runVirtualTime();
+    } else if (mode == ExecutionMode::Coroutine) {
+        runCoroutines();
+    } else {
+        // Release processes in arrival order (stable, so ties keep file order)
+        std::vector<std::size_t> order(processes.size());
+        for (std::size_t i = 0; i < order.size(); i++) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+            return processes[a].arrivalTime < processes[b].arrivalTime;
+        });
+        
+        if (burstMode == BurstMode::Burn) {
+            BurnKernel::instance();
+        }
+        startTime = std::chrono::steady_clock::now();
+        workerCpus = planCpus(pinning, (workerCount == 0) ? ThreadPool::defaultThreadCount() : workerCount);
+        std::unique_ptr<Executor> pool = createExecutor(executorType, workerCount, workerCpus);
+        
+        // Queue each process - a free worker runs processWorker for it
+        for (std::size_t index : order) {
+            if (timeScale > 0.0 && processes[index].arrivalTime > 0) {
+                std::this_thread::sleep_until(startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(processes[index].arrivalTime * timeScale)));
+            }
+            stats[index].queuedTime = elapsedSeconds();
+            liveCount(liveQueued);
+            pool->submit([index, this] { processWorker(index, this); });
+        }
+        
+        // Wait for all queued processes to complete
+        // This ensures all processes finish before we return
+        pool->wait();
+        executorStats = pool->getStats();
+        executorWorkers = pool->size();
+    }
+    endLiveRun();
+    
+    // Make sure all process output is on the console before returning
+    Logger::instance().flush();
+    
+    // An interrupted run's state is in the checkpoint; it has no statistics yet
+    if (interrupted) {
+        timeline.reset();
+        return;
+    }
+    
+    // Derive waiting, turnaround, response, latency and overrun
+    for (std::size_t i = 0; i < processes.size(); i++) {
+        ProcessStats& record = stats[i];
+        if (mode == ExecutionMode::VirtualTime) {
+            record.queuedTime = record.arrivalTime;
+            record.cpuTime = processes[i].burstTime;
+        }
+        record.burstTime = processes[i].burstTime * unit;
+        record.turnaroundTime = record.finishTime - record.arrivalTime;
+        record.waitingTime = record.turnaroundTime - record.burstTime;
+        record.responseTime = record.startTime - record.arrivalTime;
+        record.schedulingLatency = record.startTime - record.queuedTime;
+        record.overrun = (record.finishTime - record.startTime) - record.burstTime;
+    }
+    
+    summarize((mode != ExecutionMode::VirtualTime) ? executorWorkers
+              : ((workerCount == 0) ? ThreadPool::defaultThreadCount() : workerCount));
+    
+    if (!metricsPath.empty()) {
+        writeMetrics(metricsPath, metricsFormat);
+    }
+    
+    if (timeline) {
+        // Wall-clock spans come straight from the records (virtual slices were traced live)
+        if (mode != ExecutionMode::VirtualTime) {
+            for (std::size_t i = 0; i < stats.size(); i++) {
+                const ProcessStats& record = stats[i];
+                timeline->addSpan(i, "queued", static_cast<std::int64_t>(record.queuedTime * 1e9),
+                                  static_cast<std::int64_t>(record.startTime * 1e9));
+                timeline->addSpan(i, "run", static_cast<std::int64_t>(record.startTime * 1e9),
+                                  static_cast<std::int64_t>(record.finishTime * 1e9));
+            }
+        }
+        timeline->write(tracePath);
+        timeline.reset();
+    }
+}
+
+/**
+ * @brief Fill summary from the per-process records of the last run
+ * 
+ * The makespan runs from the start of the run (time 0) to the last finish.
+ * Busy time is the summed run spans in RealTime mode (so sleep overruns
+ * count as busy) and the summed bursts in VirtualTime mode (where a span
+ * also covers time spent preempted). In Coroutine mode it is the time the
+ * workers spent resuming coroutines: sleeping bursts are timers that hold
+ * no worker, so their spans overlap and would exceed workers x makespan.
+ * 
+ * @param workers Workers or simulated CPUs of the run
+ */
+void ProcessSimulator::summarize(unsigned int workers) {
+    summary.processes = stats.size();
+    summary.workers = workers;
+    summary.makespan = 0.0;
+    summary.busyTime = 0.0;
+    summary.cpuTime = 0.0;
+    for (const auto& record : stats) {
+        summary.cpuTime += record.cpuTime;
+        summary.makespan = std::max(summary.makespan, record.finishTime);
+        summary.busyTime += (mode != ExecutionMode::VirtualTime) ? record.finishTime - record.startTime
+                                                                 : record.burstTime;
+    }
+    if (mode == ExecutionMode::Coroutine) {
+        summary.busyTime = coroutineBusy;
+    }
+    summary.throughput = (summary.makespan > 0.0) ? summary.processes / summary.makespan : 0.0;
+    summary.utilization = (summary.makespan > 0.0 && workers > 0)
+                          ? summary.busyTime / (workers * summary.makespan) : 0.0;
+    if (mode == ExecutionMode::Coroutine) {
+        // A worker's last resume ends just after the final finish it records
+        summary.utilization = std::min(summary.utilization, 1.0);
+    }
+}
+
+/**
+ * @brief Consumer loop of streamProcesses()
+ * 
+ * Pops records until the queue is closed and drained, executing each like
+ * processWorker() does. Timing totals are kept locally and merged into
+ * streamStats once, so workers only contend on the queue.
+ * 
+ * Thread Safety: streamStats is updated under streamMutex (CRITICAL SECTION)
+ * 
+ * @param sim Pointer to ProcessSimulator instance
+ * @param queue Ingestion queue shared with the reader
+ */
+void ProcessSimulator::streamWorker(ProcessSimulator* sim, BoundedQueue<Process>* queue) {
+    std::uint64_t executed = 0;
+    double waiting = 0.0;
+    double turnaround = 0.0;
+    double response = 0.0;
+    double busy = 0.0;
+    double cpu = 0.0;
+    
+    Process process;
+    while (queue->pop(process)) {
+        double started = sim->elapsedSeconds();
+        sim->liveCount(sim->liveDispatched);
+        if (sim->logging(LogLevel::Events)) {
+            sim->log(startedMessage(process.pid, process.burstTime));
+        }
+        
+        cpu += sim->runBurst(process.burstTime);
+        
+        double finished = sim->elapsedSeconds();
+        sim->liveCount(sim->liveCompleted);
+        if (sim->logging(LogLevel::Events)) {
+            sim->log(finishedMessage(process.pid));
+        }
+        
+        double arrival = process.arrivalTime * sim->timeScale;
+        executed++;
+        turnaround += finished - arrival;
+        waiting += (finished - arrival) - process.burstTime * sim->timeScale;
+        response += started - arrival;
+        busy += finished - started;
+    }
+    
+    // CRITICAL SECTION BEGIN - merge this worker's totals
+    std::lock_guard<std::mutex> lock(sim->streamMutex);
+    sim->streamStats.processes += executed;
+    sim->streamStats.totalWaiting += waiting;
+    sim->streamStats.totalTurnaround += turnaround;
+    sim->streamStats.totalResponse += response;
+    sim->streamStats.totalBusy += busy;
+    sim->streamStats.totalCpu += cpu;
+    // CRITICAL SECTION END
+}
+
+/**
+ * @brief Execute a trace while it is being read (RealTime mode only)
+ * 
+ * Pipeline:
+ * 1. Start workerCount consumer threads (hardware concurrency by default)
+ *    blocked on an empty BoundedQueue
+ * 2. The calling thread reads the source in STREAM_CHUNK_SIZE chunks and
+ *    splits it into lines, carrying a partial last line over to the next
+ *    chunk; each line is validated with parseProcessLine()
+ * 3. Each record is pushed once its arrival time has passed; push() blocks
+ *    while the queue is full, which throttles the reader to the workers
+ * 4. At end of input (or on an error) the queue is closed; the workers drain
+ *    it and exit
+ * 
+ * Nothing is retained per record: memory is bounded by the queue capacity
+ * and one chunk, however long the trace is.
+ * 
+ * @param source Path of the trace, or "-" for stdin
+ * @param queueCapacity Maximum number of records buffered between reader and workers
+ * @return true if the whole stream was read and executed, false on error
+ */
+bool ProcessSimulator::streamProcesses(const std::string& source, std::size_t queueCapacity) {
+    if (mode != ExecutionMode::RealTime) {
+        std::cerr << "Error: Streaming ingestion needs RealTime mode "
+                  << "(virtual time replays the whole trace from memory)" << std::endl;
+        return false;
+    }
+    
+    StreamSource input;
+    if (!input.open(source)) {
+        std::cerr << "Error: Cannot open file " << source << std::endl;
+        return false;
+    }
+    const std::string name = (source == "-") ? std::string("stdin") : source;
+    
+    StreamStats empty = { 0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0, 0, 0.0 };
+    streamStats = empty;
+    streamed = true;
+    stats.clear();
+    executorWorkers = 0;
+    
+    BoundedQueue<Process> queue(queueCapacity);
+    unsigned int workers = (workerCount > 0) ? workerCount : ThreadPool::defaultThreadCount();
+    
+    workerCpus = planCpus(pinning, workers);
+    if (burstMode == BurstMode::Burn) {
+        BurnKernel::instance();
+    }
+    
+    startTime = std::chrono::steady_clock::now();
+    beginLiveRun(0);
+    std::vector<std::thread> consumers;
+    consumers.reserve(workers);
+    for (unsigned int i = 0; i < workers; i++) {
+        int cpu = workerCpus.empty() ? -1 : workerCpus[i];
+        consumers.emplace_back([this, &queue, cpu] {
+            if (cpu >= 0) {
+                pinCurrentThread(cpu);
+            }
+            streamWorker(this, &queue);
+        });
+    }
+    
+    // Chunk buffer: a partial line is moved to the front before the next read
+    std::vector<char> buffer(STREAM_CHUNK_SIZE);
+    std::size_t carried = 0;
+    int lineNumber = 0;
+    bool firstChunk = true;
+    bool ok = true;
+    bool atEnd = false;
+    
+    while (ok && !atEnd) {
+        // Grow the buffer if a single line fills it
+        if (carried == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        long count = input.read(buffer.data() + carried, buffer.size() - carried);
+        if (count < 0) {
+            std::cerr << "Error: Failed reading " << name << std::endl;
+            ok = false;
+            break;
+        }
+        atEnd = (count == 0);
+        std::size_t filled = carried + static_cast<std::size_t>(count);
+        
+        if (firstChunk && filled >= sizeof(TRACE_MAGIC)) {
+            firstChunk = false;
+            if (isBinaryTrace(buffer.data(), filled)) {
+                std::cerr << "Error: " << name << " is a binary trace; streaming reads text traces only "
+                          << "(convert it with trace_convert first)" << std::endl;
+                ok = false;
+                break;
+            }
+        }
+        
+        // Hand out every complete line (and the unterminated last line at the end)
+        const char* cursor = buffer.data();
+        const char* end = cursor + filled;
+        while (ok && cursor != end) {
+            const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor)));
+            if (newline == nullptr && !atEnd) {
+                break;
+            }
+            const char* lineEnd = (newline == nullptr) ? end : newline;
+            lineNumber++;
+            
+            // Skip empty lines
+            if (lineEnd != cursor) {
+                Process proc;
+                if (!parseProcessLine(cursor, lineEnd, lineNumber, name, proc)) {
+                    ok = false;
+                    break;
+                }
+                if (timeScale > 0.0 && proc.arrivalTime > 0) {
+                    std::this_thread::sleep_until(startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<double>(proc.arrivalTime * timeScale)));
+                }
+                liveCount(liveQueued);
+                queue.push(proc);
+            }
+            
+            cursor = (newline == nullptr) ? end : newline + 1;
+        }
+        
+        carried = static_cast<std::size_t>(end - cursor);
+        if (carried > 0 && cursor != buffer.data()) {
+            std::memmove(buffer.data(), cursor, carried);
+        }
+    }
+    input.close();
+    
+    // No more records: let the workers drain the queue and exit
+    queue.close();
+    for (std::thread& consumer : consumers) {
+        consumer.join();
+    }
+    endLiveRun();
+    
+    streamStats.queueCapacity = queue.capacity();
+    streamStats.maxQueueDepth = queue.getMaxDepth();
+    streamStats.workers = workers;
+    streamStats.elapsed = elapsedSeconds();
+    
+    summary.processes = streamStats.processes;
+    summary.workers = workers;
+    summary.makespan = streamStats.elapsed;
+    summary.busyTime = streamStats.totalBusy;
+    summary.cpuTime = streamStats.totalCpu;
+    summary.throughput = (summary.makespan > 0.0) ? summary.processes / summary.makespan : 0.0;
+    summary.utilization = (summary.makespan > 0.0) ? summary.busyTime / (workers * summary.makespan) : 0.0;
+    
+    // Make sure all process output is on the console before returning
+    Logger::instance().flush();
+    
+    if (!metricsPath.empty()) {
+        writeMetrics(metricsPath, metricsFormat);
+    }
+    
+    if (ok && streamStats.processes == 0) {
+        std::cerr << "Warning: No valid processes found in " << name << std::endl;
+    }
+    return ok;
+}
+
+/**
+ * @brief Get throughput and utilization of the last run
+ * 
+ * @return Aggregate results of executeProcesses() or streamProcesses()
+ */
+const RunSummary& ProcessSimulator::getRunSummary() const {
+    return summary;
+}
+
+/**
+ * @brief Write metrics to a file at the end of every run
+ * 
+ * @param path Output file ("" disables the export)
+ * @param format CSV or JSON lines
+ */
+void ProcessSimulator::setMetricsPath(const std::string& path, MetricsFormat format) {
+    metricsPath = path;
+    metricsFormat = format;
+}
+
+/**
+ * @brief Write a Chrome trace-event timeline at the end of every executeProcesses() run
+ * 
+ * @param path Output file ("" disables tracing)
+ */
+void ProcessSimulator::setTracePath(const std::string& path) {
+    tracePath = path;
+}
+
+/**
+ * @brief Publish the progress of every run to a live metrics exporter
+ * 
+ * @param metrics Exporter (null disables the counters)
+ */
+void ProcessSimulator::setLiveMetrics(LiveMetrics* metrics) {
+    liveMetrics = metrics;
+}
+
+/**
+ * @brief Reset the live counters and register the "process" source
+ * 
+ * @param total Processes in the run (0 if unknown)
+ */
+void ProcessSimulator::beginLiveRun(std::uint64_t total) {
+    if (!liveMetrics) {
+        return;
+    }
+    liveTotal.store(total, std::memory_order_relaxed);
+    liveQueued.store(0, std::memory_order_relaxed);
+    liveDispatched.store(0, std::memory_order_relaxed);
+    liveCompleted.store(0, std::memory_order_relaxed);
+    liveClock.store(0, std::memory_order_relaxed);
+    liveRunning.store(true, std::memory_order_relaxed);
+    liveMetrics->addCollector("process", [this](MetricsWriter& out) { collectLiveMetrics(out); });
+}
+
+/**
+ * @brief Unregister the "process" source; the exporter keeps its final counts
+ */
+void ProcessSimulator::endLiveRun() {
+    if (!liveMetrics) {
+        return;
+    }
+    liveRunning.store(false, std::memory_order_relaxed);
+    liveMetrics->removeCollector("process");
+}
+
+/**
+ * @brief Write the live counters (exporter thread)
+ * 
+ * The runnable depth is queued - dispatched: processes handed to the pool
+ * (or the scheduler, or the stream queue) that no worker or CPU has taken
+ * yet. The counters are read one at a time, so the difference is clamped
+ * at 0.
+ * 
+ * @param out Metrics writer
+ */
+void ProcessSimulator::collectLiveMetrics(MetricsWriter& out) const {
+    std::uint64_t completed = liveCompleted.load(std::memory_order_relaxed);
+    std::uint64_t dispatched = liveDispatched.load(std::memory_order_relaxed);
+    std::uint64_t queued = liveQueued.load(std::memory_order_relaxed);
+    
+    out.family("sim_process_running", "gauge", "1 while a process simulation run is in progress");
+    out.sample("sim_process_running", liveRunning.load(std::memory_order_relaxed) ? 1.0 : 0.0);
+    out.family("sim_process_total", "gauge", "Processes in the run (0 when streaming)");
+    out.sample("sim_process_total", static_cast<double>(liveTotal.load(std::memory_order_relaxed)));
+    out.family("sim_process_queued_total", "counter", "Processes made runnable (arrivals and requeues)");
+    out.sample("sim_process_queued_total", static_cast<double>(queued));
+    out.family("sim_process_dispatched_total", "counter", "Processes given a worker or simulated CPU");
+    out.sample("sim_process_dispatched_total", static_cast<double>(dispatched));
+    out.family("sim_process_completed_total", "counter", "Processes finished");
+    out.sample("sim_process_completed_total", static_cast<double>(completed));
+    out.family("sim_process_runnable", "gauge", "Runnable processes waiting for a worker or CPU");
+    out.sample("sim_process_runnable", (queued > dispatched) ? static_cast<double>(queued - dispatched) : 0.0);
+    if (mode == ExecutionMode::VirtualTime) {
+        out.family("sim_process_virtual_time_seconds", "gauge", "Simulated clock of the virtual-time engine");
+        out.sample("sim_process_virtual_time_seconds",
+                   static_cast<double>(liveClock.load(std::memory_order_relaxed)));
+    }
+}
+
+/**
+ * @brief Set the checkpoint file and the periodic checkpoint interval
+ * @param path Checkpoint file ("" = none)
+ * @param interval Time between periodic checkpoints (0 = only when interrupted)
+ */
+void ProcessSimulator::setCheckpoint(const std::string& path, std::chrono::nanoseconds interval) {
+    checkpointPath = path;
+    checkpointInterval = (interval.count() > 0) ? interval : std::chrono::nanoseconds(0);
+}
+
+/**
+ * @brief Check a process checkpoint against the loaded trace and keep it for the next run
+ * @param checkpoint State read by readCheckpoint()
+ * @return false if the checkpoint belongs to another trace
+ */
+bool ProcessSimulator::setResumePoint(const ProcessCheckpoint& checkpoint) {
+    if (checkpoint.processCount != processes.size() || checkpoint.traceFingerprint != traceFingerprint(processes)) {
+        std::cerr << "Error: The checkpoint was taken from a different trace (" << checkpoint.processCount
+                  << " processes, " << processes.size() << " loaded)" << std::endl;
+        return false;
+    }
+    mode = ExecutionMode::VirtualTime;
+    policy = checkpoint.policy;
+    readyQueue = checkpoint.readyQueue;
+    timeQuantum = checkpoint.quantum;
+    workerCount = static_cast<unsigned int>(checkpoint.cpus.size());
+    resumeState.reset(new ProcessCheckpoint(checkpoint));
+    return true;
+}
+
+bool ProcessSimulator::wasInterrupted() const {
+    return interrupted;
+}
+
+/**
+ * @brief Bind the worker threads of RealTime and streamed runs to CPUs
+ * 
+ * @param cpuPinning Placement policy
+ */
+void ProcessSimulator::setPinning(const CpuPinning& cpuPinning) {
+    pinning = cpuPinning;
+}
+
+/**
+ * @brief Choose how RealTime and streamed workers spend a burst
+ * 
+ * @param mode BurstMode::Sleep (default) or BurstMode::Burn
+ */
+void ProcessSimulator::setBurstMode(BurstMode mode) {
+    burstMode = mode;
+}
+
+/**
+ * @brief Get how RealTime workers spend a burst
+ * 
+ * @return The configured BurstMode
+ */
+BurstMode ProcessSimulator::getBurstMode() const {
+    return burstMode;
+}
+
+/**
+ * @brief Write per-process records and the run summary of the last run
+ * 
+ * CSV: a header line, one row per process and a final "# summary" comment
+ * line (skipped by CSV readers that honour '#' comments).
+ * JSON lines: one {"type":"process",...} object per process followed by one
+ * {"type":"summary",...} object.
+ * 
+ * @param path Output file (truncated)
+ * @param format CSV or JSON lines
+ * @return true on success, false on I/O error
+ */
+bool ProcessSimulator::writeMetrics(const std::string& path, MetricsFormat format) const {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot create metrics file " << path << std::endl;
+        return false;
+    }
+    
+    const char* modeName = (mode == ExecutionMode::RealTime) ? "real"
+                           : (mode == ExecutionMode::Coroutine) ? "coroutine" : "virtual";
+    file << std::fixed << std::setprecision(9);
+    
+    if (format == MetricsFormat::JsonLines) {
+        for (const auto& record : stats) {
+            file << "{\"type\":\"process\",\"pid\":" << record.pid
+                 << ",\"arrival\":" << record.arrivalTime
+                 << ",\"queued\":" << record.queuedTime
+                 << ",\"start\":" << record.startTime
+                 << ",\"finish\":" << record.finishTime
+                 << ",\"burst\":" << record.burstTime
+                 << ",\"schedulingLatency\":" << record.schedulingLatency
+                 << ",\"overrun\":" << record.overrun
+                 << ",\"cpu\":" << record.cpuTime
+                 << ",\"waiting\":" << record.waitingTime
+                 << ",\"turnaround\":" << record.turnaroundTime
+                 << ",\"response\":" << record.responseTime << "}\n";
+        }
+        file << "{\"type\":\"summary\",\"mode\":\"" << modeName << "\""
+             << ",\"streamed\":" << (streamed ? "true" : "false")
+             << ",\"processes\":" << summary.processes
+             << ",\"workers\":" << summary.workers
+             << ",\"makespan\":" << summary.makespan
+             << ",\"busy\":" << summary.busyTime
+             << ",\"cpu\":" << summary.cpuTime
+             << ",\"burstMode\":\"" << burstModeName(burstMode) << "\""
+             << ",\"throughput\":" << summary.throughput
+             << ",\"utilization\":" << summary.utilization << "}\n";
+    } else {
+        file << "pid,arrival,queued,start,finish,burst,scheduling_latency,overrun,cpu,waiting,turnaround,response\n";
+        for (const auto& record : stats) {
+            file << record.pid << ',' << record.arrivalTime << ',' << record.queuedTime << ','
+                 << record.startTime << ',' << record.finishTime << ',' << record.burstTime << ','
+                 << record.schedulingLatency << ',' << record.overrun << ',' << record.cpuTime << ','
+                 << record.waitingTime << ','
+                 << record.turnaroundTime << ',' << record.responseTime << '\n';
+        }
+        file << "# summary mode=" << modeName << " streamed=" << (streamed ? 1 : 0)
+             << " processes=" << summary.processes << " workers=" << summary.workers
+             << " makespan=" << summary.makespan << " busy=" << summary.busyTime
+             << " cpu=" << summary.cpuTime << " burst_mode=" << burstModeName(burstMode)
+             << " throughput=" << summary.throughput << " utilization=" << summary.utilization << '\n';
+    }
+    
+    if (!file) {
+        std::cerr << "Error: Failed to write metrics file " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Get the aggregate results of the last streamProcesses() run
+ * 
+ * @return Counts, summed times and queue usage
+ */
+const StreamStats& ProcessSimulator::getStreamStats() const {
+    return streamStats;
+}
+
+/**
+ * @brief Get the loaded processes
+ * 
+ * @return Processes in file order
+ */
+const std::vector<Process>& ProcessSimulator::getProcesses() const {
+    return processes;
+}
+
+/**
+ * @brief Replace the loaded processes with an in-memory workload
+ * 
+ * @param newProcesses Processes to execute
+ */
+void ProcessSimulator::setProcesses(const std::vector<Process>& newProcesses) {
+    processes = newProcesses;
+    stats.clear();
+}
+
+/**
+ * @brief Get per-process timing results of the last executeProcesses() run
+ * 
+ * @return Statistics in the same order as the loaded processes
+ */
+const std::vector<ProcessStats>& ProcessSimulator::getProcessStats() const {
+    return stats;
+}
+
+/**
+ * @brief Print a per-pid table of waiting, turnaround and response times
+ * 
+ * The table is followed by the averages over all processes.
+ * 
+ * After streamProcesses() only a summary of the StreamStats is printed.
+ * 
+ * @param out Output stream (e.g., std::cout)
+ */
+void ProcessSimulator::printStatistics(std::ostream& out) const {
+    // Streamed runs keep no per-pid records, only the totals
+    if (streamed) {
+        double count = (streamStats.processes > 0) ? static_cast<double>(streamStats.processes) : 1.0;
+        out << std::fixed << std::setprecision(3);
+        out << "  Streamed " << streamStats.processes << " processes on " << streamStats.workers
+            << " workers in " << streamStats.elapsed << "s" << std::endl;
+        out << "  avg waiting " << streamStats.totalWaiting / count
+            << ", avg turnaround " << streamStats.totalTurnaround / count
+            << ", avg response " << streamStats.totalResponse / count << std::endl;
+        out << "  Ingestion queue: capacity " << streamStats.queueCapacity
+            << ", max depth " << streamStats.maxQueueDepth << std::endl;
+        out << "  Throughput: " << summary.throughput << " processes/s, utilization "
+            << summary.utilization * 100.0 << "%" << std::endl;
+        printBurstTimes(out);
+        out << "  Topology: " << CpuTopology::instance().describe() << ", pinning "
+            << describeCpuPinning(pinning);
+        if (!workerCpus.empty()) {
+            out << " (CPUs " << formatCpuList(workerCpus) << ")";
+        }
+        out << std::endl;
+        out.unsetf(std::ios::floatfield);
+        out << std::setprecision(6);
+        return;
+    }
+    
+    out << "  " << std::setw(5) << "PID" << std::setw(9) << "Arrival"
+        << std::setw(9) << "Start" << std::setw(9) << "Finish"
+        << std::setw(9) << "Waiting" << std::setw(12) << "Turnaround"
+        << std::setw(10) << "Response" << std::endl;
+    
+    double totalWaiting = 0.0;
+    double totalTurnaround = 0.0;
+    double totalResponse = 0.0;
+    
+    out << std::fixed << std::setprecision(3);
+    for (const auto& record : stats) {
+        out << "  " << std::setw(5) << record.pid << std::setw(9) << record.arrivalTime
+            << std::setw(9) << record.startTime << std::setw(9) << record.finishTime
+            << std::setw(9) << record.waitingTime << std::setw(12) << record.turnaroundTime
+            << std::setw(10) << record.responseTime << std::endl;
+        totalWaiting += record.waitingTime;
+        totalTurnaround += record.turnaroundTime;
+        totalResponse += record.responseTime;
+    }
+    
+    if (!stats.empty()) {
+        double count = static_cast<double>(stats.size());
+        out << "  " << std::setw(5) << "avg" << std::setw(27) << ""
+            << std::setw(9) << totalWaiting / count << std::setw(12) << totalTurnaround / count
+            << std::setw(10) << totalResponse / count << std::endl;
+    }
+    
+    if (!stats.empty()) {
+        out << "  Throughput: " << summary.throughput << " processes/s over " << summary.makespan
+            << "s on " << summary.workers << " workers, utilization " << summary.utilization * 100.0 << "%" << std::endl;
+    }
+    
+    if (mode == ExecutionMode::RealTime && executorWorkers > 0) {
+        out << "  Executor: " << executorTypeName(executorType) << " (" << executorWorkers << " workers), "
+            << executorStats.tasksExecuted << " tasks, " << executorStats.steals << " steals ("
+            << executorStats.tasksStolen << " tasks moved, " << executorStats.failedSteals
+            << " failed), max queue depth " << executorStats.maxQueueDepth << std::endl;
+        printBurstTimes(out);
+        out << "  Topology: " << CpuTopology::instance().describe() << ", pinning "
+            << describeCpuPinning(pinning);
+        if (!workerCpus.empty()) {
+            out << " (CPUs " << formatCpuList(workerCpus) << ")";
+        }
+        out << std::endl;
+    }
+    if (mode == ExecutionMode::Coroutine && executorWorkers > 0) {
+        out << "  Coroutines: " << stats.size() << " processes on " << executorWorkers << " threads, "
+            << std::setprecision(0) << (stats.empty() ? 0.0 : static_cast<double>(frameBytes) / stats.size())
+            << " B coroutine frame per process" << std::setprecision(3) << std::endl;
+        printBurstTimes(out);
+        out << "  Topology: " << CpuTopology::instance().describe() << ", pinning "
+            << describeCpuPinning(pinning);
+        if (!workerCpus.empty()) {
+            out << " (CPUs " << formatCpuList(workerCpus) << ")";
+        }
+        out << std::endl;
+    }
+    out.unsetf(std::ios::floatfield);
+    out << std::setprecision(6);
+}
+
+/**
+ * @brief Print the burst mode and CPU time against run spans of the last run
+ * 
+ * Coroutine runs compare against the time workers spent resuming coroutines.
+ * 
+ * With more burning workers than cores, the CPU share falls below 100% by
+ * the time bursts spent runnable but descheduled.
+ * 
+ * @param out Output stream (fixed format already set)
+ */
+void ProcessSimulator::printBurstTimes(std::ostream& out) const {
+    out << "  Bursts: " << burstModeName(burstMode);
+    if (burstMode == BurstMode::Burn) {
+        out << " (" << BurnKernel::instance().getIterationsPerSecond() / 1e6 << "M iterations/s)";
+    }
+    out << ", CPU time " << summary.cpuTime << "s over " << summary.busyTime
+        << ((mode == ExecutionMode::Coroutine) ? "s of worker time" : "s of run spans");
+    if (summary.busyTime > 0.0 && threadCpuClockAvailable()) {
+        out << " (" << summary.cpuTime / summary.busyTime * 100.0 << "% on CPU)";
+    }
+    out << std::endl;
+}
+
+bool parseMetricsFormat(const std::string& name, MetricsFormat& format) {
+    if (name == "csv") {
+        format = MetricsFormat::Csv;
+    } else if (name == "jsonl" || name == "json") {
+        format = MetricsFormat::JsonLines;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* metricsFormatName(MetricsFormat format) {
+    switch (format) {
+        case MetricsFormat::JsonLines: return "JSON lines";
+        case MetricsFormat::Csv:
+        default:                       return "CSV";
+    }
+}
+
+bool parseBurstMode(const std::string& name, BurstMode& mode) {
+    if (name == "sleep") {
+        mode = BurstMode::Sleep;
+    } else if (name == "burn") {
+        mode = BurstMode::Burn;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* burstModeName(BurstMode mode) {
+    switch (mode) {
+        case BurstMode::Burn:  return "burn";
+        case BurstMode::Sleep:
+        default:               return "sleep";
     }
 }
@@ -3,12 +3,52 @@
  * @brief Header file for the ProcessSimulator class
  * 
  * This file defines the ProcessSimulator class which manages concurrent process
- * execution simulation using C++ threads. Each process is represented as a thread
- * that simulates CPU burst time using sleep operations.
+ * execution simulation using C++ threads. Processes are executed by a fixed-size
+ * worker pool; each worker simulates the CPU burst time of one process at a time
+ * using sleep operations.
+ * 
+ * Alternatively, in VirtualTime mode the same workload is replayed by a
+ * discrete-event simulation: a simulated clock advances from event to event
+ * (process start/finish) without sleeping, so a trace with hours of total burst
+ * time completes as fast as the events can be processed. The virtual-time engine
+ * runs a pluggable CPU scheduling policy (FCFS, SJF, SRTF, Round-Robin or
+ * Priority) over workerCount simulated CPUs.
+ * 
+ * After a run, waiting, turnaround and response times are available per pid,
+ * together with the scheduling latency and burst overrun of each process and
+ * the run's throughput and utilization (RunSummary). writeMetrics() exports
+ * them as CSV or JSON lines for dashboards. setTracePath() additionally
+ * writes a Chrome trace-event timeline with one track per process.
+ * 
+ * Streaming ingestion (streamProcesses()) runs a trace of any length from a
+ * file or stdin in RealTime mode: the calling thread parses records into a
+ * BoundedQueue while worker threads execute them, so execution overlaps with
+ * I/O and memory is capped by the queue capacity. Only aggregate statistics
+ * (StreamStats) are kept for streamed runs.
+ * 
+ * setBurstMode(BurstMode::Burn) runs every RealTime burst on a real core with
+ * a calibrated busy-work kernel (see CpuBurn.h) instead of sleeping, and every
+ * run records the thread CPU time of each burst, so oversubscribing the cores
+ * (more workers than CPUs) shows up as run spans longer than their CPU time.
+ * 
+ * setPinning() binds the worker threads of RealTime and streamed runs to
+ * CPUs (compact, scatter or an explicit list, see CpuTopology.h); the CPU
+ * topology and the CPUs used are reported by printStatistics().
+ * 
+ * setLiveMetrics() publishes the progress of a run (processes queued,
+ * dispatched and completed, the runnable queue depth and the virtual clock)
+ * to a LiveMetrics exporter while the run is in progress. Workers update the
+ * counters with relaxed atomics, and only when an exporter is attached.
+ * 
+ * setCheckpoint() lets a VirtualTime run be interrupted and continued later:
+ * on SIGINT / SIGTERM (see Checkpoint.h), and optionally every interval of
+ * wall-clock time, the engine saves its state between two events to a
+ * checkpoint file. setResumePoint() makes the next run start from such a
+ * file instead of time 0, with the same results as an uninterrupted run.
  * 
  * Thread Safety:
- * - All console output is protected by coutMutex to prevent interleaved messages
- * - Uses RAII pattern (std::lock_guard) for automatic mutex unlocking
+ * - All console output goes through the shared asynchronous Logger, so workers
+ *   never block on console I/O and messages are never interleaved
  * 
  * @author Thread Simulation System
  * @date 2024
@@ -18,17 +58,145 @@
 #define PROCESS_SIMULATOR_H
 
 #include <vector>
-#include <mutex>
 #include <string>
 #include <chrono>
+#include <iosfwd>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include "Scheduler.h"
+#include "Executor.h"
+#include "CpuTopology.h"
+
+class LiveMetrics;
+class MetricsWriter;
+struct ProcessCheckpoint;
 
 /**
  * @struct Process
- * @brief Represents a process with an ID and CPU burst time
+ * @brief Represents a process with an ID, CPU burst time, arrival time and priority
  */
 struct Process {
-    int pid;        ///< Process ID (must be positive)
-    int burstTime;  ///< CPU burst time in seconds (must be positive)
+    int pid;          ///< Process ID (must be positive)
+    int burstTime;    ///< CPU burst time in seconds (must be positive)
+    int arrivalTime;  ///< Time the process becomes ready, in seconds (default 0)
+    int priority;     ///< Scheduling priority, lower value runs first (default 0)
+};
+
+/**
+ * @struct ProcessStats
+ * @brief Per-process timing results of a run (all values in seconds)
+ */
+struct ProcessStats {
+    int pid;                  ///< Process ID
+    double arrivalTime;       ///< Time the process became ready
+    double startTime;         ///< Time the process first got a CPU
+    double finishTime;        ///< Time the process completed its burst
+    double waitingTime;       ///< Time spent ready but not running (turnaround - burst)
+    double turnaroundTime;    ///< Finish time minus arrival time
+    double responseTime;      ///< First start time minus arrival time
+    double queuedTime;        ///< Time the process was handed to the worker pool (arrival in virtual time)
+    double burstTime;         ///< Nominal burst time (burstTime x time scale)
+    double schedulingLatency; ///< Start time minus queued time (wait for a free worker)
+    double overrun;           ///< Actual run span (finish - start) minus the nominal burst
+    double cpuTime;           ///< Thread CPU time consumed by the burst (RealTime; nominal burst in virtual time)
+};
+
+/**
+ * @struct RunSummary
+ * @brief Aggregate results of the last run (times in seconds)
+ */
+struct RunSummary {
+    std::uint64_t processes;  ///< Processes completed
+    unsigned int workers;     ///< Workers (RealTime) or simulated CPUs (VirtualTime)
+    double makespan;          ///< Time from the start of the run to the last finish
+    double busyTime;          ///< Summed run spans (RealTime), bursts (VirtualTime) or worker time in coroutines
+    double throughput;        ///< Processes completed per second of makespan
+    double utilization;       ///< busyTime / (workers x makespan), 0..1
+    double cpuTime;           ///< Summed thread CPU time of all bursts
+};
+
+/**
+ * @enum MetricsFormat
+ * @brief File formats of writeMetrics()
+ */
+enum class MetricsFormat {
+    Csv,        ///< Header line, one row per process, "# summary" trailer
+    JsonLines   ///< One JSON object per process, then one summary object
+};
+
+/**
+ * @brief Parse a metrics format name ("csv" or "jsonl")
+ * @param name Format name
+ * @param format Receives the parsed format
+ * @return true if the name is recognised
+ */
+bool parseMetricsFormat(const std::string& name, MetricsFormat& format);
+
+/**
+ * @brief Get the display name of a metrics format
+ * @param format Metrics format
+ * @return Human-readable name
+ */
+const char* metricsFormatName(MetricsFormat format);
+
+/**
+ * @enum BurstMode
+ * @brief How a RealTime worker spends a process's CPU burst
+ */
+enum class BurstMode {
+    Sleep,  ///< sleep_for the burst (no CPU used, cores never contended)
+    Burn    ///< Run the calibrated BurnKernel for the burst
+};
+
+/**
+ * @brief Parse a burst mode name ("sleep" or "burn")
+ * @param name Mode name
+ * @param mode Receives the parsed mode
+ * @return true if the name is recognised
+ */
+bool parseBurstMode(const std::string& name, BurstMode& mode);
+
+/**
+ * @brief Get the display name of a burst mode
+ * @param mode Burst mode
+ * @return Human-readable name
+ */
+const char* burstModeName(BurstMode mode);
+
+/**
+ * @struct StreamStats
+ * @brief Aggregate results of a streamProcesses() run (times in scaled seconds)
+ */
+struct StreamStats {
+    std::uint64_t processes;     ///< Records executed
+    double totalWaiting;         ///< Sum of waiting times
+    double totalTurnaround;      ///< Sum of turnaround times
+    double totalResponse;        ///< Sum of response times
+    double totalBusy;            ///< Sum of run spans (finish - start)
+    double totalCpu;             ///< Sum of thread CPU time of the bursts
+    std::size_t queueCapacity;   ///< Capacity of the ingestion queue
+    std::size_t maxQueueDepth;   ///< Deepest the ingestion queue has been
+    unsigned int workers;        ///< Consumer threads
+    double elapsed;              ///< Wall-clock seconds from first read to last finish
+};
+
+template <typename T> class BoundedQueue;
+enum class LogLevel;
+class TimelineTrace;
+class CoTask;
+class CoScheduler;
+
+/**
+ * @enum ExecutionMode
+ * @brief Selects how executeProcesses() advances time
+ */
+enum class ExecutionMode {
+    RealTime,    ///< Worker threads sleep for each burst (wall-clock time)
+    VirtualTime, ///< Discrete-event simulation on a simulated clock (no sleeping)
+    Coroutine    ///< One coroutine per process on a CoScheduler (wall-clock time, no thread per sleep)
 };
 
 /**
@@ -40,10 +208,49 @@ struct Process {
  * to simulate CPU usage.
  */
 class ProcessSimulator {
+public:
+    static const std::size_t DEFAULT_STREAM_CAPACITY = 1024;  ///< Ingestion queue size used by default
+    static const unsigned int CHECKPOINT_POLL_EVENTS = 4096;  ///< Events between two clock reads for periodic checkpoints
+
 private:
     std::vector<Process> processes;  ///< Vector storing all loaded processes
-    std::mutex coutMutex;            ///< Mutex for thread-safe console output (CRITICAL SECTION)
     std::chrono::steady_clock::time_point startTime;  ///< Start time for timestamp calculation
+    unsigned int workerCount;        ///< Number of pool workers (0 = hardware concurrency)
+    ExecutionMode mode;              ///< Real-time threads or virtual-time event simulation
+    long long virtualNow;            ///< Simulated clock in seconds (VirtualTime mode only)
+    SchedulingPolicy policy;         ///< CPU scheduling policy (VirtualTime mode)
+    ReadyQueueType readyQueue;       ///< Ready queue of the keyed policies (VirtualTime mode)
+    int timeQuantum;                 ///< Round-Robin time quantum in seconds
+    double timeScale;                ///< Wall-clock seconds per trace time unit (RealTime mode)
+    bool loggingEnabled;             ///< false suppresses all per-process log messages
+    ExecutorType executorType;       ///< Worker pool used in RealTime mode
+    ExecutorStats executorStats;     ///< Pool counters of the last RealTime run
+    unsigned int executorWorkers;    ///< Worker count of the last RealTime or Coroutine run
+    std::uint64_t frameBytes;        ///< Coroutine frame bytes allocated by the last Coroutine run
+    double coroutineBusy;            ///< Seconds the workers spent resuming coroutines in the last Coroutine run
+    std::vector<ProcessStats> stats; ///< Per-process results of the last run (same order as processes)
+    bool streamed;                   ///< true if the last run was streamProcesses()
+    StreamStats streamStats;         ///< Aggregate results of the last streamed run
+    std::mutex streamMutex;          ///< Guards streamStats while stream workers merge their totals
+    RunSummary summary;              ///< Throughput and utilization of the last run
+    std::string metricsPath;         ///< Metrics destination written after every run ("" = none)
+    MetricsFormat metricsFormat;     ///< Format of metricsPath
+    std::string tracePath;           ///< Chrome trace destination written after every run ("" = none)
+    std::unique_ptr<TimelineTrace> timeline;  ///< Timeline of the current run (null when not tracing)
+    CpuPinning pinning;              ///< CPU placement of worker threads
+    BurstMode burstMode;             ///< Sleep or burn the CPU for each RealTime burst
+    std::vector<int> workerCpus;     ///< CPU of each worker in the last run (empty = unpinned)
+    LiveMetrics* liveMetrics;        ///< Exporter of the progress counters (null = none)
+    std::atomic<bool> liveRunning;   ///< Live: a run is in progress
+    std::atomic<std::uint64_t> liveTotal;                   ///< Live: processes in the run (0 = streamed, unknown)
+    alignas(64) std::atomic<std::uint64_t> liveQueued;      ///< Live: processes made runnable (arrivals and requeues)
+    alignas(64) std::atomic<std::uint64_t> liveDispatched;  ///< Live: processes given a worker or CPU
+    std::atomic<std::uint64_t> liveCompleted;               ///< Live: processes finished
+    std::atomic<long long> liveClock;                       ///< Live: simulated clock (VirtualTime mode)
+    std::string checkpointPath;      ///< VirtualTime checkpoint destination ("" = none)
+    std::chrono::nanoseconds checkpointInterval;  ///< Wall-clock time between periodic checkpoints (0 = only when interrupted)
+    std::unique_ptr<ProcessCheckpoint> resumeState;  ///< State the next VirtualTime run starts from (null = time 0)
+    bool interrupted;                ///< true if the last run stopped at a checkpoint
 
 public:
     /**
@@ -60,7 +267,13 @@ public:
      * @brief Load processes from a text file
      * 
      * Reads process data from the specified file. Each line should contain
-     * a process ID followed by burst time (space-separated).
+     * a process ID followed by burst time (space-separated), optionally
+     * followed by an arrival time and a priority.
+     * 
+     * The file is memory-mapped and scanned in place, so loading cost is
+     * dominated by the integer parsing rather than by stream machinery.
+     * Binary traces (see TraceFile.h) are recognised by their magic and
+     * decoded directly from the mapping.
      * 
      * @param filename Path to the input file (e.g., "processes.txt")
      * @return true if file loaded successfully, false otherwise
@@ -68,18 +281,321 @@ public:
     bool loadProcesses(const std::string& filename);
     
     /**
-     * @brief Execute all loaded processes as concurrent threads
+     * @brief Set the number of worker threads used by executeProcesses()
+     * 
+     * @param count Worker count (0 selects std::thread::hardware_concurrency())
+     */
+    void setWorkerCount(unsigned int count);
+    
+    /**
+     * @brief Get the configured number of worker threads
+     * 
+     * @return Worker count (0 means hardware concurrency)
+     */
+    unsigned int getWorkerCount() const;
+    
+    /**
+     * @brief Select real-time, virtual-time or coroutine execution
+     * 
+     * @param newMode ExecutionMode::RealTime (default), ExecutionMode::VirtualTime
+     *                or ExecutionMode::Coroutine
+     */
+    void setExecutionMode(ExecutionMode newMode);
+    
+    /**
+     * @brief Get the current execution mode
      * 
-     * Creates one thread per process and waits for all threads to complete.
-     * Each thread simulates CPU burst time using sleep.
+     * @return The configured ExecutionMode
+     */
+    ExecutionMode getExecutionMode() const;
+    
+    /**
+     * @brief Select the CPU scheduling policy used in VirtualTime mode
+     * 
+     * @param newPolicy Scheduling policy (default FCFS)
+     */
+    void setSchedulingPolicy(SchedulingPolicy newPolicy);
+    
+    /**
+     * @brief Get the configured scheduling policy
+     * 
+     * @return The configured SchedulingPolicy
+     */
+    SchedulingPolicy getSchedulingPolicy() const;
+    
+    /**
+     * @brief Select the ready queue of SJF, SRTF and Priority in VirtualTime mode
+     * 
+     * All types schedule identically; they differ only in speed.
+     * 
+     * @param type Ready queue implementation (default Scan)
+     */
+    void setReadyQueue(ReadyQueueType type);
+    
+    /**
+     * @brief Get the configured ready queue type
+     * 
+     * @return The configured ReadyQueueType
+     */
+    ReadyQueueType getReadyQueue() const;
+    
+    /**
+     * @brief Set the Round-Robin time quantum
+     * 
+     * @param quantum Time slice in seconds (must be positive, default 2)
+     */
+    void setTimeQuantum(int quantum);
+    
+    /**
+     * @brief Set how long one trace time unit lasts in RealTime mode
+     * 
+     * Burst and arrival times in the trace are multiplied by this factor before
+     * sleeping, and statistics are then reported in wall-clock seconds. 0 turns
+     * every sleep off, which measures the pure scheduling/synchronization cost.
+     * VirtualTime mode always counts in trace units.
+     * 
+     * @param secondsPerUnit Wall-clock seconds per unit (default 1.0, must not be negative)
+     */
+    void setTimeScale(double secondsPerUnit);
+    
+    /**
+     * @brief Turn the per-process log messages on or off
+     * 
+     * @param enabled false suppresses every message (e.g., for benchmarking)
+     */
+    void setLoggingEnabled(bool enabled);
+    
+    /**
+     * @brief Select the worker pool used in RealTime mode
+     * 
+     * GlobalQueue dispatches strictly FCFS from one shared queue; WorkStealing
+     * gives each worker its own run queue and lets idle workers steal, which
+     * scales better with many very short bursts but has no global order.
+     * 
+     * @param type ExecutorType::GlobalQueue (default) or ExecutorType::WorkStealing
+     */
+    void setExecutorType(ExecutorType type);
+    
+    /**
+     * @brief Get the configured worker pool type
+     * 
+     * @return The configured ExecutorType
+     */
+    ExecutorType getExecutorType() const;
+    
+    /**
+     * @brief Get the worker pool counters of the last RealTime run
+     * 
+     * @return Tasks executed, steals and maximum queue depth (all 0 before a RealTime run)
+     */
+    const ExecutorStats& getExecutorStats() const;
+    
+    /**
+     * @brief Execute all loaded processes
+     * 
+     * RealTime: releases each process at its arrival time onto an Executor
+     * (ThreadPool or WorkStealingPool, see setExecutorType()) and waits for all
+     * of them to complete. Each worker simulates CPU burst time using sleep;
+     * dispatch order is FCFS with the global-queue pool.
+     * 
+     * VirtualTime: simulates workerCount CPUs under the configured scheduling
+     * policy as a discrete-event simulation on a simulated clock.
+     * 
+     * Coroutine: each process is a coroutine that sleeps on a CoScheduler
+     * timer until its arrival and then spends its burst - co_awaiting a timer
+     * in BurstMode::Sleep (no worker is held, so every arrived process runs at
+     * once) or burning inline in BurstMode::Burn (at most workerCount at once).
      */
     void executeProcesses();
     
+    /**
+     * @brief Execute a trace while it is being read (RealTime mode only)
+     * 
+     * The calling thread reads text records from source, validates them like
+     * loadProcesses(), releases each at its arrival time and pushes it onto a
+     * BoundedQueue; workerCount threads pop and execute them concurrently.
+     * A full queue blocks the reader, so at most queueCapacity records are
+     * held in memory. Records should be ordered by arrival time; a late record
+     * is released as soon as it is read.
+     * 
+     * Binary traces are column-wise and cannot be streamed; convert them to
+     * text first. Already-queued records still run after a parse error.
+     * 
+     * @param source Path of the trace, or "-" for stdin
+     * @param queueCapacity Maximum number of records buffered between reader and workers
+     * @return true if the whole stream was read and executed, false (with a message on std::cerr) on error
+     */
+    bool streamProcesses(const std::string& source, std::size_t queueCapacity = DEFAULT_STREAM_CAPACITY);
+    
+    /**
+     * @brief Get the aggregate results of the last streamProcesses() run
+     * 
+     * @return Counts, summed times and queue usage (all 0 before a streamed run)
+     */
+    const StreamStats& getStreamStats() const;
+    
+    /**
+     * @brief Get the loaded processes
+     * 
+     * @return Processes in file order
+     */
+    const std::vector<Process>& getProcesses() const;
+    
+    /**
+     * @brief Replace the loaded processes with an in-memory workload
+     * 
+     * The processes are taken as-is (callers such as generators and benchmarks
+     * are expected to produce valid records).
+     * 
+     * @param newProcesses Processes to execute
+     */
+    void setProcesses(const std::vector<Process>& newProcesses);
+    
+    /**
+     * @brief Get per-process timing results of the last executeProcesses() run
+     * 
+     * @return Statistics in the same order as the loaded processes
+     */
+    const std::vector<ProcessStats>& getProcessStats() const;
+    
+    /**
+     * @brief Get throughput and utilization of the last run
+     * 
+     * @return Aggregate results of executeProcesses() or streamProcesses()
+     */
+    const RunSummary& getRunSummary() const;
+    
+    /**
+     * @brief Write metrics to a file at the end of every run
+     * 
+     * @param path Output file ("" disables the export)
+     * @param format CSV or JSON lines
+     */
+    void setMetricsPath(const std::string& path, MetricsFormat format = MetricsFormat::Csv);
+    
+    /**
+     * @brief Write a Chrome trace-event timeline at the end of every executeProcesses() run
+     * 
+     * One track per process: RealTime runs show a "queued" span (handed to
+     * the pool, waiting for a worker) and a "run" span; VirtualTime runs show
+     * one "run" span per CPU slice, so preemptions appear as gaps. Streamed
+     * runs keep no per-process records and are not traced.
+     * 
+     * @param path Output file ("" disables tracing)
+     */
+    void setTracePath(const std::string& path);
+    
+    /**
+     * @brief Publish the progress of every run to a live metrics exporter
+     * 
+     * Each executeProcesses() or streamProcesses() run registers the
+     * "process" source for its duration; its final counts are kept by the
+     * exporter afterwards.
+     * 
+     * @param metrics Exporter (null disables the counters; must outlive the runs)
+     */
+    void setLiveMetrics(LiveMetrics* metrics);
+    
+    /**
+     * @brief Save VirtualTime runs to a checkpoint file so they can be continued
+     * 
+     * When checkpointRequest() is set (SIGINT / SIGTERM after
+     * installCheckpointSignals()), the event loop saves its state to path and
+     * the run stops; executeProcesses() then returns without statistics and
+     * wasInterrupted() is true. If the file cannot be written, the run
+     * continues. With a positive interval the state is also saved every
+     * interval of wall-clock time (checked every CHECKPOINT_POLL_EVENTS
+     * events), so a run killed outright loses at most that much work.
+     * 
+     * @param path Checkpoint file ("" disables checkpoints)
+     * @param interval Time between periodic checkpoints (0 = only when interrupted)
+     */
+    void setCheckpoint(const std::string& path, std::chrono::nanoseconds interval);
+    
+    /**
+     * @brief Start the next run from a process checkpoint instead of time 0
+     * 
+     * The loaded trace must be the one the checkpoint was taken from (same
+     * fingerprint). The run's settings are taken from the checkpoint: the
+     * mode becomes VirtualTime, and policy, ready queue, quantum and CPU
+     * count are those of the interrupted run.
+     * 
+     * @param checkpoint State read by readCheckpoint()
+     * @return false (with a message on std::cerr) if it does not match the loaded trace
+     */
+    bool setResumePoint(const ProcessCheckpoint& checkpoint);
+    
+    /**
+     * @brief Check whether the last run stopped at a checkpoint instead of finishing
+     * 
+     * @return true if the run was interrupted and its state saved
+     */
+    bool wasInterrupted() const;
+    
+    /**
+     * @brief Bind the worker threads of RealTime and streamed runs to CPUs
+     * 
+     * Worker i runs on planCpus(pinning, workers)[i]. VirtualTime runs use a
+     * single thread and ignore the setting.
+     * 
+     * @param cpuPinning Placement policy (PinningPolicy::None by default)
+     */
+    void setPinning(const CpuPinning& cpuPinning);
+    
+    /**
+     * @brief Choose how RealTime and streamed workers spend a burst
+     * 
+     * BurstMode::Burn runs burstTime x time scale seconds of calibrated
+     * busy work; with more workers than cores the bursts then compete for
+     * CPUs and their run spans stretch beyond their CPU time.
+     * 
+     * @param mode BurstMode::Sleep (default) or BurstMode::Burn
+     */
+    void setBurstMode(BurstMode mode);
+    
+    /**
+     * @brief Get how RealTime workers spend a burst
+     * 
+     * @return The configured BurstMode
+     */
+    BurstMode getBurstMode() const;
+    
+    /**
+     * @brief Write per-process records and the run summary of the last run
+     * 
+     * Each record holds pid, arrival, queued, start and finish times,
+     * nominal burst, scheduling latency, overrun, thread CPU time, waiting,
+     * turnaround and response time in seconds (nanosecond precision). Streamed runs keep no
+     * per-process records, so only the summary is written for them.
+     * 
+     * @param path Output file (truncated)
+     * @param format CSV or JSON lines
+     * @return true on success, false (with a message on std::cerr) on I/O error
+     */
+    bool writeMetrics(const std::string& path, MetricsFormat format) const;
+    
+    /**
+     * @brief Print a per-pid table of waiting, turnaround and response times
+     * 
+     * After streamProcesses() only a summary of the StreamStats is printed.
+     * 
+     * @param out Output stream (e.g., std::cout)
+     */
+    void printStatistics(std::ostream& out) const;
+    
+    /**
+     * @brief Check whether messages of a level are logged by this simulator
+     * @param level Level of the message
+     * @return true if the level is compiled in and enabled and logging is on
+     */
+    bool logging(LogLevel level) const;
+    
     /**
      * @brief Thread-safe logging with timestamp
      * 
-     * CRITICAL SECTION: Acquires coutMutex before writing to console
-     * to prevent interleaved output from multiple threads.
+     * Hands the message to the shared Logger, which stamps it with the time
+     * elapsed since startTime (or the simulated clock in VirtualTime mode)
+     * and writes it from its background thread.
      * 
      * @param message The message to log
      */
@@ -88,6 +604,8 @@ public:
     /**
      * @brief Get elapsed time since simulation start
      * 
+     * In VirtualTime mode this is the simulated clock instead of wall-clock time.
+     * 
      * @return Formatted timestamp string in seconds
      */
     std::string getTimestamp();
@@ -96,14 +614,120 @@ private:
     /**
      * @brief Worker function executed by each process thread
      * 
-     * This static function is the entry point for each process thread.
+     * This static function is run by a pool worker for each process.
      * It logs the start, simulates CPU burst time, and logs completion.
      * 
-     * @param pid Process ID
-     * @param burstTime CPU burst time in seconds
+     * @param index Index of the process in the processes vector
      * @param sim Pointer to ProcessSimulator instance for logging
      */
-    static void processWorker(int pid, int burstTime, ProcessSimulator* sim);
+    static void processWorker(std::size_t index, ProcessSimulator* sim);
+    
+    /**
+     * @brief Spend one burst on the calling worker (sleep or burn, see BurstMode)
+     * 
+     * @param burstTime Burst in trace time units (scaled by the time scale)
+     * @return Thread CPU seconds the burst consumed
+     */
+    double runBurst(int burstTime) const;
+    
+    /**
+     * @brief Print the burst mode and CPU time against run spans of the last run
+     * 
+     * @param out Output stream
+     */
+    void printBurstTimes(std::ostream& out) const;
+    
+    /**
+     * @brief Parse and validate one line of the text trace format
+     * 
+     * Accepts "pid burstTime [arrivalTime [priority]]" with the same rules as
+     * stream extraction (leading whitespace, optional sign, decimal digits).
+     * Prints the error with its line number to std::cerr on failure.
+     * 
+     * @param begin First character of the line
+     * @param end One past the last character (excluding the newline)
+     * @param lineNumber 1-based line number for error messages
+     * @param filename File name for error messages
+     * @param process Receives the parsed process
+     * @return true if the line is a valid process record
+     */
+    static bool parseProcessLine(const char* begin, const char* end, int lineNumber,
+                                 const std::string& filename, Process& process);
+    
+    /**
+     * @brief Seconds of wall-clock time elapsed since startTime
+     * 
+     * @return Elapsed time in seconds
+     */
+    double elapsedSeconds() const;
+    
+    /**
+     * @brief Fill summary from the per-process records of the last run
+     * 
+     * @param workers Workers or simulated CPUs of the run
+     */
+    void summarize(unsigned int workers);
+    
+    /**
+     * @brief Consumer loop of streamProcesses(): execute queued records until the queue closes
+     * 
+     * @param sim Pointer to ProcessSimulator instance
+     * @param queue Ingestion queue shared with the reader
+     */
+    static void streamWorker(ProcessSimulator* sim, BoundedQueue<Process>* queue);
+    
+    /**
+     * @brief Reset the live counters and register the "process" source
+     * 
+     * @param total Processes in the run (0 if unknown)
+     */
+    void beginLiveRun(std::uint64_t total);
+    
+    /**
+     * @brief Unregister the "process" source (the exporter keeps its final counts)
+     */
+    void endLiveRun();
+    
+    /**
+     * @brief Count one event on a live counter, if an exporter is attached
+     * 
+     * @param counter Counter to increment (relaxed)
+     */
+    void liveCount(std::atomic<std::uint64_t>& counter) {
+        if (liveMetrics) {
+            counter.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    
+    /**
+     * @brief Write the live counters (exporter thread)
+     * 
+     * @param out Metrics writer
+     */
+    void collectLiveMetrics(MetricsWriter& out) const;
+    
+    /**
+     * @brief Discrete-event execution of all loaded processes
+     * 
+     * Single-threaded event loop used by executeProcesses() in VirtualTime mode.
+     */
+    void runVirtualTime();
+    
+    /**
+     * @brief Coroutine of one process: wait for the arrival, spend the burst, finish
+     * 
+     * @param index Index of the process in the processes vector
+     * @param runner Scheduler running the coroutine
+     * @return The process's task
+     */
+    CoTask processTask(std::size_t index, CoScheduler* runner);
+    
+    /**
+     * @brief Run every loaded process as a coroutine on workerCount threads
+     * 
+     * Used by executeProcesses() in Coroutine mode.
+     */
+    void runCoroutines();
 };
 
 #endif // PROCESS_SIMULATOR_H
@@ -0,0 +1,79 @@
+/**
+ * @file ProcessTable.cpp
+ * @brief Implementation of the structure-of-arrays process table
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "ProcessTable.h"
+#include "ProcessSimulator.h"
+#include <algorithm>
+
+namespace {
+
+const std::size_t MIN_BLOCK = 256;  ///< Values per block of firstMinIndex()
+
+} // namespace
+
+/**
+ * @brief Fill the columns from processes in file order
+ * @param processes Loaded processes
+ */
+void ProcessTable::assign(const std::vector<Process>& processes) {
+    std::size_t n = processes.size();
+    arrivalTime.resize(n);
+    burstTime.resize(n);
+    priority.resize(n);
+    pid.resize(n);
+    for (std::size_t i = 0; i < n; i++) {
+        arrivalTime[i] = processes[i].arrivalTime;
+        burstTime[i] = processes[i].burstTime;
+        priority[i] = processes[i].priority;
+        pid[i] = processes[i].pid;
+    }
+    remaining = burstTime;
+    startTime.assign(n, -1);
+    finishTime.assign(n, -1);
+
+    arrivalOrder.resize(n);
+    for (std::size_t i = 0; i < n; i++) {
+        arrivalOrder[i] = static_cast<std::uint32_t>(i);
+    }
+    if (!std::is_sorted(arrivalTime.begin(), arrivalTime.end())) {
+        std::stable_sort(arrivalOrder.begin(), arrivalOrder.end(),
+                         [this](std::uint32_t a, std::uint32_t b) { return arrivalTime[a] < arrivalTime[b]; });
+    }
+}
+
+std::size_t ProcessTable::size() const {
+    return pid.size();
+}
+
+/**
+ * @brief Find the first position of the smallest value
+ * @param values Values
+ * @param count Number of values (must be > 0)
+ * @return Smallest i with values[i] == min(values)
+ */
+std::size_t firstMinIndex(const int* values, std::size_t count) {
+    int best = values[0];
+    std::size_t bestBlock = 0;
+    for (std::size_t start = 0; start < count; start += MIN_BLOCK) {
+        std::size_t end = std::min(start + MIN_BLOCK, count);
+        int blockMin = values[start];
+        for (std::size_t i = start + 1; i < end; i++) {
+            blockMin = (values[i] < blockMin) ? values[i] : blockMin;
+        }
+        if (blockMin < best) {
+            best = blockMin;
+            bestBlock = start;
+        }
+    }
+
+    std::size_t i = bestBlock;
+    while (values[i] != best) {
+        i++;
+    }
+    return i;
+}
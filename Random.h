@@ -0,0 +1,145 @@
+/**
+ * @file Random.h
+ * @brief Header file for the FastRandom generator
+ *
+ * This file defines a small, allocation-free pseudo-random generator for the
+ * simulation hot paths. std::random_device may open a device file and
+ * std::mt19937 carries 2.5 KB of state, so constructing them per draw costs
+ * far more than the draw itself. FastRandom is xoshiro256** (Blackman and
+ * Vigna) seeded through splitmix64:
+ *
+ * - 32 bytes of state, one instance per thread or per philosopher
+ * - A handful of shifts, rotates and multiplies per 64-bit draw
+ * - Equal seeds produce equal sequences, so runs can be reproduced
+ *
+ * Everything is inline: the generator is used once per think-eat cycle and
+ * must not cost a call into another translation unit.
+ *
+ * Thread Safety:
+ * - An instance is not thread-safe; give each thread its own generator
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+/**
+ * @class FastRandom
+ * @brief xoshiro256** pseudo-random generator (not cryptographically secure)
+ */
+class FastRandom {
+private:
+    std::uint64_t state[4];  ///< Generator state (never all zero)
+
+    /**
+     * @brief Rotate a 64-bit value left
+     */
+    static std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    /**
+     * @brief Constructor - seeds the generator
+     * @param seed Any value (0 is fine: splitmix64 spreads it over the state)
+     */
+    explicit FastRandom(std::uint64_t seed = 0) {
+        reseed(seed);
+    }
+
+    /**
+     * @brief Restart the sequence from a seed
+     *
+     * splitmix64 expands the seed into four well-mixed words, so nearby seeds
+     * (seed, seed + 1, ...) give unrelated sequences.
+     *
+     * @param seed Any value
+     */
+    void reseed(std::uint64_t seed) {
+        for (int i = 0; i < 4; i++) {
+            seed += 0x9E3779B97F4A7C15ull;
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            state[i] = z ^ (z >> 31);
+        }
+    }
+
+    /**
+     * @brief Copy out the generator state (for checkpoints)
+     * @param words Receives the four state words
+     */
+    void saveState(std::uint64_t words[4]) const {
+        for (int i = 0; i < 4; i++) {
+            words[i] = state[i];
+        }
+    }
+
+    /**
+     * @brief Continue the sequence from a state copied out by saveState()
+     * @param words Four state words (an all-zero state is replaced by reseed(0))
+     */
+    void restoreState(const std::uint64_t words[4]) {
+        if ((words[0] | words[1] | words[2] | words[3]) == 0) {
+            reseed(0);
+            return;
+        }
+        for (int i = 0; i < 4; i++) {
+            state[i] = words[i];
+        }
+    }
+
+    /**
+     * @brief Draw the next 64-bit value
+     * @return Uniformly distributed 64-bit value
+     */
+    std::uint64_t next() {
+        std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+        std::uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    /**
+     * @brief Draw an integer uniformly from [lo, hi]
+     *
+     * Multiply-shift range reduction (Lemire): the high half of next() * span.
+     * The bias is below span / 2^64, far too small to matter here.
+     *
+     * @param lo Smallest value
+     * @param hi Largest value (must be >= lo)
+     * @return Value in [lo, hi]
+     */
+    long long uniform(long long lo, long long hi) {
+        std::uint64_t span = static_cast<std::uint64_t>(hi) - static_cast<std::uint64_t>(lo) + 1;
+        if (span == 0) {
+            return static_cast<long long>(next());  // Full 64-bit range
+        }
+#if defined(__SIZEOF_INT128__)
+        std::uint64_t offset = static_cast<std::uint64_t>(
+            (static_cast<unsigned __int128>(next()) * span) >> 64);
+#else
+        std::uint64_t offset = next() % span;
+#endif
+        return static_cast<long long>(static_cast<std::uint64_t>(lo) + offset);
+    }
+
+    /**
+     * @brief Draw a double uniformly from [0, 1)
+     * @return Value with 53 random bits
+     */
+    double uniformReal() {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+#endif // RANDOM_H
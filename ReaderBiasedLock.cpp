@@ -0,0 +1,235 @@
+/**
+ * @file ReaderBiasedLock.cpp
+ * @brief Implementation of the ReaderBiasedLock class
+ *
+ * Correctness rests on one store-load pair on each side, all seq_cst:
+ * a reader increments its counter and then reads the writer flag, and a
+ * writer sets the flag and then reads the counters. At least one of the
+ * two sees the other, so a reader never enters while a writer that saw its
+ * counter at 0 is inside.
+ *
+ * Linux: a writer parks with FUTEX_WAIT_PRIVATE on the counter it waits
+ * for; the last reader to leave it wakes the writer. Readers that find a
+ * writer mark the flag 2 and park on it; the writer's release wakes them
+ * all. Other platforms yield in a loop instead, like SpinParkLock.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "ReaderBiasedLock.h"
+#include <climits>
+#include <thread>
+
+#if defined(__linux__)
+#define READER_BIASED_LOCK_USE_FUTEX 1
+#include <linux/futex.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+const std::size_t ReaderBiasedLock::READER_SLOTS;
+const std::size_t ReaderBiasedLock::CACHE_LINE_SIZE;
+
+namespace {
+
+/**
+ * @brief Spin rounds before parking (1, 2, 4 ... 64 pauses each)
+ */
+const int SPIN_ROUNDS = 8;
+
+/**
+ * @brief Tell the CPU this is a spin-wait loop
+ */
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+/**
+ * @brief Spin with exponential backoff until a word leaves a value or the rounds run out
+ * @return true if the word no longer holds the value
+ */
+inline bool spinWhile(const std::atomic<std::uint32_t>& word, std::uint32_t value) {
+    // On a single CPU the thread we wait for cannot run while we spin
+    static const int spinRounds = (std::thread::hardware_concurrency() > 1) ? SPIN_ROUNDS : 0;
+    unsigned int backoff = 1;
+    for (int round = 0; round < spinRounds; round++) {
+        if (word.load(std::memory_order_relaxed) != value) {
+            return true;
+        }
+        for (unsigned int i = 0; i < backoff; i++) {
+            cpuRelax();
+        }
+        backoff <<= 1;
+    }
+    return word.load(std::memory_order_relaxed) != value;
+}
+
+/**
+ * @brief Sleep while *word == expected (returns early on wake-ups and signals)
+ */
+inline void parkWhile(std::atomic<std::uint32_t>& word, std::uint32_t expected) {
+#ifdef READER_BIASED_LOCK_USE_FUTEX
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+    (void)word;
+    (void)expected;
+    std::this_thread::yield();
+#endif
+}
+
+/**
+ * @brief Wake up to count threads sleeping on word
+ */
+inline void wake(std::atomic<std::uint32_t>& word, int count) {
+#ifdef READER_BIASED_LOCK_USE_FUTEX
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#else
+    (void)word;
+    (void)count;
+#endif
+}
+
+/**
+ * @brief Choose the reader slot of a new thread
+ *
+ * The CPU the thread runs on, so pinned workers on different cores never
+ * share a slot; threads that cannot tell are spread round-robin.
+ */
+std::size_t pickSlot() {
+#ifdef READER_BIASED_LOCK_USE_FUTEX
+    int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return static_cast<std::size_t>(cpu) % ReaderBiasedLock::READER_SLOTS;
+    }
+#endif
+    static std::atomic<std::size_t> nextSlot(0);
+    return nextSlot.fetch_add(1, std::memory_order_relaxed) % ReaderBiasedLock::READER_SLOTS;
+}
+
+} // namespace
+
+/**
+ * @brief Get the reader slot of the calling thread
+ *
+ * Chosen once, so unlock_shared() always leaves the counter lock_shared()
+ * entered even if the thread has migrated since.
+ *
+ * @return Index in readers
+ */
+std::size_t ReaderBiasedLock::readerSlot() {
+    static thread_local const std::size_t slot = pickSlot();
+    return slot;
+}
+
+/**
+ * @brief Contended shared path: wait for the writer flag to clear, then retry
+ *
+ * Spins briefly, then marks the flag 2 ("readers parked") and sleeps on it
+ * until the writer's unlock() clears it.
+ */
+void ReaderBiasedLock::lockSharedSlow() {
+    for (;;) {
+        std::uint32_t flag = writer.load(std::memory_order_relaxed);
+        if (flag == 0) {
+            if (try_lock_shared()) {
+                return;
+            }
+            continue;
+        }
+        if (spinWhile(writer, flag)) {
+            continue;
+        }
+        if (flag == 1 && !writer.compare_exchange_strong(flag, 2, std::memory_order_relaxed)) {
+            continue;
+        }
+        parkWhile(writer, 2);
+    }
+}
+
+/**
+ * @brief Wait until every reader counter is 0 (writer flag set)
+ *
+ * New readers back out once they see the flag, so each counter only falls.
+ * A counter can rise again briefly while a reader backs out; the reader
+ * that brings it back to 0 wakes the writer.
+ */
+void ReaderBiasedLock::waitForReaders() {
+    for (ReaderSlot& slot : readers) {
+        if (slot.count.load(std::memory_order_seq_cst) == 0) {
+            continue;
+        }
+        spinWhile(slot.count, slot.count.load(std::memory_order_relaxed));
+        std::uint32_t inside;
+        while ((inside = slot.count.load(std::memory_order_seq_cst)) != 0) {
+            parkWhile(slot.count, inside);
+        }
+    }
+}
+
+/**
+ * @brief Acquire the lock exclusively
+ *
+ * Writers queue on writerLock; the one that holds it raises the flag, which
+ * turns new readers away, and waits for the readers already inside.
+ */
+void ReaderBiasedLock::lock() {
+    writerLock.lock();
+    writer.store(1, std::memory_order_seq_cst);
+    waitForReaders();
+}
+
+/**
+ * @brief Acquire the lock exclusively only if no writer or reader holds it
+ * @return true if the lock was acquired
+ */
+bool ReaderBiasedLock::try_lock() {
+    if (!writerLock.try_lock()) {
+        return false;
+    }
+    writer.store(1, std::memory_order_seq_cst);
+    for (const ReaderSlot& slot : readers) {
+        if (slot.count.load(std::memory_order_seq_cst) != 0) {
+            clearWriter();
+            writerLock.unlock();
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Release an exclusive acquisition
+ */
+void ReaderBiasedLock::unlock() {
+    clearWriter();
+    writerLock.unlock();
+}
+
+/**
+ * @brief Clear the writer flag and wake the parked readers
+ */
+void ReaderBiasedLock::clearWriter() {
+    if (writer.exchange(0, std::memory_order_seq_cst) == 2) {
+        wake(writer, INT_MAX);
+    }
+}
+
+/**
+ * @brief Wake a writer parked on a drained reader counter
+ * @param count Counter
+ */
+void ReaderBiasedLock::wakeWriter(std::atomic<std::uint32_t>& count) {
+    wake(count, 1);
+}
@@ -0,0 +1,161 @@
+/**
+ * @file ReaderBiasedLock.h
+ * @brief Header file for the ReaderBiasedLock class
+ *
+ * This file defines a reader-writer lock for read-mostly resources.
+ * std::shared_mutex keeps its reader count in one word, so every shared
+ * acquisition and release is an atomic write to that word. Readers on
+ * different cores then take turns owning one cache line even though they
+ * never exclude each other. ReaderBiasedLock spreads the count instead:
+ *
+ * - READER_SLOTS reader counters, each on its own cache line. A thread always
+ *   uses the same slot (chosen from the CPU it first ran a shared acquisition
+ *   on), so readers on different cores touch different lines.
+ * - A writer flag, set by a writer before it waits for every counter to
+ *   drain. A reader increments its counter, then checks the flag; if a
+ *   writer is present it backs its increment out and waits for the writer.
+ * - A SpinParkLock that orders writers among themselves.
+ *
+ * Reads stay cheap and scale with the cores; a write costs a scan of all
+ * the counters and waits for the readers inside. Readers yield to a waiting
+ * writer, so a steady stream of readers cannot starve writers.
+ *
+ * Waiting writers park on the counter they wait for, and waiting readers
+ * park on the writer flag (Linux futex; other platforms yield), as
+ * SpinParkLock does.
+ *
+ * ReaderBiasedLock meets the standard Lockable and SharedLockable
+ * requirements (lock, try_lock, unlock, lock_shared, try_lock_shared,
+ * unlock_shared), so std::unique_lock and std::shared_lock accept it.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef READER_BIASED_LOCK_H
+#define READER_BIASED_LOCK_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "SpinParkLock.h"
+
+/**
+ * @class ReaderBiasedLock
+ * @brief Reader-writer lock with per-core reader counters
+ */
+class ReaderBiasedLock {
+public:
+    static const std::size_t READER_SLOTS = 16;     ///< Reader counters per lock (threads share them modulo this)
+    static const std::size_t CACHE_LINE_SIZE = 64;  ///< Alignment of each reader counter
+
+    /**
+     * @brief Constructor - creates an unlocked lock
+     */
+    ReaderBiasedLock() : writer(0) {
+        for (ReaderSlot& slot : readers) {
+            slot.count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Acquire the lock shared, waiting while a writer holds or wants it
+     */
+    void lock_shared() {
+        if (!try_lock_shared()) {
+            lockSharedSlow();
+        }
+    }
+
+    /**
+     * @brief Acquire the lock shared only if no writer holds or wants it
+     * @return true if the lock was acquired
+     */
+    bool try_lock_shared() {
+        std::atomic<std::uint32_t>& count = readers[readerSlot()].count;
+        count.fetch_add(1, std::memory_order_seq_cst);
+        if (writer.load(std::memory_order_seq_cst) == 0) {
+            return true;
+        }
+        leave(count);
+        return false;
+    }
+
+    /**
+     * @brief Release a shared acquisition (on the thread that made it)
+     */
+    void unlock_shared() {
+        leave(readers[readerSlot()].count);
+    }
+
+    /**
+     * @brief Acquire the lock exclusively, waiting for the readers inside
+     */
+    void lock();
+
+    /**
+     * @brief Acquire the lock exclusively only if it is free
+     * @return true if the lock was acquired
+     */
+    bool try_lock();
+
+    /**
+     * @brief Release an exclusive acquisition, waking the readers that wait
+     */
+    void unlock();
+
+private:
+    /**
+     * @struct ReaderSlot
+     * @brief One reader counter on its own cache line
+     */
+    struct alignas(CACHE_LINE_SIZE) ReaderSlot {
+        std::atomic<std::uint32_t> count;  ///< Readers inside (or backing out) through this slot
+    };
+
+    ReaderSlot readers[READER_SLOTS];  ///< Per-core reader counters
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint32_t> writer;  ///< 0 none, 1 writer in or waiting, 2 and readers may be parked
+    SpinParkLock writerLock;           ///< Orders the writers
+
+    ReaderBiasedLock(const ReaderBiasedLock&) = delete;             ///< Non-copyable
+    ReaderBiasedLock& operator=(const ReaderBiasedLock&) = delete;  ///< Non-assignable
+
+    /**
+     * @brief Get the reader slot of the calling thread
+     * @return Index in readers (fixed for the life of the thread)
+     */
+    static std::size_t readerSlot();
+
+    /**
+     * @brief Leave a reader counter, waking a writer that waits for it to drain
+     * @param count Counter of the calling thread's slot
+     */
+    void leave(std::atomic<std::uint32_t>& count) {
+        if (count.fetch_sub(1, std::memory_order_seq_cst) == 1 && writer.load(std::memory_order_seq_cst) != 0) {
+            wakeWriter(count);
+        }
+    }
+
+    /**
+     * @brief Contended shared path: wait for the writer flag to clear, then retry
+     */
+    void lockSharedSlow();
+
+    /**
+     * @brief Wait until every reader counter is 0 (writer flag set)
+     */
+    void waitForReaders();
+
+    /**
+     * @brief Clear the writer flag and wake the parked readers
+     */
+    void clearWriter();
+
+    /**
+     * @brief Wake a writer parked on a drained reader counter
+     * @param count Counter
+     */
+    static void wakeWriter(std::atomic<std::uint32_t>& count);
+};
+
+#endif // READER_BIASED_LOCK_H
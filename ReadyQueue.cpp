@@ -0,0 +1,342 @@
+/**
+ * @file ReadyQueue.cpp
+ * @brief Implementation of the keyed ready queues
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "ReadyQueue.h"
+#include "ProcessTable.h"
+#include <bit>
+
+const std::size_t DaryHeapReadyQueue::ARITY;
+const std::uint32_t PairingHeapReadyQueue::NONE;
+const std::size_t BucketReadyQueue::BUCKET_LIMIT;
+const std::uint32_t BucketReadyQueue::NONE;
+
+ReadyQueue::~ReadyQueue() {
+}
+
+// ---------------------------------------------------------------------------
+// ScanReadyQueue
+// ---------------------------------------------------------------------------
+
+void ScanReadyQueue::push(std::uint32_t index, int key) {
+    keys.push_back(key);
+    indices.push_back(index);
+}
+
+bool ScanReadyQueue::empty() const {
+    return keys.empty();
+}
+
+/**
+ * @brief Remove the first entry with the smallest key
+ * @return Process index
+ */
+std::uint32_t ScanReadyQueue::popMin() {
+    std::size_t pos = firstMinIndex(keys.data(), keys.size());
+    std::uint32_t index = indices[pos];
+    keys.erase(keys.begin() + static_cast<std::ptrdiff_t>(pos));
+    indices.erase(indices.begin() + static_cast<std::ptrdiff_t>(pos));
+    return index;
+}
+
+// ---------------------------------------------------------------------------
+// DaryHeapReadyQueue
+// ---------------------------------------------------------------------------
+
+DaryHeapReadyQueue::DaryHeapReadyQueue() : nextSeq(0) {
+}
+
+/**
+ * @brief Append an entry and sift it up
+ * @param index Process index
+ * @param key Scheduling key
+ */
+void DaryHeapReadyQueue::push(std::uint32_t index, int key) {
+    Entry entry = { key, index, nextSeq++ };
+    std::size_t pos = heap.size();
+    heap.push_back(entry);
+    while (pos > 0) {
+        std::size_t parent = (pos - 1) / ARITY;
+        if (!before(entry, heap[parent])) {
+            break;
+        }
+        heap[pos] = heap[parent];
+        pos = parent;
+    }
+    heap[pos] = entry;
+}
+
+bool DaryHeapReadyQueue::empty() const {
+    return heap.empty();
+}
+
+/**
+ * @brief Remove the root and sift the last entry down from it
+ * @return Process index of the removed root
+ */
+std::uint32_t DaryHeapReadyQueue::popMin() {
+    std::uint32_t index = heap[0].index;
+    Entry last = heap.back();
+    heap.pop_back();
+    std::size_t n = heap.size();
+    if (n == 0) {
+        return index;
+    }
+
+    std::size_t pos = 0;
+    for (;;) {
+        std::size_t first = pos * ARITY + 1;
+        if (first >= n) {
+            break;
+        }
+        std::size_t end = (first + ARITY < n) ? first + ARITY : n;
+        std::size_t best = first;
+        for (std::size_t c = first + 1; c < end; c++) {
+            if (before(heap[c], heap[best])) {
+                best = c;
+            }
+        }
+        if (!before(heap[best], last)) {
+            break;
+        }
+        heap[pos] = heap[best];
+        pos = best;
+    }
+    heap[pos] = last;
+    return index;
+}
+
+int DaryHeapReadyQueue::minKey() const {
+    return heap[0].key;
+}
+
+// ---------------------------------------------------------------------------
+// PairingHeapReadyQueue
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Constructor - allocates the per-process links
+ * @param capacity Number of process indices
+ */
+PairingHeapReadyQueue::PairingHeapReadyQueue(std::size_t capacity)
+    : key(capacity, 0), seq(capacity, 0), child(capacity, NONE), sibling(capacity, NONE),
+      root(NONE), nextSeq(0) {
+}
+
+/**
+ * @brief Make the later root the first child of the earlier one
+ * @param a Root of the first heap
+ * @param b Root of the second heap
+ * @return Root of the melded heap
+ */
+std::uint32_t PairingHeapReadyQueue::meld(std::uint32_t a, std::uint32_t b) {
+    if (a == NONE) {
+        return b;
+    }
+    if (b == NONE) {
+        return a;
+    }
+    if (key[b] < key[a] || (key[b] == key[a] && seq[b] < seq[a])) {
+        std::uint32_t t = a;
+        a = b;
+        b = t;
+    }
+    sibling[b] = child[a];
+    child[a] = b;
+    return a;
+}
+
+/**
+ * @brief Meld a one-node heap with the root
+ * @param index Process index
+ * @param value Scheduling key
+ */
+void PairingHeapReadyQueue::push(std::uint32_t index, int value) {
+    key[index] = value;
+    seq[index] = nextSeq++;
+    child[index] = NONE;
+    sibling[index] = NONE;
+    root = meld(root, index);
+}
+
+bool PairingHeapReadyQueue::empty() const {
+    return root == NONE;
+}
+
+/**
+ * @brief Remove the root and meld its children in two passes
+ * @return Process index of the removed root
+ */
+std::uint32_t PairingHeapReadyQueue::popMin() {
+    std::uint32_t index = root;
+
+    // First pass: meld the children in pairs, left to right
+    pairs.clear();
+    std::uint32_t c = child[index];
+    while (c != NONE) {
+        std::uint32_t a = c;
+        std::uint32_t b = sibling[a];
+        c = (b != NONE) ? sibling[b] : NONE;
+        sibling[a] = NONE;
+        if (b != NONE) {
+            sibling[b] = NONE;
+        }
+        pairs.push_back(meld(a, b));
+    }
+
+    // Second pass: meld the pairs into one heap, right to left
+    std::uint32_t merged = NONE;
+    for (std::size_t i = pairs.size(); i > 0; i--) {
+        merged = meld(pairs[i - 1], merged);
+    }
+    root = merged;
+    child[index] = NONE;
+    return index;
+}
+
+// ---------------------------------------------------------------------------
+// BucketReadyQueue
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Constructor - sizes the direct buckets for [minKey, maxKey]
+ * @param capacity Number of process indices
+ * @param minKey Smallest key expected
+ * @param maxKey Largest key expected
+ */
+BucketReadyQueue::BucketReadyQueue(std::size_t capacity, int minKey, int maxKey)
+    : base(minKey), next(capacity, NONE), lowestWord(0), queued(0) {
+    long long range = (maxKey >= minKey) ? static_cast<long long>(maxKey) - minKey + 1 : 1;
+    std::size_t buckets = (range < static_cast<long long>(BUCKET_LIMIT)) ? static_cast<std::size_t>(range) : BUCKET_LIMIT;
+    head.assign(buckets, NONE);
+    tail.assign(buckets, NONE);
+    busy.assign((buckets + 63) / 64, 0);
+    lowestWord = busy.size();
+}
+
+/**
+ * @brief Append the process to its key's bucket, or to the overflow heap
+ * @param index Process index
+ * @param key Scheduling key
+ */
+void BucketReadyQueue::push(std::uint32_t index, int key) {
+    long long offset = static_cast<long long>(key) - base;
+    if (offset < 0 || offset >= static_cast<long long>(head.size())) {
+        overflow.push(index, key);
+        return;
+    }
+
+    std::size_t b = static_cast<std::size_t>(offset);
+    next[index] = NONE;
+    if (head[b] == NONE) {
+        head[b] = index;
+        busy[b / 64] |= std::uint64_t(1) << (b % 64);
+        if (b / 64 < lowestWord) {
+            lowestWord = b / 64;
+        }
+    } else {
+        next[tail[b]] = index;
+    }
+    tail[b] = index;
+    queued++;
+}
+
+bool BucketReadyQueue::empty() const {
+    return queued == 0 && overflow.empty();
+}
+
+/**
+ * @brief Take the head of the lowest busy bucket, unless the overflow heap holds a smaller key
+ *
+ * Overflow keys below the buckets always win; overflow keys above them only
+ * once the buckets are empty, so ties never cross the two sources.
+ *
+ * @return Process index
+ */
+std::uint32_t BucketReadyQueue::popMin() {
+    if (queued == 0 || (!overflow.empty() && overflow.minKey() < base)) {
+        return overflow.popMin();
+    }
+
+    while (busy[lowestWord] == 0) {
+        lowestWord++;
+    }
+    std::size_t b = lowestWord * 64 + static_cast<std::size_t>(std::countr_zero(busy[lowestWord]));
+    std::uint32_t index = head[b];
+    head[b] = next[index];
+    if (head[b] == NONE) {
+        tail[b] = NONE;
+        busy[b / 64] &= ~(std::uint64_t(1) << (b % 64));
+    }
+    queued--;
+    if (queued == 0) {
+        lowestWord = busy.size();
+    }
+    return index;
+}
+
+// ---------------------------------------------------------------------------
+// Factory and names
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Create a ready queue
+ * @param type Implementation
+ * @param capacity Number of process indices
+ * @param minKey Smallest key expected
+ * @param maxKey Largest key expected
+ * @return Newly allocated queue
+ */
+std::unique_ptr<ReadyQueue> createReadyQueue(ReadyQueueType type, std::size_t capacity, int minKey, int maxKey) {
+    switch (type) {
+        case ReadyQueueType::DaryHeap:
+            return std::make_unique<DaryHeapReadyQueue>();
+        case ReadyQueueType::PairingHeap:
+            return std::make_unique<PairingHeapReadyQueue>(capacity);
+        case ReadyQueueType::Bucket:
+            return std::make_unique<BucketReadyQueue>(capacity, minKey, maxKey);
+        case ReadyQueueType::Scan:
+        default:
+            return std::make_unique<ScanReadyQueue>();
+    }
+}
+
+/**
+ * @brief Parse a ready queue name
+ * @param name Ready queue name
+ * @param type Receives the parsed type
+ * @return true if the name is recognised
+ */
+bool parseReadyQueueType(const std::string& name, ReadyQueueType& type) {
+    if (name == "scan") {
+        type = ReadyQueueType::Scan;
+    } else if (name == "heap") {
+        type = ReadyQueueType::DaryHeap;
+    } else if (name == "pairing") {
+        type = ReadyQueueType::PairingHeap;
+    } else if (name == "bucket") {
+        type = ReadyQueueType::Bucket;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Get the command-line name of a ready queue type
+ * @param type Ready queue type
+ * @return Ready queue name
+ */
+const char* readyQueueTypeName(ReadyQueueType type) {
+    switch (type) {
+        case ReadyQueueType::DaryHeap:    return "heap";
+        case ReadyQueueType::PairingHeap: return "pairing";
+        case ReadyQueueType::Bucket:      return "bucket";
+        case ReadyQueueType::Scan:
+        default:                          return "scan";
+    }
+}
@@ -0,0 +1,247 @@
+/**
+ * @file ReadyQueue.h
+ * @brief Header file for the keyed ready queues of the SJF, SRTF and Priority schedulers
+ *
+ * A ready queue holds (key, process index) pairs and removes the smallest
+ * key first; equal keys leave in the order they were pushed, so a keyed
+ * policy with all-equal keys behaves like FCFS. Four interchangeable
+ * implementations trade constant factors against asymptotics:
+ *
+ * | Type     | push             | popMin             | Notes                                  |
+ * |----------|------------------|--------------------|----------------------------------------|
+ * | scan     | O(1)             | O(n), vectorized   | Contiguous keys, best for short queues |
+ * | heap     | O(log4 n)        | O(4 log4 n)        | Implicit 4-ary heap, cache-friendly    |
+ * | pairing  | O(1)             | O(log n) amortized | Pairing heap in per-index arrays       |
+ * | bucket   | O(1)             | O(range / 64)      | FIFO per key, bitmap of busy keys      |
+ *
+ * The bucket queue relies on the keys being bounded integers (burst times
+ * and priorities of the loaded trace). Keys within BUCKET_LIMIT of the
+ * smallest possible key get a direct bucket; any others (heavy-tailed burst
+ * times) go to an overflow 4-ary heap, so the queue stays correct for any
+ * key range.
+ *
+ * Each process is in a ready queue at most once at a time, which lets the
+ * pairing heap and the bucket lists keep their links in arrays indexed by
+ * process rather than in allocated nodes.
+ *
+ * Thread Safety:
+ * - Not thread-safe; used from the virtual-time simulation thread only
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef READY_QUEUE_H
+#define READY_QUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @enum ReadyQueueType
+ * @brief Ready queue implementations available to the keyed schedulers
+ */
+enum class ReadyQueueType {
+    Scan,         ///< Unsorted arrays in ready order, min-reduction per pick
+    DaryHeap,     ///< Implicit 4-ary min-heap
+    PairingHeap,  ///< Pairing heap
+    Bucket        ///< One FIFO per key value
+};
+
+/**
+ * @class ReadyQueue
+ * @brief Min-priority queue of process indices with FIFO ties
+ */
+class ReadyQueue {
+public:
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~ReadyQueue();
+
+    /**
+     * @brief Add a process
+     * @param index Process index (not already in the queue)
+     * @param key Scheduling key (smaller leaves first)
+     */
+    virtual void push(std::uint32_t index, int key) = 0;
+
+    /**
+     * @brief Check whether the queue is empty
+     * @return true if no process is queued
+     */
+    virtual bool empty() const = 0;
+
+    /**
+     * @brief Remove the process with the smallest key (earliest pushed among equals)
+     * @return Process index (the queue must not be empty)
+     */
+    virtual std::uint32_t popMin() = 0;
+};
+
+/**
+ * @class ScanReadyQueue
+ * @brief Keys and indices in two arrays in push order; popMin() is firstMinIndex() and an erase
+ */
+class ScanReadyQueue : public ReadyQueue {
+private:
+    std::vector<int> keys;               ///< Key of each queued process, in push order
+    std::vector<std::uint32_t> indices;  ///< Process index of each entry
+
+public:
+    void push(std::uint32_t index, int key) override;
+    bool empty() const override;
+    std::uint32_t popMin() override;
+};
+
+/**
+ * @class DaryHeapReadyQueue
+ * @brief Implicit 4-ary min-heap ordered by (key, push sequence)
+ *
+ * Four children per node halve the depth of a binary heap, and the children
+ * of a node share one cache line, so a sift-down costs about one miss per
+ * level.
+ */
+class DaryHeapReadyQueue : public ReadyQueue {
+public:
+    static const std::size_t ARITY = 4;  ///< Children per node
+
+private:
+    /**
+     * @struct Entry
+     * @brief One queued process
+     */
+    struct Entry {
+        int key;              ///< Scheduling key
+        std::uint32_t index;  ///< Process index
+        std::uint64_t seq;    ///< Push order, breaks ties
+    };
+
+    std::vector<Entry> heap;  ///< Heap array; the children of i are ARITY*i+1 .. ARITY*i+ARITY
+    std::uint64_t nextSeq;    ///< Sequence number of the next push
+
+    /**
+     * @brief Heap order: smaller key, then earlier push
+     */
+    static bool before(const Entry& a, const Entry& b) {
+        return a.key < b.key || (a.key == b.key && a.seq < b.seq);
+    }
+
+public:
+    DaryHeapReadyQueue();
+    void push(std::uint32_t index, int key) override;
+    bool empty() const override;
+    std::uint32_t popMin() override;
+
+    /**
+     * @brief Get the smallest key
+     * @return Key of the entry popMin() would remove (the queue must not be empty)
+     */
+    int minKey() const;
+};
+
+/**
+ * @class PairingHeapReadyQueue
+ * @brief Pairing heap whose nodes are the process indices themselves
+ *
+ * push() melds a one-node heap with the root in O(1). popMin() melds the
+ * root's children in two passes (pairs left to right, then the pairs right
+ * to left), which gives O(log n) amortized time.
+ */
+class PairingHeapReadyQueue : public ReadyQueue {
+private:
+    static const std::uint32_t NONE = 0xFFFFFFFFu;  ///< Null link
+
+    std::vector<int> key;                  ///< Key of each process
+    std::vector<std::uint64_t> seq;        ///< Push order of each process
+    std::vector<std::uint32_t> child;      ///< First child of each node
+    std::vector<std::uint32_t> sibling;    ///< Next sibling of each node
+    std::vector<std::uint32_t> pairs;      ///< Scratch list for popMin()
+    std::uint32_t root;                    ///< Root node (NONE = empty)
+    std::uint64_t nextSeq;                 ///< Sequence number of the next push
+
+    /**
+     * @brief Meld two heaps
+     * @param a Root of the first heap
+     * @param b Root of the second heap
+     * @return Root of the melded heap (the one that comes first)
+     */
+    std::uint32_t meld(std::uint32_t a, std::uint32_t b);
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Number of process indices (largest index + 1)
+     */
+    explicit PairingHeapReadyQueue(std::size_t capacity);
+    void push(std::uint32_t index, int key) override;
+    bool empty() const override;
+    std::uint32_t popMin() override;
+};
+
+/**
+ * @class BucketReadyQueue
+ * @brief One FIFO list per key value, with a bitmap of the non-empty buckets
+ *
+ * A push links the process at the tail of its key's bucket and sets the
+ * bucket's bit; popMin() finds the lowest set bit from a cursor that only
+ * moves back when a smaller key is pushed.
+ */
+class BucketReadyQueue : public ReadyQueue {
+public:
+    static const std::size_t BUCKET_LIMIT = 1 << 16;  ///< Most direct buckets (larger ranges overflow to a heap)
+
+private:
+    static const std::uint32_t NONE = 0xFFFFFFFFu;  ///< Null link
+
+    int base;                              ///< Key of bucket 0
+    std::vector<std::uint32_t> head;       ///< First process of each bucket
+    std::vector<std::uint32_t> tail;       ///< Last process of each bucket
+    std::vector<std::uint32_t> next;       ///< Next process in the same bucket
+    std::vector<std::uint64_t> busy;       ///< Bit b set = bucket b non-empty
+    std::size_t lowestWord;                ///< No busy bit below word lowestWord
+    std::size_t queued;                    ///< Processes in the buckets
+    DaryHeapReadyQueue overflow;           ///< Keys outside the direct buckets
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Number of process indices (largest index + 1)
+     * @param minKey Smallest key expected
+     * @param maxKey Largest key expected
+     */
+    BucketReadyQueue(std::size_t capacity, int minKey, int maxKey);
+    void push(std::uint32_t index, int key) override;
+    bool empty() const override;
+    std::uint32_t popMin() override;
+};
+
+/**
+ * @brief Create a ready queue
+ * @param type Implementation
+ * @param capacity Number of process indices (largest index + 1)
+ * @param minKey Smallest key expected (sizes the bucket queue)
+ * @param maxKey Largest key expected (sizes the bucket queue)
+ * @return Newly allocated queue
+ */
+std::unique_ptr<ReadyQueue> createReadyQueue(ReadyQueueType type, std::size_t capacity, int minKey, int maxKey);
+
+/**
+ * @brief Parse a ready queue name ("scan", "heap", "pairing", "bucket")
+ * @param name Ready queue name
+ * @param type Receives the parsed type
+ * @return true if the name is recognised
+ */
+bool parseReadyQueueType(const std::string& name, ReadyQueueType& type);
+
+/**
+ * @brief Get the command-line name of a ready queue type
+ * @param type Ready queue type
+ * @return "scan", "heap", "pairing" or "bucket"
+ */
+const char* readyQueueTypeName(ReadyQueueType type);
+
+#endif // READY_QUEUE_H
@@ -0,0 +1,322 @@
+/**
+ * @file ResourceGraph.cpp
+ * @brief Implementation of the agent -> shared-resource requirement graph
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "ResourceGraph.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+const int ResourceGraph::MAX_ID;
+
+namespace {
+
+/**
+ * @brief Parse one non-negative decimal int token
+ * @param token Text of the token
+ * @param value Receives the number
+ * @return true if the whole token is a number in [0, INT_MAX]
+ */
+bool parseId(const std::string& token, int& value) {
+    if (token.empty() || token[0] < '0' || token[0] > '9') {
+        return false;
+    }
+    errno = 0;
+    char* end = nullptr;
+    long parsed = std::strtol(token.c_str(), &end, 10);
+    if (errno != 0 || *end != '\0' || parsed > INT_MAX) {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+/**
+ * @brief Check one agent's resource list
+ * @param agent Agent ID (for the message)
+ * @param needs The agent's resources
+ * @param where Suffix naming the location of the list (for the message)
+ * @return true if the list is non-empty, within [0, MAX_ID] and free of duplicates
+ */
+bool checkNeeds(int agent, const std::vector<int>& needs, const std::string& where) {
+    if (needs.empty()) {
+        std::cerr << "Error: Agent " << agent << " needs no resources" << where << std::endl;
+        return false;
+    }
+    std::vector<int> sorted(needs);
+    std::sort(sorted.begin(), sorted.end());
+    if (sorted[0] < 0) {
+        std::cerr << "Error: Agent " << agent << " needs negative resource " << sorted[0] << where << std::endl;
+        return false;
+    }
+    if (sorted.back() > ResourceGraph::MAX_ID) {
+        std::cerr << "Error: Agent " << agent << " needs resource " << sorted.back()
+                  << ", above the maximum ID " << ResourceGraph::MAX_ID << where << std::endl;
+        return false;
+    }
+    for (std::size_t k = 1; k < sorted.size(); k++) {
+        if (sorted[k] == sorted[k - 1]) {
+            std::cerr << "Error: Agent " << agent << " lists resource " << sorted[k] << " twice" << where << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief Constructor - creates an empty graph (no agents, no resources)
+ */
+ResourceGraph::ResourceGraph() : needOffsets(1, 0), userOffsets(1, 0), resources(0), ringTopology(false) {}
+
+/**
+ * @brief Create the classic round table
+ *
+ * Philosopher i has fork i on their left and fork (i + 1) % n on their
+ * right; the modulo makes philosopher n-1's right fork fork 0.
+ *
+ * @param agents Number of philosophers and forks (raised to 2 if smaller)
+ * @return Graph where agent i needs resources i and (i + 1) % agents
+ */
+ResourceGraph ResourceGraph::ring(int agents) {
+    if (agents < 2) {
+        agents = 2;
+    }
+    std::vector<std::vector<int> > needs(static_cast<std::size_t>(agents));
+    for (int i = 0; i < agents; i++) {
+        needs[i].push_back(i);
+        needs[i].push_back((i + 1) % agents);
+    }
+    ResourceGraph graph;
+    graph.build(needs, agents);
+    graph.ringTopology = true;
+    return graph;
+}
+
+/**
+ * @brief Load a graph from a file ("agent: resource resource ..." per line)
+ * @param filename Path of the file
+ * @return true on success, false (with a message on std::cerr) on error
+ */
+bool ResourceGraph::load(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open resource graph " << filename << std::endl;
+        return false;
+    }
+
+    std::vector<std::vector<int> > needs;
+    std::vector<int> definedAt;  // line number of each agent's list (0 = not seen yet)
+    int resourceCount = 0;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        std::string::size_type hash = line.find('#');
+        if (hash != std::string::npos) {
+            line.erase(hash);
+        }
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+
+        std::string where = " at line " + std::to_string(lineNumber) + " in file " + filename;
+        std::string::size_type colon = line.find(':');
+        std::istringstream head(line.substr(0, colon));
+        std::string token;
+        int agent = 0;
+        if (colon == std::string::npos || !(head >> token) || !parseId(token, agent) || (head >> token)) {
+            std::cerr << "Error: Expected \"agent: resource ...\"" << where << std::endl;
+            return false;
+        }
+        if (agent > MAX_ID) {
+            std::cerr << "Error: Agent ID " << agent << " is above the maximum " << MAX_ID << where << std::endl;
+            return false;
+        }
+        if (static_cast<std::size_t>(agent) >= needs.size()) {
+            needs.resize(static_cast<std::size_t>(agent) + 1);
+            definedAt.resize(static_cast<std::size_t>(agent) + 1, 0);
+        }
+        if (definedAt[agent] != 0) {
+            std::cerr << "Error: Agent " << agent << " is listed again" << where
+                      << " (first at line " << definedAt[agent] << ")" << std::endl;
+            return false;
+        }
+        definedAt[agent] = lineNumber;
+
+        std::istringstream tail(line.substr(colon + 1));
+        while (tail >> token) {
+            int resource = 0;
+            if (!parseId(token, resource)) {
+                std::cerr << "Error: Invalid resource ID '" << token << "'" << where << std::endl;
+                return false;
+            }
+            if (resource > MAX_ID) {
+                std::cerr << "Error: Resource ID " << resource << " is above the maximum " << MAX_ID << where << std::endl;
+                return false;
+            }
+            needs[agent].push_back(resource);
+            resourceCount = std::max(resourceCount, resource + 1);
+        }
+        if (!checkNeeds(agent, needs[agent], where)) {
+            return false;
+        }
+    }
+
+    if (needs.empty()) {
+        std::cerr << "Error: No agents found in resource graph " << filename << std::endl;
+        return false;
+    }
+    for (std::size_t a = 0; a < definedAt.size(); a++) {
+        if (definedAt[a] == 0) {
+            std::cerr << "Error: Agent " << a << " is missing from resource graph " << filename
+                      << " (agents must be numbered 0 to " << needs.size() - 1 << ")" << std::endl;
+            return false;
+        }
+    }
+
+    build(needs, resourceCount);
+    ringTopology = false;
+    source = filename;
+    return true;
+}
+
+/**
+ * @brief Build a graph from in-memory lists
+ * @param needs Resources of agent i at index i (non-empty, non-negative, no duplicates)
+ * @return true on success, false (with a message on std::cerr) on error
+ */
+bool ResourceGraph::setNeeds(const std::vector<std::vector<int> >& needs) {
+    if (needs.empty()) {
+        std::cerr << "Error: A resource graph needs at least one agent" << std::endl;
+        return false;
+    }
+    int resourceCount = 0;
+    for (std::size_t a = 0; a < needs.size(); a++) {
+        if (!checkNeeds(static_cast<int>(a), needs[a], "")) {
+            return false;
+        }
+        resourceCount = std::max(resourceCount, *std::max_element(needs[a].begin(), needs[a].end()) + 1);
+    }
+    build(needs, resourceCount);
+    ringTopology = false;
+    source.clear();
+    return true;
+}
+
+/**
+ * @brief Build every array from per-agent lists
+ *
+ * Users are filled in agent order, so each resource's user list comes out
+ * ascending without a sort.
+ *
+ * @param needs Resources of agent i at index i (validated by the caller)
+ * @param resourceCount Number of resources
+ */
+void ResourceGraph::build(const std::vector<std::vector<int> >& needs, int resourceCount) {
+    resources = resourceCount;
+    needOffsets.assign(1, 0);
+    listedNeeds.clear();
+    sortedNeeds.clear();
+    std::vector<std::size_t> counts(static_cast<std::size_t>(resourceCount), 0);
+    for (const auto& list : needs) {
+        listedNeeds.insert(listedNeeds.end(), list.begin(), list.end());
+        sortedNeeds.insert(sortedNeeds.end(), list.begin(), list.end());
+        std::sort(sortedNeeds.end() - static_cast<std::ptrdiff_t>(list.size()), sortedNeeds.end());
+        needOffsets.push_back(listedNeeds.size());
+        for (int r : list) {
+            counts[r]++;
+        }
+    }
+
+    userOffsets.assign(static_cast<std::size_t>(resourceCount) + 1, 0);
+    for (int r = 0; r < resourceCount; r++) {
+        userOffsets[r + 1] = userOffsets[r] + counts[r];
+    }
+    users.assign(listedNeeds.size(), 0);
+    std::vector<std::size_t> next(userOffsets.begin(), userOffsets.end() - 1);
+    for (std::size_t a = 0; a < needs.size(); a++) {
+        for (int r : needs[a]) {
+            users[next[r]++] = static_cast<int>(a);
+        }
+    }
+}
+
+int ResourceGraph::agentCount() const {
+    return static_cast<int>(needOffsets.size() - 1);
+}
+
+int ResourceGraph::resourceCount() const {
+    return resources;
+}
+
+const int* ResourceGraph::listedNeedsOf(int agent) const {
+    return listedNeeds.data() + needOffsets[agent];
+}
+
+const int* ResourceGraph::sortedNeedsOf(int agent) const {
+    return sortedNeeds.data() + needOffsets[agent];
+}
+
+std::size_t ResourceGraph::needCount(int agent) const {
+    return needOffsets[agent + 1] - needOffsets[agent];
+}
+
+const int* ResourceGraph::usersOf(int resource) const {
+    return users.data() + userOffsets[resource];
+}
+
+std::size_t ResourceGraph::userCount(int resource) const {
+    return userOffsets[resource + 1] - userOffsets[resource];
+}
+
+std::size_t ResourceGraph::maxUsers() const {
+    std::size_t most = 0;
+    for (int r = 0; r < resources; r++) {
+        most = std::max(most, userCount(r));
+    }
+    return most;
+}
+
+std::size_t ResourceGraph::maxNeeds() const {
+    std::size_t most = 0;
+    for (int a = 0; a < agentCount(); a++) {
+        most = std::max(most, needCount(a));
+    }
+    return most;
+}
+
+bool ResourceGraph::isRing() const {
+    return ringTopology;
+}
+
+/**
+ * @brief Describe the graph for statistics output
+ * @return e.g. "ring of 5" or "graph.txt: 12 agents, 8 resources, 2-4 per agent, up to 3 users"
+ */
+std::string ResourceGraph::describe() const {
+    if (ringTopology) {
+        return "ring of " + std::to_string(agentCount());
+    }
+    std::size_t fewest = (agentCount() > 0) ? needCount(0) : 0;
+    for (int a = 1; a < agentCount(); a++) {
+        fewest = std::min(fewest, needCount(a));
+    }
+    std::ostringstream text;
+    text << (source.empty() ? std::string("graph") : source) << ": " << agentCount() << " agents, "
+         << resources << " resources, " << fewest;
+    if (maxNeeds() != fewest) {
+        text << "-" << maxNeeds();
+    }
+    text << " per agent, up to " << maxUsers() << " users";
+    return text.str();
+}
@@ -0,0 +1,166 @@
+/**
+ * @file ResourceGraph.h
+ * @brief Header file for the agent -> shared-resource requirement graph
+ *
+ * This file defines the table layout used by DiningPhilosophers. Agent i
+ * needs a set of shared resources (forks). It must hold all of them at once
+ * to eat, and it releases them when it stops:
+ *
+ * - ring(n): the classic table, where philosopher i needs forks i and
+ *   (i + 1) % n
+ * - load(file): an arbitrary graph, one agent per line:
+ *
+ *       # agent: resources
+ *       0: 0 1 2
+ *       1: 2 3
+ *       2: 3 0 4
+ *
+ *   Agents must be numbered 0 to A-1 and listed once each, in any order.
+ *   Resources are numbered from 0; the resource count is the largest ID + 1,
+ *   so unused IDs become resources nobody needs. Agent and resource IDs may
+ *   not exceed MAX_ID, which bounds the arrays a file can make us allocate.
+ *   Blank lines and # comments are skipped.
+ *
+ * Both adjacency directions are stored flat (CSR: one offset array and one
+ * ID array), so a lookup in the hot loop is two index reads:
+ * - needs: the resources of an agent, in listed order (ring: left, right)
+ *   and in ascending order
+ * - users: the agents of a resource, in ascending order
+ *
+ * The graph is immutable once built, so concurrent readers need no locking.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef RESOURCE_GRAPH_H
+#define RESOURCE_GRAPH_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @class ResourceGraph
+ * @brief Which shared resources each agent needs (and which agents share each resource)
+ */
+class ResourceGraph {
+private:
+    std::vector<std::size_t> needOffsets;  ///< needs of agent a are [needOffsets[a], needOffsets[a + 1])
+    std::vector<int> listedNeeds;          ///< Resources of every agent, in listed order
+    std::vector<int> sortedNeeds;          ///< Resources of every agent, ascending
+    std::vector<std::size_t> userOffsets;  ///< users of resource r are [userOffsets[r], userOffsets[r + 1])
+    std::vector<int> users;                ///< Agents of every resource, ascending
+    int resources;                         ///< Number of resources
+    bool ringTopology;                     ///< true if built by ring()
+    std::string source;                    ///< File the graph was loaded from ("" for ring())
+
+    /**
+     * @brief Build every array from per-agent lists
+     * @param needs Resources of agent i at index i (validated by the caller)
+     * @param resourceCount Number of resources
+     */
+    void build(const std::vector<std::vector<int> >& needs, int resourceCount);
+
+public:
+    static const int MAX_ID = (1 << 20) - 1;  ///< Largest agent or resource ID (about a million of each)
+
+    /**
+     * @brief Constructor - creates an empty graph (no agents, no resources)
+     */
+    ResourceGraph();
+
+    /**
+     * @brief Create the classic round table
+     * @param agents Number of philosophers and forks (at least 2)
+     * @return Graph where agent i needs resources i and (i + 1) % agents
+     */
+    static ResourceGraph ring(int agents);
+
+    /**
+     * @brief Load a graph from a file ("agent: resource resource ..." per line)
+     * @param filename Path of the file
+     * @return true on success, false (with a message on std::cerr) on error
+     */
+    bool load(const std::string& filename);
+
+    /**
+     * @brief Build a graph from in-memory lists
+     * @param needs Resources of agent i at index i (non-empty, non-negative, no duplicates)
+     * @return true on success, false (with a message on std::cerr) on error
+     */
+    bool setNeeds(const std::vector<std::vector<int> >& needs);
+
+    /**
+     * @brief Get the number of agents
+     * @return Agent count
+     */
+    int agentCount() const;
+
+    /**
+     * @brief Get the number of resources
+     * @return Resource count
+     */
+    int resourceCount() const;
+
+    /**
+     * @brief Get the resources of an agent in listed order
+     * @param agent Agent ID
+     * @return First of needCount(agent) resource IDs
+     */
+    const int* listedNeedsOf(int agent) const;
+
+    /**
+     * @brief Get the resources of an agent in ascending order
+     * @param agent Agent ID
+     * @return First of needCount(agent) resource IDs
+     */
+    const int* sortedNeedsOf(int agent) const;
+
+    /**
+     * @brief Get the number of resources an agent needs
+     * @param agent Agent ID
+     * @return Resource count of the agent
+     */
+    std::size_t needCount(int agent) const;
+
+    /**
+     * @brief Get the agents that need a resource, in ascending order
+     * @param resource Resource ID
+     * @return First of userCount(resource) agent IDs
+     */
+    const int* usersOf(int resource) const;
+
+    /**
+     * @brief Get the number of agents that need a resource
+     * @param resource Resource ID
+     * @return User count of the resource
+     */
+    std::size_t userCount(int resource) const;
+
+    /**
+     * @brief Get the largest number of agents sharing one resource
+     * @return Maximum user count (0 for an empty graph)
+     */
+    std::size_t maxUsers() const;
+
+    /**
+     * @brief Get the largest number of resources one agent needs
+     * @return Maximum need count (0 for an empty graph)
+     */
+    std::size_t maxNeeds() const;
+
+    /**
+     * @brief Check whether this is the classic round table
+     * @return true if built by ring()
+     */
+    bool isRing() const;
+
+    /**
+     * @brief Describe the graph for statistics output
+     * @return e.g. "ring of 5" or "graph.txt: 12 agents, 8 resources, 2-4 per agent, up to 3 users"
+     */
+    std::string describe() const;
+};
+
+#endif // RESOURCE_GRAPH_H
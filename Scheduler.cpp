@@ -0,0 +1,238 @@
+/**
+ * @file Scheduler.cpp
+ * @brief Implementation of the CPU scheduling policies
+ *
+ * This file implements the ready queues used by the virtual-time engine:
+ * - FCFS and Round-Robin keep a FIFO deque
+ * - SJF, SRTF and Priority keep their ready set in a ReadyQueue sized to the
+ *   range of their key over the process table
+ *
+ * Schedulers are only used from the single simulation thread, so no locking
+ * is required.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "Scheduler.h"
+#include "ProcessTable.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Create a ready queue sized to the values a key column can take
+ * @param type Ready queue implementation
+ * @param table Process table
+ * @param column Column the key is taken from
+ * @param fromZero Start the key range at 0 (SRTF keys shrink as processes run)
+ * @return Newly allocated queue
+ */
+std::unique_ptr<ReadyQueue> columnQueue(ReadyQueueType type, const ProcessTable& table,
+                                        const std::vector<int>& column, bool fromZero) {
+    int lo = 0;
+    int hi = 0;
+    if (!column.empty()) {
+        auto range = std::minmax_element(column.begin(), column.end());
+        lo = fromZero ? std::min(0, *range.first) : *range.first;
+        hi = *range.second;
+    }
+    return createReadyQueue(type, table.size(), lo, hi);
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Scheduler (base)
+// ---------------------------------------------------------------------------
+
+Scheduler::Scheduler(const ProcessTable& table) : table(table) {
+}
+
+Scheduler::~Scheduler() {
+}
+
+/**
+ * @brief Default time slice - run until the burst completes
+ * @return 0 (no quantum)
+ */
+long long Scheduler::timeSlice() const {
+    return 0;
+}
+
+/**
+ * @brief Default preemption rule - never preempt
+ * @return false
+ */
+bool Scheduler::shouldPreempt(std::size_t, long long, std::size_t, long long) const {
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// FCFS
+// ---------------------------------------------------------------------------
+
+FcfsScheduler::FcfsScheduler(const ProcessTable& table) : Scheduler(table) {
+}
+
+const char* FcfsScheduler::name() const {
+    return "FCFS";
+}
+
+void FcfsScheduler::addReady(std::size_t index, long long) {
+    readyQueue.push_back(index);
+}
+
+bool FcfsScheduler::empty() const {
+    return readyQueue.empty();
+}
+
+std::size_t FcfsScheduler::pickNext() {
+    std::size_t index = readyQueue.front();
+    readyQueue.pop_front();
+    return index;
+}
+
+// ---------------------------------------------------------------------------
+// Round-Robin
+// ---------------------------------------------------------------------------
+
+RoundRobinScheduler::RoundRobinScheduler(const ProcessTable& table, long long quantum)
+    : FcfsScheduler(table), quantum(quantum) {
+}
+
+const char* RoundRobinScheduler::name() const {
+    return "Round-Robin";
+}
+
+/**
+ * @brief Round-Robin grants at most one quantum per dispatch
+ * @return The configured quantum
+ */
+long long RoundRobinScheduler::timeSlice() const {
+    return quantum;
+}
+
+// ---------------------------------------------------------------------------
+// Keyed schedulers (SJF, SRTF, Priority)
+// ---------------------------------------------------------------------------
+
+KeyedScheduler::KeyedScheduler(const ProcessTable& table, std::unique_ptr<ReadyQueue> ready)
+    : Scheduler(table), ready(std::move(ready)) {
+}
+
+void KeyedScheduler::addReady(std::size_t index, long long remaining) {
+    ready->push(static_cast<std::uint32_t>(index), keyFor(index, remaining));
+}
+
+bool KeyedScheduler::empty() const {
+    return ready->empty();
+}
+
+/**
+ * @brief Remove and return the ready process with the smallest key
+ *
+ * Equal keys leave in ready order, so equal keys behave like FCFS.
+ *
+ * @return Process index
+ */
+std::size_t KeyedScheduler::pickNext() {
+    return ready->popMin();
+}
+
+SjfScheduler::SjfScheduler(const ProcessTable& table, ReadyQueueType type)
+    : KeyedScheduler(table, columnQueue(type, table, table.burstTime, false)) {
+}
+
+const char* SjfScheduler::name() const {
+    return "SJF";
+}
+
+int SjfScheduler::keyFor(std::size_t index, long long) const {
+    return table.burstTime[index];
+}
+
+SrtfScheduler::SrtfScheduler(const ProcessTable& table, ReadyQueueType type)
+    : KeyedScheduler(table, columnQueue(type, table, table.burstTime, true)) {
+}
+
+const char* SrtfScheduler::name() const {
+    return "SRTF";
+}
+
+int SrtfScheduler::keyFor(std::size_t, long long remaining) const {
+    return static_cast<int>(remaining);
+}
+
+/**
+ * @brief SRTF preempts when the newcomer needs strictly less time
+ * @return true if candidateRemaining < runningRemaining
+ */
+bool SrtfScheduler::shouldPreempt(std::size_t, long long candidateRemaining,
+                                  std::size_t, long long runningRemaining) const {
+    return candidateRemaining < runningRemaining;
+}
+
+PriorityScheduler::PriorityScheduler(const ProcessTable& table, ReadyQueueType type)
+    : KeyedScheduler(table, columnQueue(type, table, table.priority, false)) {
+}
+
+const char* PriorityScheduler::name() const {
+    return "Priority";
+}
+
+int PriorityScheduler::keyFor(std::size_t index, long long) const {
+    return table.priority[index];
+}
+
+// ---------------------------------------------------------------------------
+// Factory and name helpers
+// ---------------------------------------------------------------------------
+
+std::unique_ptr<Scheduler> createScheduler(SchedulingPolicy policy,
+                                           const ProcessTable& table,
+                                           long long quantum,
+                                           ReadyQueueType readyQueue) {
+    switch (policy) {
+        case SchedulingPolicy::SJF:
+            return std::unique_ptr<Scheduler>(new SjfScheduler(table, readyQueue));
+        case SchedulingPolicy::SRTF:
+            return std::unique_ptr<Scheduler>(new SrtfScheduler(table, readyQueue));
+        case SchedulingPolicy::RoundRobin:
+            return std::unique_ptr<Scheduler>(new RoundRobinScheduler(table, quantum));
+        case SchedulingPolicy::Priority:
+            return std::unique_ptr<Scheduler>(new PriorityScheduler(table, readyQueue));
+        case SchedulingPolicy::FCFS:
+        default:
+            return std::unique_ptr<Scheduler>(new FcfsScheduler(table));
+    }
+}
+
+bool parseSchedulingPolicy(const std::string& name, SchedulingPolicy& policy) {
+    if (name == "fcfs") {
+        policy = SchedulingPolicy::FCFS;
+    } else if (name == "sjf") {
+        policy = SchedulingPolicy::SJF;
+    } else if (name == "srtf") {
+        policy = SchedulingPolicy::SRTF;
+    } else if (name == "rr") {
+        policy = SchedulingPolicy::RoundRobin;
+    } else if (name == "priority") {
+        policy = SchedulingPolicy::Priority;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* schedulingPolicyName(SchedulingPolicy policy) {
+    switch (policy) {
+        case SchedulingPolicy::SJF:        return "SJF";
+        case SchedulingPolicy::SRTF:       return "SRTF";
+        case SchedulingPolicy::RoundRobin: return "Round-Robin";
+        case SchedulingPolicy::Priority:   return "Priority";
+        case SchedulingPolicy::FCFS:
+        default:                           return "FCFS";
+    }
+}
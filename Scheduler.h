@@ -0,0 +1,256 @@
+/**
+ * @file Scheduler.h
+ * @brief Header file for the CPU scheduling policies
+ *
+ * This file defines the Scheduler interface used by the virtual-time engine of
+ * ProcessSimulator to decide which ready process runs next on an idle
+ * simulated CPU, how long it may run, and whether a newly ready process may
+ * preempt a running one.
+ *
+ * Supported policies:
+ * - FCFS:        First-come, first-served (non-preemptive)
+ * - SJF:         Shortest job first by burst time (non-preemptive)
+ * - SRTF:        Shortest remaining time first (preemptive SJF)
+ * - Round-Robin: FIFO with a fixed time quantum
+ * - Priority:    Lowest priority value first (non-preemptive)
+ *
+ * Ties are always broken by the order in which processes became ready.
+ *
+ * Schedulers read process fields from the run's ProcessTable (one array per
+ * field), so the keyed policies touch only the column they sort by. The keyed
+ * policies keep their ready set in a ReadyQueue of the chosen type (linear
+ * scan, 4-ary heap, pairing heap or key buckets); every type picks the same
+ * process, so the choice only changes the simulation's speed.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include "ReadyQueue.h"
+
+struct ProcessTable;
+
+/**
+ * @enum SchedulingPolicy
+ * @brief CPU scheduling algorithms available to ProcessSimulator
+ */
+enum class SchedulingPolicy {
+    FCFS,        ///< First-come, first-served
+    SJF,         ///< Shortest job first (non-preemptive)
+    SRTF,        ///< Shortest remaining time first (preemptive)
+    RoundRobin,  ///< Round-Robin with a configurable time quantum
+    Priority     ///< Lowest priority value first (non-preemptive)
+};
+
+/**
+ * @class Scheduler
+ * @brief Interface for a ready queue with a scheduling policy
+ *
+ * Processes are identified by their index in the process table.
+ */
+class Scheduler {
+protected:
+    const ProcessTable& table;  ///< Process table owned by the virtual-time engine
+
+public:
+    /**
+     * @brief Constructor
+     * @param table Process table the indices refer to
+     */
+    explicit Scheduler(const ProcessTable& table);
+
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~Scheduler();
+
+    /**
+     * @brief Human-readable policy name
+     * @return Policy name (e.g., "SRTF")
+     */
+    virtual const char* name() const = 0;
+
+    /**
+     * @brief Add a process to the ready queue
+     * @param index Process index
+     * @param remaining Remaining burst time of the process
+     */
+    virtual void addReady(std::size_t index, long long remaining) = 0;
+
+    /**
+     * @brief Check whether any process is ready
+     * @return true if the ready queue is empty
+     */
+    virtual bool empty() const = 0;
+
+    /**
+     * @brief Remove and return the process that should run next
+     * @return Process index (the ready queue must not be empty)
+     */
+    virtual std::size_t pickNext() = 0;
+
+    /**
+     * @brief Maximum time a dispatched process may run before being preempted
+     * @return Time slice, or 0 to run until the burst completes
+     */
+    virtual long long timeSlice() const;
+
+    /**
+     * @brief Decide whether a newly ready process should preempt a running one
+     * @param candidate Index of the newly ready process
+     * @param candidateRemaining Remaining burst time of the candidate
+     * @param running Index of the running process
+     * @param runningRemaining Remaining burst time of the running process
+     * @return true if the running process should be preempted
+     */
+    virtual bool shouldPreempt(std::size_t candidate, long long candidateRemaining,
+                               std::size_t running, long long runningRemaining) const;
+
+private:
+    Scheduler(const Scheduler&) = delete;             ///< Non-copyable
+    Scheduler& operator=(const Scheduler&) = delete;  ///< Non-assignable
+};
+
+/**
+ * @class FcfsScheduler
+ * @brief First-come, first-served: a plain FIFO ready queue
+ */
+class FcfsScheduler : public Scheduler {
+protected:
+    std::deque<std::size_t> readyQueue;  ///< Ready processes in arrival order
+
+public:
+    explicit FcfsScheduler(const ProcessTable& table);
+    const char* name() const override;
+    void addReady(std::size_t index, long long remaining) override;
+    bool empty() const override;
+    std::size_t pickNext() override;
+};
+
+/**
+ * @class RoundRobinScheduler
+ * @brief FIFO ready queue with a fixed time quantum
+ */
+class RoundRobinScheduler : public FcfsScheduler {
+private:
+    long long quantum;  ///< Time slice granted per dispatch
+
+public:
+    RoundRobinScheduler(const ProcessTable& table, long long quantum);
+    const char* name() const override;
+    long long timeSlice() const override;
+};
+
+/**
+ * @class KeyedScheduler
+ * @brief Ready queue that always picks the entry with the smallest key
+ *
+ * Subclasses define the key and its range over the table. The ready set is
+ * a ReadyQueue, which returns the smallest key and, among equal keys, the
+ * process that became ready first. Keys are fixed while a process is queued
+ * (SRTF re-adds a preempted process with its new remaining time), so no
+ * queue needs a decrease-key operation.
+ */
+class KeyedScheduler : public Scheduler {
+protected:
+    std::unique_ptr<ReadyQueue> ready;  ///< Ready processes by key (smaller runs first)
+
+    /**
+     * @brief Compute the scheduling key of a process
+     * @param index Process index
+     * @param remaining Remaining burst time
+     * @return Key (smaller runs first)
+     */
+    virtual int keyFor(std::size_t index, long long remaining) const = 0;
+
+public:
+    /**
+     * @brief Constructor
+     * @param table Process table the indices refer to
+     * @param ready Empty ready queue sized for the subclass's keys
+     */
+    KeyedScheduler(const ProcessTable& table, std::unique_ptr<ReadyQueue> ready);
+    void addReady(std::size_t index, long long remaining) override;
+    bool empty() const override;
+    std::size_t pickNext() override;
+};
+
+/**
+ * @class SjfScheduler
+ * @brief Shortest job first: smallest total burst time runs next
+ */
+class SjfScheduler : public KeyedScheduler {
+protected:
+    int keyFor(std::size_t index, long long remaining) const override;
+
+public:
+    SjfScheduler(const ProcessTable& table, ReadyQueueType type);
+    const char* name() const override;
+};
+
+/**
+ * @class SrtfScheduler
+ * @brief Shortest remaining time first, preempting longer running processes
+ */
+class SrtfScheduler : public KeyedScheduler {
+protected:
+    int keyFor(std::size_t index, long long remaining) const override;
+
+public:
+    SrtfScheduler(const ProcessTable& table, ReadyQueueType type);
+    const char* name() const override;
+    bool shouldPreempt(std::size_t candidate, long long candidateRemaining,
+                       std::size_t running, long long runningRemaining) const override;
+};
+
+/**
+ * @class PriorityScheduler
+ * @brief Lowest priority value runs next (non-preemptive)
+ */
+class PriorityScheduler : public KeyedScheduler {
+protected:
+    int keyFor(std::size_t index, long long remaining) const override;
+
+public:
+    PriorityScheduler(const ProcessTable& table, ReadyQueueType type);
+    const char* name() const override;
+};
+
+/**
+ * @brief Create a scheduler for the given policy
+ * @param policy Scheduling policy
+ * @param table Process table the indices refer to
+ * @param quantum Time quantum (used by Round-Robin only)
+ * @param readyQueue Ready queue of SJF, SRTF and Priority (FCFS and Round-Robin use a FIFO)
+ * @return Newly allocated scheduler
+ */
+std::unique_ptr<Scheduler> createScheduler(SchedulingPolicy policy,
+                                           const ProcessTable& table,
+                                           long long quantum,
+                                           ReadyQueueType readyQueue = ReadyQueueType::Scan);
+
+/**
+ * @brief Parse a policy name ("fcfs", "sjf", "srtf", "rr", "priority")
+ * @param name Policy name (case-sensitive, lowercase)
+ * @param policy Receives the parsed policy
+ * @return true if the name was recognised
+ */
+bool parseSchedulingPolicy(const std::string& name, SchedulingPolicy& policy);
+
+/**
+ * @brief Get the display name of a policy
+ * @param policy Scheduling policy
+ * @return Policy name (e.g., "Round-Robin")
+ */
+const char* schedulingPolicyName(SchedulingPolicy policy);
+
+#endif // SCHEDULER_H
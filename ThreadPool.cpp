@@ -0,0 +1,220 @@
+/**
+ * @file ThreadPool.cpp
+ * @brief Implementation of the ThreadPool class
+ *
+ * This file implements a fixed-size worker pool:
+ * - A bounded set of worker threads is created once in the constructor
+ * - Tasks are pushed onto a shared FIFO queue by submit()
+ * - The queue is a power-of-two ring buffer that doubles when full and never
+ *   shrinks, so the steady state allocates nothing
+ * - Idle workers block on a condition variable until work arrives
+ * - wait() blocks until the queue is drained and no task is running
+ *
+ * Thread Safety:
+ * - The task queue and bookkeeping counters are protected by queueMutex (CRITICAL SECTION)
+ * - Tasks themselves run outside the lock so workers execute concurrently
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "ThreadPool.h"
+#include "CpuTopology.h"
+#include <utility>
+
+const std::size_t ThreadPool::INITIAL_CAPACITY;
+
+/**
+ * @brief Constructor - starts the worker threads
+ *
+ * Workers are started immediately and block until tasks are submitted.
+ * A pinned worker binds itself to its CPU before taking the first task.
+ *
+ * @param numThreads Number of workers (0 selects defaultThreadCount())
+ * @param cpus CPU of worker i at index i % size (empty leaves workers unpinned)
+ */
+ThreadPool::ThreadPool(unsigned int numThreads, const std::vector<int>& cpus)
+    : tasks(INITIAL_CAPACITY), head(0), queued(0),
+      pending(0), stopping(false), tasksExecuted(0), maxQueueDepth(0) {
+    if (numThreads == 0) {
+        numThreads = defaultThreadCount();
+    }
+
+    workers.reserve(numThreads);
+    for (unsigned int i = 0; i < numThreads; i++) {
+        int cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+        workers.push_back(std::thread([this, cpu] {
+            if (cpu >= 0) {
+                pinCurrentThread(cpu);
+            }
+            workerLoop(this);
+        }));
+    }
+}
+
+/**
+ * @brief Destructor - waits for queued tasks and joins all workers
+ *
+ * Any tasks still in the queue are run to completion before the workers exit.
+ */
+ThreadPool::~ThreadPool() {
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Default worker count for this machine
+ *
+ * std::thread::hardware_concurrency() may return 0 when the value is not
+ * computable, in which case a single worker is used.
+ *
+ * @return Number of hardware threads, at least 1
+ */
+unsigned int ThreadPool::defaultThreadCount() {
+    unsigned int count = std::thread::hardware_concurrency();
+    return (count == 0) ? 1 : count;
+}
+
+/**
+ * @brief Get the number of worker threads
+ * @return Worker count
+ */
+unsigned int ThreadPool::size() const {
+    return static_cast<unsigned int>(workers.size());
+}
+
+/**
+ * @brief Get the pool's counters
+ *
+ * There is no stealing in a single shared queue, so only tasksExecuted and
+ * maxQueueDepth are non-zero.
+ *
+ * @return Statistics since the pool was created
+ */
+ExecutorStats ThreadPool::getStats() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    ExecutorStats result = { tasksExecuted, 0, 0, 0, maxQueueDepth };
+    return result;
+}
+
+/**
+ * @brief Get the display name of the pool implementation
+ * @return "Global queue"
+ */
+const char* ThreadPool::name() const {
+    return "Global queue";
+}
+
+/**
+ * @brief Queue a task for execution on one of the workers
+ *
+ * CRITICAL SECTION: The task is appended under queueMutex and one idle
+ * worker is woken up.
+ *
+ * @param task Callable to run
+ */
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        pushTask(std::move(task));
+        pending++;
+        if (queued > maxQueueDepth) {
+            maxQueueDepth = queued;
+        }
+    }
+    taskAvailable.notify_one();
+}
+
+/**
+ * @brief Append a task to the ring, doubling it when full
+ *
+ * Growing moves the queued tasks to the front of the new ring in FIFO order.
+ *
+ * @param task Callable to queue
+ */
+void ThreadPool::pushTask(std::function<void()>&& task) {
+    std::size_t capacity = tasks.size();
+    if (queued == capacity) {
+        std::vector<std::function<void()>> grown(capacity * 2);
+        for (std::size_t i = 0; i < queued; i++) {
+            grown[i] = std::move(tasks[(head + i) & (capacity - 1)]);
+        }
+        tasks.swap(grown);
+        head = 0;
+        capacity *= 2;
+    }
+    tasks[(head + queued) & (capacity - 1)] = std::move(task);
+    queued++;
+}
+
+/**
+ * @brief Remove the oldest task from the ring
+ * @return The task
+ */
+std::function<void()> ThreadPool::popTask() {
+    std::function<void()> task = std::move(tasks[head]);
+    tasks[head] = nullptr;
+    head = (head + 1) & (tasks.size() - 1);
+    queued--;
+    return task;
+}
+
+/**
+ * @brief Block until all submitted tasks have completed
+ *
+ * Tasks submitted by other tasks while waiting are also waited for, since
+ * they are counted in pending before their parent task finishes.
+ */
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    allDone.wait(lock, [this] { return pending == 0; });
+}
+
+/**
+ * @brief Main loop executed by each worker thread
+ *
+ * Repeatedly takes the task at the front of the queue and runs it outside
+ * the lock. Exits once the pool is stopping and the queue is empty.
+ *
+ * @param pool Pointer to the owning ThreadPool
+ */
+void ThreadPool::workerLoop(ThreadPool* pool) {
+    for (;;) {
+        std::function<void()> task;
+
+        {
+            // CRITICAL SECTION BEGIN - take the next task from the queue
+            std::unique_lock<std::mutex> lock(pool->queueMutex);
+            pool->taskAvailable.wait(lock, [pool] { return pool->stopping || pool->queued != 0; });
+
+            if (pool->queued == 0) {
+                return;  // Stopping and nothing left to run
+            }
+
+            task = pool->popTask();
+            // CRITICAL SECTION END
+        }
+
+        task();
+
+        bool lastTask = false;
+        {
+            std::lock_guard<std::mutex> lock(pool->queueMutex);
+            pool->pending--;
+            pool->tasksExecuted++;
+            lastTask = (pool->pending == 0);
+        }
+        if (lastTask) {
+            pool->allDone.notify_all();
+        }
+    }
+}
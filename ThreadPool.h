@@ -0,0 +1,139 @@
+/**
+ * @file ThreadPool.h
+ * @brief Header file for the ThreadPool class
+ *
+ * This file defines a fixed-size worker pool. A bounded number of worker
+ * threads is created once and each worker repeatedly takes the next task from
+ * a shared FIFO queue. This replaces the "one std::thread per job" model, which
+ * exhausts thread handles and spends most of its time in thread creation and
+ * context switches when there are tens of thousands of jobs.
+ *
+ * Thread Safety:
+ * - The task queue is protected by queueMutex (CRITICAL SECTION)
+ * - Workers sleep on a condition variable while the queue is empty
+ * - submit() may be called from any thread, including from inside a task
+ *
+ * The queue is a ring buffer that only grows (doubling when full), so once it
+ * has reached the working depth, submitting and running tasks performs no
+ * queue allocations. (std::deque allocates and frees a block every few dozen
+ * pushes as the queue moves through memory.)
+ *
+ * ThreadPool is the GlobalQueue implementation of the Executor interface.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include "Executor.h"
+
+/**
+ * @class ThreadPool
+ * @brief Fixed-size executor that runs queued tasks on a set of worker threads
+ *
+ * Tasks are executed in submission (FIFO) order by whichever worker becomes
+ * free first. wait() blocks until every submitted task has finished.
+ */
+class ThreadPool : public Executor {
+private:
+    std::vector<std::thread> workers;             ///< Worker threads (created once in the constructor)
+    std::vector<std::function<void()>> tasks;     ///< Ring buffer of pending tasks (CRITICAL RESOURCE)
+    std::size_t head;                             ///< Ring index of the oldest queued task
+    std::size_t queued;                           ///< Number of queued tasks in the ring
+    mutable std::mutex queueMutex;                ///< Mutex protecting the ring, pending and stopping
+    std::condition_variable taskAvailable;        ///< Signalled when a task is queued or the pool stops
+    std::condition_variable allDone;              ///< Signalled when the last pending task finishes
+    std::size_t pending;                          ///< Number of queued plus running tasks
+    bool stopping;                                ///< Set by the destructor to release the workers
+    std::uint64_t tasksExecuted;                  ///< Tasks run to completion (guarded by queueMutex)
+    std::size_t maxQueueDepth;                    ///< Deepest the queue has been (guarded by queueMutex)
+
+public:
+    /**
+     * @brief Constructor - starts the worker threads
+     * @param numThreads Number of workers (0 selects defaultThreadCount())
+     * @param cpus CPU of worker i at index i % size (empty leaves workers unpinned)
+     */
+    explicit ThreadPool(unsigned int numThreads = 0, const std::vector<int>& cpus = std::vector<int>());
+
+    /**
+     * @brief Destructor - waits for queued tasks and joins all workers
+     */
+    ~ThreadPool() override;
+
+    /**
+     * @brief Queue a task for execution on one of the workers
+     * @param task Callable to run
+     */
+    void submit(std::function<void()> task) override;
+
+    /**
+     * @brief Block until all submitted tasks have completed
+     */
+    void wait() override;
+
+    /**
+     * @brief Get the number of worker threads
+     * @return Worker count
+     */
+    unsigned int size() const override;
+
+    /**
+     * @brief Get the pool's counters
+     * @return Tasks executed and the deepest the shared queue has been
+     */
+    ExecutorStats getStats() const override;
+
+    /**
+     * @brief Get the display name of the pool implementation
+     * @return "Global queue"
+     */
+    const char* name() const override;
+
+    /**
+     * @brief Default worker count for this machine
+     * @return std::thread::hardware_concurrency(), or 1 if it is unknown
+     */
+    static unsigned int defaultThreadCount();
+
+private:
+    ThreadPool(const ThreadPool&) = delete;             ///< Non-copyable
+    ThreadPool& operator=(const ThreadPool&) = delete;  ///< Non-assignable
+
+    static const std::size_t INITIAL_CAPACITY = 64;     ///< Ring slots allocated up front (power of two)
+
+    /**
+     * @brief Append a task to the ring, doubling it when full
+     *
+     * Caller must hold queueMutex.
+     *
+     * @param task Callable to queue
+     */
+    void pushTask(std::function<void()>&& task);
+
+    /**
+     * @brief Remove the oldest task from the ring
+     *
+     * Caller must hold queueMutex and the ring must not be empty.
+     *
+     * @return The task
+     */
+    std::function<void()> popTask();
+
+    /**
+     * @brief Main loop executed by each worker thread
+     * @param pool Pointer to the owning ThreadPool
+     */
+    static void workerLoop(ThreadPool* pool);
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,193 @@
+/**
+ * @file TimelineTrace.cpp
+ * @brief Implementation of the TimelineTrace class
+ *
+ * Output layout (one JSON object, events in track order):
+ * - "M" metadata events naming the trace process and each track
+ * - "X" complete events for spans, with ts/dur in microseconds
+ * - "s" / "f" flow events sharing an id per hand-over; "bp":"e" binds the
+ *   arrow head to the span enclosing the acquisition time
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "TimelineTrace.h"
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+const int TRACE_PID = 1;  ///< Trace process id used for every event
+
+/**
+ * @brief Write nanoseconds as microseconds with three decimals (no rounding)
+ */
+void writeMicros(std::ostream& out, std::int64_t ns) {
+    if (ns < 0) {
+        ns = 0;
+    }
+    std::int64_t fraction = ns % 1000;
+    out << ns / 1000 << '.' << static_cast<char>('0' + fraction / 100)
+        << static_cast<char>('0' + (fraction / 10) % 10) << static_cast<char>('0' + fraction % 10);
+}
+
+/**
+ * @brief Write a string as a JSON string literal
+ */
+void writeQuoted(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) >= 0x20) {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+/**
+ * @brief Constructor - creates an empty timeline
+ * @param name Label of the timeline
+ * @param flowResource Prefix of flow labels
+ */
+TimelineTrace::TimelineTrace(const std::string& name, const char* flowResource)
+    : processName(name), resourceName(flowResource) {}
+
+/**
+ * @brief Drop all events and create trackCount empty tracks
+ * @param trackCount Number of tracks
+ */
+void TimelineTrace::reset(std::size_t trackCount) {
+    tracks.clear();
+    tracks.resize(trackCount);
+}
+
+/**
+ * @brief Set the label of a track
+ * @param track Track index
+ * @param name Label
+ */
+void TimelineTrace::setTrackName(std::size_t track, const std::string& name) {
+    tracks[track].name = name;
+}
+
+/**
+ * @brief Record a span on a track
+ *
+ * Only the track's current writer may call this.
+ *
+ * @param track Track index
+ * @param name Span label (string literal)
+ * @param startNs Start time in nanoseconds
+ * @param endNs End time in nanoseconds
+ */
+void TimelineTrace::addSpan(std::size_t track, const char* name, std::int64_t startNs, std::int64_t endNs) {
+    Span span = { name, startNs, (endNs < startNs) ? startNs : endNs };
+    tracks[track].spans.push_back(span);
+}
+
+/**
+ * @brief Record a hand-over of a resource from one track to another
+ *
+ * Stored on toTrack, so only toTrack's writer touches the vector.
+ *
+ * @param fromTrack Releasing track
+ * @param fromNs Release time in nanoseconds
+ * @param toTrack Acquiring track
+ * @param toNs Acquisition time in nanoseconds
+ * @param resource Resource number
+ */
+void TimelineTrace::addFlow(std::size_t fromTrack, std::int64_t fromNs, std::size_t toTrack, std::int64_t toNs,
+                            int resource) {
+    Flow flow = { fromTrack, fromNs, toNs, resource };
+    tracks[toTrack].flows.push_back(flow);
+}
+
+/**
+ * @brief Get the number of tracks
+ * @return Track count
+ */
+std::size_t TimelineTrace::trackCount() const {
+    return tracks.size();
+}
+
+/**
+ * @brief Get the number of recorded spans and flows
+ * @return Events over all tracks
+ */
+std::size_t TimelineTrace::eventCount() const {
+    std::size_t count = 0;
+    for (const auto& track : tracks) {
+        count += track.spans.size() + track.flows.size();
+    }
+    return count;
+}
+
+/**
+ * @brief Write the timeline as a Chrome trace-event JSON file
+ *
+ * Track t becomes trace thread t + 1 (tid 0 is avoided because some viewers
+ * treat it specially). Flow ids are assigned in output order.
+ *
+ * @param path Output file (truncated)
+ * @return true on success, false on I/O error
+ */
+bool TimelineTrace::write(const std::string& path) const {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot create trace file " << path << std::endl;
+        return false;
+    }
+
+    file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << TRACE_PID << ",\"args\":{\"name\":";
+    writeQuoted(file, processName);
+    file << "}}";
+
+    for (std::size_t t = 0; t < tracks.size(); t++) {
+        file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << TRACE_PID << ",\"tid\":" << t + 1
+             << ",\"args\":{\"name\":";
+        writeQuoted(file, tracks[t].name);
+        file << "}}";
+        file << ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":" << TRACE_PID << ",\"tid\":" << t + 1
+             << ",\"args\":{\"sort_index\":" << t << "}}";
+    }
+
+    for (std::size_t t = 0; t < tracks.size(); t++) {
+        for (const Span& span : tracks[t].spans) {
+            file << ",\n{\"name\":\"" << span.name << "\",\"ph\":\"X\",\"pid\":" << TRACE_PID
+                 << ",\"tid\":" << t + 1 << ",\"ts\":";
+            writeMicros(file, span.startNs);
+            file << ",\"dur\":";
+            writeMicros(file, span.endNs - span.startNs);
+            file << "}";
+        }
+    }
+
+    std::uint64_t flowId = 0;
+    for (std::size_t t = 0; t < tracks.size(); t++) {
+        for (const Flow& flow : tracks[t].flows) {
+            flowId++;
+            file << ",\n{\"name\":\"" << resourceName << ' ' << flow.resource << "\",\"cat\":\"handoff\",\"ph\":\"s\""
+                 << ",\"id\":" << flowId << ",\"pid\":" << TRACE_PID << ",\"tid\":" << flow.fromTrack + 1 << ",\"ts\":";
+            writeMicros(file, flow.fromNs);
+            file << "}";
+            file << ",\n{\"name\":\"" << resourceName << ' ' << flow.resource << "\",\"cat\":\"handoff\",\"ph\":\"f\""
+                 << ",\"bp\":\"e\",\"id\":" << flowId << ",\"pid\":" << TRACE_PID << ",\"tid\":" << t + 1 << ",\"ts\":";
+            writeMicros(file, flow.toNs);
+            file << "}";
+        }
+    }
+
+    file << "\n]}\n";
+
+    if (!file) {
+        std::cerr << "Error: Failed to write trace file " << path << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file TimelineTrace.h
+ * @brief Header file for the TimelineTrace class
+ *
+ * This file defines a recorder for Chrome trace-event timelines (the JSON
+ * format loaded by chrome://tracing and the Perfetto UI). A run is drawn as:
+ *
+ * - One track (trace "thread") per process or philosopher
+ * - Spans ("X" complete events) on each track, e.g. think / wait / eat for a
+ *   philosopher or queued / run for a process
+ * - Flow arrows ("s" / "f" events) between tracks, e.g. from the philosopher
+ *   releasing a contended fork to the philosopher that acquires it next
+ *
+ * Events are kept in memory per track and written once at the end of the run
+ * by write(), so recording costs one vector append and no I/O.
+ *
+ * Thread Safety:
+ * - Each track must have a single writer at a time (the thread currently
+ *   running that process or philosopher); tracks themselves are independent,
+ *   so recording takes no lock
+ * - A flow is stored on its destination track and must be added by that
+ *   track's writer
+ * - reset() and write() must not run concurrently with recording
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef TIMELINE_TRACE_H
+#define TIMELINE_TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class TimelineTrace
+ * @brief Per-track span and flow recorder with a Chrome trace-event JSON writer
+ */
+class TimelineTrace {
+private:
+    /**
+     * @struct Span
+     * @brief A named interval on one track (nanoseconds since the run origin)
+     */
+    struct Span {
+        const char* name;      ///< Span label (string literal, not copied)
+        std::int64_t startNs;  ///< Start time
+        std::int64_t endNs;    ///< End time (>= startNs)
+    };
+
+    /**
+     * @struct Flow
+     * @brief An arrow from a point on another track to a point on this one
+     */
+    struct Flow {
+        std::size_t fromTrack;  ///< Track the arrow starts on
+        std::int64_t fromNs;    ///< Time the arrow starts
+        std::int64_t toNs;      ///< Time the arrow ends (on the owning track)
+        int resource;           ///< Resource handed over (e.g., fork index)
+    };
+
+    /**
+     * @struct Track
+     * @brief Events of one process or philosopher
+     */
+    struct Track {
+        std::string name;         ///< Track label (e.g., "PHIL 3")
+        std::vector<Span> spans;  ///< Spans in recording order
+        std::vector<Flow> flows;  ///< Flows ending on this track
+    };
+
+    std::string processName;    ///< Label of the whole timeline
+    const char* resourceName;   ///< Flow label prefix (e.g., "fork" gives "fork 3")
+    std::vector<Track> tracks;  ///< One track per process or philosopher
+
+public:
+    /**
+     * @brief Constructor - creates an empty timeline
+     * @param name Label of the timeline (shown as the trace process name)
+     * @param flowResource Prefix of flow labels, followed by the resource number
+     */
+    TimelineTrace(const std::string& name, const char* flowResource);
+
+    /**
+     * @brief Drop all events and create trackCount empty tracks
+     * @param trackCount Number of tracks
+     */
+    void reset(std::size_t trackCount);
+
+    /**
+     * @brief Set the label of a track
+     * @param track Track index
+     * @param name Label
+     */
+    void setTrackName(std::size_t track, const std::string& name);
+
+    /**
+     * @brief Record a span on a track
+     * @param track Track index
+     * @param name Span label (must outlive the TimelineTrace; use a string literal)
+     * @param startNs Start time in nanoseconds since the run origin
+     * @param endNs End time in nanoseconds since the run origin
+     */
+    void addSpan(std::size_t track, const char* name, std::int64_t startNs, std::int64_t endNs);
+
+    /**
+     * @brief Record a hand-over of a resource from one track to another
+     *
+     * Called by the writer of toTrack. The arrow is attached to the span that
+     * encloses fromNs on fromTrack and to the span that encloses toNs on
+     * toTrack.
+     *
+     * @param fromTrack Track that released the resource
+     * @param fromNs Release time in nanoseconds since the run origin
+     * @param toTrack Track that acquired the resource
+     * @param toNs Acquisition time in nanoseconds since the run origin
+     * @param resource Resource number (appended to the flow label)
+     */
+    void addFlow(std::size_t fromTrack, std::int64_t fromNs, std::size_t toTrack, std::int64_t toNs, int resource);
+
+    /**
+     * @brief Get the number of tracks
+     * @return Track count
+     */
+    std::size_t trackCount() const;
+
+    /**
+     * @brief Get the number of recorded spans and flows
+     * @return Events over all tracks
+     */
+    std::size_t eventCount() const;
+
+    /**
+     * @brief Write the timeline as a Chrome trace-event JSON file
+     * @param path Output file (truncated)
+     * @return true on success, false (with a message on std::cerr) on I/O error
+     */
+    bool write(const std::string& path) const;
+};
+
+#endif // TIMELINE_TRACE_H
@@ -0,0 +1,315 @@
+/**
+ * @file TraceFile.cpp
+ * @brief Implementation of the process trace file formats
+ *
+ * This file implements:
+ * - Detection, decoding and validation of the binary (column-wise) format
+ * - Writers for the binary and text formats
+ *
+ * All multi-byte fields are stored little-endian and are encoded/decoded byte
+ * by byte, so the files are portable between hosts of either endianness.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "TraceFile.h"
+#include "ProcessSimulator.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+/**
+ * @brief Decode a little-endian 32-bit value
+ */
+inline std::uint32_t readU32(const char* p) {
+    const unsigned char* b = reinterpret_cast<const unsigned char*>(p);
+    return static_cast<std::uint32_t>(b[0]) | (static_cast<std::uint32_t>(b[1]) << 8) |
+           (static_cast<std::uint32_t>(b[2]) << 16) | (static_cast<std::uint32_t>(b[3]) << 24);
+}
+
+/**
+ * @brief Decode a little-endian 64-bit value
+ */
+inline std::uint64_t readU64(const char* p) {
+    return static_cast<std::uint64_t>(readU32(p)) | (static_cast<std::uint64_t>(readU32(p + 4)) << 32);
+}
+
+/**
+ * @brief Encode a little-endian 32-bit value
+ */
+inline void writeU32(char* p, std::uint32_t value) {
+    p[0] = static_cast<char>(value & 0xFF);
+    p[1] = static_cast<char>((value >> 8) & 0xFF);
+    p[2] = static_cast<char>((value >> 16) & 0xFF);
+    p[3] = static_cast<char>((value >> 24) & 0xFF);
+}
+
+/**
+ * @brief Encode a little-endian 64-bit value
+ */
+inline void writeU64(char* p, std::uint64_t value) {
+    writeU32(p, static_cast<std::uint32_t>(value & 0xFFFFFFFFu));
+    writeU32(p + 4, static_cast<std::uint32_t>(value >> 32));
+}
+
+/**
+ * @brief Append the decimal form of an int to a buffer
+ */
+inline void appendInt(std::string& out, int value) {
+    char digits[12];
+    int length = 0;
+    long long v = value;
+    bool negative = (v < 0);
+    if (negative) {
+        v = -v;
+    }
+    do {
+        digits[length++] = static_cast<char>('0' + (v % 10));
+        v /= 10;
+    } while (v != 0);
+    if (negative) {
+        out.push_back('-');
+    }
+    while (length > 0) {
+        out.push_back(digits[--length]);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Check whether a buffer starts with the binary trace magic
+ * @param data File contents
+ * @param size Size of the contents in bytes
+ * @return true if the contents look like a binary trace
+ */
+bool isBinaryTrace(const char* data, std::size_t size) {
+    return size >= sizeof(TRACE_MAGIC) && std::memcmp(data, TRACE_MAGIC, sizeof(TRACE_MAGIC)) == 0;
+}
+
+/**
+ * @brief Decode and validate a binary trace
+ *
+ * 1. Check the header (magic, version, mandatory columns, size consistency)
+ * 2. Resize the output once, then fill it one column at a time
+ * 3. Validate every record with the text loader's rules
+ *
+ * @param data File contents
+ * @param size Size of the contents in bytes
+ * @param filename File name for error messages
+ * @param processes Receives the decoded processes (appended)
+ * @return true on success, false (with a message on std::cerr) on error
+ */
+bool parseBinaryTrace(const char* data, std::size_t size, const std::string& filename,
+                      std::vector<Process>& processes) {
+    if (size < TRACE_HEADER_SIZE || !isBinaryTrace(data, size)) {
+        std::cerr << "Error: Invalid binary trace header in file " << filename << std::endl;
+        return false;
+    }
+
+    std::uint32_t version = readU32(data + 4);
+    std::uint32_t columns = readU32(data + 8);
+    std::uint64_t count = readU64(data + 16);
+
+    if (version == 0 || version > TRACE_VERSION) {
+        std::cerr << "Error: Unsupported binary trace version " << version
+                  << " in file " << filename << std::endl;
+        return false;
+    }
+
+    if ((columns & TRACE_COLUMN_PID) == 0 || (columns & TRACE_COLUMN_BURST) == 0 ||
+        (columns & ~TRACE_COLUMNS_ALL) != 0) {
+        std::cerr << "Error: Invalid column mask in binary trace " << filename << std::endl;
+        return false;
+    }
+
+    std::size_t columnCount = 0;
+    for (std::uint32_t bit = TRACE_COLUMN_PID; bit <= TRACE_COLUMN_PRIORITY; bit <<= 1) {
+        columnCount += (columns & bit) ? 1 : 0;
+    }
+
+    if (count > (size - TRACE_HEADER_SIZE) / (4 * columnCount) ||
+        TRACE_HEADER_SIZE + count * 4 * columnCount != size) {
+        std::cerr << "Error: Binary trace " << filename << " is truncated or has trailing data ("
+                  << count << " records declared)" << std::endl;
+        return false;
+    }
+
+    std::size_t n = static_cast<std::size_t>(count);
+    std::size_t base = processes.size();
+    Process blank = { 0, 0, 0, 0 };
+    processes.resize(base + n, blank);
+
+    // Decode each present column with one sequential pass
+    const char* column = data + TRACE_HEADER_SIZE;
+    if (columns & TRACE_COLUMN_PID) {
+        for (std::size_t i = 0; i < n; i++) {
+            processes[base + i].pid = static_cast<int>(readU32(column + 4 * i));
+        }
+        column += 4 * n;
+    }
+    if (columns & TRACE_COLUMN_BURST) {
+        for (std::size_t i = 0; i < n; i++) {
+            processes[base + i].burstTime = static_cast<int>(readU32(column + 4 * i));
+        }
+        column += 4 * n;
+    }
+    if (columns & TRACE_COLUMN_ARRIVAL) {
+        for (std::size_t i = 0; i < n; i++) {
+            processes[base + i].arrivalTime = static_cast<int>(readU32(column + 4 * i));
+        }
+        column += 4 * n;
+    }
+    if (columns & TRACE_COLUMN_PRIORITY) {
+        for (std::size_t i = 0; i < n; i++) {
+            processes[base + i].priority = static_cast<int>(readU32(column + 4 * i));
+        }
+    }
+
+    // Same validation as the text format, reported by record number
+    for (std::size_t i = 0; i < n; i++) {
+        const Process& proc = processes[base + i];
+        const char* problem = nullptr;
+        int value = 0;
+        if (proc.pid <= 0) {
+            problem = "process ID";
+            value = proc.pid;
+        } else if (proc.burstTime <= 0) {
+            problem = "burst time";
+            value = proc.burstTime;
+        } else if (proc.arrivalTime < 0) {
+            problem = "arrival time";
+            value = proc.arrivalTime;
+        }
+
+        if (problem != nullptr) {
+            std::cerr << "Error: Invalid " << problem << " " << value
+                      << " at record " << (i + 1) << " in file " << filename << std::endl;
+            processes.resize(base);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Encode a binary trace header
+ * @param header Receives TRACE_HEADER_SIZE bytes
+ * @param columns TRACE_COLUMN_* bits of the columns that follow
+ * @param count Record count
+ */
+void encodeTraceHeader(char* header, std::uint32_t columns, std::uint64_t count) {
+    for (std::size_t i = 0; i < sizeof(TRACE_MAGIC); i++) {
+        header[i] = TRACE_MAGIC[i];
+    }
+    writeU32(header + 4, TRACE_VERSION);
+    writeU32(header + 8, columns);
+    writeU32(header + 12, 0);
+    writeU64(header + 16, count);
+    writeU64(header + 24, 0);
+}
+
+/**
+ * @brief Encode a run of one binary trace column
+ * @param values Column values
+ * @param count Number of values
+ * @param out Receives 4 * count bytes (little-endian)
+ */
+void encodeTraceColumn(const int* values, std::size_t count, char* out) {
+    for (std::size_t i = 0; i < count; i++) {
+        writeU32(out + 4 * i, static_cast<std::uint32_t>(values[i]));
+    }
+}
+
+/**
+ * @brief Append one record in the text trace format (with its newline)
+ * @param out Text buffer
+ * @param proc Record
+ */
+void appendTraceLine(std::string& out, const Process& proc) {
+    appendInt(out, proc.pid);
+    out.push_back(' ');
+    appendInt(out, proc.burstTime);
+    if (proc.arrivalTime != 0 || proc.priority != 0) {
+        out.push_back(' ');
+        appendInt(out, proc.arrivalTime);
+        if (proc.priority != 0) {
+            out.push_back(' ');
+            appendInt(out, proc.priority);
+        }
+    }
+    out.push_back('\n');
+}
+
+/**
+ * @brief Write processes in the binary trace format
+ *
+ * All four columns are written. The file is assembled in memory and written
+ * with a single call.
+ *
+ * @param filename Output path
+ * @param processes Processes to write
+ * @return true on success
+ */
+bool writeBinaryTrace(const std::string& filename, const std::vector<Process>& processes) {
+    std::size_t n = processes.size();
+    std::vector<char> image(TRACE_HEADER_SIZE + 16 * n, 0);
+    char* p = &image[0];
+
+    encodeTraceHeader(p, TRACE_COLUMNS_ALL, static_cast<std::uint64_t>(n));
+
+    char* pidColumn = p + TRACE_HEADER_SIZE;
+    char* burstColumn = pidColumn + 4 * n;
+    char* arrivalColumn = burstColumn + 4 * n;
+    char* priorityColumn = arrivalColumn + 4 * n;
+    for (std::size_t i = 0; i < n; i++) {
+        writeU32(pidColumn + 4 * i, static_cast<std::uint32_t>(processes[i].pid));
+        writeU32(burstColumn + 4 * i, static_cast<std::uint32_t>(processes[i].burstTime));
+        writeU32(arrivalColumn + 4 * i, static_cast<std::uint32_t>(processes[i].arrivalTime));
+        writeU32(priorityColumn + 4 * i, static_cast<std::uint32_t>(processes[i].priority));
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot create file " << filename << std::endl;
+        return false;
+    }
+    file.write(&image[0], static_cast<std::streamsize>(image.size()));
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief Write processes in the text trace format
+ *
+ * The arrival and priority columns are omitted on lines where both are 0, so
+ * a trace such as processes.txt round-trips unchanged.
+ *
+ * @param filename Output path
+ * @param processes Processes to write
+ * @return true on success
+ */
+bool writeTextTrace(const std::string& filename, const std::vector<Process>& processes) {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot create file " << filename << std::endl;
+        return false;
+    }
+
+    std::string chunk;
+    chunk.reserve(1 << 20);
+    for (const auto& proc : processes) {
+        appendTraceLine(chunk, proc);
+
+        // Write in large chunks to keep the number of write calls low
+        if (chunk.size() >= (1 << 20) - 64) {
+            file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            chunk.clear();
+        }
+    }
+    file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    return static_cast<bool>(file);
+}
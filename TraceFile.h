@@ -0,0 +1,123 @@
+/**
+ * @file TraceFile.h
+ * @brief Header file for the process trace file formats
+ *
+ * Two on-disk formats are supported for process traces:
+ *
+ * 1. Text (processes.txt): one "pid burstTime [arrivalTime [priority]]" per line
+ * 2. Binary (versioned, little-endian, column-wise):
+ *
+ *    Offset  Size  Field
+ *    0       4     magic "PSTR"
+ *    4       4     format version (currently 1)
+ *    8       4     column mask (TRACE_COLUMN_* bits present in the body)
+ *    12      4     reserved (0)
+ *    16      8     record count N
+ *    24      8     reserved (0)
+ *    32      ...   one int32[N] array per present column, in the order
+ *                  pid, burstTime, arrivalTime, priority
+ *
+ *    Columns missing from the mask default to 0 (pid and burstTime are
+ *    mandatory). Storing columns contiguously lets a loader copy each field
+ *    with a single sequential pass over one array.
+ *
+ * ProcessSimulator::loadProcesses() recognises the binary format by its magic,
+ * so either format can be passed wherever a trace file is expected.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef TRACE_FILE_H
+#define TRACE_FILE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+struct Process;
+
+static const char TRACE_MAGIC[4] = { 'P', 'S', 'T', 'R' };        ///< Binary trace magic bytes
+static const std::uint32_t TRACE_VERSION = 1;                      ///< Current binary format version
+static const std::size_t TRACE_HEADER_SIZE = 32;                   ///< Header size in bytes
+
+static const std::uint32_t TRACE_COLUMN_PID = 1u << 0;             ///< pid column present
+static const std::uint32_t TRACE_COLUMN_BURST = 1u << 1;           ///< burstTime column present
+static const std::uint32_t TRACE_COLUMN_ARRIVAL = 1u << 2;         ///< arrivalTime column present
+static const std::uint32_t TRACE_COLUMN_PRIORITY = 1u << 3;        ///< priority column present
+static const std::uint32_t TRACE_COLUMNS_ALL = TRACE_COLUMN_PID | TRACE_COLUMN_BURST |
+                                               TRACE_COLUMN_ARRIVAL | TRACE_COLUMN_PRIORITY;
+
+/**
+ * @brief Check whether a buffer starts with the binary trace magic
+ * @param data File contents
+ * @param size Size of the contents in bytes
+ * @return true if the contents look like a binary trace
+ */
+bool isBinaryTrace(const char* data, std::size_t size);
+
+/**
+ * @brief Decode and validate a binary trace
+ *
+ * Applies the same rules as the text loader (positive pid and burst time,
+ * non-negative arrival time) and reports errors with the record number.
+ *
+ * @param data File contents
+ * @param size Size of the contents in bytes
+ * @param filename File name for error messages
+ * @param processes Receives the decoded processes (appended)
+ * @return true on success, false (with a message on std::cerr) on error
+ */
+bool parseBinaryTrace(const char* data, std::size_t size, const std::string& filename,
+                      std::vector<Process>& processes);
+
+/**
+ * @brief Encode a binary trace header
+ *
+ * For writers that stream the columns themselves: column k (in mask order)
+ * of an N-record trace starts at TRACE_HEADER_SIZE + 4 * N * k.
+ *
+ * @param header Receives TRACE_HEADER_SIZE bytes
+ * @param columns TRACE_COLUMN_* bits of the columns that follow
+ * @param count Record count
+ */
+void encodeTraceHeader(char* header, std::uint32_t columns, std::uint64_t count);
+
+/**
+ * @brief Encode a run of one binary trace column
+ * @param values Column values
+ * @param count Number of values
+ * @param out Receives 4 * count bytes (little-endian)
+ */
+void encodeTraceColumn(const int* values, std::size_t count, char* out);
+
+/**
+ * @brief Append one record in the text trace format (with its newline)
+ *
+ * The arrival and priority columns are left out when they are 0, as in
+ * writeTextTrace().
+ *
+ * @param out Text buffer
+ * @param proc Record
+ */
+void appendTraceLine(std::string& out, const Process& proc);
+
+/**
+ * @brief Write processes in the binary trace format
+ * @param filename Output path
+ * @param processes Processes to write
+ * @return true on success
+ */
+bool writeBinaryTrace(const std::string& filename, const std::vector<Process>& processes);
+
+/**
+ * @brief Write processes in the text trace format ("pid burst arrival priority";
+ *        arrival and priority are left out on lines where both are 0)
+ * @param filename Output path
+ * @param processes Processes to write
+ * @return true on success
+ */
+bool writeTextTrace(const std::string& filename, const std::vector<Process>& processes);
+
+#endif // TRACE_FILE_H
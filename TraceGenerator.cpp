@@ -0,0 +1,404 @@
+/**
+ * @file TraceGenerator.cpp
+ * @brief Implementation of the synthetic process trace generator
+ *
+ * Every chunk has two generators: one for the inter-arrival gaps and one for
+ * burst times and priorities. prepare() only needs the gaps, so it runs the
+ * arrival generator alone, and generate() later replays the same gap
+ * sequence from the chunk's start time.
+ *
+ * Arrival times are floor(chunk start + running sum of gaps), where the
+ * running sum is computed in the same order in both passes. The last running
+ * sum of a chunk is therefore exactly the span that prepare() added to get
+ * the next chunk's start, so arrival times never decrease across a chunk
+ * boundary.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "TraceGenerator.h"
+#include "Executor.h"
+#include "Random.h"
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+const std::size_t TraceGenerator::CHUNK_RECORDS;
+
+namespace {
+
+/**
+ * @brief Derive the seed of one generator of one chunk
+ * @param seed Seed of the whole trace
+ * @param chunk Chunk index
+ * @param stream 0 = arrival gaps, 1 = bursts and priorities
+ * @return Seed for FastRandom (which mixes it further with splitmix64)
+ */
+inline std::uint64_t chunkSeed(std::uint64_t seed, std::size_t chunk, std::uint64_t stream) {
+    return seed ^ (0xD1B54A32D192ED03ull * (2 * static_cast<std::uint64_t>(chunk) + stream + 1));
+}
+
+/**
+ * @brief Draw an exponential value
+ * @param random Generator
+ * @param mean Mean of the distribution
+ * @return Value >= 0
+ */
+inline double exponential(FastRandom& random, double mean) {
+    return -mean * std::log(1.0 - random.uniformReal());
+}
+
+/**
+ * @brief Round a burst to whole time units, clamped to [1, INT_MAX]
+ */
+inline int toBurst(double value) {
+    if (!(value < static_cast<double>(INT_MAX))) {
+        return INT_MAX;
+    }
+    long long rounded = std::llround(value);
+    return (rounded < 1) ? 1 : static_cast<int>(rounded);
+}
+
+/**
+ * @brief Split "a:b:c" into its fields and parse each one as a number
+ * @param text Field text
+ * @param values Receives the numbers
+ * @return true if every field is a number
+ */
+bool parseNumbers(const std::string& text, std::vector<double>& values) {
+    values.clear();
+    std::size_t begin = 0;
+    while (begin <= text.size()) {
+        std::size_t end = text.find(':', begin);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::string field = text.substr(begin, end - begin);
+        char* parsed = nullptr;
+        double value = std::strtod(field.c_str(), &parsed);
+        if (field.empty() || *parsed != '\0' || !std::isfinite(value)) {
+            return false;
+        }
+        values.push_back(value);
+        begin = end + 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Format a parameter with up to six significant digits
+ */
+std::string formatNumber(double value) {
+    std::ostringstream text;
+    text << value;
+    return text.str();
+}
+
+} // namespace
+
+/**
+ * @brief Constructor - 1000 records arriving at time 0 with exp:5 bursts, no priorities, seed 1
+ */
+TraceGenerator::TraceGenerator() : count(1000), priorityLevels(0), seed(1) {
+    arrivals.pattern = ArrivalPattern::Zero;
+    arrivals.rate = 1.0;
+    arrivals.batch = 1.0;
+    bursts.shape = BurstShape::Exponential;
+    bursts.first = 5.0;
+    bursts.second = 0.0;
+    bursts.third = 0.0;
+}
+
+void TraceGenerator::setCount(std::uint64_t records) {
+    count = records;
+    chunkStart.clear();
+}
+
+std::uint64_t TraceGenerator::getCount() const {
+    return count;
+}
+
+void TraceGenerator::setArrivalModel(const ArrivalModel& model) {
+    arrivals = model;
+    chunkStart.clear();
+}
+
+void TraceGenerator::setBurstModel(const BurstModel& model) {
+    bursts = model;
+}
+
+void TraceGenerator::setPriorityLevels(int levels) {
+    priorityLevels = (levels > 0) ? levels : 0;
+}
+
+bool TraceGenerator::hasPriorities() const {
+    return priorityLevels > 0;
+}
+
+void TraceGenerator::setSeed(std::uint64_t newSeed) {
+    seed = newSeed;
+    chunkStart.clear();
+}
+
+std::size_t TraceGenerator::chunkCount() const {
+    return static_cast<std::size_t>((count + CHUNK_RECORDS - 1) / CHUNK_RECORDS);
+}
+
+std::size_t TraceGenerator::chunkSize(std::size_t chunk) const {
+    std::uint64_t first = static_cast<std::uint64_t>(chunk) * CHUNK_RECORDS;
+    std::uint64_t left = count - first;
+    return (left < CHUNK_RECORDS) ? static_cast<std::size_t>(left) : CHUNK_RECORDS;
+}
+
+/**
+ * @brief Draw the gap between a record and the previous one
+ *
+ * Bursty: each record starts a new batch with probability 1 / batch (so
+ * batch sizes are geometric with mean batch) and otherwise arrives with the
+ * previous one. Batches are Poisson with rate rate / batch. The decision
+ * needs no state from earlier records, so chunks stay independent.
+ *
+ * @param random Arrival generator of the chunk
+ * @return Gap in time units
+ */
+double TraceGenerator::drawGap(FastRandom& random) const {
+    switch (arrivals.pattern) {
+        case ArrivalPattern::Periodic:
+            return 1.0 / arrivals.rate;
+        case ArrivalPattern::Poisson:
+            return exponential(random, 1.0 / arrivals.rate);
+        case ArrivalPattern::Bursty:
+            if (random.uniformReal() * arrivals.batch >= 1.0) {
+                return 0.0;
+            }
+            return exponential(random, arrivals.batch / arrivals.rate);
+        case ArrivalPattern::Zero:
+        default:
+            return 0.0;
+    }
+}
+
+/**
+ * @brief Draw a burst time
+ * @param random Burst generator of the chunk
+ * @return Burst time in whole time units (>= 1)
+ */
+int TraceGenerator::drawBurst(FastRandom& random) const {
+    switch (bursts.shape) {
+        case BurstShape::Uniform:
+            return static_cast<int>(random.uniform(toBurst(bursts.first), toBurst(bursts.second)));
+        case BurstShape::Exponential:
+            return toBurst(exponential(random, bursts.first));
+        case BurstShape::Bimodal: {
+            double mean = (random.uniformReal() < bursts.third) ? bursts.second : bursts.first;
+            return toBurst(exponential(random, mean));
+        }
+        case BurstShape::Pareto:
+            return toBurst(bursts.first / std::pow(1.0 - random.uniformReal(), 1.0 / bursts.second));
+        case BurstShape::Constant:
+        default:
+            return toBurst(bursts.first);
+    }
+}
+
+/**
+ * @brief Compute the chunk start times (first pass, parallel)
+ *
+ * Each task sums the gaps of one chunk; the start times are then a
+ * sequential prefix sum over the chunks.
+ *
+ * @param executor Pool that runs one task per chunk
+ * @return true on success, false (with a message on std::cerr) if the
+ *         arrival times would not fit in an int
+ */
+bool TraceGenerator::prepare(Executor& executor) {
+    std::size_t chunks = chunkCount();
+    std::vector<double> spans(chunks, 0.0);
+    if (arrivals.pattern != ArrivalPattern::Zero) {
+        for (std::size_t c = 0; c < chunks; c++) {
+            executor.submit([this, &spans, c] {
+                FastRandom random(chunkSeed(seed, c, 0));
+                double span = 0.0;
+                for (std::size_t i = 0, n = chunkSize(c); i < n; i++) {
+                    span += drawGap(random);
+                }
+                spans[c] = span;
+            });
+        }
+        executor.wait();
+    }
+
+    chunkStart.assign(chunks + 1, 0.0);
+    for (std::size_t c = 0; c < chunks; c++) {
+        chunkStart[c + 1] = chunkStart[c] + spans[c];
+    }
+    if (chunkStart[chunks] >= static_cast<double>(INT_MAX)) {
+        std::cerr << "Error: Arrival times of " << count << " processes reach " << chunkStart[chunks]
+                  << ", beyond the int range of the trace formats; raise the arrival rate" << std::endl;
+        chunkStart.clear();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Generate one chunk (after prepare())
+ * @param chunk Chunk index
+ * @param out Receives the records (its buffers are reused)
+ */
+void TraceGenerator::generate(std::size_t chunk, TraceChunk& out) const {
+    std::size_t n = chunkSize(chunk);
+    out.first = static_cast<std::uint64_t>(chunk) * CHUNK_RECORDS;
+    out.pid.resize(n);
+    out.burstTime.resize(n);
+    out.arrivalTime.resize(n);
+    out.priority.resize(hasPriorities() ? n : 0);
+    out.burstSum = 0;
+
+    FastRandom arrivalRandom(chunkSeed(seed, chunk, 0));
+    FastRandom burstRandom(chunkSeed(seed, chunk, 1));
+    double start = chunkStart[chunk];
+    double offset = 0.0;
+    for (std::size_t i = 0; i < n; i++) {
+        offset += drawGap(arrivalRandom);
+        out.pid[i] = static_cast<int>(out.first + i + 1);
+        out.arrivalTime[i] = static_cast<int>(std::floor(start + offset));
+        out.burstTime[i] = drawBurst(burstRandom);
+        out.burstSum += static_cast<std::uint64_t>(out.burstTime[i]);
+        if (hasPriorities()) {
+            out.priority[i] = static_cast<int>(burstRandom.uniform(0, priorityLevels - 1));
+        }
+    }
+}
+
+double TraceGenerator::getSpan() const {
+    return chunkStart.empty() ? 0.0 : chunkStart.back();
+}
+
+/**
+ * @brief Describe the configuration
+ * @return e.g. "1000000 processes, arrivals poisson:0.5, bursts exp:2, 4 priority levels, seed 1"
+ */
+std::string TraceGenerator::describe() const {
+    std::ostringstream text;
+    text << count << " processes, arrivals " << describeArrivalModel(arrivals) << ", bursts "
+         << describeBurstModel(bursts) << ", ";
+    if (hasPriorities()) {
+        text << priorityLevels << " priority levels";
+    } else {
+        text << "no priorities";
+    }
+    text << ", seed " << seed;
+    return text.str();
+}
+
+bool parseArrivalModel(const std::string& spec, ArrivalModel& model) {
+    std::size_t colon = spec.find(':');
+    std::string kind = spec.substr(0, colon);
+    std::vector<double> values;
+    bool numbers = (colon != std::string::npos) && parseNumbers(spec.substr(colon + 1), values);
+
+    if (kind == "zero" && colon == std::string::npos) {
+        model.pattern = ArrivalPattern::Zero;
+        model.rate = 1.0;
+        model.batch = 1.0;
+        return true;
+    }
+    if (kind == "periodic" && numbers && values.size() == 1 && values[0] > 0.0) {
+        model.pattern = ArrivalPattern::Periodic;
+        model.rate = 1.0 / values[0];
+        model.batch = 1.0;
+        return true;
+    }
+    if (kind == "poisson" && numbers && values.size() == 1 && values[0] > 0.0) {
+        model.pattern = ArrivalPattern::Poisson;
+        model.rate = values[0];
+        model.batch = 1.0;
+        return true;
+    }
+    if (kind == "bursty" && numbers && values.size() == 2 && values[0] > 0.0 && values[1] >= 1.0) {
+        model.pattern = ArrivalPattern::Bursty;
+        model.rate = values[0];
+        model.batch = values[1];
+        return true;
+    }
+
+    std::cerr << "Error: Invalid arrival pattern '" << spec
+              << "' (expected zero, periodic:GAP, poisson:RATE or bursty:RATE:BATCH;"
+              << " GAP and RATE > 0, BATCH >= 1)" << std::endl;
+    return false;
+}
+
+std::string describeArrivalModel(const ArrivalModel& model) {
+    switch (model.pattern) {
+        case ArrivalPattern::Periodic:
+            return "periodic:" + formatNumber(1.0 / model.rate);
+        case ArrivalPattern::Poisson:
+            return "poisson:" + formatNumber(model.rate);
+        case ArrivalPattern::Bursty:
+            return "bursty:" + formatNumber(model.rate) + ":" + formatNumber(model.batch);
+        case ArrivalPattern::Zero:
+        default:
+            return "zero";
+    }
+}
+
+bool parseBurstModel(const std::string& spec, BurstModel& model) {
+    std::size_t colon = spec.find(':');
+    std::string kind = spec.substr(0, colon);
+    std::vector<double> values;
+    if (colon != std::string::npos && parseNumbers(spec.substr(colon + 1), values)) {
+        std::size_t given = values.size();
+        values.resize(3, 0.0);
+        model.first = values[0];
+        model.second = values[1];
+        model.third = values[2];
+
+        if (kind == "constant" && given == 1 && model.first >= 1.0) {
+            model.shape = BurstShape::Constant;
+            return true;
+        }
+        if (kind == "uniform" && given == 2 && model.first >= 1.0 && model.second >= model.first) {
+            model.shape = BurstShape::Uniform;
+            return true;
+        }
+        if ((kind == "exp" || kind == "exponential") && given == 1 && model.first > 0.0) {
+            model.shape = BurstShape::Exponential;
+            return true;
+        }
+        if (kind == "bimodal" && given == 3 && model.first > 0.0 && model.second > 0.0 &&
+            model.third >= 0.0 && model.third <= 1.0) {
+            model.shape = BurstShape::Bimodal;
+            return true;
+        }
+        if (kind == "pareto" && given == 2 && model.first >= 1.0 && model.second > 0.0) {
+            model.shape = BurstShape::Pareto;
+            return true;
+        }
+    }
+
+    std::cerr << "Error: Invalid burst distribution '" << spec
+              << "' (expected constant:N, uniform:MIN:MAX, exp:MEAN, bimodal:SHORT:LONG:P"
+              << " or pareto:MIN:ALPHA)" << std::endl;
+    return false;
+}
+
+std::string describeBurstModel(const BurstModel& model) {
+    switch (model.shape) {
+        case BurstShape::Uniform:
+            return "uniform:" + formatNumber(model.first) + ":" + formatNumber(model.second);
+        case BurstShape::Exponential:
+            return "exp:" + formatNumber(model.first);
+        case BurstShape::Bimodal:
+            return "bimodal:" + formatNumber(model.first) + ":" + formatNumber(model.second) + ":" +
+                   formatNumber(model.third);
+        case BurstShape::Pareto:
+            return "pareto:" + formatNumber(model.first) + ":" + formatNumber(model.second);
+        case BurstShape::Constant:
+        default:
+            return "constant:" + formatNumber(model.first);
+    }
+}
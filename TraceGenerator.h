@@ -0,0 +1,262 @@
+/**
+ * @file TraceGenerator.h
+ * @brief Header file for the synthetic process trace generator
+ *
+ * This file defines a seeded, deterministic generator of large process
+ * workloads (millions to hundreds of millions of records) for the
+ * ProcessSimulator trace formats.
+ *
+ * Arrival patterns (ArrivalModel, times in trace time units):
+ * - zero:               every process arrives at time 0
+ * - periodic:GAP        one arrival every GAP time units
+ * - poisson:RATE        Poisson arrivals, RATE processes per time unit
+ * - bursty:RATE:BATCH   compound Poisson: batches of geometrically
+ *                       distributed size (mean BATCH) arrive together, RATE
+ *                       processes per time unit overall
+ *
+ * Burst time distributions (BurstModel, rounded to whole time units >= 1):
+ * - constant:N          always N
+ * - uniform:MIN:MAX     uniform integers in [MIN, MAX]
+ * - exp:MEAN            exponential with the given mean
+ * - bimodal:SHORT:LONG:P  exponential with mean LONG with probability P,
+ *                       otherwise with mean SHORT (interactive vs batch jobs)
+ * - pareto:MIN:ALPHA    Pareto (heavy-tailed) with scale MIN and shape ALPHA
+ *
+ * Priorities are optional: with L levels each process gets a uniform
+ * priority in [0, L-1]; with none the priority column is left out.
+ *
+ * Determinism and parallelism: the records are cut into fixed chunks of
+ * CHUNK_RECORDS, and every chunk draws from its own generators seeded from
+ * (seed, chunk). A chunk can therefore be generated by any thread, in any
+ * order, with the same result for any thread count. Arrival times are a
+ * running sum across chunks, so prepare() first sums each chunk's
+ * inter-arrival gaps in parallel and turns them into chunk start times; each
+ * generate() call then redraws its gaps from that start.
+ *
+ * Thread Safety:
+ * - After prepare(), generate() only reads the generator and may run
+ *   concurrently for different chunks
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef TRACE_GENERATOR_H
+#define TRACE_GENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Executor;
+class FastRandom;
+
+/**
+ * @enum ArrivalPattern
+ * @brief Shapes of the arrival process
+ */
+enum class ArrivalPattern {
+    Zero,      ///< Everything arrives at time 0
+    Periodic,  ///< Fixed gap between arrivals
+    Poisson,   ///< Exponential gaps
+    Bursty     ///< Exponential gaps between geometrically sized batches
+};
+
+/**
+ * @struct ArrivalModel
+ * @brief Arrival pattern and its parameters
+ */
+struct ArrivalModel {
+    ArrivalPattern pattern;  ///< Shape
+    double rate;             ///< Processes per time unit (Periodic: 1 / gap)
+    double batch;            ///< Bursty: mean batch size (>= 1)
+};
+
+/**
+ * @enum BurstShape
+ * @brief Shapes of the burst time distribution
+ */
+enum class BurstShape {
+    Constant,     ///< Always the same burst
+    Uniform,      ///< Uniform on [first, second]
+    Exponential,  ///< Exponential with mean first
+    Bimodal,      ///< Mean first, or mean second with probability third
+    Pareto        ///< Scale first, shape second
+};
+
+/**
+ * @struct BurstModel
+ * @brief Burst time distribution and its parameters
+ */
+struct BurstModel {
+    BurstShape shape;  ///< Shape
+    double first;      ///< Constant value, minimum, mean, short mean or Pareto scale
+    double second;     ///< Uniform maximum, long mean or Pareto shape
+    double third;      ///< Bimodal: probability of the long mode
+};
+
+/**
+ * @struct TraceChunk
+ * @brief One generated chunk of records, column-wise (as in the binary format)
+ */
+struct TraceChunk {
+    std::uint64_t first;               ///< Index of the chunk's first record
+    std::vector<int> pid;              ///< Process IDs (first + 1, first + 2, ...)
+    std::vector<int> burstTime;        ///< Burst times
+    std::vector<int> arrivalTime;      ///< Arrival times (non-decreasing)
+    std::vector<int> priority;         ///< Priorities (empty without priority levels)
+    std::uint64_t burstSum;            ///< Sum of burstTime
+};
+
+/**
+ * @class TraceGenerator
+ * @brief Chunked, seeded generator of synthetic process traces
+ */
+class TraceGenerator {
+public:
+    static const std::size_t CHUNK_RECORDS = 1 << 16;  ///< Records per chunk (fixed: part of the seed schedule)
+
+private:
+    std::uint64_t count;              ///< Records to generate
+    ArrivalModel arrivals;            ///< Arrival pattern
+    BurstModel bursts;                ///< Burst time distribution
+    int priorityLevels;               ///< Priority levels (0 = no priority column)
+    std::uint64_t seed;               ///< Seed of the whole trace
+    std::vector<double> chunkStart;   ///< Arrival clock at the start of each chunk (set by prepare())
+
+    /**
+     * @brief Draw the gap between a record and the previous one
+     * @param random Arrival generator of the chunk
+     * @return Gap in time units
+     */
+    double drawGap(FastRandom& random) const;
+
+    /**
+     * @brief Draw a burst time
+     * @param random Burst generator of the chunk
+     * @return Burst time in whole time units (>= 1)
+     */
+    int drawBurst(FastRandom& random) const;
+
+    /**
+     * @brief Get the number of records of a chunk
+     * @param chunk Chunk index
+     * @return CHUNK_RECORDS, or fewer for the last chunk
+     */
+    std::size_t chunkSize(std::size_t chunk) const;
+
+public:
+    /**
+     * @brief Constructor - 1000 records arriving at time 0 with exp:5 bursts, no priorities, seed 1
+     */
+    TraceGenerator();
+
+    /**
+     * @brief Set the number of records
+     * @param records Record count (1 to INT32_MAX, since pids are int)
+     */
+    void setCount(std::uint64_t records);
+
+    /**
+     * @brief Get the number of records
+     * @return Record count
+     */
+    std::uint64_t getCount() const;
+
+    /**
+     * @brief Set the arrival pattern
+     * @param model Pattern and parameters
+     */
+    void setArrivalModel(const ArrivalModel& model);
+
+    /**
+     * @brief Set the burst time distribution
+     * @param model Shape and parameters
+     */
+    void setBurstModel(const BurstModel& model);
+
+    /**
+     * @brief Set the number of priority levels
+     * @param levels Levels (0 = no priorities)
+     */
+    void setPriorityLevels(int levels);
+
+    /**
+     * @brief Check whether records carry a priority
+     * @return true if priority levels were set
+     */
+    bool hasPriorities() const;
+
+    /**
+     * @brief Set the seed of the whole trace
+     * @param newSeed Any value
+     */
+    void setSeed(std::uint64_t newSeed);
+
+    /**
+     * @brief Compute the chunk start times (first pass, parallel)
+     * @param executor Pool that runs one task per chunk
+     * @return true on success, false (with a message on std::cerr) if the
+     *         arrival times would not fit in an int
+     */
+    bool prepare(Executor& executor);
+
+    /**
+     * @brief Get the number of chunks
+     * @return ceil(count / CHUNK_RECORDS)
+     */
+    std::size_t chunkCount() const;
+
+    /**
+     * @brief Generate one chunk (after prepare())
+     * @param chunk Chunk index
+     * @param out Receives the records (its buffers are reused)
+     */
+    void generate(std::size_t chunk, TraceChunk& out) const;
+
+    /**
+     * @brief Get the arrival clock after the last record (after prepare())
+     * @return Time units
+     */
+    double getSpan() const;
+
+    /**
+     * @brief Describe the configuration
+     * @return e.g. "1000000 processes, arrivals poisson:0.5, bursts exp:2, 4 priority levels, seed 1"
+     */
+    std::string describe() const;
+};
+
+/**
+ * @brief Parse an arrival pattern ("zero", "periodic:GAP", "poisson:RATE", "bursty:RATE:BATCH")
+ * @param spec Pattern text
+ * @param model Receives the parsed pattern
+ * @return true on success, false (with a message on std::cerr) on error
+ */
+bool parseArrivalModel(const std::string& spec, ArrivalModel& model);
+
+/**
+ * @brief Format an arrival pattern in the notation of parseArrivalModel()
+ * @param model Pattern
+ * @return Pattern text
+ */
+std::string describeArrivalModel(const ArrivalModel& model);
+
+/**
+ * @brief Parse a burst distribution ("constant:N", "uniform:MIN:MAX", "exp:MEAN",
+ *        "bimodal:SHORT:LONG:P", "pareto:MIN:ALPHA")
+ * @param spec Distribution text
+ * @param model Receives the parsed distribution
+ * @return true on success, false (with a message on std::cerr) on error
+ */
+bool parseBurstModel(const std::string& spec, BurstModel& model);
+
+/**
+ * @brief Format a burst distribution in the notation of parseBurstModel()
+ * @param model Distribution
+ * @return Distribution text
+ */
+std::string describeBurstModel(const BurstModel& model);
+
+#endif // TRACE_GENERATOR_H
@@ -0,0 +1,299 @@
+/**
+ * @file WorkStealingPool.cpp
+ * @brief Implementation of the WorkStealingPool class
+ *
+ * Sleep/wake protocol (no lost wake-ups without a global lock on submit):
+ * - submit() publishes the task (queued++) and then reads sleepers; only if a
+ *   worker may be asleep does it take sleepMutex and notify
+ * - A worker going to sleep increments sleepers and then re-checks queued
+ *   under sleepMutex before waiting
+ * Both sides use sequentially consistent operations, so at least one of them
+ * observes the other: either the worker sees the new task or submit() sees
+ * the sleeper.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include "WorkStealingPool.h"
+#include "ThreadPool.h"
+#include "CpuTopology.h"
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Pool and worker index of the calling thread (null if not a worker)
+ */
+thread_local const WorkStealingPool* currentPool = nullptr;
+thread_local std::size_t currentWorker = 0;
+
+} // namespace
+
+/**
+ * @brief Constructor - starts the worker threads
+ *
+ * All run queues exist before the first thread starts, so workers can steal
+ * from each other immediately. A pinned worker binds itself to its CPU
+ * before looking for work.
+ *
+ * @param numThreads Number of workers (0 selects ThreadPool::defaultThreadCount())
+ * @param cpus CPU of worker i at index i % size (empty leaves workers unpinned)
+ */
+WorkStealingPool::WorkStealingPool(unsigned int numThreads, const std::vector<int>& cpus)
+    : queued(0), pending(0), nextQueue(0), sleepers(0), stopping(false) {
+    if (numThreads == 0) {
+        numThreads = ThreadPool::defaultThreadCount();
+    }
+
+    workers.reserve(numThreads);
+    for (unsigned int i = 0; i < numThreads; i++) {
+        std::unique_ptr<Worker> worker(new Worker());
+        worker->maxDepth = 0;
+        worker->executed = 0;
+        worker->steals = 0;
+        worker->stolen = 0;
+        worker->failedSteals = 0;
+        workers.push_back(std::move(worker));
+    }
+    for (std::size_t i = 0; i < workers.size(); i++) {
+        int cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+        workers[i]->thread = std::thread([this, i, cpu] {
+            if (cpu >= 0) {
+                pinCurrentThread(cpu);
+            }
+            workerLoop(this, i);
+        });
+    }
+}
+
+/**
+ * @brief Destructor - waits for queued tasks and joins all workers
+ */
+WorkStealingPool::~WorkStealingPool() {
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+
+    for (auto& worker : workers) {
+        worker->thread.join();
+    }
+}
+
+/**
+ * @brief Queue a task on a worker's run queue
+ *
+ * A worker of this pool pushes onto its own queue (the task is likely to
+ * touch the same data as its parent); other threads spread tasks round-robin.
+ *
+ * CRITICAL SECTION: Appends to one run queue under that queue's mutex.
+ *
+ * @param task Callable to run
+ */
+void WorkStealingPool::submit(std::function<void()> task) {
+    std::size_t target = (currentPool == this)
+        ? currentWorker
+        : nextQueue.fetch_add(1, std::memory_order_relaxed) % workers.size();
+    Worker& worker = *workers[target];
+
+    // Count the task before it becomes visible, so counters never dip below zero
+    pending.fetch_add(1);
+    queued.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(worker.queueMutex);
+        worker.tasks.push_back(std::move(task));
+        if (worker.tasks.size() > worker.maxDepth) {
+            worker.maxDepth = worker.tasks.size();
+        }
+    }
+
+    if (sleepers.load() > 0) {
+        { std::lock_guard<std::mutex> lock(sleepMutex); }
+        workAvailable.notify_one();
+    }
+}
+
+/**
+ * @brief Block until all submitted tasks have completed
+ */
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(doneMutex);
+    allDone.wait(lock, [this] { return pending.load() == 0; });
+}
+
+/**
+ * @brief Get the number of worker threads
+ * @return Worker count
+ */
+unsigned int WorkStealingPool::size() const {
+    return static_cast<unsigned int>(workers.size());
+}
+
+/**
+ * @brief Get the counters summed over all workers (maxQueueDepth is the maximum)
+ * @return Statistics since the pool was created
+ */
+ExecutorStats WorkStealingPool::getStats() const {
+    ExecutorStats total = { 0, 0, 0, 0, 0 };
+    for (const auto& record : getWorkerStats()) {
+        total.tasksExecuted += record.executed;
+        total.steals += record.steals;
+        total.tasksStolen += record.stolen;
+        total.failedSteals += record.failedSteals;
+        if (record.maxDepth > total.maxQueueDepth) {
+            total.maxQueueDepth = record.maxDepth;
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Get the display name of the pool implementation
+ * @return "Work-stealing"
+ */
+const char* WorkStealingPool::name() const {
+    return "Work-stealing";
+}
+
+/**
+ * @brief Get the counters of every worker
+ * @return One record per worker
+ */
+std::vector<WorkStealingPool::WorkerStats> WorkStealingPool::getWorkerStats() const {
+    std::vector<WorkerStats> result;
+    result.reserve(workers.size());
+    for (const auto& worker : workers) {
+        WorkerStats record;
+        record.executed = worker->executed.load(std::memory_order_relaxed);
+        record.steals = worker->steals.load(std::memory_order_relaxed);
+        record.stolen = worker->stolen.load(std::memory_order_relaxed);
+        record.failedSteals = worker->failedSteals.load(std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(worker->queueMutex);
+            record.maxDepth = worker->maxDepth;
+        }
+        result.push_back(record);
+    }
+    return result;
+}
+
+/**
+ * @brief Take the oldest task from a worker's own queue
+ *
+ * CRITICAL SECTION: Pops under the worker's queue mutex.
+ *
+ * @param self Worker index
+ * @param task Receives the task
+ * @return true if a task was taken
+ */
+bool WorkStealingPool::popLocal(std::size_t self, std::function<void()>& task) {
+    Worker& worker = *workers[self];
+    std::lock_guard<std::mutex> lock(worker.queueMutex);
+    if (worker.tasks.empty()) {
+        return false;
+    }
+    task = std::move(worker.tasks.front());
+    worker.tasks.pop_front();
+    queued.fetch_sub(1);
+    return true;
+}
+
+/**
+ * @brief Steal half of the first non-empty victim queue into the worker's own queue
+ *
+ * Victims are scanned starting after the thief's own index and the scan start
+ * rotates with every attempt, so thieves spread over different victims. The
+ * oldest half of the victim's queue is moved (rounded up); the first of those
+ * tasks is returned and the rest are appended to the thief's queue.
+ *
+ * CRITICAL SECTION: Locks one victim queue at a time, then the thief's own queue.
+ *
+ * @param self Worker index
+ * @param task Receives the first stolen task (run immediately)
+ * @return true if anything was stolen
+ */
+bool WorkStealingPool::steal(std::size_t self, std::function<void()>& task) {
+    std::size_t count = workers.size();
+    Worker& thief = *workers[self];
+    std::size_t start = static_cast<std::size_t>(thief.failedSteals.load(std::memory_order_relaxed) +
+                                                 thief.steals.load(std::memory_order_relaxed));
+
+    for (std::size_t i = 0; i + 1 < count; i++) {
+        Worker& victim = *workers[(self + 1 + (start + i) % (count - 1)) % count];
+        std::deque<std::function<void()>> loot;
+        {
+            std::lock_guard<std::mutex> lock(victim.queueMutex);
+            std::size_t take = (victim.tasks.size() + 1) / 2;
+            for (std::size_t k = 0; k < take; k++) {
+                loot.push_back(std::move(victim.tasks.front()));
+                victim.tasks.pop_front();
+            }
+        }
+        if (loot.empty()) {
+            continue;
+        }
+
+        task = std::move(loot.front());
+        loot.pop_front();
+        queued.fetch_sub(1);
+        if (!loot.empty()) {
+            std::lock_guard<std::mutex> lock(thief.queueMutex);
+            for (auto& item : loot) {
+                thief.tasks.push_back(std::move(item));
+            }
+            if (thief.tasks.size() > thief.maxDepth) {
+                thief.maxDepth = thief.tasks.size();
+            }
+        }
+
+        thief.steals.fetch_add(1, std::memory_order_relaxed);
+        thief.stolen.fetch_add(loot.size() + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    thief.failedSteals.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+/**
+ * @brief Main loop executed by each worker thread
+ *
+ * Runs its own queue, then tries to steal, then sleeps until more work is
+ * queued. Exits once the pool is stopping and no task is left anywhere.
+ *
+ * @param pool Pointer to the owning pool
+ * @param self Index of the worker
+ */
+void WorkStealingPool::workerLoop(WorkStealingPool* pool, std::size_t self) {
+    currentPool = pool;
+    currentWorker = self;
+    Worker& worker = *pool->workers[self];
+
+    for (;;) {
+        std::function<void()> task;
+        if (pool->popLocal(self, task) || pool->steal(self, task)) {
+            task();
+            task = nullptr;  // Release captured state before signalling completion
+            worker.executed.fetch_add(1, std::memory_order_relaxed);
+
+            if (pool->pending.fetch_sub(1) == 1) {
+                { std::lock_guard<std::mutex> lock(pool->doneMutex); }
+                pool->allDone.notify_all();
+            }
+            continue;
+        }
+
+        // Nothing to run or steal: sleep until a task is queued or the pool stops
+        std::unique_lock<std::mutex> lock(pool->sleepMutex);
+        pool->sleepers.fetch_add(1);
+        pool->workAvailable.wait(lock, [pool] { return pool->stopping.load() || pool->queued.load() > 0; });
+        pool->sleepers.fetch_sub(1);
+        if (pool->stopping.load() && pool->queued.load() == 0) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,165 @@
+/**
+ * @file WorkStealingPool.h
+ * @brief Header file for the WorkStealingPool class
+ *
+ * This file defines a fixed-size worker pool with one run queue per worker
+ * (like per-core run queues in an OS scheduler):
+ *
+ * - Tasks submitted from outside the pool are spread round-robin over the
+ *   worker queues; tasks submitted from inside a task go to the submitting
+ *   worker's own queue
+ * - Each worker runs its own queue in FIFO order
+ * - A worker whose queue is empty steals half of the queue of the first
+ *   non-empty victim (scanning from a rotating start), so a burst of short
+ *   tasks is rebalanced with few steal operations
+ * - Workers with nothing to run or steal sleep on a condition variable; the
+ *   sleep mutex is only taken by submit() while some worker is asleep
+ *
+ * Unlike ThreadPool there is no global dispatch order: tasks queued on
+ * different workers may start in any order.
+ *
+ * Thread Safety:
+ * - Each run queue is protected by its own mutex (CRITICAL SECTION), so
+ *   workers only contend when stealing from the same victim
+ * - Counters are relaxed atomics written by their owning worker
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Executor.h"
+
+/**
+ * @class WorkStealingPool
+ * @brief Executor with per-worker FIFO run queues and work stealing
+ */
+class WorkStealingPool : public Executor {
+private:
+    /**
+     * @struct Worker
+     * @brief One worker's run queue and counters, on its own cache lines
+     */
+    struct alignas(64) Worker {
+        std::mutex queueMutex;                    ///< Protects tasks and maxDepth
+        std::deque<std::function<void()>> tasks;  ///< Run queue (CRITICAL RESOURCE)
+        std::size_t maxDepth;                     ///< Deepest the queue has been
+        std::atomic<std::uint64_t> executed;      ///< Tasks this worker ran
+        std::atomic<std::uint64_t> steals;        ///< Successful steal operations
+        std::atomic<std::uint64_t> stolen;        ///< Tasks moved into this queue by steals
+        std::atomic<std::uint64_t> failedSteals;  ///< Steal rounds that found nothing
+        std::thread thread;                       ///< The worker thread
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;  ///< All workers (fixed after construction)
+    std::atomic<std::size_t> queued;          ///< Tasks sitting in run queues
+    std::atomic<std::size_t> pending;         ///< Queued plus running tasks
+    std::atomic<unsigned int> nextQueue;      ///< Round-robin cursor for external submissions
+    std::atomic<unsigned int> sleepers;       ///< Workers waiting on workAvailable
+    std::atomic<bool> stopping;               ///< Set by the destructor to release the workers
+    std::mutex sleepMutex;                    ///< Pairs with workAvailable
+    std::condition_variable workAvailable;    ///< Signalled when a task is queued or the pool stops
+    std::mutex doneMutex;                     ///< Pairs with allDone
+    std::condition_variable allDone;          ///< Signalled when the last pending task finishes
+
+public:
+    /**
+     * @struct WorkerStats
+     * @brief Counters of one worker
+     */
+    struct WorkerStats {
+        std::uint64_t executed;      ///< Tasks this worker ran
+        std::uint64_t steals;        ///< Successful steal operations
+        std::uint64_t stolen;        ///< Tasks moved into this queue by steals
+        std::uint64_t failedSteals;  ///< Steal rounds that found nothing
+        std::size_t maxDepth;        ///< Deepest this worker's queue has been
+    };
+
+    /**
+     * @brief Constructor - starts the worker threads
+     * @param numThreads Number of workers (0 selects ThreadPool::defaultThreadCount())
+     * @param cpus CPU of worker i at index i % size (empty leaves workers unpinned)
+     */
+    explicit WorkStealingPool(unsigned int numThreads = 0, const std::vector<int>& cpus = std::vector<int>());
+
+    /**
+     * @brief Destructor - waits for queued tasks and joins all workers
+     */
+    ~WorkStealingPool() override;
+
+    /**
+     * @brief Queue a task on a worker's run queue
+     * @param task Callable to run
+     */
+    void submit(std::function<void()> task) override;
+
+    /**
+     * @brief Block until all submitted tasks have completed
+     */
+    void wait() override;
+
+    /**
+     * @brief Get the number of worker threads
+     * @return Worker count
+     */
+    unsigned int size() const override;
+
+    /**
+     * @brief Get the counters summed over all workers (maxQueueDepth is the maximum)
+     * @return Statistics since the pool was created
+     */
+    ExecutorStats getStats() const override;
+
+    /**
+     * @brief Get the display name of the pool implementation
+     * @return "Work-stealing"
+     */
+    const char* name() const override;
+
+    /**
+     * @brief Get the counters of every worker
+     * @return One record per worker
+     */
+    std::vector<WorkerStats> getWorkerStats() const;
+
+private:
+    WorkStealingPool(const WorkStealingPool&) = delete;             ///< Non-copyable
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;  ///< Non-assignable
+
+    /**
+     * @brief Take the oldest task from a worker's own queue
+     * @param self Worker index
+     * @param task Receives the task
+     * @return true if a task was taken
+     */
+    bool popLocal(std::size_t self, std::function<void()>& task);
+
+    /**
+     * @brief Steal half of the first non-empty victim queue into the worker's own queue
+     * @param self Worker index
+     * @param task Receives the first stolen task (run immediately)
+     * @return true if anything was stolen
+     */
+    bool steal(std::size_t self, std::function<void()>& task);
+
+    /**
+     * @brief Main loop executed by each worker thread
+     * @param pool Pointer to the owning pool
+     * @param self Index of the worker
+     */
+    static void workerLoop(WorkStealingPool* pool, std::size_t self);
+};
+
+#endif // WORK_STEALING_POOL_H
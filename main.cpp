@@ -5,12 +5,14 @@
  * This program demonstrates operating system synchronization concepts through
  * two simulations:
  * 1. Process Simulation: Simulates concurrent process execution using threads
- * 2. Dining Philosophers: Demonstrates deadlock prevention using ordered resource acquisition
+ * 2. Dining Philosophers: Demonstrates deadlock prevention (ordered resource acquisition
+ *    by default, or another selectable strategy)
  * 
- * The program reads process data from processes.txt and creates threads to simulate
- * concurrent process execution. It then runs the classic Dining Philosophers problem
- * with 5 philosophers and implements deadlock prevention through ordered resource
- * acquisition (always acquiring the lower-numbered fork first).
+ * The program reads process data from processes.txt and runs the processes on a
+ * bounded worker pool to simulate concurrent process execution. It then runs the classic Dining Philosophers problem
+ * with N philosophers (5 by default), or any agent -> fork set graph loaded with --graph, and
+ * implements deadlock prevention through ordered resource acquisition (always acquiring the
+ * lower-numbered fork first).
  * 
  * @author Thread Simulation System
  * @date 2024
@@ -18,8 +20,18 @@
 
 #include <iostream>
 #include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <cctype>
+#include <cstdint>
 #include "ProcessSimulator.h"
 #include "DiningPhilosophers.h"
+#include "CoroutinePhilosophers.h"
+#include "DurationDistribution.h"
+#include "Logger.h"
+#include "CpuTopology.h"
+#include "LiveMetrics.h"
+#include "Checkpoint.h"
 
 /**
  * @brief Main function - coordinates execution of both simulations
@@ -27,35 +39,382 @@
  * Executes the process simulation first, followed by the dining philosophers
  * simulation. Provides formatted output with section separators for clarity.
  * 
- * @return 0 on success, 1 if process loading fails
+ * Command-line options:
+ * - --virtual         : run the process simulation in virtual time (no sleeping)
+ * - --policy NAME     : scheduling policy (fcfs, sjf, srtf, rr, priority; virtual time)
+ * - --ready-queue NAME: ready queue of sjf/srtf/priority (scan, heap, pairing, bucket; default: scan)
+ * - --cpus N          : number of workers / simulated CPUs (default: hardware concurrency)
+ * - --quantum N       : Round-Robin time quantum in seconds (default: 2)
+ * - --time-scale S    : real-time seconds per trace time unit (default: 1, 0 = no sleeping)
+ * - --executor NAME   : real-time worker pool (pool = shared FIFO queue, stealing = work stealing)
+ * - --stream FILE     : execute a text trace while reading it (FILE or - for stdin; real time only)
+ * - --queue-capacity N: records buffered between the stream reader and the workers (default: 1024)
+ * - --metrics FILE    : write per-process records and throughput/utilization to FILE
+ * - --metrics-format F: format of --metrics (csv or jsonl, default: csv)
+ * - --trace FILE      : write a Chrome trace-event timeline of the process run to FILE
+ * - --philosophers N  : number of dining philosophers (default: 5, minimum: 2)
+ * - --graph FILE      : seat the philosophers at a resource graph ("agent: fork fork ..." per line)
+ *                       instead of the round table (see ResourceGraph.h)
+ * - --phil-workers N  : pool workers running the philosophers (default: hardware concurrency)
+ * - --strategy NAME   : fork protocol (ordered, waiter, chandy-misra, trylock, monitor, naive)
+ * - --deadlock ACTION : wait-for graph watchdog (off, report, abort, preempt; default off,
+ *                       abort for the naive strategy)
+ * - --deadlock-interval D : time between two watchdog scans (default 10ms)
+ * - --fork-lock NAME  : fork lock (mutex = std::mutex, spin = spin-then-park,
+ *                       shared = std::shared_mutex, biased = reader-biased with per-core reader counters)
+ * - --read-ratio R    : share of meals that are reads and hold their forks shared (0-1, default 0; needs --deadlock off)
+ * - --phil-duration S : run the philosophers for S seconds instead of 3 cycles each
+ * - --phil-metrics F  : write fork/philosopher contention metrics to JSON file F
+ * - --phil-trace F    : write a Chrome trace-event timeline of the philosophers to F
+ * - --seed N          : seed the philosophers' think times (default: a fresh random seed)
+ * - --think DIST      : think time distribution (default uniform:1s:3s; see DurationDistribution.h)
+ * - --eat DIST        : eat time distribution (default constant:2s)
+ * - --timestamp-precision N : decimals of the printed log timestamps (0-9, default 3)
+ * - --log-level NAME  : verbosity (off, summary, events, trace; default trace, capped at SIM_LOG_LEVEL)
+ * - --burst-mode M    : spend real-time bursts sleeping (sleep, default) or on a calibrated busy loop (burn)
+ * - --pin SPEC        : pin worker threads of both simulations (none, compact, scatter or a list like 0,2,4-7)
+ * - --live-metrics T : publish live progress counters: http:PORT or http:ADDRESS:PORT (Prometheus
+ *                       scrape endpoint at /metrics) or file:PATH (snapshot file rewritten periodically)
+ * - --live-interval D : time between two snapshot files (default 1s)
+ * - --checkpoint FILE : on SIGINT / SIGTERM, save the running simulation to FILE and exit with status 3
+ *                       (virtual-time process simulation and the philosophers)
+ * - --checkpoint-interval D : also save the virtual-time process simulation every D of wall-clock time
+ * - --resume FILE     : continue the run saved in checkpoint FILE (same processes.txt and table)
+ * - --coroutines      : run processes and philosophers as C++20 coroutines on --cpus / --phil-workers
+ *                       threads (ordered strategy only; not with --virtual or --stream)
+ * 
+ * @param argc Number of command-line arguments
+ * @param argv Command-line arguments
+ * @return 0 on success, 1 if process loading fails or an option is invalid,
+ *         3 if the run was interrupted and saved to the --checkpoint file
  */
-int main() {
+int main(int argc, char* argv[]) {
+    ExecutionMode processMode = ExecutionMode::RealTime;
+    SchedulingPolicy policy = SchedulingPolicy::FCFS;
+    ReadyQueueType readyQueue = ReadyQueueType::Scan;
+    int cpuCount = 0;
+    int quantum = 2;
+    double timeScale = 1.0;
+    ExecutorType executorType = ExecutorType::GlobalQueue;
+    std::string streamSource;
+    std::size_t queueCapacity = ProcessSimulator::DEFAULT_STREAM_CAPACITY;
+    std::string processMetrics;
+    MetricsFormat metricsFormat = MetricsFormat::Csv;
+    int philosopherCount = DiningPhilosophers::DEFAULT_PHILOSOPHERS;
+    bool philosopherCountGiven = false;
+    std::string graphFile;
+    int philosopherWorkers = 0;
+    DiningStrategy strategy = DiningStrategy::Ordered;
+    ForkLockType forkLock = ForkLockType::Mutex;
+    double readRatio = 0.0;
+    DeadlockAction deadlockAction = DeadlockAction::Off;
+    bool deadlockActionGiven = false;
+    std::chrono::nanoseconds deadlockInterval = std::chrono::milliseconds(DeadlockDetector::DEFAULT_INTERVAL_MS);
+    double philosopherDuration = 0.0;
+    std::string philosopherMetrics;
+    std::string philosopherTrace;
+    std::string processTrace;
+    std::uint64_t seed = 0;
+    bool seedGiven = false;
+    DurationDistribution thinkTime = DurationDistribution::uniform(std::chrono::seconds(1), std::chrono::seconds(3));
+    DurationDistribution eatTime = DurationDistribution::constant(std::chrono::seconds(2));
+    LogLevel logLevel = LogLevel::Trace;
+    CpuPinning pinning = { PinningPolicy::None, std::vector<int>() };
+    BurstMode burstMode = BurstMode::Sleep;
+    bool coroutines = false;
+    LiveMetricsTarget liveTarget = { LiveMetricsTransport::Off, "", 0, "" };
+    std::chrono::nanoseconds liveInterval = std::chrono::milliseconds(LiveMetrics::DEFAULT_INTERVAL_MS);
+    std::string checkpointFile;
+    std::chrono::nanoseconds checkpointInterval(0);
+    std::string resumeFile;
+    
+    // Parse command-line options
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--virtual") {
+            processMode = ExecutionMode::VirtualTime;
+        } else if (arg == "--policy" && hasValue && parseSchedulingPolicy(argv[i + 1], policy)) {
+            i++;
+        } else if (arg == "--ready-queue" && hasValue && parseReadyQueueType(argv[i + 1], readyQueue)) {
+            i++;
+        } else if (arg == "--cpus" && hasValue && std::atoi(argv[i + 1]) > 0) {
+            cpuCount = std::atoi(argv[++i]);
+        } else if (arg == "--quantum" && hasValue && std::atoi(argv[i + 1]) > 0) {
+            quantum = std::atoi(argv[++i]);
+        } else if (arg == "--time-scale" && hasValue && std::atof(argv[i + 1]) >= 0.0) {
+            timeScale = std::atof(argv[++i]);
+        } else if (arg == "--executor" && hasValue && parseExecutorType(argv[i + 1], executorType)) {
+            i++;
+        } else if (arg == "--stream" && hasValue) {
+            streamSource = argv[++i];
+        } else if (arg == "--queue-capacity" && hasValue && std::atoi(argv[i + 1]) > 0) {
+            queueCapacity = static_cast<std::size_t>(std::atoi(argv[++i]));
+        } else if (arg == "--metrics" && hasValue) {
+            processMetrics = argv[++i];
+        } else if (arg == "--trace" && hasValue) {
+            processTrace = argv[++i];
+        } else if (arg == "--metrics-format" && hasValue && parseMetricsFormat(argv[i + 1], metricsFormat)) {
+            i++;
+        } else if (arg == "--philosophers" && hasValue && std::atoi(argv[i + 1]) >= 2) {
+            philosopherCount = std::atoi(argv[++i]);
+            philosopherCountGiven = true;
+        } else if (arg == "--graph" && hasValue) {
+            graphFile = argv[++i];
+        } else if (arg == "--phil-workers" && hasValue && std::atoi(argv[i + 1]) > 0) {
+            philosopherWorkers = std::atoi(argv[++i]);
+        } else if (arg == "--strategy" && hasValue && parseDiningStrategy(argv[i + 1], strategy)) {
+            i++;
+        } else if (arg == "--fork-lock" && hasValue && parseForkLockType(argv[i + 1], forkLock)) {
+            i++;
+        } else if (arg == "--read-ratio" && hasValue && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))
+                   && std::atof(argv[i + 1]) <= 1.0) {
+            readRatio = std::atof(argv[++i]);
+        } else if (arg == "--deadlock" && hasValue && parseDeadlockAction(argv[i + 1], deadlockAction)) {
+            deadlockActionGiven = true;
+            i++;
+        } else if (arg == "--deadlock-interval" && hasValue && parseDuration(argv[i + 1], deadlockInterval)
+                   && deadlockInterval.count() > 0) {
+            i++;
+        } else if (arg == "--phil-duration" && hasValue && std::atof(argv[i + 1]) > 0.0) {
+            philosopherDuration = std::atof(argv[++i]);
+        } else if (arg == "--phil-metrics" && hasValue) {
+            philosopherMetrics = argv[++i];
+        } else if (arg == "--phil-trace" && hasValue) {
+            philosopherTrace = argv[++i];
+        } else if (arg == "--seed" && hasValue && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+            seedGiven = true;
+        } else if (arg == "--think" && hasValue && parseDurationDistribution(argv[i + 1], thinkTime)) {
+            i++;
+        } else if (arg == "--eat" && hasValue && parseDurationDistribution(argv[i + 1], eatTime)) {
+            i++;
+        } else if (arg == "--timestamp-precision" && hasValue && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+            Logger::instance().setTimestampPrecision(std::atoi(argv[++i]));
+        } else if (arg == "--log-level" && hasValue && parseLogLevel(argv[i + 1], logLevel)) {
+            i++;
+        } else if (arg == "--pin" && hasValue && parseCpuPinning(argv[i + 1], pinning)) {
+            i++;
+        } else if (arg == "--burst-mode" && hasValue && parseBurstMode(argv[i + 1], burstMode)) {
+            i++;
+        } else if (arg == "--live-metrics" && hasValue && parseLiveMetricsTarget(argv[i + 1], liveTarget)) {
+            i++;
+        } else if (arg == "--live-interval" && hasValue && parseDuration(argv[i + 1], liveInterval)
+                   && liveInterval.count() > 0) {
+            i++;
+        } else if (arg == "--checkpoint" && hasValue) {
+            checkpointFile = argv[++i];
+        } else if (arg == "--checkpoint-interval" && hasValue && parseDuration(argv[i + 1], checkpointInterval)
+                   && checkpointInterval.count() > 0) {
+            i++;
+        } else if (arg == "--resume" && hasValue) {
+            resumeFile = argv[++i];
+        } else if (arg == "--coroutines") {
+            coroutines = true;
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--virtual] [--policy fcfs|sjf|srtf|rr|priority] [--ready-queue scan|heap|pairing|bucket]"
+                      << " [--cpus N] [--quantum N] [--time-scale S] [--executor pool|stealing]"
+                      << " [--stream FILE|-] [--queue-capacity N] [--metrics FILE] [--metrics-format csv|jsonl] [--trace FILE]"
+                      << " [--philosophers N] [--graph FILE] [--phil-workers N]"
+                      << " [--strategy ordered|waiter|chandy-misra|trylock|monitor|naive] [--fork-lock mutex|spin|shared|biased]"
+                      << " [--read-ratio R]"
+                      << " [--deadlock off|report|abort|preempt] [--deadlock-interval D]"
+                      << " [--phil-duration S] [--phil-metrics FILE] [--phil-trace FILE] [--seed N]"
+                      << " [--think DIST] [--eat DIST] [--timestamp-precision N]"
+                      << " [--log-level off|summary|events|trace] [--pin none|compact|scatter|LIST]"
+                      << " [--burst-mode sleep|burn] [--live-metrics http:[ADDRESS:]PORT|file:PATH] [--live-interval D]"
+                      << " [--checkpoint FILE] [--checkpoint-interval D] [--resume FILE]"
+                      << " [--coroutines]" << std::endl;
+            return 1;
+        }
+    }
+    
+    Logger::setLevel(logLevel);
+    
+    // A resumed run takes the settings of the interrupted one from its checkpoint
+    Checkpoint resume;
+    resume.kind = CheckpointKind::None;
+    if (!resumeFile.empty()) {
+        if (!streamSource.empty() || coroutines) {
+            std::cerr << "Error: --resume cannot be combined with --stream or --coroutines" << std::endl;
+            return 1;
+        }
+        if (!readCheckpoint(resumeFile, resume)) {
+            return 1;
+        }
+        if (resume.kind == CheckpointKind::Processes) {
+            processMode = ExecutionMode::VirtualTime;
+        } else {
+            strategy = resume.philosophers.strategy;
+        }
+    }
+    bool savable = (processMode == ExecutionMode::VirtualTime || resume.kind == CheckpointKind::Philosophers);
+    if (!checkpointFile.empty() && (!savable || !streamSource.empty() || coroutines)) {
+        std::cerr << "Error: --checkpoint needs --virtual (the real-time process simulation cannot be saved)"
+                  << " and cannot be combined with --stream or --coroutines" << std::endl;
+        return 1;
+    }
+    if (checkpointInterval.count() > 0 && checkpointFile.empty()) {
+        std::cerr << "Error: --checkpoint-interval needs --checkpoint" << std::endl;
+        return 1;
+    }
+    
+    // A naive table must fail fast rather than hang, unless asked otherwise
+    if (!deadlockActionGiven && strategy == DiningStrategy::Naive) {
+        deadlockAction = DeadlockAction::Abort;
+    }
+    if (readRatio > 0.0 && deadlockAction != DeadlockAction::Off) {
+        std::cerr << "Error: --read-ratio needs --deadlock off (the watchdog tracks one holder per fork)" << std::endl;
+        return 1;
+    }
+    
+    for (int cpu : pinning.list) {
+        bool available = false;
+        for (const CpuInfo& info : CpuTopology::instance().getCpus()) {
+            available = available || (info.cpu == cpu);
+        }
+        if (!available) {
+            std::cerr << "Error: CPU " << cpu << " in --pin is not available to this process" << std::endl;
+            return 1;
+        }
+    }
+    
+    if (!streamSource.empty() && processMode == ExecutionMode::VirtualTime) {
+        std::cerr << "Error: --stream runs in real time and cannot be combined with --virtual" << std::endl;
+        return 1;
+    }
+    
+    if (coroutines) {
+        if (processMode == ExecutionMode::VirtualTime || !streamSource.empty()) {
+            std::cerr << "Error: --coroutines cannot be combined with --virtual or --stream" << std::endl;
+            return 1;
+        }
+        if (strategy != DiningStrategy::Ordered || forkLock != ForkLockType::Mutex || readRatio > 0.0
+            || !philosopherMetrics.empty() || !philosopherTrace.empty() || deadlockAction != DeadlockAction::Off) {
+            std::cerr << "Error: --coroutines philosophers support only the ordered strategy "
+                      << "(no --fork-lock, --read-ratio, --phil-metrics, --phil-trace or --deadlock)" << std::endl;
+            return 1;
+        }
+        processMode = ExecutionMode::Coroutine;
+    }
+    
+    // The table is checked before anything runs so a bad graph fails fast
+    ResourceGraph table = ResourceGraph::ring(philosopherCount);
+    if (!graphFile.empty()) {
+        if (philosopherCountGiven || coroutines) {
+            std::cerr << "Error: --graph sets the table and cannot be combined with --philosophers or --coroutines"
+                      << std::endl;
+            return 1;
+        }
+        if (!table.load(graphFile)) {
+            return 1;
+        }
+        if (strategy == DiningStrategy::ChandyMisra && table.maxUsers() > 2) {
+            std::cerr << "Error: The chandy-misra strategy needs every fork shared by at most 2 philosophers ("
+                      << graphFile << " has forks with " << table.maxUsers() << ")" << std::endl;
+            return 1;
+        }
+    }
+    
     std::cout << "\n" << std::string(60, '=') << std::endl;
     std::cout << "  THREAD-BASED PROCESS SIMULATION SYSTEM" << std::endl;
     std::cout << std::string(60, '=') << std::endl;
     
+    // Live progress counters, served or snapshotted from their own thread for the whole run
+    LiveMetrics liveMetrics;
+    if (!liveMetrics.start(liveTarget, liveInterval)) {
+        return 1;
+    }
+    if (liveTarget.transport != LiveMetricsTransport::Off) {
+        std::cout << "  Live metrics: " << liveMetrics.describe() << std::endl;
+    }
+    LiveMetrics* live = (liveTarget.transport != LiveMetricsTransport::Off) ? &liveMetrics : nullptr;
+    
+    // From here on the first SIGINT / SIGTERM saves the running simulation
+    if (!checkpointFile.empty()) {
+        installCheckpointSignals();
+        std::cout << "  Checkpoint: " << checkpointFile << " (on SIGINT / SIGTERM";
+        if (checkpointInterval.count() > 0) {
+            std::cout << " and every " << formatDuration(checkpointInterval);
+        }
+        std::cout << ")" << std::endl;
+    }
+    
     // Part 1: Process Simulation
     std::cout << "\n" << std::string(60, '-') << std::endl;
     std::cout << "  PART 1: PROCESS SIMULATION" << std::endl;
     std::cout << std::string(60, '-') << std::endl;
-    std::cout << "  Loading processes from file and simulating execution..." << std::endl;
+    if (streamSource.empty()) {
+        std::cout << "  Loading processes from file and simulating execution..." << std::endl;
+    } else {
+        std::cout << "  Streaming processes from " << (streamSource == "-" ? "stdin" : streamSource)
+                  << " and simulating execution..." << std::endl;
+    }
     std::cout << std::string(60, '-') << std::endl << std::endl;
     
     ProcessSimulator procSim;
-    
-    // Load processes from file - reads process ID and burst time pairs
-    if (!procSim.loadProcesses("processes.txt")) {
-        std::cerr << "\n[ERROR] Failed to load processes. Exiting." << std::endl;
-        return 1;
+    if (resume.kind == CheckpointKind::Philosophers) {
+        // The processes had finished when the philosophers were saved
+        std::cout << "  Skipped: the process simulation had completed before checkpoint " << resumeFile << std::endl;
     }
+    procSim.setExecutionMode(processMode);
+    procSim.setSchedulingPolicy(policy);
+    procSim.setReadyQueue(readyQueue);
+    procSim.setWorkerCount(static_cast<unsigned int>(cpuCount));
+    procSim.setTimeQuantum(quantum);
+    procSim.setTimeScale(timeScale);
+    procSim.setExecutorType(executorType);
+    procSim.setMetricsPath(processMetrics, metricsFormat);
+    procSim.setTracePath(processTrace);
+    procSim.setPinning(pinning);
+    procSim.setBurstMode(burstMode);
+    procSim.setLiveMetrics(live);
+    procSim.setCheckpoint(checkpointFile, checkpointInterval);
     
-    // Execute all process threads - creates one thread per process
-    // Each thread simulates CPU burst time using sleep
-    procSim.executeProcesses();
+    if (resume.kind == CheckpointKind::Philosophers) {
+        // Nothing to run: continue with Part 2
+    } else if (!streamSource.empty()) {
+        // Streaming ingestion - records run while the rest of the trace is still being read
+        if (!procSim.streamProcesses(streamSource, queueCapacity)) {
+            std::cerr << "\n[ERROR] Failed to stream processes. Exiting." << std::endl;
+            return 1;
+        }
+    } else {
+        // Load processes from file - reads process ID and burst time pairs
+        if (!procSim.loadProcesses("processes.txt")) {
+            std::cerr << "\n[ERROR] Failed to load processes. Exiting." << std::endl;
+            return 1;
+        }
+        
+        if (resume.kind == CheckpointKind::Processes) {
+            if (!procSim.setResumePoint(resume.processes)) {
+                return 1;
+            }
+            std::cout << "  Resuming from " << resumeFile << " at t=" << resume.processes.clock << " ("
+                      << schedulingPolicyName(resume.processes.policy) << ", "
+                      << resume.processes.cpus.size() << " CPUs)" << std::endl << std::endl;
+        }
+        
+        // Execute all processes - each one is a task on the bounded worker pool
+        // (--cpus workers, or coroutines on them) that sleeps or burns for its
+        // CPU burst; in virtual time they run on simulated CPUs instead
+        procSim.executeProcesses();
+        if (procSim.wasInterrupted()) {
+            std::cout << "\n  Interrupted: process simulation saved to " << checkpointFile
+                      << "; continue with --resume " << checkpointFile << std::endl;
+            return 3;
+        }
+    }
     
-    std::cout << "\n" << std::string(60, '-') << std::endl;
-    std::cout << "  All processes completed successfully." << std::endl;
-    std::cout << std::string(60, '-') << std::endl;
+    if (resume.kind != CheckpointKind::Philosophers) {
+        std::cout << "\n" << std::string(60, '-') << std::endl;
+        std::cout << "  All processes completed successfully." << std::endl;
+        std::cout << std::string(60, '-') << std::endl << std::endl;
+        if (Logger::levelEnabled(LogLevel::Summary)) {
+            procSim.printStatistics(std::cout);
+        }
+    }
     
     // Section separator between simulations
     std::cout << "\n\n" << std::string(60, '=') << std::endl;
@@ -64,20 +423,77 @@ int main() {
     std::cout << "\n" << std::string(60, '-') << std::endl;
     std::cout << "  PART 2: DINING PHILOSOPHERS SIMULATION" << std::endl;
     std::cout << std::string(60, '-') << std::endl;
-    std::cout << "  Simulating 5 philosophers with deadlock prevention..." << std::endl;
-    std::cout << "  Strategy: Ordered resource acquisition" << std::endl;
+    std::cout << "  Simulating " << table.agentCount() << " philosophers sharing " << table.resourceCount()
+              << " forks " << (strategy == DiningStrategy::Naive ? "without" : "with") << " deadlock prevention..."
+              << std::endl;
+    std::cout << "  Table: " << table.describe() << std::endl;
+    std::cout << "  Strategy: " << diningStrategyName(strategy) << (coroutines ? " (coroutines)" : "") << std::endl;
     std::cout << std::string(60, '-') << std::endl << std::endl;
     
+    if (coroutines) {
+        // Same table as coroutines: forks are AsyncMutexes, think/eat are scheduler timers
+        CoroutinePhilosophers coSim(3, philosopherCount);
+        coSim.setWorkerCount(static_cast<unsigned int>(philosopherWorkers));
+        coSim.setRunDuration(philosopherDuration);
+        coSim.setPinning(pinning);
+        if (seedGiven) {
+            coSim.setSeed(seed);
+        }
+        coSim.setThinkDistribution(thinkTime);
+        coSim.setEatDistribution(eatTime);
+        coSim.simulate();
+        
+        std::cout << "\n" << std::string(60, '-') << std::endl;
+        std::cout << "  All philosophers completed successfully." << std::endl;
+        std::cout << std::string(60, '-') << std::endl << std::endl;
+        if (Logger::levelEnabled(LogLevel::Summary)) {
+            coSim.printStatistics(std::cout);
+        }
+        
+        std::cout << "\n" << std::string(60, '=') << std::endl;
+        std::cout << "  SIMULATION COMPLETE" << std::endl;
+        std::cout << std::string(60, '=') << std::endl << std::endl;
+        return 0;
+    }
+    
     // Create dining philosophers simulation with 3 think-eat cycles per philosopher
-    // Deadlock Prevention Strategy: Ordered resource acquisition
+    // Default Deadlock Prevention Strategy: Ordered resource acquisition
     // - Each philosopher picks up the lower-numbered fork first, then the higher-numbered fork
     // - This breaks the circular wait condition and prevents deadlock
-    DiningPhilosophers philSim(3);
+    DiningPhilosophers philSim(3, philosopherCount);
+    philSim.setResourceGraph(table);
+    philSim.setWorkerCount(static_cast<unsigned int>(philosopherWorkers));
+    philSim.setStrategy(strategy);
+    philSim.setForkLockType(forkLock);
+    philSim.setReadRatio(readRatio);
+    philSim.setDeadlockDetection(deadlockAction, deadlockInterval);
+    philSim.setRunDuration(philosopherDuration);
+    philSim.setMetricsPath(philosopherMetrics);
+    philSim.setTracePath(philosopherTrace);
+    philSim.setPinning(pinning);
+    philSim.setLiveMetrics(live);
+    if (seedGiven) {
+        philSim.setSeed(seed);
+    }
+    philSim.setThinkDistribution(thinkTime);
+    philSim.setEatDistribution(eatTime);
+    philSim.setCheckpoint(checkpointFile);
+    if (resume.kind == CheckpointKind::Philosophers && !philSim.setResumePoint(resume.philosophers)) {
+        return 1;
+    }
     philSim.simulate();
+    if (philSim.wasInterrupted()) {
+        std::cout << "\n  Interrupted: philosophers saved to " << checkpointFile
+                  << "; continue with --resume " << checkpointFile << std::endl;
+        return 3;
+    }
     
     std::cout << "\n" << std::string(60, '-') << std::endl;
     std::cout << "  All philosophers completed successfully." << std::endl;
-    std::cout << std::string(60, '-') << std::endl;
+    std::cout << std::string(60, '-') << std::endl << std::endl;
+    if (Logger::levelEnabled(LogLevel::Summary)) {
+        philSim.printStatistics(std::cout);
+    }
     
     std::cout << "\n" << std::string(60, '=') << std::endl;
     std::cout << "  SIMULATION COMPLETE" << std::endl;
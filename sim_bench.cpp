@@ -0,0 +1,625 @@
+/**
+ * @file sim_bench.cpp
+ * @brief Microbenchmark harness for both simulations
+ *
+ * Runs ProcessSimulator and DiningPhilosophers with logging off and zero (or
+ * configurable) sleep durations across a grid of configurations, and prints
+ * one row per configuration with throughput and latency percentiles:
+ *
+ *   process-rt    real-time pool       executors x threads x procs  processes/s, response latency
+ *   process-vt    virtual-time engine  policies x ready queues x CPUs x procs   processes/s
+ *   philosophers  dining table         strategies x locks x N x workers  meals/s, wait-for-forks latency
+ *   rw-table      shared hot fork      read ratios x rw locks x N x workers  meals/s, gain over the first lock
+ *
+ * Example:
+ *
+ *   sim_bench --threads 1,4 --processes 10000 --philosophers 5,64 --meals 500
+ *   sim_bench --suite philosophers --think exp:20us --eat uniform:1us:5us
+ *   sim_bench --pin scatter --threads 8,16
+ *   sim_bench --suite process --policies sjf,srtf,priority --ready-queues heap,bucket --workload big.bin
+ *   sim_bench --suite rw --read-ratios 0,0.9,1 --threads 8 --eat constant:2us
+ *
+ * Each configuration is run --repeat times and the fastest run is reported,
+ * which keeps the numbers stable enough to compare two builds. Philosopher
+ * runs use a fixed seed, so every build sees the same think and eat draws.
+ * SJF, SRTF and Priority are run once per --ready-queues entry; FCFS and
+ * Round-Robin do not use a keyed ready queue and are run once.
+ *
+ * The rw-table benchmark seats N philosophers at a table where philosopher
+ * i needs fork 0, which everyone shares, and its own fork i + 1. Each meal
+ * is a read with the given ratio and holds its forks shared. With std::mutex
+ * every meal still takes fork 0 alone; with a shared-capable lock readers
+ * eat together, so the gain column shows what shared acquisition buys at
+ * each read ratio.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include "ProcessSimulator.h"
+#include "DiningPhilosophers.h"
+#include "LatencyHistogram.h"
+#include "DurationDistribution.h"
+#include "CpuTopology.h"
+
+/**
+ * @struct BenchOptions
+ * @brief Benchmark grid and timing parameters from the command line
+ */
+struct BenchOptions {
+    std::vector<int> threads;              ///< Worker / CPU counts
+    std::vector<int> processCounts;        ///< Synthetic workload sizes
+    std::vector<int> philosopherCounts;    ///< Table sizes
+    std::vector<DiningStrategy> strategies;    ///< Fork protocols
+    std::vector<ForkLockType> forkLocks;       ///< Fork lock implementations
+    std::vector<ForkLockType> rwLocks;         ///< Fork locks of the rw-table benchmark (the first is the baseline)
+    std::vector<double> readRatios;            ///< Read ratios of the rw-table benchmark
+    DeadlockAction deadlockAction;             ///< Watchdog action for the naive strategy
+    std::vector<SchedulingPolicy> policies;    ///< Virtual-time scheduling policies
+    std::vector<ReadyQueueType> readyQueues;   ///< Ready queues of the keyed policies
+    std::string workloadFile;                  ///< Trace benchmarked instead of the synthetic workloads
+    std::vector<ExecutorType> executors;       ///< Real-time worker pools
+    int meals;                             ///< Think-eat cycles per philosopher
+    int burstMicros;                       ///< Real-time microseconds per burst unit
+    DurationDistribution thinkTime;        ///< Philosopher think time
+    DurationDistribution eatTime;          ///< Philosopher eat time
+    int repeat;                            ///< Runs per configuration (best is reported)
+    CpuPinning pinning;                    ///< CPU placement of real-time and philosopher workers
+    BurstMode burstMode;                   ///< Real-time bursts sleep or burn a core
+    bool runProcesses;                     ///< Run the process benchmarks
+    bool runPhilosophers;                  ///< Run the philosopher benchmarks
+    bool runReadWrite;                     ///< Run the rw-table benchmarks
+};
+
+/**
+ * @struct BenchResult
+ * @brief Outcome of one configuration
+ */
+struct BenchResult {
+    double opsPerSecond;        ///< Completed operations per wall-clock second
+    bool hasLatency;            ///< false if the benchmark has no wall-clock latency
+    LatencyHistogram latency;   ///< Per-operation latency in nanoseconds
+};
+
+/**
+ * @brief Print command-line usage
+ * @param program Program name (argv[0])
+ */
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --suite all|process|philosophers|rw  Benchmarks to run (default: all)\n"
+              << "  --threads LIST        Worker/CPU counts (default: 1,2,4)\n"
+              << "  --processes LIST      Process counts (default: 1000,10000)\n"
+              << "  --policies LIST       Virtual-time policies (default: fcfs,sjf,srtf,rr,priority)\n"
+              << "  --ready-queues LIST   Ready queues of sjf/srtf/priority (default: scan,heap,pairing,bucket)\n"
+              << "  --workload FILE       Benchmark the processes of a trace instead of --processes\n"
+              << "  --executors LIST      Real-time worker pools (default: pool,stealing)\n"
+              << "  --philosophers LIST   Philosopher counts (default: 5,64)\n"
+              << "  --strategies LIST     Fork strategies (default: ordered,waiter,chandy-misra,trylock,monitor)\n"
+              << "  --locks LIST          Fork locks (default: mutex,spin)\n"
+              << "  --rw-locks LIST       rw-table fork locks, the first is the baseline (default: mutex,shared,biased)\n"
+              << "  --read-ratios LIST    rw-table read ratios from 0 to 1 (default: 0,0.5,0.9,0.99,1)\n"
+              << "  --deadlock ACTION     Naive strategy watchdog: off, report, abort or preempt (default: abort)\n"
+              << "  --meals N             Cycles per philosopher (default: 200)\n"
+              << "  --burst-us N          Real-time microseconds per burst unit (default: 0)\n"
+              << "  --think-us N          Longest think time in microseconds (default: 0)\n"
+              << "  --eat-us N            Eat time in microseconds (default: 0)\n"
+              << "  --think DIST          Think time distribution, e.g. exp:20us (overrides --think-us)\n"
+              << "  --eat DIST            Eat time distribution, e.g. uniform:1us:5us (overrides --eat-us)\n"
+              << "  --repeat N            Runs per configuration, best reported (default: 3)\n"
+              << "  --burst-mode M        Real-time bursts: sleep or burn (default: sleep)\n"
+              << "  --pin SPEC            Pin workers: none, compact, scatter or a CPU list (default: none)" << std::endl;
+}
+
+/**
+ * @brief Split a comma-separated list
+ * @param text List text
+ * @return Items (empty items are dropped)
+ */
+static std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+/**
+ * @brief Parse a comma-separated list of positive integers
+ * @param text List text
+ * @param values Receives the values
+ * @return true if every item is a positive integer
+ */
+static bool parseIntList(const std::string& text, std::vector<int>& values) {
+    values.clear();
+    for (const auto& item : splitList(text)) {
+        char* end = nullptr;
+        long value = std::strtol(item.c_str(), &end, 10);
+        if (*end != '\0' || value <= 0) {
+            return false;
+        }
+        values.push_back(static_cast<int>(value));
+    }
+    return !values.empty();
+}
+
+/**
+ * @brief Parse a comma-separated list of ratios in [0, 1]
+ * @param text List text
+ * @param values Receives the values
+ * @return true if every item is a number from 0 to 1
+ */
+static bool parseRatioList(const std::string& text, std::vector<double>& values) {
+    values.clear();
+    for (const auto& item : splitList(text)) {
+        char* end = nullptr;
+        double value = std::strtod(item.c_str(), &end);
+        if (*end != '\0' || !(value >= 0.0 && value <= 1.0)) {
+            return false;
+        }
+        values.push_back(value);
+    }
+    return !values.empty();
+}
+
+/**
+ * @brief Parse a comma-separated list of fork lock names
+ * @param text List text
+ * @param values Receives the lock types
+ * @return true if every item is a fork lock name
+ */
+static bool parseLockList(const std::string& text, std::vector<ForkLockType>& values) {
+    values.clear();
+    for (const auto& name : splitList(text)) {
+        ForkLockType forkLock;
+        if (!parseForkLockType(name, forkLock)) {
+            return false;
+        }
+        values.push_back(forkLock);
+    }
+    return !values.empty();
+}
+
+/**
+ * @brief Get the short command-line name of a fork lock type
+ * @param forkLock Lock type
+ * @return Name accepted by parseForkLockType()
+ */
+static const char* forkLockShortName(ForkLockType forkLock) {
+    switch (forkLock) {
+        case ForkLockType::SpinPark:     return "spin";
+        case ForkLockType::SharedMutex:  return "shared";
+        case ForkLockType::ReaderBiased: return "biased";
+        case ForkLockType::Mutex:
+        default:                         return "mutex";
+    }
+}
+
+/**
+ * @brief Parse a non-negative integer option value
+ * @param text Option value
+ * @param value Receives the value
+ * @return true if the text is a non-negative integer
+ */
+static bool parseCount(const char* text, int& value) {
+    char* end = nullptr;
+    long parsed = std::strtol(text, &end, 10);
+    if (*end != '\0' || parsed < 0) {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+/**
+ * @brief Build a deterministic synthetic workload
+ *
+ * Burst times cycle through 1..10 units; every process arrives at time 0 so
+ * the benchmark measures dispatch rather than arrival pacing. Priorities vary
+ * so that the Priority policy has real work to do.
+ *
+ * @param count Number of processes
+ * @return The workload
+ */
+static std::vector<Process> makeWorkload(int count) {
+    std::vector<Process> workload(static_cast<std::size_t>(count));
+    for (int i = 0; i < count; i++) {
+        Process& proc = workload[static_cast<std::size_t>(i)];
+        proc.pid = i + 1;
+        proc.burstTime = 1 + (i * 7) % 10;
+        proc.arrivalTime = 0;
+        proc.priority = (i * 13) % 5;
+    }
+    return workload;
+}
+
+/**
+ * @brief Real-time process simulation on a worker pool
+ *
+ * Latency is each process's response time (queued to started).
+ */
+static BenchResult benchProcessRealTime(const std::vector<Process>& workload, int threads, int burstMicros,
+                                        ExecutorType executor, const BenchOptions& options) {
+    ProcessSimulator sim;
+    sim.setLoggingEnabled(false);
+    sim.setPinning(options.pinning);
+    sim.setBurstMode(options.burstMode);
+    sim.setProcesses(workload);
+    sim.setWorkerCount(static_cast<unsigned int>(threads));
+    sim.setExecutorType(executor);
+    sim.setTimeScale(burstMicros * 1e-6);
+
+    auto begin = std::chrono::steady_clock::now();
+    sim.executeProcesses();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    BenchResult result;
+    result.opsPerSecond = (seconds > 0.0) ? workload.size() / seconds : 0.0;
+    result.hasLatency = true;
+    for (const auto& record : sim.getProcessStats()) {
+        double response = (record.responseTime > 0.0) ? record.responseTime : 0.0;
+        result.latency.record(static_cast<std::uint64_t>(response * 1e9));
+    }
+    return result;
+}
+
+/**
+ * @brief Virtual-time process simulation under one scheduling policy
+ */
+static BenchResult benchProcessVirtualTime(const std::vector<Process>& workload, int cpus,
+                                           SchedulingPolicy policy, ReadyQueueType readyQueue) {
+    ProcessSimulator sim;
+    sim.setLoggingEnabled(false);
+    sim.setProcesses(workload);
+    sim.setWorkerCount(static_cast<unsigned int>(cpus));
+    sim.setExecutionMode(ExecutionMode::VirtualTime);
+    sim.setSchedulingPolicy(policy);
+    sim.setReadyQueue(readyQueue);
+
+    auto begin = std::chrono::steady_clock::now();
+    sim.executeProcesses();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    BenchResult result;
+    result.opsPerSecond = (seconds > 0.0) ? workload.size() / seconds : 0.0;
+    result.hasLatency = false;
+    return result;
+}
+
+/**
+ * @brief Dining philosophers under one strategy and fork lock
+ *
+ * Latency is each meal's wait for forks ("waiting" to "eating"). The naive
+ * strategy runs under the deadlock watchdog, so a deadlocking configuration
+ * aborts the benchmark (or is preempted) instead of hanging it; the safe
+ * strategies cannot deadlock and run without it.
+ */
+static BenchResult benchPhilosophers(const BenchOptions& options, int philosophers, int workers,
+                                     DiningStrategy strategy, ForkLockType forkLock) {
+    DiningPhilosophers sim(options.meals, philosophers);
+    sim.setLoggingEnabled(false);
+    sim.setWorkerCount(static_cast<unsigned int>(workers));
+    sim.setStrategy(strategy);
+    sim.setForkLockType(forkLock);
+    if (strategy == DiningStrategy::Naive) {
+        sim.setDeadlockDetection(options.deadlockAction);
+    }
+    sim.setThinkDistribution(options.thinkTime);
+    sim.setEatDistribution(options.eatTime);
+    sim.setSeed(1);
+    sim.setPinning(options.pinning);
+    sim.simulate();
+
+    BenchResult result;
+    result.opsPerSecond = sim.getMealsPerSecond();
+    result.hasLatency = true;
+    result.latency = sim.getWaitLatency();
+    return result;
+}
+
+/**
+ * @brief Dining philosophers around one shared hot fork, with a share of read meals
+ *
+ * Philosopher i needs fork 0 and fork i + 1 (ordered acquisition), so every
+ * meal meets on fork 0; reads take both forks shared.
+ */
+static BenchResult benchReadWrite(const BenchOptions& options, int philosophers, int workers,
+                                  ForkLockType forkLock, double readRatio) {
+    std::vector<std::vector<int> > needs(static_cast<std::size_t>(philosophers));
+    for (int i = 0; i < philosophers; i++) {
+        needs[static_cast<std::size_t>(i)] = { 0, i + 1 };
+    }
+    ResourceGraph table;
+    table.setNeeds(needs);
+
+    DiningPhilosophers sim(options.meals);
+    sim.setResourceGraph(table);
+    sim.setLoggingEnabled(false);
+    sim.setWorkerCount(static_cast<unsigned int>(workers));
+    sim.setStrategy(DiningStrategy::Ordered);
+    sim.setForkLockType(forkLock);
+    sim.setReadRatio(readRatio);
+    sim.setThinkDistribution(options.thinkTime);
+    sim.setEatDistribution(options.eatTime);
+    sim.setSeed(1);
+    sim.setPinning(options.pinning);
+    sim.simulate();
+
+    BenchResult result;
+    result.opsPerSecond = sim.getMealsPerSecond();
+    result.hasLatency = true;
+    result.latency = sim.getWaitLatency();
+    return result;
+}
+
+/**
+ * @brief Print one result row
+ * @param name Benchmark name
+ * @param config Configuration description
+ * @param result Best run of the configuration
+ */
+static void printRow(const std::string& name, const std::string& config, const BenchResult& result) {
+    std::cout << "  " << std::left << std::setw(14) << name << std::setw(40) << config << std::right
+              << std::fixed << std::setprecision(0) << std::setw(14) << result.opsPerSecond;
+    if (result.hasLatency) {
+        std::cout << std::setprecision(1)
+                  << std::setw(11) << result.latency.percentile(50.0) / 1e3
+                  << std::setw(11) << result.latency.percentile(99.0) / 1e3
+                  << std::setw(11) << result.latency.percentile(99.9) / 1e3;
+    } else {
+        std::cout << std::setw(11) << "-" << std::setw(11) << "-" << std::setw(11) << "-";
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Run a configuration options.repeat times and keep the fastest run
+ */
+template <typename Run>
+static BenchResult bestOf(int repeat, Run run) {
+    BenchResult best = run();
+    for (int i = 1; i < repeat; i++) {
+        BenchResult next = run();
+        if (next.opsPerSecond > best.opsPerSecond) {
+            best = next;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Main function - parses the grid and runs every configuration
+ * @param argc Number of command-line arguments
+ * @param argv Command-line arguments
+ * @return 0 on success, 1 on invalid arguments
+ */
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    options.threads = { 1, 2, 4 };
+    options.processCounts = { 1000, 10000 };
+    options.philosopherCounts = { 5, 64 };
+    options.strategies = { DiningStrategy::Ordered, DiningStrategy::Waiter, DiningStrategy::ChandyMisra,
+                           DiningStrategy::TryLock, DiningStrategy::Monitor };
+    options.forkLocks = { ForkLockType::Mutex, ForkLockType::SpinPark };
+    options.rwLocks = { ForkLockType::Mutex, ForkLockType::SharedMutex, ForkLockType::ReaderBiased };
+    options.readRatios = { 0.0, 0.5, 0.9, 0.99, 1.0 };
+    options.deadlockAction = DeadlockAction::Abort;
+    options.policies = { SchedulingPolicy::FCFS, SchedulingPolicy::SJF, SchedulingPolicy::SRTF,
+                         SchedulingPolicy::RoundRobin, SchedulingPolicy::Priority };
+    options.readyQueues = { ReadyQueueType::Scan, ReadyQueueType::DaryHeap, ReadyQueueType::PairingHeap,
+                            ReadyQueueType::Bucket };
+    options.executors = { ExecutorType::GlobalQueue, ExecutorType::WorkStealing };
+    options.meals = 200;
+    options.burstMicros = 0;
+    options.repeat = 3;
+    options.runProcesses = true;
+    options.runPhilosophers = true;
+    options.runReadWrite = true;
+    options.pinning.policy = PinningPolicy::None;
+    options.burstMode = BurstMode::Sleep;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool ok = (i + 1 < argc);
+        const char* value = ok ? argv[++i] : "";
+
+        if (!ok) {
+            // Every option takes a value
+        } else if (arg == "--suite") {
+            std::string suite = value;
+            options.runProcesses = (suite == "all" || suite == "process");
+            options.runPhilosophers = (suite == "all" || suite == "philosophers");
+            options.runReadWrite = (suite == "all" || suite == "rw");
+            ok = options.runProcesses || options.runPhilosophers || options.runReadWrite;
+        } else if (arg == "--threads") {
+            ok = parseIntList(value, options.threads);
+        } else if (arg == "--processes") {
+            ok = parseIntList(value, options.processCounts);
+        } else if (arg == "--philosophers") {
+            ok = parseIntList(value, options.philosopherCounts);
+        } else if (arg == "--strategies") {
+            options.strategies.clear();
+            for (const auto& name : splitList(value)) {
+                DiningStrategy strategy;
+                ok = ok && parseDiningStrategy(name, strategy);
+                options.strategies.push_back(strategy);
+            }
+            ok = ok && !options.strategies.empty();
+        } else if (arg == "--locks") {
+            ok = parseLockList(value, options.forkLocks);
+        } else if (arg == "--rw-locks") {
+            ok = parseLockList(value, options.rwLocks);
+        } else if (arg == "--read-ratios") {
+            ok = parseRatioList(value, options.readRatios);
+        } else if (arg == "--deadlock") {
+            ok = parseDeadlockAction(value, options.deadlockAction);
+        } else if (arg == "--policies") {
+            options.policies.clear();
+            for (const auto& name : splitList(value)) {
+                SchedulingPolicy policy;
+                ok = ok && parseSchedulingPolicy(name, policy);
+                options.policies.push_back(policy);
+            }
+            ok = ok && !options.policies.empty();
+        } else if (arg == "--ready-queues") {
+            options.readyQueues.clear();
+            for (const auto& name : splitList(value)) {
+                ReadyQueueType readyQueue;
+                ok = ok && parseReadyQueueType(name, readyQueue);
+                options.readyQueues.push_back(readyQueue);
+            }
+            ok = ok && !options.readyQueues.empty();
+        } else if (arg == "--workload") {
+            options.workloadFile = value;
+        } else if (arg == "--executors") {
+            options.executors.clear();
+            for (const auto& name : splitList(value)) {
+                ExecutorType executor;
+                ok = ok && parseExecutorType(name, executor);
+                options.executors.push_back(executor);
+            }
+            ok = ok && !options.executors.empty();
+        } else if (arg == "--meals") {
+            ok = parseCount(value, options.meals) && options.meals > 0;
+        } else if (arg == "--burst-us") {
+            ok = parseCount(value, options.burstMicros);
+        } else if (arg == "--think-us") {
+            int micros = 0;
+            ok = parseCount(value, micros);
+            options.thinkTime = DurationDistribution::uniform(std::chrono::nanoseconds(0),
+                                                              std::chrono::microseconds(micros));
+        } else if (arg == "--eat-us") {
+            int micros = 0;
+            ok = parseCount(value, micros);
+            options.eatTime = DurationDistribution::constant(std::chrono::microseconds(micros));
+        } else if (arg == "--think") {
+            ok = parseDurationDistribution(value, options.thinkTime);
+        } else if (arg == "--eat") {
+            ok = parseDurationDistribution(value, options.eatTime);
+        } else if (arg == "--repeat") {
+            ok = parseCount(value, options.repeat) && options.repeat > 0;
+        } else if (arg == "--pin") {
+            ok = parseCpuPinning(value, options.pinning);
+        } else if (arg == "--burst-mode") {
+            ok = parseBurstMode(value, options.burstMode);
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::cout << "  Topology: " << CpuTopology::instance().describe() << ", pinning "
+              << describeCpuPinning(options.pinning) << ", bursts " << burstModeName(options.burstMode) << std::endl;
+    std::cout << "  " << std::left << std::setw(14) << "Benchmark" << std::setw(40) << "Config" << std::right
+              << std::setw(14) << "ops/s" << std::setw(11) << "p50 us"
+              << std::setw(11) << "p99 us" << std::setw(11) << "p999 us" << std::endl;
+    std::cout << "  " << std::string(101, '-') << std::endl;
+
+    if (options.runProcesses) {
+        std::vector<Process> loaded;
+        if (!options.workloadFile.empty()) {
+            ProcessSimulator loader;
+            loader.setLoggingEnabled(false);
+            if (!loader.loadProcesses(options.workloadFile)) {
+                return 1;
+            }
+            loaded = loader.getProcesses();
+            options.processCounts = { static_cast<int>(loaded.size()) };
+        }
+
+        for (int count : options.processCounts) {
+            std::vector<Process> workload = loaded.empty() ? makeWorkload(count) : loaded;
+
+            for (ExecutorType executor : options.executors) {
+                for (int threads : options.threads) {
+                    std::ostringstream config;
+                    config << (executor == ExecutorType::WorkStealing ? "stealing" : "pool")
+                           << " threads=" << threads << " procs=" << count;
+                    printRow("process-rt", config.str(), bestOf(options.repeat, [&] {
+                        return benchProcessRealTime(workload, threads, options.burstMicros, executor, options);
+                    }));
+                }
+            }
+
+            for (SchedulingPolicy policy : options.policies) {
+                bool keyed = (policy == SchedulingPolicy::SJF || policy == SchedulingPolicy::SRTF ||
+                              policy == SchedulingPolicy::Priority);
+                std::vector<ReadyQueueType> readyQueues = keyed ? options.readyQueues
+                                                                : std::vector<ReadyQueueType>{ ReadyQueueType::Scan };
+                for (ReadyQueueType readyQueue : readyQueues) {
+                    for (int cpus : options.threads) {
+                        std::ostringstream config;
+                        config << schedulingPolicyName(policy);
+                        if (keyed) {
+                            config << "/" << readyQueueTypeName(readyQueue);
+                        }
+                        config << " cpus=" << cpus << " procs=" << count;
+                        printRow("process-vt", config.str(), bestOf(options.repeat, [&] {
+                            return benchProcessVirtualTime(workload, cpus, policy, readyQueue);
+                        }));
+                    }
+                }
+            }
+        }
+    }
+
+    if (options.runPhilosophers) {
+        for (DiningStrategy strategy : options.strategies) {
+            for (ForkLockType forkLock : options.forkLocks) {
+                for (int philosophers : options.philosopherCounts) {
+                    for (int workers : options.threads) {
+                        std::ostringstream config;
+                        std::string name = diningStrategyName(strategy);
+                        config << name.substr(0, name.find(' '))
+                               << "/" << forkLockShortName(forkLock)
+                               << " n=" << philosophers << " workers=" << workers;
+                        printRow("philosophers", config.str(), bestOf(options.repeat, [&] {
+                            return benchPhilosophers(options, philosophers, workers, strategy, forkLock);
+                        }));
+                    }
+                }
+            }
+        }
+    }
+
+    if (options.runReadWrite) {
+        for (int philosophers : options.philosopherCounts) {
+            for (int workers : options.threads) {
+                for (double readRatio : options.readRatios) {
+                    double baseline = 0.0;
+                    for (ForkLockType forkLock : options.rwLocks) {
+                        BenchResult result = bestOf(options.repeat, [&] {
+                            return benchReadWrite(options, philosophers, workers, forkLock, readRatio);
+                        });
+                        if (baseline <= 0.0) {
+                            baseline = result.opsPerSecond;
+                        }
+                        std::ostringstream config;
+                        config << forkLockShortName(forkLock) << " r=" << std::fixed << std::setprecision(2)
+                               << readRatio << " n=" << philosophers << " workers=" << workers << " x"
+                               << ((baseline > 0.0) ? result.opsPerSecond / baseline : 0.0);
+                        printRow("rw-table", config.str(), result);
+                    }
+                }
+            }
+        }
+    }
+
+    return 0;
+}
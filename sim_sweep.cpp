@@ -0,0 +1,543 @@
+/**
+ * @file sim_sweep.cpp
+ * @brief Parametric sweep runner: many independent simulations in parallel
+ *
+ * Expands a grid of parameters into independent simulation instances, runs
+ * up to --jobs of them at once on a worker pool, and prints one results
+ * table (and optionally a CSV file) in grid order:
+ *
+ *   process       virtual-time engine  traces x policies x CPUs            makespan, throughput, waiting time, utilization
+ *   philosophers  dining table         N x strategies x workers x cycles   meals/s, wait for forks, fairness
+ *
+ * Example:
+ *
+ *   sim_sweep --traces processes.txt,big.bin --policies fcfs,sjf,rr --threads 1,2,4,8
+ *   sim_sweep --suite philosophers --philosophers 5,64,256 --strategies ordered,waiter --iterations 100,1000
+ *   sim_sweep --csv results.csv --jobs 16
+ *
+ * Each trace is loaded once and shared read-only by its instances. Process
+ * instances run in virtual time, so they are deterministic and use exactly
+ * one thread each. Philosopher instances run in real time (think and eat
+ * times default to zero) with a fixed seed, and each one starts its own
+ * worker pool of --threads workers.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include "ProcessSimulator.h"
+#include "DiningPhilosophers.h"
+#include "LatencyHistogram.h"
+#include "DurationDistribution.h"
+#include "ThreadPool.h"
+
+/**
+ * @struct SweepOptions
+ * @brief Parameter grid and shared settings from the command line
+ */
+struct SweepOptions {
+    std::vector<std::string> traces;           ///< Process trace files (text or binary)
+    std::vector<SchedulingPolicy> policies;    ///< Virtual-time scheduling policies
+    std::vector<int> threads;                  ///< Simulated CPUs (processes) / pool workers (philosophers)
+    std::vector<int> philosopherCounts;        ///< Table sizes
+    std::vector<DiningStrategy> strategies;    ///< Fork protocols
+    std::vector<int> iterations;               ///< Think-eat cycles per philosopher
+    int quantum;                               ///< Round-Robin time quantum
+    DurationDistribution thinkTime;            ///< Philosopher think time
+    DurationDistribution eatTime;              ///< Philosopher eat time
+    std::uint64_t seed;                        ///< Seed of every philosopher instance
+    DeadlockAction deadlockAction;             ///< Watchdog action for the naive strategy
+    unsigned int jobs;                         ///< Instances run at once (0 = hardware concurrency)
+    std::string csvPath;                       ///< CSV destination ("" = none)
+    bool runProcesses;                         ///< Sweep the process grid
+    bool runPhilosophers;                      ///< Sweep the philosopher grid
+};
+
+/**
+ * @struct SweepRun
+ * @brief One grid point and, once it has run, its results
+ *
+ * Times are in trace time units for process runs (virtual time) and in
+ * wall-clock seconds for philosopher runs.
+ */
+struct SweepRun {
+    bool philosophers;          ///< false = process simulation, true = dining philosophers
+    std::size_t trace;          ///< Process runs: index in SweepOptions::traces
+    SchedulingPolicy policy;    ///< Process runs: scheduling policy
+    DiningStrategy strategy;    ///< Philosopher runs: fork protocol
+    int threads;                ///< Simulated CPUs or pool workers
+    int philosopherCount;       ///< Philosopher runs: table size
+    int iterations;             ///< Philosopher runs: cycles per philosopher
+    std::uint64_t completed;    ///< Processes finished or meals eaten
+    double makespan;            ///< Length of the simulated run
+    double throughput;          ///< completed / makespan
+    double meanWait;            ///< Mean waiting time (processes) or wait for forks (meals)
+    double p99Wait;             ///< 99th percentile of the same wait
+    double utilization;         ///< Process runs: busy CPU share, 0..1
+    double fairness;            ///< Philosopher runs: Jain index of meal counts
+    double wallSeconds;         ///< Wall-clock time the instance took
+};
+
+/**
+ * @brief Print command-line usage
+ * @param program Program name (argv[0])
+ */
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --suite all|process|philosophers  Grids to run (default: all)\n"
+              << "  --traces LIST         Process trace files (default: processes.txt)\n"
+              << "  --policies LIST       Virtual-time policies (default: fcfs,sjf,srtf,rr,priority)\n"
+              << "  --threads LIST        Simulated CPUs / philosopher workers (default: 1,2,4)\n"
+              << "  --quantum N           Round-Robin time quantum (default: 2)\n"
+              << "  --philosophers LIST   Philosopher counts (default: 5)\n"
+              << "  --strategies LIST     Fork strategies (default: ordered,waiter,chandy-misra,trylock,monitor)\n"
+              << "  --iterations LIST     Think-eat cycles per philosopher (default: 3)\n"
+              << "  --think DIST          Think time distribution (default: constant:0)\n"
+              << "  --eat DIST            Eat time distribution (default: constant:0)\n"
+              << "  --seed N              Seed of every philosopher run (default: 1)\n"
+              << "  --deadlock ACTION     Naive strategy watchdog: off, report, abort or preempt (default: abort)\n"
+              << "  --jobs N              Simulations run at once (default: hardware concurrency)\n"
+              << "  --csv FILE            Also write the results table to FILE as CSV" << std::endl;
+}
+
+/**
+ * @brief Split a comma-separated list
+ * @param text List text
+ * @return Items (empty items are dropped)
+ */
+static std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+/**
+ * @brief Parse a comma-separated list of positive integers
+ * @param text List text
+ * @param values Receives the values
+ * @return true if every item is a positive integer
+ */
+static bool parseIntList(const std::string& text, std::vector<int>& values) {
+    values.clear();
+    for (const auto& item : splitList(text)) {
+        char* end = nullptr;
+        long value = std::strtol(item.c_str(), &end, 10);
+        if (*end != '\0' || value <= 0) {
+            return false;
+        }
+        values.push_back(static_cast<int>(value));
+    }
+    return !values.empty();
+}
+
+/**
+ * @brief Parse a positive integer option value
+ * @param text Option value
+ * @param value Receives the value
+ * @return true if the text is a positive integer
+ */
+static bool parsePositive(const char* text, int& value) {
+    char* end = nullptr;
+    long parsed = std::strtol(text, &end, 10);
+    if (*end != '\0' || parsed <= 0) {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+/**
+ * @brief Get a percentile of a set of values exactly (nearest rank, as LatencyHistogram)
+ * @param values Values; reordered in place
+ * @param percentile Percentile in (0, 100]
+ * @return The value at rank ceil(p/100 * count) (0 if empty)
+ */
+static double exactPercentile(std::vector<double>& values, double percentile) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::size_t rank = static_cast<std::size_t>(std::ceil(percentile / 100.0 * static_cast<double>(values.size())));
+    std::size_t index = (rank == 0) ? 0 : std::min(rank, values.size()) - 1;
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+    return values[index];
+}
+
+/**
+ * @brief Run one process grid point in virtual time
+ *
+ * Waits are in trace time units, which can be far beyond the nanosecond
+ * range of a LatencyHistogram, so their p99 is taken from the exact values.
+ *
+ * @param run Grid point; receives the results
+ * @param workload Processes of the run's trace
+ * @param options Shared settings
+ */
+static void runProcessSimulation(SweepRun& run, const std::vector<Process>& workload, const SweepOptions& options) {
+    ProcessSimulator sim;
+    sim.setLoggingEnabled(false);
+    sim.setProcesses(workload);
+    sim.setExecutionMode(ExecutionMode::VirtualTime);
+    sim.setSchedulingPolicy(run.policy);
+    sim.setWorkerCount(static_cast<unsigned int>(run.threads));
+    sim.setTimeQuantum(options.quantum);
+    sim.executeProcesses();
+
+    const RunSummary& summary = sim.getRunSummary();
+    std::vector<double> waits;
+    waits.reserve(sim.getProcessStats().size());
+    double totalWait = 0.0;
+    for (const auto& record : sim.getProcessStats()) {
+        double waiting = (record.waitingTime > 0.0) ? record.waitingTime : 0.0;
+        totalWait += waiting;
+        waits.push_back(waiting);
+    }
+    run.completed = summary.processes;
+    run.makespan = summary.makespan;
+    run.throughput = summary.throughput;
+    run.meanWait = (summary.processes > 0) ? totalWait / summary.processes : 0.0;
+    run.p99Wait = exactPercentile(waits, 99.0);
+    run.utilization = summary.utilization;
+}
+
+/**
+ * @brief Run one philosopher grid point in real time
+ * @param run Grid point; receives the results
+ * @param options Shared settings
+ */
+static void runPhilosopherSimulation(SweepRun& run, const SweepOptions& options) {
+    DiningPhilosophers sim(run.iterations, run.philosopherCount);
+    sim.setLoggingEnabled(false);
+    sim.setWorkerCount(static_cast<unsigned int>(run.threads));
+    sim.setStrategy(run.strategy);
+    if (run.strategy == DiningStrategy::Naive) {
+        sim.setDeadlockDetection(options.deadlockAction);
+    }
+    sim.setThinkDistribution(options.thinkTime);
+    sim.setEatDistribution(options.eatTime);
+    sim.setSeed(options.seed);
+    sim.simulate();
+
+    std::uint64_t meals = 0;
+    for (const auto& record : sim.getPhilosopherStats()) {
+        meals += static_cast<std::uint64_t>(record.meals);
+    }
+    LatencyHistogram waits = sim.getWaitLatency();
+    run.completed = meals;
+    run.throughput = sim.getMealsPerSecond();
+    run.makespan = (run.throughput > 0.0) ? meals / run.throughput : 0.0;
+    run.meanWait = waits.mean() / 1e9;
+    run.p99Wait = waits.percentile(99.0) / 1e9;
+    run.fairness = sim.getFairnessIndex();
+}
+
+/**
+ * @brief Get the short name of a fork strategy (first word of its display name)
+ * @param strategy Strategy
+ * @return e.g. "Ordered" or "Waiter"
+ */
+static std::string strategyShortName(DiningStrategy strategy) {
+    std::string name = diningStrategyName(strategy);
+    return name.substr(0, name.find(' '));
+}
+
+/**
+ * @brief Describe the input and protocol of a grid point
+ * @param run Grid point
+ * @param options Shared settings (for the trace names)
+ * @return e.g. "processes.txt sjf" or "ring of 5 Ordered"
+ */
+static std::string describeRun(const SweepRun& run, const SweepOptions& options) {
+    if (run.philosophers) {
+        return "ring of " + std::to_string(run.philosopherCount) + " " + strategyShortName(run.strategy);
+    }
+    return options.traces[run.trace] + " " + schedulingPolicyName(run.policy);
+}
+
+/**
+ * @brief Format a number with a fixed number of decimals
+ * @param value Number
+ * @param precision Decimals
+ * @return e.g. "41028.123456"
+ */
+static std::string formatFixed(double value, int precision) {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(precision) << value;
+    return text.str();
+}
+
+/**
+ * @brief Print the results table
+ *
+ * Cells are formatted first and every column is as wide as its widest
+ * cell, with two spaces between columns, so long trace paths and large
+ * waits never run into their neighbours.
+ *
+ * @param runs Every grid point, in grid order
+ * @param options Shared settings
+ */
+static void printTable(const std::vector<SweepRun>& runs, const SweepOptions& options) {
+    const std::vector<std::string> header = {"#", "Simulation", "Config", "Threads", "Iter", "Completed", "Makespan",
+                                             "Throughput", "Avg wait", "P99 wait", "Util", "Fairness", "Wall s"};
+    const std::size_t leftColumns[] = {1, 2};  // Simulation and Config are left-aligned
+    std::vector<std::vector<std::string> > rows;
+    rows.reserve(runs.size());
+    for (std::size_t i = 0; i < runs.size(); i++) {
+        const SweepRun& run = runs[i];
+        rows.push_back({std::to_string(i), run.philosophers ? "philosophers" : "process", describeRun(run, options),
+                        std::to_string(run.threads), run.philosophers ? std::to_string(run.iterations) : "-",
+                        std::to_string(run.completed), formatFixed(run.makespan, 3), formatFixed(run.throughput, 3),
+                        formatFixed(run.meanWait, 6), formatFixed(run.p99Wait, 6),
+                        run.philosophers ? "-" : formatFixed(run.utilization * 100.0, 1) + "%",
+                        run.philosophers ? formatFixed(run.fairness, 3) : "-", formatFixed(run.wallSeconds, 3)});
+    }
+
+    std::vector<std::size_t> widths(header.size());
+    for (std::size_t c = 0; c < header.size(); c++) {
+        widths[c] = header[c].size();
+        for (const auto& row : rows) {
+            widths[c] = std::max(widths[c], row[c].size());
+        }
+    }
+    std::size_t lineWidth = 0;
+    for (std::size_t width : widths) {
+        lineWidth += width + 2;
+    }
+
+    auto printRow = [&](const std::vector<std::string>& cells) {
+        std::cout << " ";
+        for (std::size_t c = 0; c < cells.size(); c++) {
+            bool left = std::find(std::begin(leftColumns), std::end(leftColumns), c) != std::end(leftColumns);
+            std::cout << "  " << (left ? std::left : std::right) << std::setw(static_cast<int>(widths[c])) << cells[c];
+        }
+        std::cout << std::right << std::endl;
+    };
+    printRow(header);
+    std::cout << "  " << std::string(lineWidth - 2, '-') << std::endl;
+    for (const auto& row : rows) {
+        printRow(row);
+    }
+}
+
+/**
+ * @brief Write the results table as CSV (empty cells where a column does not apply)
+ * @param runs Every grid point, in grid order
+ * @param options Shared settings
+ * @return true on success, false (with a message on std::cerr) on error
+ */
+static bool writeCsv(const std::vector<SweepRun>& runs, const SweepOptions& options) {
+    std::ofstream file(options.csvPath, std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot create results file " << options.csvPath << std::endl;
+        return false;
+    }
+    file << "run,simulation,trace,policy,philosophers,strategy,threads,iterations,completed,makespan,"
+         << "throughput,meanWait,p99Wait,utilization,fairness,wallSeconds\n";
+    for (std::size_t i = 0; i < runs.size(); i++) {
+        const SweepRun& run = runs[i];
+        file << i << ",";
+        if (run.philosophers) {
+            file << "philosophers,,," << run.philosopherCount << "," << strategyShortName(run.strategy) << ","
+                 << run.threads << "," << run.iterations << ",";
+        } else {
+            file << "process," << options.traces[run.trace] << "," << schedulingPolicyName(run.policy) << ",,,"
+                 << run.threads << ",,";
+        }
+        file << run.completed << "," << run.makespan << "," << run.throughput << "," << run.meanWait << ","
+             << run.p99Wait << ",";
+        if (run.philosophers) {
+            file << "," << run.fairness;
+        } else {
+            file << run.utilization << ",";
+        }
+        file << "," << run.wallSeconds << "\n";
+    }
+    if (!file) {
+        std::cerr << "Error: Failed to write results file " << options.csvPath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Main function - parses the grid, runs every grid point and prints the results
+ * @param argc Number of command-line arguments
+ * @param argv Command-line arguments
+ * @return 0 on success, 1 on invalid arguments or unreadable traces
+ */
+int main(int argc, char* argv[]) {
+    SweepOptions options;
+    options.traces = { "processes.txt" };
+    options.policies = { SchedulingPolicy::FCFS, SchedulingPolicy::SJF, SchedulingPolicy::SRTF,
+                         SchedulingPolicy::RoundRobin, SchedulingPolicy::Priority };
+    options.threads = { 1, 2, 4 };
+    options.philosopherCounts = { 5 };
+    options.strategies = { DiningStrategy::Ordered, DiningStrategy::Waiter, DiningStrategy::ChandyMisra,
+                           DiningStrategy::TryLock, DiningStrategy::Monitor };
+    options.iterations = { 3 };
+    options.quantum = 2;
+    options.seed = 1;
+    options.deadlockAction = DeadlockAction::Abort;
+    options.jobs = 0;
+    options.runProcesses = true;
+    options.runPhilosophers = true;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool ok = (i + 1 < argc);
+        const char* value = ok ? argv[++i] : "";
+
+        if (!ok) {
+            // Every option takes a value
+        } else if (arg == "--suite") {
+            std::string suite = value;
+            options.runProcesses = (suite == "all" || suite == "process");
+            options.runPhilosophers = (suite == "all" || suite == "philosophers");
+            ok = options.runProcesses || options.runPhilosophers;
+        } else if (arg == "--traces") {
+            options.traces = splitList(value);
+            ok = !options.traces.empty();
+        } else if (arg == "--policies") {
+            options.policies.clear();
+            for (const auto& name : splitList(value)) {
+                SchedulingPolicy policy;
+                ok = ok && parseSchedulingPolicy(name, policy);
+                options.policies.push_back(policy);
+            }
+            ok = ok && !options.policies.empty();
+        } else if (arg == "--threads") {
+            ok = parseIntList(value, options.threads);
+        } else if (arg == "--quantum") {
+            ok = parsePositive(value, options.quantum);
+        } else if (arg == "--philosophers") {
+            ok = parseIntList(value, options.philosopherCounts);
+        } else if (arg == "--strategies") {
+            options.strategies.clear();
+            for (const auto& name : splitList(value)) {
+                DiningStrategy strategy;
+                ok = ok && parseDiningStrategy(name, strategy);
+                options.strategies.push_back(strategy);
+            }
+            ok = ok && !options.strategies.empty();
+        } else if (arg == "--iterations") {
+            ok = parseIntList(value, options.iterations);
+        } else if (arg == "--think") {
+            ok = parseDurationDistribution(value, options.thinkTime);
+        } else if (arg == "--eat") {
+            ok = parseDurationDistribution(value, options.eatTime);
+        } else if (arg == "--seed") {
+            char* end = nullptr;
+            options.seed = std::strtoull(value, &end, 10);
+            ok = (*value >= '0' && *value <= '9') && *end == '\0';
+        } else if (arg == "--deadlock") {
+            ok = parseDeadlockAction(value, options.deadlockAction);
+        } else if (arg == "--jobs") {
+            int jobs = 0;
+            ok = parsePositive(value, jobs);
+            options.jobs = static_cast<unsigned int>(jobs);
+        } else if (arg == "--csv") {
+            options.csvPath = value;
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Every trace is read once, up front, and shared by its runs
+    std::vector<std::vector<Process> > workloads;
+    if (options.runProcesses) {
+        for (const auto& path : options.traces) {
+            ProcessSimulator loader;
+            loader.setLoggingEnabled(false);
+            if (!loader.loadProcesses(path)) {
+                std::cerr << "Error: Failed to load trace " << path << std::endl;
+                return 1;
+            }
+            workloads.push_back(loader.getProcesses());
+        }
+    }
+
+    // Expand the grid in a fixed order; results are reported in this order
+    std::vector<SweepRun> runs;
+    SweepRun point = SweepRun();
+    if (options.runProcesses) {
+        point.philosophers = false;
+        for (std::size_t t = 0; t < options.traces.size(); t++) {
+            for (SchedulingPolicy policy : options.policies) {
+                for (int threads : options.threads) {
+                    point.trace = t;
+                    point.policy = policy;
+                    point.threads = threads;
+                    runs.push_back(point);
+                }
+            }
+        }
+    }
+    if (options.runPhilosophers) {
+        point.philosophers = true;
+        for (int count : options.philosopherCounts) {
+            for (DiningStrategy strategy : options.strategies) {
+                for (int threads : options.threads) {
+                    for (int iterations : options.iterations) {
+                        point.philosopherCount = count;
+                        point.strategy = strategy;
+                        point.threads = threads;
+                        point.iterations = iterations;
+                        runs.push_back(point);
+                    }
+                }
+            }
+        }
+    }
+
+    // Independent instances: each task owns its simulator and writes only its own row
+    auto begin = std::chrono::steady_clock::now();
+    unsigned int jobs = 0;
+    {
+        ThreadPool pool(options.jobs);
+        jobs = pool.size();
+        for (std::size_t i = 0; i < runs.size(); i++) {
+            pool.submit([&runs, &workloads, &options, i] {
+                SweepRun& run = runs[i];
+                auto runStart = std::chrono::steady_clock::now();
+                if (run.philosophers) {
+                    runPhilosopherSimulation(run, options);
+                } else {
+                    runProcessSimulation(run, workloads[run.trace], options);
+                }
+                run.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+            });
+        }
+        pool.wait();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    printTable(runs, options);
+    std::cout << std::endl << "  " << runs.size() << " simulations in " << std::fixed << std::setprecision(3)
+              << seconds << "s (up to " << jobs << " at a time)" << std::endl;
+
+    if (!options.csvPath.empty() && !writeCsv(runs, options)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file trace_convert.cpp
+ * @brief Command-line converter between the text and binary trace formats
+ * 
+ * Reads a trace in either format (the binary format is detected by its magic)
+ * and writes it in the other one, or in the format selected explicitly:
+ * 
+ *   trace_convert processes.txt processes.bin          # text -> binary
+ *   trace_convert --to-text processes.bin out.txt      # binary -> text
+ * 
+ * Input validation is the same as ProcessSimulator::loadProcesses().
+ * 
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include <iostream>
+#include <string>
+#include "ProcessSimulator.h"
+#include "TraceFile.h"
+#include "MappedFile.h"
+
+/**
+ * @brief Print command-line usage
+ * @param program Program name (argv[0])
+ */
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--to-text | --to-binary] <input> <output>" << std::endl;
+}
+
+/**
+ * @brief Main function - loads the input trace and writes the converted trace
+ * 
+ * Without an explicit direction, text input is written as binary and binary
+ * input as text.
+ * 
+ * @param argc Number of command-line arguments
+ * @param argv Command-line arguments
+ * @return 0 on success, 1 on invalid arguments or I/O/validation errors
+ */
+int main(int argc, char* argv[]) {
+    enum { AUTO, TO_TEXT, TO_BINARY } direction = AUTO;
+    std::string input;
+    std::string output;
+    
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--to-text") {
+            direction = TO_TEXT;
+        } else if (arg == "--to-binary") {
+            direction = TO_BINARY;
+        } else if (input.empty()) {
+            input = arg;
+        } else if (output.empty()) {
+            output = arg;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    
+    if (input.empty() || output.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    // Resolve the automatic direction from the input format
+    if (direction == AUTO) {
+        MappedFile probe;
+        if (!probe.open(input)) {
+            std::cerr << "Error: Cannot open file " << input << std::endl;
+            return 1;
+        }
+        direction = isBinaryTrace(probe.data(), probe.size()) ? TO_TEXT : TO_BINARY;
+    }
+    
+    ProcessSimulator sim;
+    if (!sim.loadProcesses(input)) {
+        return 1;
+    }
+    
+    const std::vector<Process>& processes = sim.getProcesses();
+    bool written = (direction == TO_TEXT) ? writeTextTrace(output, processes)
+                                          : writeBinaryTrace(output, processes);
+    if (!written) {
+        std::cerr << "Error: Failed to write " << output << std::endl;
+        return 1;
+    }
+    
+    std::cout << "Converted " << processes.size() << " processes: " << input << " -> " << output
+              << (direction == TO_TEXT ? " (text)" : " (binary)") << std::endl;
+    return 0;
+}
@@ -0,0 +1,234 @@
+/**
+ * @file trace_gen.cpp
+ * @brief Command-line generator of large synthetic process traces
+ *
+ * Writes a seeded, deterministic workload in the text or binary trace
+ * format (see TraceGenerator.h for the arrival and burst models):
+ *
+ *   trace_gen --count 1000000 --arrivals poisson:0.5 --bursts exp:2 big.bin
+ *   trace_gen --count 100000000 --arrivals bursty:4:50 --bursts pareto:1:1.5 --priorities 8 huge.bin
+ *   trace_gen --count 10000 --bursts bimodal:1:40:0.1 - | process_sim --stream - --time-scale 0
+ *
+ * Records are generated and encoded in parallel, a window of chunks at a
+ * time, and written in order, so memory stays bounded for any trace size and
+ * the output is the same for any --threads value. Binary output streams
+ * each chunk's slice of every column to its final offset; output names
+ * ending in ".bin" select it by default.
+ *
+ * @author Thread Simulation System
+ * @date 2024
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstdint>
+#include "ProcessSimulator.h"
+#include "TraceFile.h"
+#include "TraceGenerator.h"
+#include "ThreadPool.h"
+
+/**
+ * @brief Print command-line usage
+ * @param program Program name (argv[0])
+ */
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options] <output | ->\n"
+              << "  --count N          Processes to generate (default: 1000)\n"
+              << "  --arrivals SPEC    zero, periodic:GAP, poisson:RATE or bursty:RATE:BATCH (default: zero)\n"
+              << "  --bursts SPEC      constant:N, uniform:MIN:MAX, exp:MEAN, bimodal:SHORT:LONG:P\n"
+              << "                     or pareto:MIN:ALPHA (default: exp:5)\n"
+              << "  --priorities N     Uniform priorities in [0, N-1] (default: none)\n"
+              << "  --seed N           Seed of the trace (default: 1)\n"
+              << "  --threads N        Generator threads (default: hardware concurrency)\n"
+              << "  --text | --binary  Output format (default: binary for *.bin, text otherwise;\n"
+              << "                     '-' writes text to standard output)" << std::endl;
+}
+
+/**
+ * @brief Parse an unsigned integer option value
+ * @param text Option value
+ * @param value Receives the value
+ * @return true if the text is a decimal number
+ */
+static bool parseUnsigned(const char* text, std::uint64_t& value) {
+    char* end = nullptr;
+    value = std::strtoull(text, &end, 10);
+    return *text >= '0' && *text <= '9' && *end == '\0';
+}
+
+/**
+ * @brief Main function - parses the models and writes the trace
+ * @param argc Number of command-line arguments
+ * @param argv Command-line arguments
+ * @return 0 on success, 1 on invalid arguments or I/O errors
+ */
+int main(int argc, char* argv[]) {
+    enum { AUTO, TEXT, BINARY } format = AUTO;
+    TraceGenerator generator;
+    std::uint64_t threads = 0;
+    std::string output;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool ok = true;
+        std::uint64_t number = 0;
+        if (arg == "--text") {
+            format = TEXT;
+        } else if (arg == "--binary") {
+            format = BINARY;
+        } else if (i + 1 < argc && arg == "--count") {
+            ok = parseUnsigned(argv[++i], number) && number > 0 && number <= static_cast<std::uint64_t>(INT_MAX);
+            generator.setCount(number);
+        } else if (i + 1 < argc && arg == "--arrivals") {
+            ArrivalModel model;
+            ok = parseArrivalModel(argv[++i], model);
+            generator.setArrivalModel(model);
+        } else if (i + 1 < argc && arg == "--bursts") {
+            BurstModel model;
+            ok = parseBurstModel(argv[++i], model);
+            generator.setBurstModel(model);
+        } else if (i + 1 < argc && arg == "--priorities") {
+            ok = parseUnsigned(argv[++i], number) && number <= static_cast<std::uint64_t>(INT_MAX);
+            generator.setPriorityLevels(static_cast<int>(number));
+        } else if (i + 1 < argc && arg == "--seed") {
+            ok = parseUnsigned(argv[++i], number);
+            generator.setSeed(number);
+        } else if (i + 1 < argc && arg == "--threads") {
+            ok = parseUnsigned(argv[++i], threads) && threads > 0 && threads <= 4096;
+        } else if (output.empty() && (arg == "-" || arg[0] != '-')) {
+            output = arg;
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (output.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    bool toStdout = (output == "-");
+    if (format == AUTO) {
+        bool binaryName = output.size() > 4 && output.compare(output.size() - 4, 4, ".bin") == 0;
+        format = binaryName ? BINARY : TEXT;
+    }
+    if (toStdout && format == BINARY) {
+        std::cerr << "Error: Binary traces are written to a file (the columns are seeked to)" << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!toStdout) {
+        file.open(output, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Error: Cannot create file " << output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = toStdout ? std::cout : file;
+
+    auto begin = std::chrono::steady_clock::now();
+    ThreadPool pool(static_cast<unsigned int>(threads));
+    if (!generator.prepare(pool)) {
+        return 1;
+    }
+
+    // Binary layout: header, then one int32[N] array per column in mask order
+    std::uint64_t count = generator.getCount();
+    std::uint32_t columns = TRACE_COLUMN_PID | TRACE_COLUMN_BURST | TRACE_COLUMN_ARRIVAL;
+    if (generator.hasPriorities()) {
+        columns |= TRACE_COLUMN_PRIORITY;
+    }
+    std::size_t columnCount = generator.hasPriorities() ? 4 : 3;
+    if (format == BINARY) {
+        char header[TRACE_HEADER_SIZE];
+        encodeTraceHeader(header, columns, count);
+        out.write(header, TRACE_HEADER_SIZE);
+    }
+
+    // Generate and encode a window of chunks in parallel, then write it in order
+    std::size_t chunks = generator.chunkCount();
+    std::size_t window = static_cast<std::size_t>(pool.size()) * 4;
+    std::vector<TraceChunk> slots(window);
+    std::vector<std::string> encoded(window);
+    std::uint64_t burstSum = 0;
+    int lastArrival = 0;
+    for (std::size_t base = 0; base < chunks && out; base += window) {
+        std::size_t batch = std::min(window, chunks - base);
+        for (std::size_t s = 0; s < batch; s++) {
+            pool.submit([&generator, &slots, &encoded, base, s, format, columnCount] {
+                TraceChunk& chunk = slots[s];
+                std::string& bytes = encoded[s];
+                generator.generate(base + s, chunk);
+                std::size_t n = chunk.pid.size();
+                bytes.clear();
+                if (format == BINARY) {
+                    bytes.resize(4 * n * columnCount);
+                    encodeTraceColumn(chunk.pid.data(), n, &bytes[0]);
+                    encodeTraceColumn(chunk.burstTime.data(), n, &bytes[4 * n]);
+                    encodeTraceColumn(chunk.arrivalTime.data(), n, &bytes[8 * n]);
+                    if (columnCount == 4) {
+                        encodeTraceColumn(chunk.priority.data(), n, &bytes[12 * n]);
+                    }
+                } else {
+                    Process proc = { 0, 0, 0, 0 };
+                    for (std::size_t i = 0; i < n; i++) {
+                        proc.pid = chunk.pid[i];
+                        proc.burstTime = chunk.burstTime[i];
+                        proc.arrivalTime = chunk.arrivalTime[i];
+                        proc.priority = chunk.priority.empty() ? 0 : chunk.priority[i];
+                        appendTraceLine(bytes, proc);
+                    }
+                }
+            });
+        }
+        pool.wait();
+
+        for (std::size_t s = 0; s < batch; s++) {
+            const TraceChunk& chunk = slots[s];
+            std::size_t n = chunk.pid.size();
+            burstSum += chunk.burstSum;
+            lastArrival = chunk.arrivalTime[n - 1];
+            if (format == BINARY) {
+                for (std::size_t k = 0; k < columnCount; k++) {
+                    std::uint64_t offset = TRACE_HEADER_SIZE + 4 * (count * k + chunk.first);
+                    out.seekp(static_cast<std::streamoff>(offset));
+                    out.write(&encoded[s][4 * n * k], static_cast<std::streamsize>(4 * n));
+                }
+            } else {
+                out.write(encoded[s].data(), static_cast<std::streamsize>(encoded[s].size()));
+            }
+        }
+    }
+    out.flush();
+    if (!out) {
+        std::cerr << "Error: Failed to write " << output << std::endl;
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    // The summary goes to std::cerr when the trace itself is on std::cout
+    std::ostream& report = toStdout ? std::cerr : std::cout;
+    double meanBurst = static_cast<double>(burstSum) / static_cast<double>(count);
+    report << "Generated " << generator.describe() << std::endl;
+    report << "Wrote " << count << " processes to " << output << (format == BINARY ? " (binary)" : " (text)")
+           << " in " << std::fixed << std::setprecision(3) << seconds << "s on " << pool.size() << (pool.size() == 1 ? " thread" : " threads")
+           << std::endl;
+    report << "Last arrival " << lastArrival << ", mean burst " << std::setprecision(2) << meanBurst;
+    if (lastArrival > 0) {
+        report << ", offered load " << static_cast<double>(burstSum) / lastArrival << " CPUs";
+    }
+    report << std::endl;
+    return 0;
+}